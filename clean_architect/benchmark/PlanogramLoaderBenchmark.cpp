@@ -0,0 +1,115 @@
+/**
+ * @file PlanogramLoaderBenchmark.cpp
+ * @brief PlanogramLoader の読み込み時間の計測
+ *
+ * 10,000 スロットのカタログ（CSV / JSON）と、数千台分のスロットを含む
+ * 全機械分の CSV をメモリ上に生成し、読み込みにかかる時間を計測します。
+ *
+ * 使い方: planogram_benchmark [繰り返し回数（既定 20）]
+ */
+
+#include "domain/inventory/Inventory.hpp"
+#include "interface_adapters/gateways/loaders/PlanogramLoader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using vending_machine::interface_adapters::PlanogramFormat;
+using vending_machine::interface_adapters::PlanogramLoader;
+
+std::string makeCsv(int machines, int slots_per_machine) {
+  std::string text = "machine_id,slot_id,name,price,stock\n";
+  for (int machine = 1; machine <= machines; ++machine) {
+    for (int slot = 1; slot <= slots_per_machine; ++slot) {
+      text += "M" + std::to_string(machine) + "," + std::to_string(slot) +
+              ",product-" + std::to_string(slot) + "," +
+              std::to_string(100 + slot % 50 * 10) + "," +
+              std::to_string(slot % 51) + "\n";
+    }
+  }
+  return text;
+}
+
+std::string makeJson(int slots) {
+  std::string text = "[\n";
+  for (int slot = 1; slot <= slots; ++slot) {
+    text += std::string(slot == 1 ? "" : ",\n") + "{\"slot_id\": " +
+            std::to_string(slot) + ", \"name\": \"product-" +
+            std::to_string(slot) + "\", \"price\": " +
+            std::to_string(100 + slot % 50 * 10) +
+            ", \"stock\": " + std::to_string(slot % 51) + "}";
+  }
+  return text + "\n]\n";
+}
+
+// 最短時間を採用する（他プロセスの影響を除くため）
+template <typename Body> double bestMillis(int iterations, Body body) {
+  double best = 1e300;
+  for (int i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(
+        best, std::chrono::duration<double, std::milli>(elapsed).count());
+  }
+  return best;
+}
+
+void report(const char *name, const std::string &text, std::size_t rows,
+            double millis) {
+  std::printf("%-28s %8zu rows %9.2f MiB %9.3f ms %12.0f rows/s\n", name,
+              rows, static_cast<double>(text.size()) / (1024.0 * 1024.0),
+              millis, static_cast<double>(rows) / (millis / 1000.0));
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+  PlanogramLoader loader;
+
+  const std::string catalog_csv = makeCsv(1, 10000);
+  const std::string catalog_json = makeJson(10000);
+  const std::string fleet_csv = makeCsv(5000, 40);
+
+  std::size_t rows = 0;
+  double millis = bestMillis(iterations, [&] {
+    vending_machine::domain::Inventory inventory;
+    std::istringstream in(catalog_csv);
+    rows = loader.loadInto(in, PlanogramFormat::CSV, inventory).slots_loaded;
+  });
+  report("catalog 10k slots (CSV)", catalog_csv, rows, millis);
+
+  millis = bestMillis(iterations, [&] {
+    vending_machine::domain::Inventory inventory;
+    std::istringstream in(catalog_json);
+    rows = loader.loadInto(in, PlanogramFormat::JSON, inventory).slots_loaded;
+  });
+  report("catalog 10k slots (JSON)", catalog_json, rows, millis);
+
+  // 全機械分のファイルを検証だけして走査する（在庫への登録は行わない）
+  millis = bestMillis(iterations, [&] {
+    std::istringstream in(fleet_csv);
+    rows = loader
+               .load(in, PlanogramFormat::CSV,
+                     [](std::string_view,
+                        const vending_machine::domain::ProductSlot &) {})
+               .slots_loaded;
+  });
+  report("fleet 5000 x 40 slots (CSV)", fleet_csv, rows, millis);
+
+  // 全機械分のファイルから1台分だけを登録する
+  millis = bestMillis(iterations, [&] {
+    vending_machine::domain::Inventory inventory;
+    std::istringstream in(fleet_csv);
+    rows = loader.loadInto(in, PlanogramFormat::CSV, inventory, "M2500")
+               .slots_loaded;
+  });
+  report("fleet, one machine (CSV)", fleet_csv, rows, millis);
+  return 0;
+}
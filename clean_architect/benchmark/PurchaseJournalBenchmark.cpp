@@ -0,0 +1,159 @@
+/**
+ * @file PurchaseJournalBenchmark.cpp
+ * @brief 現金購入1回（販売の経路）の所要時間の計測
+ *
+ * セッション開始・現金投入・購入を1回として、購入ジャーナルと
+ * チェックポイントの組み合わせごとに p50 / p99 / 最大を表示します。
+ * - ジャーナルなし
+ * - ジャーナル（同期なし）と定期保存（現在の構成）
+ * - ジャーナル（追記ごとに fdatasync）と定期保存
+ * - ジャーナル（同期なし）と購入ごとの保存（比較用。以前の構成）
+ *
+ * 使い方: purchase_journal_benchmark [購入回数（既定 20,000）]
+ *        [作業ファイルの接頭辞（既定 purchase_journal_benchmark）]
+ */
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/interfaces/ICoinMech.hpp"
+#include "domain/interfaces/IDispenser.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedPaymentGateway.hpp"
+#include "interface_adapters/gateways/repositories/BinaryFileMachineStateRepository.hpp"
+#include "interface_adapters/gateways/repositories/FilePurchaseJournal.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "usecases/VendingMachineApplication.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using vending_machine::interface_adapters::BinaryFileMachineStateRepository;
+using vending_machine::interface_adapters::FilePurchaseJournal;
+using vending_machine::interface_adapters::JournalSync;
+using vending_machine::usecases::VendingMachineApplication;
+
+/// 出力しない硬貨処理機（計測に標準出力を含めない）
+class SilentCoinMech : public vending_machine::domain::ICoinMech {
+public:
+  bool canMakeChange(const vending_machine::domain::Money &) const override {
+    return true;
+  }
+  void dispense(const vending_machine::domain::Money &) override {}
+};
+
+/// 出力しない排出機
+class SilentDispenser : public vending_machine::domain::IDispenser {
+public:
+  bool canDispense(
+      const vending_machine::domain::ProductInfo &) const override {
+    return true;
+  }
+  void dispense(const vending_machine::domain::ProductInfo &) override {}
+};
+
+struct Config {
+  const char *name;
+  bool journal;
+  JournalSync sync;
+  bool checkpoint_each_purchase;
+};
+
+double percentile(std::vector<double> &samples, double ratio) {
+  auto index = static_cast<std::size_t>(
+      static_cast<double>(samples.size() - 1) * ratio);
+  std::nth_element(samples.begin(),
+                   samples.begin() + static_cast<std::ptrdiff_t>(index),
+                   samples.end());
+  return samples[index];
+}
+
+void measure(const Config &config, std::size_t total,
+             const std::string &prefix) {
+  const std::string journal_path = prefix + ".journal";
+  const std::string checkpoint_path = prefix + ".ckpt";
+  std::remove(journal_path.c_str());
+  std::remove(checkpoint_path.c_str());
+
+  SilentCoinMech coin_mech;
+  SilentDispenser dispenser;
+  vending_machine::interface_adapters::SimulatedPaymentGateway payment_gateway;
+  vending_machine::interface_adapters::InMemoryTransactionHistoryRepository
+      history;
+  VendingMachineApplication app(coin_mech, dispenser, payment_gateway,
+                                history);
+  app.initializeInventory();
+
+  BinaryFileMachineStateRepository checkpoints(checkpoint_path);
+  std::optional<FilePurchaseJournal> journal;
+  if (config.journal) {
+    app.enableCheckpoints(checkpoints, std::chrono::hours(1));
+    journal.emplace(journal_path, config.sync);
+    app.enablePurchaseJournal(*journal);
+  }
+
+  auto &usecase = app.getPurchaseWithCashUseCase();
+  std::vector<double> samples;
+  samples.reserve(total);
+  for (std::size_t i = 0; i < total; ++i) {
+    int slot = static_cast<int>(i % 4) + 1;
+    if (i % 40 < 4) {
+      // 初期在庫は各10個。計測の外で補充する
+      app.getInventoryRefillUseCase().refillSlot(
+          vending_machine::domain::SlotId(slot),
+          vending_machine::domain::Quantity(10));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    usecase.startSession();
+    usecase.insertCash(vending_machine::usecases::dto::InsertCashRequest{500});
+    usecase.selectAndPurchase(
+        vending_machine::usecases::dto::PurchaseRequest{slot});
+    if (config.checkpoint_each_purchase) {
+      app.saveCheckpoint();
+    }
+    samples.push_back(std::chrono::duration<double, std::micro>(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+  }
+
+  double max = *std::max_element(samples.begin(), samples.end());
+  double p50 = percentile(samples, 0.5);
+  double p99 = percentile(samples, 0.99);
+  std::printf("%-44s %10.2f %10.2f %10.1f\n", config.name, p50, p99, max);
+
+  journal.reset();
+  std::remove(journal_path.c_str());
+  std::remove(checkpoint_path.c_str());
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t total =
+      argc > 1 ? static_cast<std::size_t>(std::max(1L, std::atol(argv[1])))
+               : 20000;
+  std::string prefix = argc > 2 ? argv[2] : "purchase_journal_benchmark";
+
+  const Config configs[] = {
+      {"no journal", false, JournalSync::NONE, false},
+      {"journal + periodic checkpoint", true, JournalSync::NONE, false},
+      {"journal (fdatasync) + periodic checkpoint", true,
+       JournalSync::EACH_ENTRY, false},
+      {"journal + checkpoint per purchase (before)", true, JournalSync::NONE,
+       true},
+  };
+
+  std::printf("%-44s %10s %10s %10s\n", "vend path", "p50 us", "p99 us",
+              "max us");
+  for (const auto &config : configs) {
+    measure(config, total, prefix);
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file SqliteTransactionHistoryBenchmark.cpp
+ * @brief SqliteTransactionHistoryRepository とメモリ内実装の比較
+ *
+ * 同じ取引履歴を両方のリポジトリに保存し、保存・スロット別検索・
+ * 時間範囲検索・売上合計にかかる時間を計測します。SQLite はバッチの
+ * 大きさを変えて保存時間を比べます。メモリ内実装には時間範囲検索が
+ * 無いため、全件走査で同じ結果を求めた時間を示します。
+ *
+ * 使い方: sqlite_history_benchmark [保存件数（既定 200,000）]
+ *        [データベースファイル（既定 sqlite_history_benchmark.db）]
+ */
+
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "interface_adapters/gateways/repositories/sqlite/SqliteTransactionHistoryRepository.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using vending_machine::domain::TransactionRecord;
+using vending_machine::interface_adapters::
+    InMemoryTransactionHistoryRepository;
+using vending_machine::interface_adapters::SqliteTransactionHistoryRepository;
+using Clock = std::chrono::system_clock;
+
+const Clock::time_point BASE = Clock::time_point(std::chrono::hours(480000));
+
+TransactionRecord makeRecord(std::size_t i) {
+  return TransactionRecord(
+      vending_machine::domain::SalesId(static_cast<int>(i % 100000) + 1),
+      vending_machine::domain::SlotId(static_cast<int>(i % 40) + 1),
+      vending_machine::domain::Price(100 + static_cast<int>(i % 10) * 10),
+      i % 3 == 0 ? vending_machine::domain::PaymentMethodType::EMONEY
+                 : vending_machine::domain::PaymentMethodType::CASH,
+      BASE + std::chrono::seconds(i));
+}
+
+template <typename Body> double millis(Body body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void removeDatabase(const std::string &path) {
+  for (const char *suffix : {"", "-wal", "-shm"}) {
+    std::remove((path + suffix).c_str());
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t total =
+      argc > 1 ? static_cast<std::size_t>(std::max(1L, std::atol(argv[1])))
+               : 200000;
+  std::string path = argc > 2 ? argv[2] : "sqlite_history_benchmark.db";
+  const auto range_from = BASE + std::chrono::seconds(total / 2);
+  const auto range_to = range_from + std::chrono::hours(1);
+  std::printf("%-34s %12s\n", "operation", "ms");
+
+  InMemoryTransactionHistoryRepository in_memory;
+  std::printf("%-34s %12.2f\n", "in-memory save",
+              millis([&] {
+                for (std::size_t i = 0; i < total; ++i) {
+                  in_memory.save(makeRecord(i));
+                }
+              }));
+
+  for (std::size_t batch : {1u, 64u, 4096u}) {
+    removeDatabase(path);
+    SqliteTransactionHistoryRepository sqlite(path, batch);
+    double elapsed = millis([&] {
+      for (std::size_t i = 0; i < total; ++i) {
+        sqlite.save(makeRecord(i));
+      }
+      sqlite.flush();
+    });
+    std::printf("%-28s %5zu %12.2f\n", "sqlite save, batch", batch, elapsed);
+  }
+
+  SqliteTransactionHistoryRepository sqlite(path);
+  const vending_machine::domain::SlotId slot(7);
+  std::size_t rows = 0;
+  std::printf("%-34s %12.2f\n", "in-memory getBySlotId",
+              millis([&] { rows = in_memory.getBySlotId(slot).size(); }));
+  std::printf("%-34s %12.2f\n", "sqlite getBySlotId (index)",
+              millis([&] { rows = sqlite.getBySlotId(slot).size(); }));
+
+  std::printf("%-34s %12.2f\n", "in-memory time range (scan)", millis([&] {
+                rows = 0;
+                in_memory.forEach([&](const TransactionRecord &record) {
+                  if (record.getTimestamp() >= range_from &&
+                      record.getTimestamp() < range_to) {
+                    ++rows;
+                  }
+                });
+              }));
+  std::printf("%-34s %12.2f\n", "sqlite getByTimeRange (index)", millis([&] {
+                rows = sqlite.getByTimeRange(range_from, range_to).size();
+              }));
+
+  std::printf("%-34s %12.2f\n", "in-memory getTotalRevenue",
+              millis([&] { in_memory.getTotalRevenue(); }));
+  std::printf("%-34s %12.2f\n", "sqlite getTotalRevenue",
+              millis([&] { sqlite.getTotalRevenue(); }));
+  std::printf("(%zu rows in the last range query)\n", rows);
+  removeDatabase(path);
+  return 0;
+}
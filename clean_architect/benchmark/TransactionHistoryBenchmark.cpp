@@ -0,0 +1,102 @@
+/**
+ * @file TransactionHistoryBenchmark.cpp
+ * @brief InMemoryTransactionHistoryRepository::save の遅延の計測
+ *
+ * 履歴を数百万件まで積みながら、save() 1回ごとの所要時間を区間ごとに
+ * 集め、区間内の p50 / p99 / p99.9 / 最大を表示します。比較のため、
+ * std::vector へ push_back するだけの場合（容量超過時に全件を再配置する）
+ * も同じ条件で計測します。
+ *
+ * 使い方: transaction_history_benchmark [保存件数（既定 4,000,000）]
+ */
+
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using vending_machine::domain::TransactionRecord;
+
+/// 集計の区間数
+constexpr std::size_t WINDOWS = 8;
+
+TransactionRecord makeRecord(std::size_t i) {
+  return TransactionRecord(
+      vending_machine::domain::SalesId(1),
+      vending_machine::domain::SlotId(static_cast<int>(i % 40) + 1),
+      vending_machine::domain::Price(100 + static_cast<int>(i % 10) * 10),
+      i % 3 == 0 ? vending_machine::domain::PaymentMethodType::EMONEY
+                 : vending_machine::domain::PaymentMethodType::CASH);
+}
+
+double percentile(std::vector<double> &samples, double ratio) {
+  auto index = static_cast<std::size_t>(
+      static_cast<double>(samples.size() - 1) * ratio);
+  std::nth_element(samples.begin(),
+                   samples.begin() + static_cast<std::ptrdiff_t>(index),
+                   samples.end());
+  return samples[index];
+}
+
+// 1件ずつ保存の所要時間（マイクロ秒）を計り、区間ごとに表示する
+template <typename Save> void measure(const char *name, std::size_t total,
+                                      Save save) {
+  std::printf("%s\n", name);
+  std::printf("%12s %10s %10s %10s %10s\n", "records", "p50 us", "p99 us",
+              "p99.9 us", "max us");
+  const std::size_t window = std::max<std::size_t>(1, total / WINDOWS);
+  std::vector<double> samples;
+  samples.reserve(window);
+  for (std::size_t i = 0; i < total; ++i) {
+    auto record = makeRecord(i);
+    auto start = std::chrono::steady_clock::now();
+    save(record);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(elapsed).count());
+
+    if (samples.size() == window || i + 1 == total) {
+      double max = *std::max_element(samples.begin(), samples.end());
+      double p50 = percentile(samples, 0.5);
+      double p99 = percentile(samples, 0.99);
+      double p999 = percentile(samples, 0.999);
+      std::printf("%12zu %10.3f %10.3f %10.3f %10.1f\n", i + 1, p50, p99,
+                  p999, max);
+      samples.clear();
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t total =
+      argc > 1 ? static_cast<std::size_t>(std::max(1L, std::atol(argv[1])))
+               : 4000000;
+
+  {
+    vending_machine::interface_adapters::InMemoryTransactionHistoryRepository
+        repository;
+    measure("InMemoryTransactionHistoryRepository (chunked)", total,
+            [&repository](const TransactionRecord &record) {
+              repository.save(record);
+            });
+  }
+  std::printf("\n");
+  {
+    std::vector<TransactionRecord> records;
+    measure("std::vector::push_back (baseline)", total,
+            [&records](const TransactionRecord &record) {
+              records.push_back(record);
+            });
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file ErrorCode.cpp
+ * @brief ErrorCode の実装
+ */
+
+#include "ErrorCode.hpp"
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+const char *toMessage(ErrorCode code) {
+  switch (code) {
+  case ErrorCode::OK:
+    return "OK";
+  case ErrorCode::INVALID_AMOUNT:
+    return "Invalid amount";
+  case ErrorCode::SLOT_NOT_FOUND:
+    return "Slot not found in inventory";
+  case ErrorCode::OUT_OF_STOCK:
+    return "Product is out of stock";
+  case ErrorCode::CAPACITY_EXCEEDED:
+    return "Increase would exceed maximum capacity";
+  case ErrorCode::INSUFFICIENT_BALANCE:
+    return "Insufficient balance for withdrawal";
+  case ErrorCode::MAINTENANCE_MODE:
+    return "Cannot start session in maintenance mode";
+  case ErrorCode::SESSION_ALREADY_EXISTS:
+    return "Session already exists";
+  case ErrorCode::NO_ACTIVE_SESSION:
+    return "No active session";
+  case ErrorCode::PRODUCT_ALREADY_SELECTED:
+    return "Product already selected in this session";
+  case ErrorCode::NO_PRODUCT_SELECTED:
+    return "No product selected";
+  case ErrorCode::INVALID_STATE_TRANSITION:
+    return "Invalid state transition";
+  case ErrorCode::PAYMENT_DECLINED:
+    return "Payment Failed";
+  case ErrorCode::ARITHMETIC_OVERFLOW:
+    return "Revenue would overflow";
+  }
+  return "Unknown error";
+}
+
+void throwIfError(ErrorCode code) {
+  switch (code) {
+  case ErrorCode::OK:
+    return;
+  case ErrorCode::INVALID_AMOUNT:
+  case ErrorCode::SLOT_NOT_FOUND:
+    throw std::invalid_argument(toMessage(code));
+  case ErrorCode::ARITHMETIC_OVERFLOW:
+    throw std::overflow_error(toMessage(code));
+  default:
+    throw std::domain_error(toMessage(code));
+  }
+}
+
+} // namespace domain
+} // namespace vending_machine
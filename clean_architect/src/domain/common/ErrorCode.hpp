@@ -0,0 +1,64 @@
+/**
+ * @file ErrorCode.hpp
+ * @brief ErrorCode - 業務上の失敗を表すエラーコード
+ *
+ * @details
+ * 在庫切れ・残高不足・セッション状態の不一致・決済失敗などは、
+ * 稼働中の自販機では日常的に起こる結果です。
+ * try* 系のAPIはこれらを例外ではなく ErrorCode で返し、
+ * スタックの巻き戻しなしで呼び出し元が分岐できるようにします。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_COMMON_ERRORCODE_HPP
+#define VENDING_MACHINE_DOMAIN_COMMON_ERRORCODE_HPP
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @enum ErrorCode
+ * @brief 業務上の失敗の種別
+ */
+enum class ErrorCode {
+  OK,                       ///< 成功
+  INVALID_AMOUNT,           ///< 数量・金額の指定が不正（負の値など）
+  SLOT_NOT_FOUND,           ///< スロットが存在しない
+  OUT_OF_STOCK,             ///< 在庫切れ
+  CAPACITY_EXCEEDED,        ///< 最大収容数を超える
+  INSUFFICIENT_BALANCE,     ///< 残高不足
+  MAINTENANCE_MODE,         ///< メンテナンスモード中
+  SESSION_ALREADY_EXISTS,   ///< 既にセッションが存在する
+  NO_ACTIVE_SESSION,        ///< セッションが存在しない
+  PRODUCT_ALREADY_SELECTED, ///< 既に商品が選択されている
+  NO_PRODUCT_SELECTED,      ///< 商品が選択されていない
+  INVALID_STATE_TRANSITION, ///< セッションの状態遷移が不正
+  PAYMENT_DECLINED,         ///< 外部決済が承認されなかった
+  ARITHMETIC_OVERFLOW       ///< 集計値が表現可能な範囲を超える
+};
+
+/**
+ * @brief エラーコードに対応するメッセージを取得
+ * @param code エラーコード
+ * @return メッセージ（静的な文字列）
+ */
+const char *toMessage(ErrorCode code);
+
+/**
+ * @brief エラーコードを従来の例外に変換して送出する
+ * @param code エラーコード（OKの場合は何もしない）
+ * @throw std::invalid_argument INVALID_AMOUNT, SLOT_NOT_FOUND の場合
+ * @throw std::overflow_error ARITHMETIC_OVERFLOW の場合
+ * @throw std::domain_error それ以外のエラーの場合
+ *
+ * @details
+ * 例外ベースのAPIとの互換性のため、境界（従来のメソッド）でのみ使用します。
+ */
+void throwIfError(ErrorCode code);
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_COMMON_ERRORCODE_HPP
@@ -0,0 +1,83 @@
+/**
+ * @file Expected.hpp
+ * @brief Expected - 値またはエラーコードを保持する結果型
+ *
+ * @details
+ * C++17 には std::expected がないため、ドメインで必要な最小限の
+ * 機能だけを持つ結果型を用意しています。
+ * 成功時は値を、失敗時は ErrorCode を保持します。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_COMMON_EXPECTED_HPP
+#define VENDING_MACHINE_DOMAIN_COMMON_EXPECTED_HPP
+
+#include "domain/common/ErrorCode.hpp"
+#include <optional>
+#include <utility>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class Expected
+ * @brief 値またはエラーコードを保持する結果型
+ * @tparam T 成功時の値の型
+ */
+template <typename T> class Expected {
+public:
+  /**
+   * @brief 成功結果を生成
+   * @param value 値
+   */
+  constexpr Expected(T value)
+      : value_(std::move(value)), error_(ErrorCode::OK) {}
+
+  /**
+   * @brief 失敗結果を生成
+   * @param error エラーコード（OK以外）
+   */
+  constexpr Expected(ErrorCode error) : value_(std::nullopt), error_(error) {}
+
+  /**
+   * @brief 成功したかどうか
+   * @return 値を保持している場合true
+   */
+  constexpr bool hasValue() const { return value_.has_value(); }
+
+  /**
+   * @brief 成功したかどうか
+   */
+  constexpr explicit operator bool() const { return hasValue(); }
+
+  /**
+   * @brief 値を取得
+   * @return 値への参照
+   * @throw std::bad_optional_access 失敗結果の場合
+   */
+  constexpr T &value() { return value_.value(); }
+
+  /**
+   * @brief 値を取得（const版）
+   * @return 値へのconst参照
+   * @throw std::bad_optional_access 失敗結果の場合
+   */
+  constexpr const T &value() const { return value_.value(); }
+
+  /**
+   * @brief エラーコードを取得
+   * @return エラーコード（成功時はOK）
+   */
+  constexpr ErrorCode error() const { return error_; }
+
+private:
+  std::optional<T> value_; ///< 成功時の値
+  ErrorCode error_;        ///< 失敗時のエラーコード
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_COMMON_EXPECTED_HPP
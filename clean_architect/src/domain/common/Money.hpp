@@ -16,6 +16,7 @@
 #ifndef VENDING_MACHINE_DOMAIN_COMMON_MONEY_HPP
 #define VENDING_MACHINE_DOMAIN_COMMON_MONEY_HPP
 
+#include "domain/common/StrongInt.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -27,34 +28,42 @@ namespace domain {
  *
  * 金額の計算（加算・減算）のロジックを内包し、不変性を保証します。
  * 計算結果は常に新しいインスタンスとして返されます。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
  */
-class Money {
+class Money : public StrongInt<Money> {
 public:
   /**
    * @brief コンストラクタ
    * @param amount 金額（円）
    * @throw std::invalid_argument 金額が負の場合
    */
-  explicit Money(int amount);
+  constexpr explicit Money(int amount) : StrongInt(amount) {
+    if (amount < 0) {
+      throw std::invalid_argument("Money amount cannot be negative");
+    }
+  }
 
   /**
    * @brief 金額の生の値を取得
    * @return 金額（円）
    */
-  int getRawValue() const;
+  constexpr int getRawValue() const { return value_; }
 
   /**
    * @brief 金額が0円かどうかを判定
    * @return 0円の場合true、それ以外false
    */
-  bool isZero() const;
+  constexpr bool isZero() const { return value_ == 0; }
 
   /**
    * @brief 加算演算子
    * @param other 加算する金額
    * @return 加算結果の新しいMoneyオブジェクト
    */
-  Money operator+(const Money &other) const;
+  constexpr Money operator+(const Money &other) const {
+    return Money(value_ + other.value_);
+  }
 
   /**
    * @brief 減算演算子
@@ -62,52 +71,12 @@ public:
    * @return 減算結果の新しいMoneyオブジェクト
    * @throw std::domain_error 減算結果が負になる場合
    */
-  Money operator-(const Money &other) const;
-
-  /**
-   * @brief 等価演算子
-   * @param other 比較対象
-   * @return 金額が等しい場合true
-   */
-  bool operator==(const Money &other) const;
-
-  /**
-   * @brief 不等価演算子
-   * @param other 比較対象
-   * @return 金額が等しくない場合true
-   */
-  bool operator!=(const Money &other) const;
-
-  /**
-   * @brief 小なり演算子
-   * @param other 比較対象
-   * @return この金額がotherより小さい場合true
-   */
-  bool operator<(const Money &other) const;
-
-  /**
-   * @brief 小なりイコール演算子
-   * @param other 比較対象
-   * @return この金額がother以下の場合true
-   */
-  bool operator<=(const Money &other) const;
-
-  /**
-   * @brief 大なり演算子
-   * @param other 比較対象
-   * @return この金額がotherより大きい場合true
-   */
-  bool operator>(const Money &other) const;
-
-  /**
-   * @brief 大なりイコール演算子
-   * @param other 比較対象
-   * @return この金額がother以上の場合true
-   */
-  bool operator>=(const Money &other) const;
-
-private:
-  int amount_; ///< 金額（円）
+  constexpr Money operator-(const Money &other) const {
+    if (value_ < other.value_) {
+      throw std::domain_error("Subtraction would result in negative money");
+    }
+    return Money(value_ - other.value_);
+  }
 };
 
 } // namespace domain
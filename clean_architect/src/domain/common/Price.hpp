@@ -17,6 +17,7 @@
 #ifndef VENDING_MACHINE_DOMAIN_COMMON_PRICE_HPP
 #define VENDING_MACHINE_DOMAIN_COMMON_PRICE_HPP
 
+#include "domain/common/StrongInt.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -27,66 +28,27 @@ namespace domain {
  * @brief 商品価格を表す値オブジェクト
  *
  * 商品の販売価格を表現し、Money型と比較可能です。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
  */
-class Price {
+class Price : public StrongInt<Price> {
 public:
   /**
    * @brief コンストラクタ
    * @param amount 価格（円）
    * @throw std::invalid_argument 価格が負の場合
    */
-  explicit Price(int amount);
+  constexpr explicit Price(int amount) : StrongInt(amount) {
+    if (amount < 0) {
+      throw std::invalid_argument("Price cannot be negative");
+    }
+  }
 
   /**
    * @brief 価格の生の値を取得
    * @return 価格（円）
    */
-  int getRawValue() const;
-
-  /**
-   * @brief 等価演算子
-   * @param other 比較対象
-   * @return 価格が等しい場合true
-   */
-  bool operator==(const Price &other) const;
-
-  /**
-   * @brief 不等価演算子
-   * @param other 比較対象
-   * @return 価格が等しくない場合true
-   */
-  bool operator!=(const Price &other) const;
-
-  /**
-   * @brief 小なり演算子
-   * @param other 比較対象
-   * @return この価格がotherより小さい場合true
-   */
-  bool operator<(const Price &other) const;
-
-  /**
-   * @brief 小なりイコール演算子
-   * @param other 比較対象
-   * @return この価格がother以下の場合true
-   */
-  bool operator<=(const Price &other) const;
-
-  /**
-   * @brief 大なり演算子
-   * @param other 比較対象
-   * @return この価格がotherより大きい場合true
-   */
-  bool operator>(const Price &other) const;
-
-  /**
-   * @brief 大なりイコール演算子
-   * @param other 比較対象
-   * @return この価格がother以上の場合true
-   */
-  bool operator>=(const Price &other) const;
-
-private:
-  int amount_; ///< 価格（円）
+  constexpr int getRawValue() const { return value_; }
 };
 
 } // namespace domain
@@ -16,6 +16,8 @@
 #ifndef VENDING_MACHINE_DOMAIN_COMMON_QUANTITY_HPP
 #define VENDING_MACHINE_DOMAIN_COMMON_QUANTITY_HPP
 
+#include "domain/common/Expected.hpp"
+#include "domain/common/StrongInt.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -26,8 +28,10 @@ namespace domain {
  * @brief 在庫数を表す値オブジェクト
  *
  * 在庫の増減ロジックを内包し、不変性と境界値の妥当性を保証します。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
  */
-class Quantity {
+class Quantity : public StrongInt<Quantity> {
 public:
   /**
    * @brief 最大収容数（自販機の物理的な制約）
@@ -39,19 +43,26 @@ public:
    * @param value 在庫数
    * @throw std::invalid_argument 在庫数が負、または最大収容数を超える場合
    */
-  explicit Quantity(int value);
+  constexpr explicit Quantity(int value) : StrongInt(value) {
+    if (value < 0) {
+      throw std::invalid_argument("Quantity cannot be negative");
+    }
+    if (value > MAX_CAPACITY) {
+      throw std::invalid_argument("Quantity cannot exceed maximum capacity");
+    }
+  }
 
   /**
    * @brief 在庫数を取得
    * @return 在庫数
    */
-  int getValue() const;
+  constexpr int getValue() const { return value_; }
 
   /**
    * @brief 在庫が0かどうかを判定（売り切れ判定）
    * @return 0の場合true、それ以外false
    */
-  bool isZero() const;
+  constexpr bool isZero() const { return value_ == 0; }
 
   /**
    * @brief 在庫を増加
@@ -60,7 +71,16 @@ public:
    * @throw std::invalid_argument amountが負の場合
    * @throw std::domain_error 増加後の値が最大収容数を超える場合
    */
-  Quantity increase(int amount) const;
+  constexpr Quantity increase(int amount) const {
+    auto result = tryIncrease(amount);
+    if (result.error() == ErrorCode::INVALID_AMOUNT) {
+      throw std::invalid_argument("Cannot increase by negative amount");
+    }
+    if (!result) {
+      throw std::domain_error("Increase would exceed maximum capacity");
+    }
+    return result.value();
+  }
 
   /**
    * @brief 在庫を減少
@@ -69,38 +89,46 @@ public:
    * @throw std::invalid_argument amountが負の場合
    * @throw std::domain_error 減少後の値が負になる場合
    */
-  Quantity decrease(int amount) const;
-
-  /**
-   * @brief 等価演算子
-   * @param other 比較対象
-   * @return 在庫数が等しい場合true
-   */
-  bool operator==(const Quantity &other) const;
-
-  /**
-   * @brief 不等価演算子
-   * @param other 比較対象
-   * @return 在庫数が等しくない場合true
-   */
-  bool operator!=(const Quantity &other) const;
+  constexpr Quantity decrease(int amount) const {
+    auto result = tryDecrease(amount);
+    if (result.error() == ErrorCode::INVALID_AMOUNT) {
+      throw std::invalid_argument("Cannot decrease by negative amount");
+    }
+    if (!result) {
+      throw std::domain_error("Decrease would result in negative quantity");
+    }
+    return result.value();
+  }
 
   /**
-   * @brief 小なり演算子
-   * @param other 比較対象
-   * @return この在庫数がotherより小さい場合true
+   * @brief 在庫を増加（例外を送出しない版）
+   * @param amount 増加する数量
+   * @return 増加後のQuantity、または INVALID_AMOUNT / CAPACITY_EXCEEDED
    */
-  bool operator<(const Quantity &other) const;
+  constexpr Expected<Quantity> tryIncrease(int amount) const {
+    if (amount < 0) {
+      return ErrorCode::INVALID_AMOUNT;
+    }
+    if (value_ + amount > MAX_CAPACITY) {
+      return ErrorCode::CAPACITY_EXCEEDED;
+    }
+    return Quantity(value_ + amount);
+  }
 
   /**
-   * @brief 大なり演算子
-   * @param other 比較対象
-   * @return この在庫数がotherより大きい場合true
+   * @brief 在庫を減少（例外を送出しない版）
+   * @param amount 減少する数量
+   * @return 減少後のQuantity、または INVALID_AMOUNT / OUT_OF_STOCK
    */
-  bool operator>(const Quantity &other) const;
-
-private:
-  int value_; ///< 在庫数
+  constexpr Expected<Quantity> tryDecrease(int amount) const {
+    if (amount < 0) {
+      return ErrorCode::INVALID_AMOUNT;
+    }
+    if (value_ < amount) {
+      return ErrorCode::OUT_OF_STOCK;
+    }
+    return Quantity(value_ - amount);
+  }
 };
 
 } // namespace domain
@@ -0,0 +1,112 @@
+/**
+ * @file Revenue.hpp
+ * @brief Revenue Value Object - 売上の集計値を表す不変の値オブジェクト
+ *
+ * @details
+ * Money / Price は1回の取引で扱う金額のため int で十分ですが、
+ * 長期間・多数台の履歴を合計すると int の範囲を超えます。
+ * Revenue は集計結果専用の値オブジェクトで、64ビット整数で保持し、
+ * 加算時にオーバーフローを検出します（黙って桁あふれすることはありません）。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_COMMON_REVENUE_HPP
+#define VENDING_MACHINE_DOMAIN_COMMON_REVENUE_HPP
+
+#include "domain/common/Expected.hpp"
+#include "domain/common/Money.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/StrongInt.hpp"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class Revenue
+ * @brief 売上の集計値を表す値オブジェクト
+ *
+ * 非負の64ビット整数（円）を保持します。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
+ */
+class Revenue : public StrongInt<Revenue, std::int64_t> {
+public:
+  /**
+   * @brief 表現可能な最大値
+   */
+  static constexpr std::int64_t MAX_VALUE =
+      std::numeric_limits<std::int64_t>::max();
+
+  /**
+   * @brief コンストラクタ（0円）
+   */
+  constexpr Revenue() : StrongInt(0) {}
+
+  /**
+   * @brief コンストラクタ
+   * @param amount 売上（円）
+   * @throw std::invalid_argument 売上が負の場合
+   */
+  constexpr explicit Revenue(std::int64_t amount) : StrongInt(amount) {
+    if (amount < 0) {
+      throw std::invalid_argument("Revenue cannot be negative");
+    }
+  }
+
+  /**
+   * @brief 金額から生成
+   * @param money 金額
+   */
+  constexpr explicit Revenue(const Money &money)
+      : StrongInt(money.getRawValue()) {}
+
+  /**
+   * @brief 価格から生成
+   * @param price 価格
+   */
+  constexpr explicit Revenue(const Price &price)
+      : StrongInt(price.getRawValue()) {}
+
+  /**
+   * @brief 売上の生の値を取得
+   * @return 売上（円）
+   */
+  constexpr std::int64_t getRawValue() const { return value_; }
+
+  /**
+   * @brief 加算（例外を送出しない版）
+   * @param other 加算する売上
+   * @return 加算結果、またはオーバーフローする場合 ARITHMETIC_OVERFLOW
+   */
+  constexpr Expected<Revenue> tryAdd(const Revenue &other) const {
+    // 両辺とも非負のため、上限側のみ確認すればよい
+    if (other.value_ > MAX_VALUE - value_) {
+      return ErrorCode::ARITHMETIC_OVERFLOW;
+    }
+    return Revenue(value_ + other.value_);
+  }
+
+  /**
+   * @brief 加算演算子
+   * @param other 加算する売上
+   * @return 加算結果の新しいRevenueオブジェクト
+   * @throw std::overflow_error 加算結果が表現可能な範囲を超える場合
+   */
+  constexpr Revenue operator+(const Revenue &other) const {
+    auto result = tryAdd(other);
+    if (!result) {
+      throw std::overflow_error("Revenue would overflow");
+    }
+    return result.value();
+  }
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_COMMON_REVENUE_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file RevenueAccumulator.hpp
+ * @brief RevenueAccumulator - 売上の高速かつ正確な集計
+ *
+ * @details
+ * 1件ごとの金額は int（非負）に収まるため、64ビットの部分和には
+ * 2^32 件未満であれば確認なしで加算できます。
+ * そこで、一定件数（ブロック）ごとに確認なしの部分和を取り、
+ * ブロックの合計だけを Revenue の検査付き加算で畳み込みます。
+ * 1件あたりの処理は整数の加算と件数の比較だけで済み、
+ * 件数が多くても結果は正確なままです。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_COMMON_REVENUEACCUMULATOR_HPP
+#define VENDING_MACHINE_DOMAIN_COMMON_REVENUEACCUMULATOR_HPP
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/Revenue.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class RevenueAccumulator
+ * @brief 売上を1件ずつ加算していく集計器
+ *
+ * 取引履歴を走査しながら価格を加算する用途を想定しています。
+ */
+class RevenueAccumulator {
+public:
+  /**
+   * @brief 確認なしで部分和に加算できる件数
+   *
+   * 各金額は INT32_MAX 以下のため、この件数の合計は int64 に収まります。
+   */
+  static constexpr std::size_t BLOCK_SIZE = std::size_t{1} << 31;
+
+  /**
+   * @brief 金額を加算
+   * @param amount 金額（円、非負であること）
+   * @throw std::overflow_error 合計が表現可能な範囲を超える場合
+   */
+  void add(int amount) {
+    partial_ += amount;
+    if (++pending_ == BLOCK_SIZE) {
+      flush();
+    }
+  }
+
+  /**
+   * @brief 価格を加算
+   * @param price 価格
+   * @throw std::overflow_error 合計が表現可能な範囲を超える場合
+   */
+  void add(const Price &price) { add(price.getRawValue()); }
+
+  /**
+   * @brief 金額を加算
+   * @param money 金額
+   * @throw std::overflow_error 合計が表現可能な範囲を超える場合
+   */
+  void add(const Money &money) { add(money.getRawValue()); }
+
+  /**
+   * @brief 集計済みの売上を加算
+   * @param revenue 売上
+   * @throw std::overflow_error 合計が表現可能な範囲を超える場合
+   */
+  void add(const Revenue &revenue) { total_ = total_ + revenue; }
+
+  /**
+   * @brief 別の集計器の結果を加算
+   * @param other 加算する集計器
+   * @throw std::overflow_error 合計が表現可能な範囲を超える場合
+   */
+  void merge(const RevenueAccumulator &other) { add(other.getTotal()); }
+
+  /**
+   * @brief 合計を取得
+   * @return これまでに加算した売上の合計
+   * @throw std::overflow_error 合計が表現可能な範囲を超える場合
+   */
+  Revenue getTotal() const { return total_ + Revenue(partial_); }
+
+private:
+  void flush() {
+    total_ = total_ + Revenue(partial_);
+    partial_ = 0;
+    pending_ = 0;
+  }
+
+  Revenue total_;            ///< 確定済みの合計
+  std::int64_t partial_ = 0; ///< 現在のブロックの部分和
+  std::size_t pending_ = 0;  ///< 現在のブロックの件数
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_COMMON_REVENUEACCUMULATOR_HPP
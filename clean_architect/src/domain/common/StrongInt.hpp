@@ -0,0 +1,84 @@
+/**
+ * @file StrongInt.hpp
+ * @brief StrongInt - 整数を1つ保持する値オブジェクトの共通基底
+ *
+ * @details
+ * Money, Price, Quantity, SlotId, SalesId, SessionId, Revenue は、いずれも
+ * 整数を1つ保持し、同じ比較演算を持つ値オブジェクトです。
+ * StrongInt はその保持と比較演算をまとめた CRTP 基底クラスです。
+ *
+ * - 比較演算はヘッダ内の constexpr 関数として定義されるため、
+ *   ソートや走査のループでインライン展開・ベクトル化が可能です。
+ * - 異なる値オブジェクト同士（例: SlotId と SalesId）は比較できません。
+ * - 値の妥当性検証は各派生クラスのコンストラクタが行います。
+ *   検証も constexpr のため、定数式で不正な値を与えると
+ *   コンパイルエラーになります。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_COMMON_STRONGINT_HPP
+#define VENDING_MACHINE_DOMAIN_COMMON_STRONGINT_HPP
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class StrongInt
+ * @brief 整数を1つ保持する値オブジェクトの共通基底
+ * @tparam Derived 派生クラス（CRTP）
+ * @tparam Rep 保持する整数型
+ */
+template <typename Derived, typename Rep = int> class StrongInt {
+public:
+  /**
+   * @name 比較演算子
+   * 同じ値オブジェクト型同士でのみ比較できます。
+   * @{
+   */
+  friend constexpr bool operator==(const Derived &lhs,
+                                   const Derived &rhs) noexcept {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend constexpr bool operator!=(const Derived &lhs,
+                                   const Derived &rhs) noexcept {
+    return lhs.value_ != rhs.value_;
+  }
+
+  friend constexpr bool operator<(const Derived &lhs,
+                                  const Derived &rhs) noexcept {
+    return lhs.value_ < rhs.value_;
+  }
+
+  friend constexpr bool operator<=(const Derived &lhs,
+                                   const Derived &rhs) noexcept {
+    return lhs.value_ <= rhs.value_;
+  }
+
+  friend constexpr bool operator>(const Derived &lhs,
+                                  const Derived &rhs) noexcept {
+    return lhs.value_ > rhs.value_;
+  }
+
+  friend constexpr bool operator>=(const Derived &lhs,
+                                   const Derived &rhs) noexcept {
+    return lhs.value_ >= rhs.value_;
+  }
+  /** @} */
+
+protected:
+  /**
+   * @brief コンストラクタ（検証済みの値を受け取る）
+   * @param value 値
+   */
+  constexpr explicit StrongInt(Rep value) noexcept : value_(value) {}
+
+  Rep value_; ///< 値
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_COMMON_STRONGINT_HPP
@@ -0,0 +1,146 @@
+/**
+ * @file DomainEvent.hpp
+ * @brief DomainEvent - 状態変化を表すドメインイベント
+ *
+ * @details
+ * Inventory・Wallet・Sales の状態変化を1件ずつ記録するイベントです。
+ * 追記専用のログ（EventLog）に順に積み、先頭から再生すると
+ * 同じ状態を組み立て直せます。
+ *
+ * スロットのイベントは変化後の在庫数を持つため、スロットごとに
+ * 独立して（並列に）再生できます。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_EVENTS_DOMAIN_EVENT_HPP
+#define VENDING_MACHINE_DOMAIN_EVENTS_DOMAIN_EVENT_HPP
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/Mode.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @enum DomainEventType
+ * @brief ドメインイベントの種類
+ */
+enum class DomainEventType {
+  SLOT_CONFIGURED,   ///< スロットの登録（商品情報と在庫数）
+  PRODUCT_DISPENSED, ///< 商品の排出（在庫の減算）
+  DISPENSE_REVERTED, ///< 排出の取り消し（在庫の戻し）
+  SLOT_REFILLED,     ///< 在庫の補充
+  CASH_DEPOSITED,    ///< 現金の投入
+  EMONEY_AUTHORIZED, ///< 電子決済の承認
+  BALANCE_WITHDRAWN, ///< 残高からの出金（支払い・返金）
+  MODE_CHANGED       ///< システムモードの切り替え
+};
+
+/**
+ * @struct DomainEvent
+ * @brief ドメインイベント1件
+ *
+ * 種類ごとに使う項目が異なるフラットな構造体です。
+ * - スロットのイベント: slot_id と value（変化後の在庫数）。
+ *   SLOT_CONFIGURED は product_name と price も持つ
+ * - Wallet のイベント: value（金額）
+ * - MODE_CHANGED: value（切り替え後の Mode）
+ *
+ * sequence と timestamp は EventLog への追記時に設定されます。
+ * product_name は文字列を所有しない参照です。記録先へ渡す時点では
+ * 呼び出し元の文字列を指し、EventLog は追記時に自身が保持する複製へ
+ * 付け替えます。
+ */
+struct DomainEvent {
+  std::uint64_t sequence = 0;                      ///< 通番（1始まり）
+  std::chrono::system_clock::time_point timestamp; ///< 記録時刻
+  DomainEventType type = DomainEventType::MODE_CHANGED; ///< 種類
+  int slot_id = 0;               ///< スロットID（スロットのイベントのみ）
+  int value = 0;                 ///< 在庫数・金額・モード
+  int price = 0;                 ///< 価格（SLOT_CONFIGURED のみ）
+  std::string_view product_name; ///< 商品名（SLOT_CONFIGURED のみ）
+
+  /**
+   * @brief スロットのイベントか（スロット単位で再生できるか）
+   */
+  bool isSlotEvent() const {
+    return type == DomainEventType::SLOT_CONFIGURED ||
+           type == DomainEventType::PRODUCT_DISPENSED ||
+           type == DomainEventType::DISPENSE_REVERTED ||
+           type == DomainEventType::SLOT_REFILLED;
+  }
+
+  static DomainEvent slotConfigured(const SlotId &slot_id,
+                                    const ProductInfo &product_info,
+                                    const Quantity &stock) {
+    DomainEvent event = slotEvent(DomainEventType::SLOT_CONFIGURED, slot_id,
+                                  stock);
+    event.price = product_info.getPrice().getRawValue();
+    event.product_name = product_info.getName().getValue();
+    return event;
+  }
+
+  static DomainEvent productDispensed(const SlotId &slot_id,
+                                      const Quantity &remaining) {
+    return slotEvent(DomainEventType::PRODUCT_DISPENSED, slot_id, remaining);
+  }
+
+  static DomainEvent dispenseReverted(const SlotId &slot_id,
+                                      const Quantity &stock) {
+    return slotEvent(DomainEventType::DISPENSE_REVERTED, slot_id, stock);
+  }
+
+  static DomainEvent slotRefilled(const SlotId &slot_id,
+                                  const Quantity &stock) {
+    return slotEvent(DomainEventType::SLOT_REFILLED, slot_id, stock);
+  }
+
+  static DomainEvent cashDeposited(const Money &amount) {
+    return walletEvent(DomainEventType::CASH_DEPOSITED, amount);
+  }
+
+  static DomainEvent emoneyAuthorized(const Money &amount) {
+    return walletEvent(DomainEventType::EMONEY_AUTHORIZED, amount);
+  }
+
+  static DomainEvent balanceWithdrawn(const Money &amount) {
+    return walletEvent(DomainEventType::BALANCE_WITHDRAWN, amount);
+  }
+
+  static DomainEvent modeChanged(Mode mode) {
+    DomainEvent event;
+    event.type = DomainEventType::MODE_CHANGED;
+    event.value = static_cast<int>(mode);
+    return event;
+  }
+
+private:
+  static DomainEvent slotEvent(DomainEventType type, const SlotId &slot_id,
+                               const Quantity &stock) {
+    DomainEvent event;
+    event.type = type;
+    event.slot_id = slot_id.getValue();
+    event.value = stock.getValue();
+    return event;
+  }
+
+  static DomainEvent walletEvent(DomainEventType type, const Money &amount) {
+    DomainEvent event;
+    event.type = type;
+    event.value = amount.getRawValue();
+    return event;
+  }
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_EVENTS_DOMAIN_EVENT_HPP
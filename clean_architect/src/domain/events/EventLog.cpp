@@ -0,0 +1,94 @@
+#include "EventLog.hpp"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace vending_machine {
+namespace domain {
+
+void EventLog::append(DomainEvent event) {
+  event.sequence = getLastSequence() + 1;
+  event.timestamp = std::chrono::system_clock::now();
+  if (store_ != nullptr) {
+    store_->append(event);
+  }
+  if (!event.product_name.empty()) {
+    // 呼び出し元の文字列は追記の間だけ有効なので、ログの複製を指す
+    event.product_name = *product_names_.emplace(event.product_name).first;
+  }
+  events_.push_back(event);
+
+  if (snapshot_interval_ != 0 && event.sequence % snapshot_interval_ == 0) {
+    takeSnapshot();
+  }
+}
+
+void EventLog::setStore(IEventStore *store) {
+  if (!events_.empty() || !snapshots_.empty()) {
+    throw std::logic_error("Event store must be set before recording");
+  }
+  store_ = store;
+  first_sequence_ = store != nullptr ? store->getLastSequence() + 1 : 1;
+}
+
+void EventLog::enableSnapshots(std::size_t interval, std::size_t max_snapshots,
+                               StateCapture capture) {
+  if (interval == 0) {
+    throw std::invalid_argument("Snapshot interval must be positive");
+  }
+  if (max_snapshots == 0) {
+    throw std::invalid_argument("Snapshot count must be positive");
+  }
+  if (!capture) {
+    throw std::invalid_argument("State capture must not be empty");
+  }
+  snapshot_interval_ = interval;
+  max_snapshots_ = max_snapshots;
+  capture_ = std::move(capture);
+}
+
+void EventLog::takeSnapshot() {
+  if (!capture_) {
+    throw std::logic_error("Snapshots are not enabled");
+  }
+  // 進行中のセッションはイベントにならないため、スナップショットにも含めない
+  MachineState state = capture_();
+  state.session.reset();
+  if (!snapshots_.empty() && snapshots_.back().sequence == getLastSequence()) {
+    snapshots_.back().state = std::move(state);
+    return;
+  }
+  snapshots_.push_back({getLastSequence(), std::move(state)});
+
+  if (snapshots_.size() <= max_snapshots_ + 1) {
+    return;
+  }
+  // 最初のスナップショットは残し、その次に古いものを破棄する
+  snapshots_.erase(std::next(snapshots_.begin()));
+  if (store_ == nullptr) {
+    return;
+  }
+  // 2番目のスナップショット以前のイベントは、最初のスナップショットからの
+  // 再生にしか使わないため、ストアから読み出せばよい
+  while (!events_.empty() &&
+         events_.front().sequence <= snapshots_[1].sequence) {
+    events_.pop_front();
+    ++first_sequence_;
+  }
+}
+
+const EventSnapshot *EventLog::findSnapshot(std::uint64_t sequence) const {
+  auto it = std::upper_bound(
+      snapshots_.begin(), snapshots_.end(), sequence,
+      [](std::uint64_t value, const EventSnapshot &snapshot) {
+        return value < snapshot.sequence;
+      });
+  if (it == snapshots_.begin()) {
+    return nullptr;
+  }
+  return &*std::prev(it);
+}
+
+} // namespace domain
+} // namespace vending_machine
@@ -0,0 +1,164 @@
+/**
+ * @file EventLog.hpp
+ * @brief EventLog - 追記専用のドメインイベントログ
+ *
+ * @details
+ * ドメインイベントを通番付きで追記します。記録済みのイベントは
+ * 変更・削除しません。
+ *
+ * スナップショットを有効にすると、一定件数ごとにその時点の
+ * MachineState を保持します。再生はイベント列の先頭からではなく
+ * 直前のスナップショットから始められるため、再生の長さが
+ * スナップショット間隔で抑えられます。
+ *
+ * スナップショットは再生を速くするためのもので、イベントを破棄する
+ * 理由にはしません。最初のスナップショット（記録を始めた時点の状態）は
+ * 常に残し、それ以降のものは指定の数だけ保持して古いものから破棄します。
+ *
+ * ストア（IEventStore）を設定すると、イベントを追記のたびにストアへ
+ * 書き込みます。このときメモリには最初のスナップショットの次に古い
+ * スナップショット以降のイベントだけを置き、使用メモリは
+ * 「間隔 × 保持数」件のイベントで頭打ちになります。それより前の
+ * イベントはストアから読み出せます。ストアが無い場合はすべての
+ * イベントをメモリに保持します。
+ *
+ * 商品名は異なる名前ごとに1つだけ複製して保持し、イベントはそれを
+ * 参照します。イベント1件ごとに文字列を確保することはありません。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_EVENTS_EVENT_LOG_HPP
+#define VENDING_MACHINE_DOMAIN_EVENTS_EVENT_LOG_HPP
+
+#include "domain/events/DomainEvent.hpp"
+#include "domain/interfaces/IDomainEventSink.hpp"
+#include "domain/repositories/IEventStore.hpp"
+#include "domain/repositories/IMachineStateRepository.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_set>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @struct EventSnapshot
+ * @brief ある通番のイベントまでを反映した状態
+ */
+struct EventSnapshot {
+  std::uint64_t sequence; ///< 反映済みの最後のイベントの通番
+  MachineState state;     ///< その時点の状態
+};
+
+/**
+ * @class EventLog
+ * @brief 追記専用のドメインイベントログ（スナップショット付き）
+ */
+class EventLog : public IDomainEventSink {
+public:
+  /// スナップショット用に現在の状態を取得する関数
+  using StateCapture = std::function<MachineState()>;
+
+  /**
+   * @brief イベントを追記（通番と記録時刻を設定）
+   * @param event 追記するイベント
+   *
+   * ストアがあれば先にストアへ書き込みます（失敗した場合は例外を
+   * そのまま送出し、ログには追記しません）。
+   * 商品名はログが保持する複製への参照に付け替えます。
+   * スナップショットが有効で、通番が間隔の倍数になった場合は
+   * 追記の直後にスナップショットを取ります。
+   */
+  void append(DomainEvent event) override;
+
+  /**
+   * @brief イベントを永続化するストアを設定
+   * @param store ストア（nullptr で解除。呼び出し元が所有し、
+   *        ログより長く存続させること）
+   * @throw std::logic_error イベントかスナップショットを記録済みの場合
+   *
+   * 通番はストアに記録済みの最後の通番の続きから振ります。
+   */
+  void setStore(IEventStore *store);
+
+  /**
+   * @brief イベントを永続化するストア（設定していない場合は nullptr）
+   */
+  const IEventStore *getStore() const { return store_; }
+
+  /**
+   * @brief メモリに保持しているイベント
+   *        （通番順、先頭の通番は getFirstSequence()）
+   */
+  const std::deque<DomainEvent> &getEvents() const { return events_; }
+
+  /**
+   * @brief メモリに保持している最初のイベントの通番
+   *
+   * これより前のイベントはストアにあります（ストアが無ければ 1 です）。
+   * イベントを保持していない場合は getLastSequence() + 1 になります。
+   */
+  std::uint64_t getFirstSequence() const { return first_sequence_; }
+
+  /**
+   * @brief 最後のイベントの通番（イベントが無い場合は 0）
+   */
+  std::uint64_t getLastSequence() const {
+    return first_sequence_ + events_.size() - 1;
+  }
+
+  /**
+   * @brief 一定件数ごとのスナップショットを有効にする
+   * @param interval スナップショットを取る間隔（イベント数）
+   * @param max_snapshots 保持するスナップショットの数
+   *        （常に残す最初のスナップショットを除く）
+   * @param capture 現在の状態を取得する関数
+   * @throw std::invalid_argument interval か max_snapshots が 0、
+   *        または capture が空の場合
+   */
+  void enableSnapshots(std::size_t interval, std::size_t max_snapshots,
+                       StateCapture capture);
+
+  /**
+   * @brief 現在の状態のスナップショットを取る
+   * @throw std::logic_error スナップショットが有効でない場合
+   *
+   * 保持数を超えた場合は最初のものを除いて最も古いスナップショットを
+   * 破棄します。ストアがあれば、メモリから外したイベントはストアから
+   * 読み出せるため、残ったスナップショットのうち2番目に古いもの
+   * 以前のイベントをメモリから外します。
+   */
+  void takeSnapshot();
+
+  /**
+   * @brief 指定の通番以前で最新のスナップショット
+   * @param sequence 通番
+   * @return スナップショット（無い場合は nullptr）
+   */
+  const EventSnapshot *findSnapshot(std::uint64_t sequence) const;
+
+  /**
+   * @brief 保持しているスナップショットの数
+   */
+  std::size_t getSnapshotCount() const { return snapshots_.size(); }
+
+private:
+  IEventStore *store_ = nullptr;
+  std::deque<DomainEvent> events_;
+  std::uint64_t first_sequence_ = 1;    ///< events_ の先頭の通番
+  std::deque<EventSnapshot> snapshots_; ///< 通番の昇順（先頭は常に残す）
+  std::size_t snapshot_interval_ = 0;   ///< 0 の場合は取らない
+  std::size_t max_snapshots_ = 0;
+  StateCapture capture_;
+  std::unordered_set<std::string> product_names_; ///< イベントが参照する商品名
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_EVENTS_EVENT_LOG_HPP
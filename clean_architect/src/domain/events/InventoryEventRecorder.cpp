@@ -0,0 +1,33 @@
+#include "InventoryEventRecorder.hpp"
+#include "domain/events/DomainEvent.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+
+namespace vending_machine {
+namespace domain {
+
+InventoryEventRecorder::InventoryEventRecorder(const Inventory &inventory,
+                                               IDomainEventSink &sink)
+    : inventory_(inventory), sink_(sink) {}
+
+void InventoryEventRecorder::onDispensed(const SlotId &slot_id,
+                                         const Quantity &remaining) {
+  sink_.append(DomainEvent::productDispensed(slot_id, remaining));
+}
+
+void InventoryEventRecorder::onDispenseReverted(const SlotId &slot_id,
+                                                const Quantity &stock) {
+  sink_.append(DomainEvent::dispenseReverted(slot_id, stock));
+}
+
+void InventoryEventRecorder::onStocked(const SlotId &slot_id,
+                                       const Quantity &stock) {
+  if (configured_slots_.insert(slot_id.getValue()).second) {
+    sink_.append(DomainEvent::slotConfigured(
+        slot_id, inventory_.getSlot(slot_id).getProductInfo(), stock));
+    return;
+  }
+  sink_.append(DomainEvent::slotRefilled(slot_id, stock));
+}
+
+} // namespace domain
+} // namespace vending_machine
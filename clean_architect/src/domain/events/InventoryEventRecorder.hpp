@@ -0,0 +1,55 @@
+/**
+ * @file InventoryEventRecorder.hpp
+ * @brief InventoryEventRecorder - 在庫の変化をドメインイベントとして記録
+ *
+ * @details
+ * Inventory のオブザーバーとして登録し、在庫の変化を
+ * SLOT_CONFIGURED / PRODUCT_DISPENSED / DISPENSE_REVERTED / SLOT_REFILLED
+ * のイベントに変換して記録先へ渡します。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_EVENTS_INVENTORY_EVENT_RECORDER_HPP
+#define VENDING_MACHINE_DOMAIN_EVENTS_INVENTORY_EVENT_RECORDER_HPP
+
+#include "domain/interfaces/IDomainEventSink.hpp"
+#include "domain/interfaces/IInventoryObserver.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include <unordered_set>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class InventoryEventRecorder
+ * @brief 在庫の変化をドメインイベントに変換するオブザーバー
+ *
+ * スロットの最初の onStocked は登録（商品情報付き）、
+ * 2回目以降は補充として記録します。
+ */
+class InventoryEventRecorder : public IInventoryObserver {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param inventory 観測する在庫（商品情報の参照用）
+   * @param sink 記録先（本オブジェクトより長く生存すること）
+   */
+  InventoryEventRecorder(const Inventory &inventory, IDomainEventSink &sink);
+
+  void onDispensed(const SlotId &slot_id, const Quantity &remaining) override;
+  void onDispenseReverted(const SlotId &slot_id,
+                          const Quantity &stock) override;
+  void onStocked(const SlotId &slot_id, const Quantity &stock) override;
+
+private:
+  const Inventory &inventory_;
+  IDomainEventSink &sink_;
+  std::unordered_set<int> configured_slots_; ///< 登録を記録済みのスロット
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_EVENTS_INVENTORY_EVENT_RECORDER_HPP
@@ -0,0 +1,36 @@
+#ifndef VENDING_MACHINE_DOMAIN_INTERFACES_IDOMAINEVENTSINK_HPP
+#define VENDING_MACHINE_DOMAIN_INTERFACES_IDOMAINEVENTSINK_HPP
+
+namespace vending_machine {
+
+namespace domain {
+struct DomainEvent;
+}
+
+namespace domain {
+
+/**
+ * @class IDomainEventSink
+ * @brief ドメインイベントの記録先インターフェース
+ *
+ * Wallet・Sales に設定すると、状態が変わるたびにイベントが渡されます。
+ * 状態の変更が済んでから呼ばれます。
+ */
+class IDomainEventSink {
+public:
+  virtual ~IDomainEventSink() = default;
+
+  /**
+   * @brief イベントを記録
+   * @param event 記録するイベント（sequence と timestamp は記録先が設定）
+   *
+   * event.product_name が指す文字列は呼び出しの間だけ有効です。
+   * 保持する記録先は複製してください。
+   */
+  virtual void append(domain::DomainEvent event) = 0;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_INTERFACES_IDOMAINEVENTSINK_HPP
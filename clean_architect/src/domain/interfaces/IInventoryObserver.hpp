@@ -0,0 +1,55 @@
+#ifndef VENDING_MACHINE_DOMAIN_INTERFACES_IINVENTORYOBSERVER_HPP
+#define VENDING_MACHINE_DOMAIN_INTERFACES_IINVENTORYOBSERVER_HPP
+
+namespace vending_machine {
+
+namespace domain {
+class Quantity;
+class SlotId;
+}
+
+namespace domain {
+
+/**
+ * @class IInventoryObserver
+ * @brief 在庫の変化を受け取るインターフェース
+ *
+ * Inventory に登録すると、在庫が変わるたびに変化後の在庫数とともに
+ * 通知されます。需要予測など、在庫の推移を逐次追う用途を想定しています。
+ */
+class IInventoryObserver {
+public:
+  virtual ~IInventoryObserver() = default;
+
+  /**
+   * @brief 商品が1個販売（減算）されたときに呼ばれる
+   * @param slot_id スロットID
+   * @param remaining 販売後の在庫数
+   */
+  virtual void onDispensed(const domain::SlotId &slot_id,
+                           const domain::Quantity &remaining) = 0;
+
+  /**
+   * @brief 直前の販売が取り消され、在庫が1個戻されたときに呼ばれる
+   *
+   * 決済失敗などのロールバックで呼ばれ、販売実績には数えません。
+   *
+   * @param slot_id スロットID
+   * @param stock 取り消し後の在庫数
+   */
+  virtual void onDispenseReverted(const domain::SlotId &slot_id,
+                                  const domain::Quantity &stock) = 0;
+
+  /**
+   * @brief スロットの追加や補充で在庫が設定されたときに呼ばれる
+   * @param slot_id スロットID
+   * @param stock 補充後の在庫数
+   */
+  virtual void onStocked(const domain::SlotId &slot_id,
+                         const domain::Quantity &stock) = 0;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_INTERFACES_IINVENTORYOBSERVER_HPP
@@ -0,0 +1,33 @@
+#ifndef VENDING_MACHINE_DOMAIN_INTERFACES_ITRANSACTIONLISTENER_HPP
+#define VENDING_MACHINE_DOMAIN_INTERFACES_ITRANSACTIONLISTENER_HPP
+
+namespace vending_machine {
+
+namespace domain {
+class TransactionRecord;
+}
+
+namespace domain {
+
+/**
+ * @class ITransactionListener
+ * @brief 取引の保存を受け取るインターフェース
+ *
+ * 取引履歴への保存のたびに通知を受け、集計やスケッチを
+ * 逐次更新する用途を想定しています。
+ */
+class ITransactionListener {
+public:
+  virtual ~ITransactionListener() = default;
+
+  /**
+   * @brief 取引が保存されたときに呼ばれる
+   * @param record 保存された取引レコード
+   */
+  virtual void onTransactionSaved(const domain::TransactionRecord &record) = 0;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_INTERFACES_ITRANSACTIONLISTENER_HPP
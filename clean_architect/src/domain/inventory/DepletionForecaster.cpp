@@ -0,0 +1,153 @@
+#include "DepletionForecaster.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+namespace {
+
+/// これ未満の販売速度（個/秒）は販売なしとみなす
+constexpr double MIN_RATE = 1e-12;
+
+/// 売り切れが近い順（予測できないものは末尾、同順位はスロットID順）
+bool soonerDepletion(const DepletionForecast &a, const DepletionForecast &b) {
+  if (a.time_to_empty.has_value() != b.time_to_empty.has_value()) {
+    return a.time_to_empty.has_value();
+  }
+  if (a.time_to_empty && *a.time_to_empty != *b.time_to_empty) {
+    return *a.time_to_empty < *b.time_to_empty;
+  }
+  return a.slot_id < b.slot_id;
+}
+
+} // namespace
+
+DepletionForecaster::DepletionForecaster(std::chrono::seconds time_constant,
+                                         Clock clock)
+    : time_constant_(static_cast<double>(time_constant.count())),
+      clock_(std::move(clock)) {
+  if (time_constant.count() <= 0) {
+    throw std::invalid_argument("Time constant must be positive");
+  }
+}
+
+void DepletionForecaster::recordSale(const SlotId &slot_id,
+                                     const Quantity &remaining,
+                                     std::chrono::system_clock::time_point at) {
+  SlotState &state = stateOf(slot_id);
+  state.rate = decayedRate(state, at) + 1.0 / time_constant_;
+  state.last_update = at;
+  state.stock = remaining;
+}
+
+void DepletionForecaster::recordSaleReverted(
+    const SlotId &slot_id, const Quantity &stock,
+    std::chrono::system_clock::time_point at) {
+  SlotState &state = stateOf(slot_id);
+  state.rate = std::max(0.0, decayedRate(state, at) - 1.0 / time_constant_);
+  state.last_update = at;
+  state.stock = stock;
+}
+
+void DepletionForecaster::recordStock(const SlotId &slot_id,
+                                      const Quantity &stock) {
+  stateOf(slot_id).stock = stock;
+}
+
+void DepletionForecaster::onDispensed(const SlotId &slot_id,
+                                      const Quantity &remaining) {
+  recordSale(slot_id, remaining, clock_());
+}
+
+void DepletionForecaster::onDispenseReverted(const SlotId &slot_id,
+                                             const Quantity &stock) {
+  recordSaleReverted(slot_id, stock, clock_());
+}
+
+void DepletionForecaster::onStocked(const SlotId &slot_id,
+                                    const Quantity &stock) {
+  recordStock(slot_id, stock);
+}
+
+std::optional<DepletionForecast>
+DepletionForecaster::forecast(const SlotId &slot_id,
+                              std::chrono::system_clock::time_point now) const {
+  auto it = slots_.find(slot_id.getValue());
+  if (it == slots_.end()) {
+    return std::nullopt;
+  }
+
+  const SlotState &state = it->second;
+  double rate = decayedRate(state, now);
+  DepletionForecast result{slot_id, state.stock, rate * 3600.0, std::nullopt};
+  if (state.stock.getValue() == 0) {
+    result.time_to_empty = std::chrono::seconds(0);
+  } else if (rate >= MIN_RATE) {
+    result.time_to_empty = std::chrono::seconds(
+        std::llround(static_cast<double>(state.stock.getValue()) / rate));
+  }
+  return result;
+}
+
+std::vector<DepletionForecast> DepletionForecaster::rankByDepletion(
+    std::chrono::system_clock::time_point now) const {
+  std::vector<DepletionForecast> result;
+  result.reserve(slots_.size());
+  for (const auto &entry : slots_) {
+    result.push_back(*forecast(SlotId(entry.first), now));
+  }
+  std::sort(result.begin(), result.end(), soonerDepletion);
+  return result;
+}
+
+std::vector<FleetDepletionForecast> DepletionForecaster::rankFleet(
+    const std::vector<std::pair<std::string, const DepletionForecaster *>>
+        &machines,
+    std::chrono::system_clock::time_point now, std::size_t limit) {
+  std::vector<FleetDepletionForecast> result;
+  for (const auto &[machine_id, forecaster] : machines) {
+    for (auto &forecast : forecaster->rankByDepletion(now)) {
+      result.push_back({machine_id, std::move(forecast)});
+    }
+  }
+
+  auto sooner = [](const FleetDepletionForecast &a,
+                   const FleetDepletionForecast &b) {
+    if (soonerDepletion(a.forecast, b.forecast)) {
+      return true;
+    }
+    if (soonerDepletion(b.forecast, a.forecast)) {
+      return false;
+    }
+    return a.machine_id < b.machine_id;
+  };
+  // 上位 limit 件だけを並べ替える
+  std::size_t count = std::min(limit, result.size());
+  std::partial_sort(result.begin(), result.begin() + count, result.end(),
+                    sooner);
+  result.erase(result.begin() + count, result.end());
+  return result;
+}
+
+double DepletionForecaster::decayedRate(
+    const SlotState &state, std::chrono::system_clock::time_point now) const {
+  if (state.rate == 0.0) {
+    return 0.0;
+  }
+  double elapsed =
+      std::chrono::duration<double>(now - state.last_update).count();
+  if (elapsed <= 0.0) {
+    return state.rate;
+  }
+  return state.rate * std::exp(-elapsed / time_constant_);
+}
+
+DepletionForecaster::SlotState &
+DepletionForecaster::stateOf(const SlotId &slot_id) {
+  return slots_.try_emplace(slot_id.getValue()).first->second;
+}
+
+} // namespace domain
+} // namespace vending_machine
@@ -0,0 +1,159 @@
+/**
+ * @file DepletionForecaster.hpp
+ * @brief DepletionForecaster - スロットごとの売り切れ時刻の予測
+ *
+ * @details
+ * 販売のたびに、スロットごとの販売速度（個/時）を指数加重移動平均で
+ * 更新し、現在の在庫数と合わせて「あと何時間で売り切れるか」を
+ * 予測します。更新は1回の販売・補充につき O(1) で、履歴の再集計は
+ * 不要です。
+ *
+ * 販売速度は時定数 τ の指数減衰カウンタで表します。販売があると
+ * 1/τ を加え、時間の経過とともに exp(-Δt/τ) 倍に減衰します。
+ * 一定の速度 r で売れ続けると値は r に収束し、販売が途絶えると
+ * 0 に近づきます（直近の τ 程度の期間の販売速度を重視します）。
+ *
+ * IInventoryObserver として Inventory に登録すると、販売・補充に
+ * 合わせて自動で更新されます。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_INVENTORY_DEPLETION_FORECASTER_HPP
+#define VENDING_MACHINE_DOMAIN_INVENTORY_DEPLETION_FORECASTER_HPP
+
+#include "domain/common/Quantity.hpp"
+#include "domain/interfaces/IInventoryObserver.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @struct DepletionForecast
+ * @brief 1スロットの売り切れ予測
+ */
+struct DepletionForecast {
+  SlotId slot_id;        ///< スロットID
+  Quantity stock;        ///< 現在の在庫数
+  double sales_per_hour; ///< 推定販売速度（個/時）
+  /// 売り切れまでの予測時間（販売実績がなく予測できない場合は nullopt）
+  std::optional<std::chrono::seconds> time_to_empty;
+};
+
+/**
+ * @struct FleetDepletionForecast
+ * @brief 複数台をまとめた売り切れ予測の1件
+ */
+struct FleetDepletionForecast {
+  std::string machine_id;     ///< 自動販売機の識別子
+  DepletionForecast forecast; ///< スロットの予測
+};
+
+/**
+ * @class DepletionForecaster
+ * @brief 販売速度の移動平均から売り切れ時刻を予測するクラス
+ */
+class DepletionForecaster : public IInventoryObserver {
+public:
+  using Clock = std::function<std::chrono::system_clock::time_point()>;
+
+  /**
+   * @brief コンストラクタ
+   * @param time_constant 販売速度の移動平均の時定数 τ
+   * @param clock 現在時刻の取得関数（省略時はシステム時刻）
+   * @throw std::invalid_argument 時定数が正でない場合
+   */
+  explicit DepletionForecaster(
+      std::chrono::seconds time_constant = std::chrono::hours(6),
+      Clock clock = std::chrono::system_clock::now);
+
+  /**
+   * @brief 販売を記録
+   * @param slot_id スロットID
+   * @param remaining 販売後の在庫数
+   * @param at 販売時刻
+   */
+  void recordSale(const SlotId &slot_id, const Quantity &remaining,
+                  std::chrono::system_clock::time_point at);
+
+  /**
+   * @brief 販売の取り消しを記録（直前の recordSale を打ち消す）
+   * @param slot_id スロットID
+   * @param stock 取り消し後の在庫数
+   * @param at 取り消し時刻
+   */
+  void recordSaleReverted(const SlotId &slot_id, const Quantity &stock,
+                          std::chrono::system_clock::time_point at);
+
+  /**
+   * @brief 在庫数を記録（スロット追加・補充時。販売速度は変えない）
+   * @param slot_id スロットID
+   * @param stock 在庫数
+   */
+  void recordStock(const SlotId &slot_id, const Quantity &stock);
+
+  void onDispensed(const SlotId &slot_id, const Quantity &remaining) override;
+  void onDispenseReverted(const SlotId &slot_id,
+                          const Quantity &stock) override;
+  void onStocked(const SlotId &slot_id, const Quantity &stock) override;
+
+  /**
+   * @brief 1スロットの予測を取得
+   * @param slot_id スロットID
+   * @param now 予測の基準時刻
+   * @return 予測（記録のないスロットは nullopt）
+   */
+  std::optional<DepletionForecast>
+  forecast(const SlotId &slot_id,
+           std::chrono::system_clock::time_point now) const;
+
+  /**
+   * @brief 全スロットを売り切れが近い順に取得
+   * @param now 予測の基準時刻
+   * @return 予測のリスト（売り切れまでの時間の昇順。予測できないものは末尾）
+   */
+  std::vector<DepletionForecast>
+  rankByDepletion(std::chrono::system_clock::time_point now) const;
+
+  /**
+   * @brief 複数台のスロットを売り切れが近い順にまとめて取得
+   * @param machines 自動販売機の識別子と予測器の組
+   * @param now 予測の基準時刻
+   * @param limit 取得する最大件数
+   * @return 予測のリスト（売り切れまでの時間の昇順。予測できないものは末尾）
+   */
+  static std::vector<FleetDepletionForecast> rankFleet(
+      const std::vector<std::pair<std::string, const DepletionForecaster *>>
+          &machines,
+      std::chrono::system_clock::time_point now, std::size_t limit);
+
+private:
+  struct SlotState {
+    Quantity stock{0};
+    double rate = 0.0; ///< last_update 時点の販売速度（個/秒）
+    std::chrono::system_clock::time_point last_update;
+  };
+
+  double decayedRate(const SlotState &state,
+                     std::chrono::system_clock::time_point now) const;
+  SlotState &stateOf(const SlotId &slot_id);
+
+  double time_constant_; ///< 時定数（秒）
+  Clock clock_;
+  std::unordered_map<int, SlotState> slots_;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_INVENTORY_DEPLETION_FORECASTER_HPP
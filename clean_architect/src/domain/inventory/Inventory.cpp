@@ -18,34 +18,99 @@ void Inventory::addSlot(const ProductSlot &slot) {
   }
 
   slots_[slot_id] = std::make_shared<ProductSlot>(slot);
+  for (auto *observer : observers_) {
+    observer->onStocked(slot_id, slot.getStock());
+  }
 }
 
 ProductSlot &Inventory::getSlot(const SlotId &slot_id) {
-  auto it = slots_.find(slot_id);
-  if (it == slots_.end()) {
+  ProductSlot *slot = findSlot(slot_id);
+  if (slot == nullptr) {
     throw std::invalid_argument("Slot not found in inventory");
   }
 
-  return *it->second;
+  return *slot;
 }
 
 const ProductSlot &Inventory::getSlot(const SlotId &slot_id) const {
-  auto it = slots_.find(slot_id);
-  if (it == slots_.end()) {
+  const ProductSlot *slot = findSlot(slot_id);
+  if (slot == nullptr) {
     throw std::invalid_argument("Slot not found in inventory");
   }
 
-  return *it->second;
+  return *slot;
+}
+
+ProductSlot *Inventory::findSlot(const SlotId &slot_id) {
+  auto it = slots_.find(slot_id);
+  return it == slots_.end() ? nullptr : it->second.get();
+}
+
+const ProductSlot *Inventory::findSlot(const SlotId &slot_id) const {
+  auto it = slots_.find(slot_id);
+  return it == slots_.end() ? nullptr : it->second.get();
 }
 
 void Inventory::dispense(const SlotId &slot_id) {
   ProductSlot &slot = getSlot(slot_id);
   slot.dispense();
+  for (auto *observer : observers_) {
+    observer->onDispensed(slot_id, slot.getStock());
+  }
 }
 
 void Inventory::refill(const SlotId &slot_id, const Quantity &amount) {
   ProductSlot &slot = getSlot(slot_id);
   slot.refill(amount);
+  for (auto *observer : observers_) {
+    observer->onStocked(slot_id, slot.getStock());
+  }
+}
+
+ErrorCode Inventory::tryDispense(const SlotId &slot_id) {
+  ProductSlot *slot = findSlot(slot_id);
+  if (slot == nullptr) {
+    return ErrorCode::SLOT_NOT_FOUND;
+  }
+  ErrorCode error = slot->tryDispense();
+  if (error == ErrorCode::OK) {
+    for (auto *observer : observers_) {
+      observer->onDispensed(slot_id, slot->getStock());
+    }
+  }
+  return error;
+}
+
+ErrorCode Inventory::tryRefill(const SlotId &slot_id, const Quantity &amount) {
+  ProductSlot *slot = findSlot(slot_id);
+  if (slot == nullptr) {
+    return ErrorCode::SLOT_NOT_FOUND;
+  }
+  ErrorCode error = slot->tryRefill(amount);
+  if (error == ErrorCode::OK) {
+    for (auto *observer : observers_) {
+      observer->onStocked(slot_id, slot->getStock());
+    }
+  }
+  return error;
+}
+
+ErrorCode Inventory::tryRevertDispense(const SlotId &slot_id) {
+  ProductSlot *slot = findSlot(slot_id);
+  if (slot == nullptr) {
+    return ErrorCode::SLOT_NOT_FOUND;
+  }
+  ErrorCode error = slot->tryRefill(Quantity(1));
+  if (error == ErrorCode::OK) {
+    for (auto *observer : observers_) {
+      observer->onDispenseReverted(slot_id, slot->getStock());
+    }
+  }
+  return error;
+}
+
+void Inventory::addObserver(IInventoryObserver &observer) {
+  observers_.push_back(&observer);
 }
 
 const std::map<SlotId, std::shared_ptr<ProductSlot>> &
@@ -53,5 +118,16 @@ Inventory::getAllSlots() const {
   return slots_;
 }
 
+std::size_t Inventory::snapshot(std::vector<SlotSnapshot> &out) const {
+  out.clear();
+  out.reserve(slots_.size());
+  for (const auto &[slot_id, slot] : slots_) {
+    out.push_back({slot_id, &slot->getProductInfo(), slot->getStock()});
+  }
+  return out.size();
+}
+
+std::size_t Inventory::getSlotCount() const { return slots_.size(); }
+
 } // namespace domain
 } // namespace vending_machine
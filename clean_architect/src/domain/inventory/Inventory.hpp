@@ -20,9 +20,13 @@
 
 #include "ProductSlot.hpp"
 #include "SlotId.hpp"
+#include "SlotSnapshot.hpp"
+#include "domain/interfaces/IInventoryObserver.hpp"
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace vending_machine {
 namespace domain {
@@ -63,6 +67,20 @@ public:
    */
   const ProductSlot &getSlot(const SlotId &slot_id) const;
 
+  /**
+   * @brief スロットIDでスロットを検索（例外を送出しない版）
+   * @param slot_id 検索するスロットID
+   * @return ProductSlotへのポインタ（存在しない場合はnullptr）
+   */
+  ProductSlot *findSlot(const SlotId &slot_id);
+
+  /**
+   * @brief スロットIDでスロットを検索（const版）
+   * @param slot_id 検索するスロットID
+   * @return ProductSlotへのconstポインタ（存在しない場合はnullptr）
+   */
+  const ProductSlot *findSlot(const SlotId &slot_id) const;
+
   /**
    * @brief 指定のスロットから商品を1個販売する
    * @param slot_id スロットID
@@ -80,6 +98,43 @@ public:
    */
   void refill(const SlotId &slot_id, const Quantity &amount);
 
+  /**
+   * @brief 指定のスロットから商品を1個販売する（例外を送出しない版）
+   * @param slot_id スロットID
+   * @return OK、SLOT_NOT_FOUND、または在庫が0の場合 OUT_OF_STOCK
+   */
+  ErrorCode tryDispense(const SlotId &slot_id);
+
+  /**
+   * @brief 指定のスロットに在庫を補充（例外を送出しない版）
+   * @param slot_id スロットID
+   * @param amount 補充する数量
+   * @return OK、SLOT_NOT_FOUND、または CAPACITY_EXCEEDED
+   */
+  ErrorCode tryRefill(const SlotId &slot_id, const Quantity &amount);
+
+  /**
+   * @brief 直前の販売を取り消し、在庫を1個戻す（例外を送出しない版）
+   * @param slot_id スロットID
+   * @return OK、SLOT_NOT_FOUND、または CAPACITY_EXCEEDED
+   *
+   * @details
+   * 在庫の増え方は tryRefill(slot_id, Quantity(1)) と同じですが、
+   * オブザーバーには補充ではなく販売の取り消しとして通知されます。
+   */
+  ErrorCode tryRevertDispense(const SlotId &slot_id);
+
+  /**
+   * @brief 在庫の変化を通知するオブザーバーを登録
+   * @param observer オブザーバー（本オブジェクトより長く生存すること）
+   *
+   * @details
+   * addSlot / dispense / refill（と例外を送出しない版）の成功時に
+   * 通知されます。getSlot() で取得したスロットを直接変更した場合は
+   * 通知されません。
+   */
+  void addObserver(IInventoryObserver &observer);
+
   /**
    * @brief すべてのスロットを取得
    * @return スロットIDとProductSlotの共有ポインタのマップ
@@ -89,9 +144,29 @@ public:
    */
   const std::map<SlotId, std::shared_ptr<ProductSlot>> &getAllSlots() const;
 
+  /**
+   * @brief 登録済みの全スロットのスナップショットを1パスで取得
+   * @param out 書き込み先バッファ（先頭からクリアして書き込む）
+   * @return 書き込んだスロット数
+   *
+   * @details
+   * スロットID昇順で、登録されているスロットだけを列挙します。
+   * 例外は送出しないため、スロット数や欠番の多さに関わらず
+   * コストはスロット数に比例するだけです。
+   * 呼び出し側がバッファを使い回すことで、再確保を避けられます。
+   */
+  std::size_t snapshot(std::vector<SlotSnapshot> &out) const;
+
+  /**
+   * @brief 登録済みのスロット数を取得
+   * @return スロット数
+   */
+  std::size_t getSlotCount() const;
+
 private:
   std::map<SlotId, std::shared_ptr<ProductSlot>>
       slots_; ///< SlotId => ProductSlotへのポインタのマップ
+  std::vector<IInventoryObserver *> observers_; ///< 在庫変化の通知先
 };
 
 } // namespace domain
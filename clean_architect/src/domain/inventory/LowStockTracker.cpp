@@ -0,0 +1,95 @@
+#include "LowStockTracker.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+LowStockTracker::LowStockTracker(double threshold_ratio) {
+  if (!(threshold_ratio >= 0.0 && threshold_ratio <= 1.0)) {
+    throw std::invalid_argument("Threshold ratio must be between 0 and 1");
+  }
+  threshold_ =
+      static_cast<int>(std::ceil(threshold_ratio * Quantity::MAX_CAPACITY));
+}
+
+void LowStockTracker::addListener(Listener listener) {
+  listeners_.push_back(std::move(listener));
+}
+
+void LowStockTracker::update(const SlotId &slot_id, const Quantity &stock) {
+  int id = slot_id.getValue();
+  int new_stock = stock.getValue();
+
+  // 未登録のスロットは「在庫僅少ではない」状態から始まったものとみなす
+  bool was_low = false;
+  auto it = stock_of_.find(id);
+  if (it != stock_of_.end()) {
+    if (it->second == new_stock) {
+      return;
+    }
+    was_low = it->second < threshold_;
+    by_stock_.erase({it->second, id});
+    it->second = new_stock;
+  } else {
+    stock_of_.emplace(id, new_stock);
+  }
+  by_stock_.emplace(new_stock, id);
+
+  bool is_low = new_stock < threshold_;
+  if (is_low && !was_low) {
+    notify({LowStockEventType::BELOW_THRESHOLD, slot_id, stock});
+  } else if (!is_low && was_low) {
+    notify({LowStockEventType::RECOVERED, slot_id, stock});
+  }
+}
+
+void LowStockTracker::onDispensed(const SlotId &slot_id,
+                                  const Quantity &remaining) {
+  update(slot_id, remaining);
+}
+
+void LowStockTracker::onDispenseReverted(const SlotId &slot_id,
+                                         const Quantity &stock) {
+  update(slot_id, stock);
+}
+
+void LowStockTracker::onStocked(const SlotId &slot_id,
+                                const Quantity &stock) {
+  update(slot_id, stock);
+}
+
+std::vector<SlotStockLevel> LowStockTracker::lowest(std::size_t n) const {
+  std::vector<SlotStockLevel> result;
+  for (auto it = by_stock_.begin(); it != by_stock_.end() && result.size() < n;
+       ++it) {
+    result.push_back({SlotId(it->second), Quantity(it->first)});
+  }
+  return result;
+}
+
+std::vector<SlotStockLevel> LowStockTracker::getLowStockSlots() const {
+  std::vector<SlotStockLevel> result;
+  // しきい値未満の範囲だけを先頭から読む
+  auto end = by_stock_.lower_bound({threshold_, 0});
+  for (auto it = by_stock_.begin(); it != end; ++it) {
+    result.push_back({SlotId(it->second), Quantity(it->first)});
+  }
+  return result;
+}
+
+bool LowStockTracker::isLow(const SlotId &slot_id) const {
+  auto it = stock_of_.find(slot_id.getValue());
+  return it != stock_of_.end() && it->second < threshold_;
+}
+
+int LowStockTracker::getThreshold() const { return threshold_; }
+
+void LowStockTracker::notify(const LowStockEvent &event) const {
+  for (const auto &listener : listeners_) {
+    listener(event);
+  }
+}
+
+} // namespace domain
+} // namespace vending_machine
@@ -0,0 +1,134 @@
+/**
+ * @file LowStockTracker.hpp
+ * @brief LowStockTracker - 在庫僅少スロットの監視
+ *
+ * @details
+ * 在庫の変化を受け取り、（在庫数, スロットID）の順序付き索引を
+ * 更新します。在庫数がしきい値（Quantity::MAX_CAPACITY に対する割合）を
+ * 下回ったとき・回復したときにイベントを通知します。
+ *
+ * 1回の更新は O(log n)、在庫の少ない順の上位 N 件の取得は
+ * O(log n + N) です。販売のたびに全スロットを走査する必要はありません。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_INVENTORY_LOW_STOCK_TRACKER_HPP
+#define VENDING_MACHINE_DOMAIN_INVENTORY_LOW_STOCK_TRACKER_HPP
+
+#include "domain/common/Quantity.hpp"
+#include "domain/interfaces/IInventoryObserver.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @enum LowStockEventType
+ * @brief しきい値をまたいだ方向
+ */
+enum class LowStockEventType {
+  BELOW_THRESHOLD, ///< しきい値を下回った
+  RECOVERED        ///< しきい値以上に回復した
+};
+
+/**
+ * @struct LowStockEvent
+ * @brief しきい値をまたいだことを表すイベント
+ */
+struct LowStockEvent {
+  LowStockEventType type; ///< 方向
+  SlotId slot_id;         ///< スロットID
+  Quantity stock;         ///< 変化後の在庫数
+};
+
+/**
+ * @struct SlotStockLevel
+ * @brief スロットとその在庫数
+ */
+struct SlotStockLevel {
+  SlotId slot_id; ///< スロットID
+  Quantity stock; ///< 在庫数
+};
+
+/**
+ * @class LowStockTracker
+ * @brief 在庫僅少スロットを索引で管理し、しきい値の通過を通知するクラス
+ */
+class LowStockTracker : public IInventoryObserver {
+public:
+  using Listener = std::function<void(const LowStockEvent &)>;
+
+  /**
+   * @brief コンストラクタ
+   * @param threshold_ratio しきい値（MAX_CAPACITY に対する割合、0〜1）
+   * @throw std::invalid_argument 割合が範囲外の場合
+   *
+   * 在庫数が ceil(threshold_ratio * MAX_CAPACITY) 未満のスロットを
+   * 在庫僅少とみなします。
+   */
+  explicit LowStockTracker(double threshold_ratio = 0.2);
+
+  /**
+   * @brief イベントの通知先を登録
+   * @param listener しきい値をまたいだときに呼ばれる関数
+   */
+  void addListener(Listener listener);
+
+  /**
+   * @brief スロットの在庫数を更新
+   * @param slot_id スロットID
+   * @param stock 在庫数
+   */
+  void update(const SlotId &slot_id, const Quantity &stock);
+
+  void onDispensed(const SlotId &slot_id, const Quantity &remaining) override;
+  void onDispenseReverted(const SlotId &slot_id,
+                          const Quantity &stock) override;
+  void onStocked(const SlotId &slot_id, const Quantity &stock) override;
+
+  /**
+   * @brief 在庫の少ない順に取得
+   * @param n 取得する最大件数
+   * @return 在庫数の昇順（同数はスロットIDの昇順）
+   */
+  std::vector<SlotStockLevel> lowest(std::size_t n) const;
+
+  /**
+   * @brief しきい値を下回っているスロットをすべて取得
+   * @return 在庫数の昇順（同数はスロットIDの昇順）
+   */
+  std::vector<SlotStockLevel> getLowStockSlots() const;
+
+  /**
+   * @brief スロットがしきい値を下回っているか
+   * @param slot_id スロットID
+   * @return 下回っている場合 true（未登録のスロットは false）
+   */
+  bool isLow(const SlotId &slot_id) const;
+
+  /**
+   * @brief しきい値（この在庫数未満を在庫僅少とみなす）を取得
+   */
+  int getThreshold() const;
+
+private:
+  void notify(const LowStockEvent &event) const;
+
+  int threshold_;
+  std::set<std::pair<int, int>> by_stock_; ///< (在庫数, スロットID)
+  std::unordered_map<int, int> stock_of_;  ///< スロットID => 在庫数
+  std::vector<Listener> listeners_;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_INVENTORY_LOW_STOCK_TRACKER_HPP
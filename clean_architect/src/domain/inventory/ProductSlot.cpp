@@ -21,15 +21,32 @@ const Quantity &ProductSlot::getStock() const { return stock_; }
 bool ProductSlot::isAvailable() const { return !stock_.isZero(); }
 
 void ProductSlot::dispense() {
-  if (!isAvailable()) {
+  if (tryDispense() != ErrorCode::OK) {
     throw std::domain_error("Cannot dispense from empty slot");
   }
-  stock_ = stock_.decrease(1);
 }
 
 void ProductSlot::refill(const Quantity &amount) {
   stock_ = stock_.increase(amount.getValue());
 }
 
+ErrorCode ProductSlot::tryDispense() {
+  auto result = stock_.tryDecrease(1);
+  if (!result) {
+    return result.error();
+  }
+  stock_ = result.value();
+  return ErrorCode::OK;
+}
+
+ErrorCode ProductSlot::tryRefill(const Quantity &amount) {
+  auto result = stock_.tryIncrease(amount.getValue());
+  if (!result) {
+    return result.error();
+  }
+  stock_ = result.value();
+  return ErrorCode::OK;
+}
+
 } // namespace domain
 } // namespace vending_machine
@@ -13,6 +13,7 @@
 #ifndef VENDING_MACHINE_DOMAIN_INVENTORY_PRODUCTSLOT_HPP
 #define VENDING_MACHINE_DOMAIN_INVENTORY_PRODUCTSLOT_HPP
 
+#include "domain/common/ErrorCode.hpp"
 #include "domain/common/Quantity.hpp"
 #include "domain/inventory/ProductInfo.hpp"
 #include "domain/inventory/SlotId.hpp"
@@ -73,6 +74,19 @@ public:
    */
   void refill(const Quantity &amount);
 
+  /**
+   * @brief 商品を1個排出する（例外を送出しない版）
+   * @return OK、または在庫が0の場合 OUT_OF_STOCK
+   */
+  ErrorCode tryDispense();
+
+  /**
+   * @brief 在庫を補充する（例外を送出しない版）
+   * @param amount 補充する数量
+   * @return OK、または補充後に最大収容数を超える場合 CAPACITY_EXCEEDED
+   */
+  ErrorCode tryRefill(const Quantity &amount);
+
 private:
   SlotId id_;        ///< スロットID
   ProductInfo info_; ///< 商品情報
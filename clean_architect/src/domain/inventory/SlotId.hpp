@@ -13,6 +13,7 @@
 #ifndef VENDING_MACHINE_DOMAIN_INVENTORY_SLOTID_HPP
 #define VENDING_MACHINE_DOMAIN_INVENTORY_SLOTID_HPP
 
+#include "domain/common/StrongInt.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -23,52 +24,27 @@ namespace domain {
  * @brief スロット識別子の値オブジェクト
  *
  * スロットを一意に識別する正の整数値。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
  */
-class SlotId {
+class SlotId : public StrongInt<SlotId> {
 public:
   /**
    * @brief コンストラクタ
    * @param value スロット番号（1以上）
    * @throw std::invalid_argument スロット番号が0以下の場合
    */
-  explicit SlotId(int value);
+  constexpr explicit SlotId(int value) : StrongInt(value) {
+    if (value <= 0) {
+      throw std::invalid_argument("SlotId must be greater than 0");
+    }
+  }
 
   /**
    * @brief スロット番号を取得
    * @return スロット番号
    */
-  int getValue() const;
-
-  /**
-   * @brief 等価演算子
-   * @param other 比較対象
-   * @return スロット番号が等しい場合true
-   */
-  bool operator==(const SlotId &other) const;
-
-  /**
-   * @brief 不等価演算子
-   * @param other 比較対象
-   * @return スロット番号が等しくない場合true
-   */
-  bool operator!=(const SlotId &other) const;
-
-  /**
-   * @brief 小なり演算子
-   * @param other 比較対象
-   * @return このスロット番号がotherより小さい場合true
-   */
-  bool operator<(const SlotId &other) const;
-
-  /**
-   * @brief 大なり演算子
-   * @param other 比較対象
-   * @return このスロット番号がotherより大きい場合true
-   */
-  bool operator>(const SlotId &other) const;
-
-private:
-  int value_; ///< スロット番号
+  constexpr int getValue() const { return value_; }
 };
 
 } // namespace domain
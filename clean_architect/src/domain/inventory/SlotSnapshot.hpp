@@ -0,0 +1,38 @@
+/**
+ * @file SlotSnapshot.hpp
+ * @brief SlotSnapshot - スロットの読み取り専用スナップショット
+ *
+ * @details
+ * Inventory::snapshot() が1パスで書き出す、スロット1件分の状態です。
+ * 商品情報はコピーせず、Inventory が保持する ProductInfo を参照します。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_INVENTORY_SLOTSNAPSHOT_HPP
+#define VENDING_MACHINE_DOMAIN_INVENTORY_SLOTSNAPSHOT_HPP
+
+#include "domain/common/Quantity.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/SlotId.hpp"
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @struct SlotSnapshot
+ * @brief スロット1件分の状態
+ *
+ * @note product_info は取得元の Inventory が生存している間のみ有効です。
+ */
+struct SlotSnapshot {
+  SlotId slot_id;                  ///< スロットID
+  const ProductInfo *product_info; ///< 商品情報（Inventory内の実体を参照）
+  Quantity stock;                  ///< 取得時点の在庫数
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_INVENTORY_SLOTSNAPSHOT_HPP
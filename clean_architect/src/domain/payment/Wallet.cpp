@@ -4,6 +4,7 @@
  */
 
 #include "Wallet.hpp"
+#include "domain/events/DomainEvent.hpp"
 
 namespace vending_machine {
 namespace domain {
@@ -12,18 +13,33 @@ Wallet::Wallet() : balance_(0) {}
 
 Money Wallet::getBalance() const { return balance_; }
 
-void Wallet::depositCash(const Money &amount) { balance_ = balance_ + amount; }
+void Wallet::depositCash(const Money &amount) {
+  balance_ = balance_ + amount;
+  record(DomainEvent::cashDeposited(amount));
+}
 
 void Wallet::authorizeEMoney(const Money &amount) {
   balance_ = balance_ + amount;
+  record(DomainEvent::emoneyAuthorized(amount));
 }
 
 void Wallet::withdraw(const Money &amount) {
+  throwIfError(tryWithdraw(amount));
+}
+
+ErrorCode Wallet::tryWithdraw(const Money &amount) {
   if (balance_ < amount) {
-    throw std::domain_error("Insufficient balance for withdrawal");
+    return ErrorCode::INSUFFICIENT_BALANCE;
   }
-
   balance_ = balance_ - amount;
+  record(DomainEvent::balanceWithdrawn(amount));
+  return ErrorCode::OK;
+}
+
+void Wallet::record(const DomainEvent &event) {
+  if (event_sink_ != nullptr && event.value != 0) {
+    event_sink_->append(event);
+  }
 }
 
 } // namespace domain
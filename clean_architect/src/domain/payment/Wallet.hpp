@@ -21,7 +21,9 @@
 #ifndef VENDING_MACHINE_DOMAIN_PAYMENT_WALLET_HPP
 #define VENDING_MACHINE_DOMAIN_PAYMENT_WALLET_HPP
 
+#include "domain/common/ErrorCode.hpp"
 #include "domain/common/Money.hpp"
+#include "domain/interfaces/IDomainEventSink.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -66,8 +68,28 @@ public:
    */
   void withdraw(const Money &amount);
 
+  /**
+   * @brief 支払う（例外を送出しない版）
+   * @param amount 支払う金額
+   * @return OK、または残高不足の場合 INSUFFICIENT_BALANCE
+   */
+  ErrorCode tryWithdraw(const Money &amount);
+
+  /**
+   * @brief ドメインイベントの記録先を設定
+   * @param sink 記録先（nullptr で記録しない）。
+   *        本オブジェクトより長く生存すること
+   *
+   * 残高が変わるたびに CASH_DEPOSITED / EMONEY_AUTHORIZED /
+   * BALANCE_WITHDRAWN を記録します（0円の操作は記録しません）。
+   */
+  void setEventSink(IDomainEventSink *sink) { event_sink_ = sink; }
+
 private:
-  Money balance_; ///< 残高（現金または電子マネー）
+  Money balance_;                          ///< 残高（現金または電子マネー）
+  IDomainEventSink *event_sink_ = nullptr; ///< イベントの記録先
+
+  void record(const DomainEvent &event);
 };
 
 } // namespace domain
@@ -0,0 +1,52 @@
+#ifndef VENDING_MACHINE_DOMAIN_REPOSITORIES_IEVENTSTORE_HPP
+#define VENDING_MACHINE_DOMAIN_REPOSITORIES_IEVENTSTORE_HPP
+
+#include "domain/events/DomainEvent.hpp"
+#include <cstdint>
+#include <functional>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @interface IEventStore
+ * @brief ドメインイベントを永続化する追記専用ストア
+ *
+ * Domain層で定義されるリポジトリインターフェース。
+ * EventLog は追記のたびにイベントをストアへ書き、メモリには
+ * 再生に使う直近の範囲だけを置きます。記録済みのイベントは
+ * 変更・削除しません。
+ */
+class IEventStore {
+public:
+  /// 読み出したイベントを受け取る関数（product_name は呼び出しの間だけ有効）
+  using EventVisitor = std::function<void(const DomainEvent &)>;
+
+  virtual ~IEventStore() = default;
+
+  /**
+   * @brief イベントを追記
+   * @param event 追記するイベント（通番は getLastSequence() + 1）
+   * @throw std::invalid_argument 通番が連続していない場合
+   */
+  virtual void append(const DomainEvent &event) = 0;
+
+  /**
+   * @brief 最後のイベントの通番（イベントが無い場合は 0）
+   */
+  virtual std::uint64_t getLastSequence() const = 0;
+
+  /**
+   * @brief 通番が [from, to] のイベントを通番順に読み出す
+   * @param from 最初の通番
+   * @param to 最後の通番（記録済みの最後より大きい場合は最後まで）
+   * @param visitor イベントごとに呼び出す関数
+   */
+  virtual void forEach(std::uint64_t from, std::uint64_t to,
+                       const EventVisitor &visitor) const = 0;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_REPOSITORIES_IEVENTSTORE_HPP
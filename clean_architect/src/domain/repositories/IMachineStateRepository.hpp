@@ -0,0 +1,83 @@
+#ifndef VENDING_MACHINE_DOMAIN_REPOSITORIES_IMACHINESTATEREPOSITORY_HPP
+#define VENDING_MACHINE_DOMAIN_REPOSITORIES_IMACHINESTATEREPOSITORY_HPP
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/Mode.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/SessionId.hpp"
+#include "domain/sales/SessionStatus.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @struct SlotState
+ * @brief 保存時点のスロット1件分の状態
+ */
+struct SlotState {
+  SlotId slot_id;           ///< スロットID
+  ProductInfo product_info; ///< 商品情報
+  Quantity stock;           ///< 在庫数
+};
+
+/**
+ * @struct SessionState
+ * @brief 保存時点で進行中だった取引セッションの状態
+ */
+struct SessionState {
+  SessionId session_id;                   ///< セッションID
+  SessionStatus status;                   ///< 状態
+  std::optional<SlotId> selected_slot_id; ///< 選択済みの商品のスロットID
+};
+
+/**
+ * @struct MachineState
+ * @brief 自動販売機全体の状態（チェックポイントの単位）
+ *
+ * Inventory・Wallet・Sales（モードと進行中のセッション）を含みます。
+ * 硬貨処理機（ICoinMech）は状態を持たないため含みません。
+ * 購入ジャーナルと併用する場合は、反映済みの購入通番も含みます。
+ */
+struct MachineState {
+  SalesId sales_id;                    ///< 販売管理ID
+  Mode mode;                           ///< システムモード
+  Money balance;                       ///< Wallet の残高
+  std::vector<SlotState> slots;        ///< スロット（SlotId 昇順）
+  std::optional<SessionState> session; ///< 進行中のセッション
+  std::uint32_t journal_position = 0;  ///< 反映済みの最後の購入通番
+};
+
+/**
+ * @interface IMachineStateRepository
+ * @brief 自動販売機の状態（チェックポイント）の永続化インターフェース
+ *
+ * Domain層で定義されるリポジトリインターフェース。
+ */
+class IMachineStateRepository {
+public:
+  virtual ~IMachineStateRepository() = default;
+
+  /**
+   * @brief 状態を保存（前回の保存内容を置き換える）
+   * @param state 保存する状態
+   */
+  virtual void save(const MachineState &state) = 0;
+
+  /**
+   * @brief 最後に保存した状態を読み込む
+   * @return 状態（保存されていない場合は std::nullopt）
+   * @throw std::runtime_error 保存内容が壊れている場合
+   */
+  virtual std::optional<MachineState> load() const = 0;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_REPOSITORIES_IMACHINESTATEREPOSITORY_HPP
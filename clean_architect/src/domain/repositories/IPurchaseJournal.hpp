@@ -0,0 +1,89 @@
+#ifndef VENDING_MACHINE_DOMAIN_REPOSITORIES_IPURCHASEJOURNAL_HPP
+#define VENDING_MACHINE_DOMAIN_REPOSITORIES_IPURCHASEJOURNAL_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @enum PurchaseStep
+ * @brief 購入処理の進捗（完了した手順）
+ *
+ * 値の順に進みます。COMMITTED と ABORTED はその購入の決着を表します。
+ */
+enum class PurchaseStep : std::uint8_t {
+  STARTED = 1,       ///< 開始（在庫・残高は未変更）
+  STOCK_RESERVED,    ///< 在庫を減算した
+  PRODUCT_DISPENSED, ///< 商品を排出した
+  PAYMENT_CAPTURED,  ///< 代金を残高から引き落とした
+  CHANGE_RETURNED,   ///< お釣りを返却した
+  COMMITTED,         ///< 取引履歴に保存した（完了）
+  ABORTED            ///< 失敗して在庫を戻した（完了）
+};
+
+/**
+ * @struct PurchaseJournalEntry
+ * @brief 購入ジャーナルの1エントリ
+ *
+ * 各エントリが購入の内容（開始時の在庫数・残高を含む）を丸ごと持つため、
+ * 購入ごとに最後のエントリだけを見れば復旧の判断ができます。
+ */
+struct PurchaseJournalEntry {
+  std::uint32_t purchase_id; ///< 購入の通番（ジャーナル内で一意）
+  PurchaseStep step;         ///< 完了した手順
+  int slot_id;               ///< スロットID
+  int price;                 ///< 価格
+  int stock_before;          ///< 開始時のスロットの在庫数
+  int balance_before;        ///< 開始時の残高
+  int change;                ///< お釣り（PAYMENT_CAPTURED 以降で有効）
+  int session_id = 0;        ///< 取引セッションのID（履歴の照合に使う）
+
+  /**
+   * @brief 購入が決着済みか（COMMITTED または ABORTED）
+   */
+  bool isSettled() const {
+    return step == PurchaseStep::COMMITTED || step == PurchaseStep::ABORTED;
+  }
+};
+
+/**
+ * @interface IPurchaseJournal
+ * @brief 購入処理の進捗を記録する追記専用ジャーナル
+ *
+ * Domain層で定義されるリポジトリインターフェース。
+ * 購入の各手順の完了ごとに追記し、停止後の起動時に読み出して
+ * 決着していない購入を前進（完了）または後退（取り消し）させます。
+ */
+class IPurchaseJournal {
+public:
+  virtual ~IPurchaseJournal() = default;
+
+  /**
+   * @brief エントリを追記
+   * @param entry 追記するエントリ
+   */
+  virtual void append(const PurchaseJournalEntry &entry) = 0;
+
+  /**
+   * @brief 記録済みのエントリを読み出す
+   * @return 追記順のエントリ（書き込み途中で壊れた末尾は含まない）
+   */
+  virtual std::vector<PurchaseJournalEntry> readAll() const = 0;
+
+  /**
+   * @brief 記録済みの購入がすべて決着したことを通知
+   *
+   * 実装は記録済みのエントリを破棄してよい（破棄せず残してもよい）。
+   * 決着済みの購入は復旧の対象にならないため、どちらでも結果は同じです。
+   * ただし最後のエントリは残してください。再起動後の購入通番・
+   * セッションIDはその続きから採番します。
+   */
+  virtual void discardSettled() = 0;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_REPOSITORIES_IPURCHASEJOURNAL_HPP
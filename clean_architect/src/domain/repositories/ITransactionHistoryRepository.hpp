@@ -1,31 +1,52 @@
 #ifndef VENDING_MACHINE_DOMAIN_REPOSITORIES_ITRANSACTIONHISTORY_HPP
 #define VENDING_MACHINE_DOMAIN_REPOSITORIES_ITRANSACTIONHISTORY_HPP
 
+#include "domain/common/Revenue.hpp"
 #include "domain/sales/TransactionRecord.hpp"
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace vending_machine {
 namespace domain {
 
+/**
+ * @struct TransactionRollup
+ * @brief 個別のレコードを破棄した取引の（スロット, 決済方法）ごとの集計値
+ */
+struct TransactionRollup {
+  SlotId slot_id;                   ///< スロットID
+  PaymentMethodType payment_method; ///< 決済方法
+  std::int64_t transaction_count;   ///< 取引回数
+  Revenue total_revenue;            ///< 売上合計
+};
+
 /**
  * @interface ITransactionHistoryRepository
  * @brief トランザクション履歴の永続化インターフェース
  *
  * Domain層で定義されるリポジトリインターフェース。
+ *
+ * 実装は save() のたびにレコードへシーケンス番号を採番します
+ * （TransactionRecord::getSequence()）。番号は保存順に単調増加し、
+ * clear() しても小さい番号には戻りません。走査の順序はこの番号の
+ * 昇順であることを契約とし、エクスポートの再開などはこれに依存します。
  */
 class ITransactionHistoryRepository {
 public:
   virtual ~ITransactionHistoryRepository() = default;
 
   /**
-   * @brief トランザクションを保存
-   * @param record 保存するトランザクションレコード
+   * @brief トランザクションを保存（シーケンス番号を採番する）
+   * @param record 保存するトランザクションレコード（番号は無視される）
    */
   virtual void save(const domain::TransactionRecord &record) = 0;
 
   /**
    * @brief すべてのトランザクション履歴を取得
-   * @return トランザクションレコードのリスト（タイムスタンプ昇順）
+   * @return トランザクションレコードのリスト（タイムスタンプ降順）
    */
   virtual std::vector<domain::TransactionRecord> getAll() const = 0;
 
@@ -37,11 +58,87 @@ public:
   virtual std::vector<domain::TransactionRecord>
   getBySlotId(const domain::SlotId &slot_id) const = 0;
 
+  /**
+   * @brief すべてのトランザクション履歴を順に走査
+   *
+   * 全件を保存順に1回読む用途向けです。getAll() と異なり、実装は
+   * コピーや並べ替えを省略できます。既定の実装は getAll() の結果を
+   * シーケンス番号の昇順に並べ直して走査します。
+   *
+   * @param visitor 各レコードに対して呼び出す関数（シーケンス番号の昇順）
+   */
+  virtual void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const {
+    auto records = getAll();
+    std::stable_sort(records.begin(), records.end(),
+                     [](const domain::TransactionRecord &a,
+                        const domain::TransactionRecord &b) {
+                       return a.getSequence() < b.getSequence();
+                     });
+    for (const auto &record : records) {
+      visitor(record);
+    }
+  }
+
+  /**
+   * @brief 履歴の一部（パーティション）を走査
+   *
+   * 履歴全体を partition_count 個に分けたうちの partition 番目を
+   * 走査します。0 から partition_count - 1 までをすべて走査すると、
+   * 各レコードをちょうど1回ずつ訪れます。異なるパーティションは
+   * 別々のスレッドから同時に走査できます（save/clear との同時実行は不可）。
+   *
+   * 既定の実装は分割に対応せず、パーティション 0 で全件を走査し、
+   * それ以外のパーティションは空とします。
+   *
+   * @param partition 走査するパーティション番号
+   * @param partition_count パーティション数（1以上）
+   * @param visitor 各レコードに対して呼び出す関数（パーティション内では
+   *                シーケンス番号の昇順。パーティション間の順序は未規定）
+   */
+  virtual void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const {
+    (void)partition_count;
+    if (partition == 0) {
+      forEach(visitor);
+    }
+  }
+
+  /**
+   * @brief 個別のレコードを保持していない取引の集計値を走査
+   *
+   * 保持期間を過ぎたレコードを集計値に畳み込んで破棄する実装が、
+   * その集計値を返します。forEach() で訪れるレコードとこの集計値を
+   * 合わせると、すべての取引の集計になります。
+   * 既定の実装は何も訪れません（すべてのレコードを保持している）。
+   *
+   * @param visitor 各集計値に対して呼び出す関数
+   */
+  virtual void forEachRollup(
+      const std::function<void(const domain::TransactionRollup &)> &visitor)
+      const {
+    (void)visitor;
+  }
+
   /**
    * @brief 売上集計（すべてのトランザクションの合計）
-   * @return 売上合計
+   * @return 売上合計（64ビット、オーバーフロー検査付き）
+   */
+  virtual domain::Revenue getTotalRevenue() const = 0;
+
+  /**
+   * @brief 履歴の世代番号を取得
+   *
+   * save() / clear() のたびに増加する単調増加の番号です。
+   * 番号が変わっていなければ履歴の内容も変わっていないため、
+   * 集計結果のキャッシュの有効性判定に使えます。
+   *
+   * @return 世代番号
    */
-  virtual domain::Money getTotalRevenue() const = 0;
+  virtual std::uint64_t getGeneration() const = 0;
 
   /**
    * @brief 履歴をクリア（現金回収時など）
@@ -0,0 +1,107 @@
+#include "HyperLogLog.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+namespace {
+
+/**
+ * @brief 64ビット値の攪拌（SplitMix64 の最終段）
+ *
+ * 連番のIDでも上位ビットが一様に分布するようにする。
+ */
+std::uint64_t mix(std::uint64_t value) {
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+/**
+ * @brief 先頭から連続する 0 ビットの数（value が 0 なら 64）
+ */
+int countLeadingZeros(std::uint64_t value) {
+  int count = 0;
+  for (std::uint64_t mask = 1ULL << 63; mask != 0 && (value & mask) == 0;
+       mask >>= 1) {
+    ++count;
+  }
+  return count;
+}
+
+double alphaFor(std::size_t register_count) {
+  switch (register_count) {
+  case 16:
+    return 0.673;
+  case 32:
+    return 0.697;
+  case 64:
+    return 0.709;
+  default:
+    return 0.7213 / (1.0 + 1.079 / static_cast<double>(register_count));
+  }
+}
+
+} // namespace
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision) {
+  if (precision < MIN_PRECISION || precision > MAX_PRECISION) {
+    throw std::invalid_argument(
+        "HyperLogLog precision must be between 4 and 16");
+  }
+  registers_.assign(std::size_t{1} << precision, 0);
+}
+
+void HyperLogLog::add(std::uint64_t value) {
+  std::uint64_t hash = mix(value);
+  // 上位 p ビットでレジスタを選び、残りのビット列の先頭の 0 の数で順位を決める
+  std::size_t index = static_cast<std::size_t>(hash >> (64 - precision_));
+  std::uint64_t rest = hash << precision_;
+  int rank = std::min(countLeadingZeros(rest), 64 - precision_) + 1;
+  auto &reg = registers_[index];
+  reg = std::max(reg, static_cast<std::uint8_t>(rank));
+}
+
+void HyperLogLog::merge(const HyperLogLog &other) {
+  if (other.precision_ != precision_) {
+    throw std::invalid_argument("HyperLogLog precision mismatch");
+  }
+  for (std::size_t i = 0; i < registers_.size(); ++i) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+double HyperLogLog::estimate() const {
+  const double m = static_cast<double>(registers_.size());
+  double sum = 0.0;
+  std::size_t zeros = 0;
+  for (auto reg : registers_) {
+    sum += std::ldexp(1.0, -static_cast<int>(reg));
+    if (reg == 0) {
+      ++zeros;
+    }
+  }
+
+  double raw = alphaFor(registers_.size()) * m * m / sum;
+  // 小さい範囲では空のレジスタ数から線形計数で推定する
+  if (raw <= 2.5 * m && zeros > 0) {
+    return m * std::log(m / static_cast<double>(zeros));
+  }
+  return raw;
+}
+
+std::uint64_t HyperLogLog::count() const {
+  return static_cast<std::uint64_t>(std::llround(estimate()));
+}
+
+double HyperLogLog::getStandardError() const {
+  return 1.04 / std::sqrt(static_cast<double>(registers_.size()));
+}
+
+int HyperLogLog::getPrecision() const { return precision_; }
+
+} // namespace domain
+} // namespace vending_machine
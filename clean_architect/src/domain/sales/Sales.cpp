@@ -1,5 +1,7 @@
 #include "Sales.hpp"
+#include "domain/events/DomainEvent.hpp"
 #include <stdexcept>
+#include <utility>
 
 namespace vending_machine {
 namespace domain {
@@ -69,14 +71,94 @@ void Sales::cancelTransaction() {
   current_session_.reset();
 }
 
+void Sales::restore(Mode mode, std::optional<TransactionSession> session) {
+  if (session.has_value()) {
+    if (session->isFinished()) {
+      throw std::invalid_argument("Cannot restore a finished session");
+    }
+    if (mode == Mode::MAINTENANCE) {
+      throw std::invalid_argument(
+          "Cannot restore a session in maintenance mode");
+    }
+  }
+  changeMode(mode);
+  current_session_ =
+      session.has_value()
+          ? std::make_unique<TransactionSession>(std::move(*session))
+          : nullptr;
+}
+
 void Sales::startMaintenance() {
   if (current_session_ != nullptr && !current_session_->isFinished()) {
     throw std::domain_error("Cannot start maintenance with active session");
   }
-  mode_ = Mode::MAINTENANCE;
+  changeMode(Mode::MAINTENANCE);
+}
+
+void Sales::endMaintenance() { changeMode(Mode::NORMAL); }
+
+void Sales::changeMode(Mode mode) {
+  if (mode_ == mode) {
+    return;
+  }
+  mode_ = mode;
+  if (event_sink_ != nullptr) {
+    event_sink_->append(DomainEvent::modeChanged(mode));
+  }
+}
+
+ErrorCode Sales::tryStartSession(const SessionId &session_id) {
+  if (mode_ == Mode::MAINTENANCE) {
+    return ErrorCode::MAINTENANCE_MODE;
+  }
+  if (current_session_ != nullptr) {
+    return ErrorCode::SESSION_ALREADY_EXISTS;
+  }
+  current_session_ = std::make_unique<TransactionSession>(session_id);
+  return ErrorCode::OK;
+}
+
+ErrorCode Sales::trySelectProduct(const SlotId &slot_id) {
+  if (current_session_ == nullptr) {
+    return ErrorCode::NO_ACTIVE_SESSION;
+  }
+  return current_session_->trySelectProduct(slot_id);
 }
 
-void Sales::endMaintenance() { mode_ = Mode::NORMAL; }
+ErrorCode Sales::tryMarkPaymentPending() {
+  if (current_session_ == nullptr) {
+    return ErrorCode::NO_ACTIVE_SESSION;
+  }
+  return current_session_->tryMarkPaymentPending();
+}
+
+ErrorCode Sales::tryMarkDispensing() {
+  if (current_session_ == nullptr) {
+    return ErrorCode::NO_ACTIVE_SESSION;
+  }
+  return current_session_->tryMarkDispensing();
+}
+
+ErrorCode Sales::tryCompleteTransaction() {
+  if (current_session_ == nullptr) {
+    return ErrorCode::NO_ACTIVE_SESSION;
+  }
+  ErrorCode error = current_session_->tryComplete();
+  if (error != ErrorCode::OK) {
+    return error;
+  }
+  current_session_.reset();
+  return ErrorCode::OK;
+}
+
+ErrorCode Sales::tryCancelTransaction() {
+  if (current_session_ == nullptr) {
+    return ErrorCode::NO_ACTIVE_SESSION;
+  }
+  current_session_->cancel();
+  current_session_.reset();
+  return ErrorCode::OK;
+}
 
 } // namespace domain
 } // namespace vending_machine
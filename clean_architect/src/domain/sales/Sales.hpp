@@ -4,6 +4,7 @@
 #include "Mode.hpp"
 #include "SalesId.hpp"
 #include "TransactionSession.hpp"
+#include "domain/interfaces/IDomainEventSink.hpp"
 #include <memory>
 #include <optional>
 
@@ -99,10 +100,81 @@ public:
    */
   void endMaintenance();
 
+  /**
+   * @brief 保存済みの状態を復元
+   * @param mode 復元するモード
+   * @param session 進行中だったセッション（無い場合は std::nullopt）
+   * @throw std::invalid_argument 終了済みのセッション、または
+   *        メンテナンスモードで進行中のセッションが指定された場合
+   *
+   * 既存のセッションは破棄されます。
+   */
+  void restore(Mode mode, std::optional<TransactionSession> session);
+
+  /**
+   * @brief ドメインイベントの記録先を設定
+   * @param sink 記録先（nullptr で記録しない）。
+   *        本オブジェクトより長く生存すること
+   *
+   * モードが変わるたびに MODE_CHANGED を記録します。
+   * 取引セッションの進行はイベントにしません。
+   */
+  void setEventSink(IDomainEventSink *sink) { event_sink_ = sink; }
+
+  /**
+   * @name 例外を送出しない版
+   * 在庫切れ・状態不一致などの日常的な失敗を ErrorCode で返します。
+   * 失敗時は状態を変更しません。
+   * @{
+   */
+
+  /**
+   * @brief 新しいセッションを開始
+   * @param session_id セッションID
+   * @return OK、MAINTENANCE_MODE、または SESSION_ALREADY_EXISTS
+   */
+  ErrorCode tryStartSession(const SessionId &session_id);
+
+  /**
+   * @brief 商品を選択
+   * @param slot_id 選択するスロットID
+   * @return OK、NO_ACTIVE_SESSION、または PRODUCT_ALREADY_SELECTED
+   */
+  ErrorCode trySelectProduct(const SlotId &slot_id);
+
+  /**
+   * @brief 決済待ち状態に遷移
+   * @return OK、NO_ACTIVE_SESSION、またはセッションの状態遷移エラー
+   */
+  ErrorCode tryMarkPaymentPending();
+
+  /**
+   * @brief 排出中状態に遷移
+   * @return OK、NO_ACTIVE_SESSION、または INVALID_STATE_TRANSITION
+   */
+  ErrorCode tryMarkDispensing();
+
+  /**
+   * @brief 取引を完了してセッションを終了
+   * @return OK、NO_ACTIVE_SESSION、または INVALID_STATE_TRANSITION
+   */
+  ErrorCode tryCompleteTransaction();
+
+  /**
+   * @brief 取引をキャンセルしてセッションを終了
+   * @return OK、またはセッションが存在しない場合 NO_ACTIVE_SESSION
+   */
+  ErrorCode tryCancelTransaction();
+
+  /** @} */
+
 private:
   SalesId sales_id_;                                    ///< 販売管理ID
   Mode mode_;                                           ///< 現在のモード
   std::unique_ptr<TransactionSession> current_session_; ///< 現在のセッション
+  IDomainEventSink *event_sink_ = nullptr;              ///< イベントの記録先
+
+  void changeMode(Mode mode);
 };
 
 } // namespace domain
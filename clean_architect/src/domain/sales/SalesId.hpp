@@ -1,6 +1,7 @@
 #ifndef VENDING_MACHINE_DOMAIN_SALES_SALESID_HPP
 #define VENDING_MACHINE_DOMAIN_SALES_SALESID_HPP
 
+#include "domain/common/StrongInt.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -11,38 +12,27 @@ namespace domain {
  * @brief 販売管理集約を識別する値オブジェクト
  *
  * Sales集約ルートを一意に識別します。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
  */
-class SalesId {
+class SalesId : public StrongInt<SalesId> {
 public:
   /**
    * @brief コンストラクタ
    * @param value 販売管理ID（1以上）
    * @throw std::invalid_argument 0以下の値が指定された場合
    */
-  explicit SalesId(int value);
+  constexpr explicit SalesId(int value) : StrongInt(value) {
+    if (value <= 0) {
+      throw std::invalid_argument("SalesId must be positive");
+    }
+  }
 
   /**
    * @brief 販売管理IDの値を取得
    * @return 販売管理ID
    */
-  int getValue() const;
-
-  /**
-   * @brief 等価性を比較
-   * @param other 比較対象
-   * @return 等しい場合true
-   */
-  bool operator==(const SalesId &other) const;
-
-  /**
-   * @brief 不等価性を比較
-   * @param other 比較対象
-   * @return 等しくない場合true
-   */
-  bool operator!=(const SalesId &other) const;
-
-private:
-  int value_; ///< 販売管理ID
+  constexpr int getValue() const { return value_; }
 };
 
 } // namespace domain
@@ -0,0 +1,150 @@
+#include "SalesRollup.hpp"
+#include <climits>
+#include <stdexcept>
+#include <tuple>
+
+namespace vending_machine {
+namespace domain {
+
+namespace {
+
+using Hours = std::chrono::hours;
+using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+
+} // namespace
+
+SalesRollup::SalesRollup(std::size_t max_hours, std::size_t max_days)
+    : max_hours_(max_hours), max_days_(max_days) {
+  if (max_hours == 0 || max_days == 0) {
+    throw std::invalid_argument("SalesRollup must keep at least one bucket");
+  }
+}
+
+bool SalesRollup::Key::operator<(const Key &other) const {
+  return std::tie(bucket, slot_id, payment_method) <
+         std::tie(other.bucket, other.slot_id, other.payment_method);
+}
+
+void SalesRollup::record(const TransactionRecord &record) {
+  Revenue revenue(record.getPrice());
+  int slot_id = record.getSlotId().getValue();
+  auto method = record.getPaymentMethod();
+  auto timestamp = record.getTimestamp();
+
+  std::int64_t hour = bucketOf(RollupGranularity::HOURLY, timestamp);
+  std::int64_t day = bucketOf(RollupGranularity::DAILY, timestamp);
+  Cell *hourly = isRetained(hourly_, max_hours_, hour)
+                     ? &hourly_[{hour, slot_id, method}]
+                     : nullptr;
+  Cell *daily = isRetained(daily_, max_days_, day)
+                    ? &daily_[{day, slot_id, method}]
+                    : nullptr;
+
+  // 両方の粒度を先に更新後の値で確定させてから書き込むため、
+  // オーバーフロー時に片方だけ加算された状態にはならない
+  Revenue hourly_revenue = hourly ? hourly->revenue + revenue : Revenue();
+  Revenue daily_revenue = daily ? daily->revenue + revenue : Revenue();
+
+  if (hourly) {
+    hourly->count++;
+    hourly->revenue = hourly_revenue;
+    trim(hourly_, max_hours_);
+  }
+  if (daily) {
+    daily->count++;
+    daily->revenue = daily_revenue;
+    trim(daily_, max_days_);
+  }
+}
+
+void SalesRollup::onTransactionSaved(const TransactionRecord &record) {
+  this->record(record);
+}
+
+std::vector<RollupBucket>
+SalesRollup::query(RollupGranularity granularity,
+                   std::chrono::system_clock::time_point from,
+                   std::chrono::system_clock::time_point to) const {
+  const auto &buckets = bucketsOf(granularity);
+  auto first = buckets.lower_bound(
+      {bucketOf(granularity, from), INT_MIN, PaymentMethodType::CASH});
+  auto last = buckets.lower_bound(
+      {bucketOf(granularity, to), INT_MIN, PaymentMethodType::CASH});
+
+  std::vector<RollupBucket> result;
+  for (auto it = first; it != last; ++it) {
+    result.push_back({startOf(granularity, it->first.bucket),
+                      SlotId(it->first.slot_id), it->first.payment_method,
+                      it->second.count, it->second.revenue});
+  }
+  return result;
+}
+
+std::vector<RollupBucket>
+SalesRollup::queryBySlot(RollupGranularity granularity, const SlotId &slot_id,
+                         std::chrono::system_clock::time_point from,
+                         std::chrono::system_clock::time_point to) const {
+  std::vector<RollupBucket> result;
+  for (auto &bucket : query(granularity, from, to)) {
+    if (bucket.slot_id == slot_id) {
+      result.push_back(bucket);
+    }
+  }
+  return result;
+}
+
+std::size_t SalesRollup::getBucketCount(RollupGranularity granularity) const {
+  return bucketsOf(granularity).size();
+}
+
+void SalesRollup::clear() {
+  hourly_.clear();
+  daily_.clear();
+}
+
+std::int64_t
+SalesRollup::bucketOf(RollupGranularity granularity,
+                      std::chrono::system_clock::time_point time_point) {
+  auto since_epoch = time_point.time_since_epoch();
+  // エポックより前の時刻も正しいバケットに入るよう、切り捨ては floor で行う
+  if (granularity == RollupGranularity::HOURLY) {
+    return std::chrono::floor<Hours>(since_epoch).count();
+  }
+  return std::chrono::floor<Days>(since_epoch).count();
+}
+
+std::chrono::system_clock::time_point
+SalesRollup::startOf(RollupGranularity granularity, std::int64_t bucket) {
+  if (granularity == RollupGranularity::HOURLY) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            Hours(bucket)));
+  }
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          Days(bucket)));
+}
+
+const SalesRollup::BucketMap &
+SalesRollup::bucketsOf(RollupGranularity granularity) const {
+  return granularity == RollupGranularity::HOURLY ? hourly_ : daily_;
+}
+
+bool SalesRollup::isRetained(const BucketMap &buckets, std::size_t max_buckets,
+                             std::int64_t bucket) {
+  // キーはバケットの昇順のため、末尾が最新のバケット
+  return buckets.empty() ||
+         bucket > buckets.rbegin()->first.bucket -
+                      static_cast<std::int64_t>(max_buckets);
+}
+
+void SalesRollup::trim(BucketMap &buckets, std::size_t max_buckets) {
+  std::int64_t oldest = buckets.rbegin()->first.bucket -
+                        static_cast<std::int64_t>(max_buckets) + 1;
+  auto first_kept =
+      buckets.lower_bound({oldest, INT_MIN, PaymentMethodType::CASH});
+  buckets.erase(buckets.begin(), first_kept);
+}
+
+} // namespace domain
+} // namespace vending_machine
@@ -0,0 +1,167 @@
+/**
+ * @file SalesRollup.hpp
+ * @brief SalesRollup - 時間帯別の売上集計（ロールアップ）
+ *
+ * @details
+ * 取引を記録するたびに、時間単位・日単位のバケットへ
+ * （スロット, 決済方法）ごとの取引回数と売上を加算していきます。
+ * 期間を指定した集計は、取引件数ではなくバケット数に比例した
+ * 手間で求められます。
+ *
+ * バケットの境界は UTC（エポックからの経過時間）で区切ります。
+ * 粒度ごとに最新のバケットから保持期間（時間数・日数）より古い
+ * バケットを破棄するため、メモリ使用量は稼働期間によらず
+ * 保持期間 × スロット数 × 決済方法の数で抑えられます。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_SALES_SALES_ROLLUP_HPP
+#define VENDING_MACHINE_DOMAIN_SALES_SALES_ROLLUP_HPP
+
+#include "domain/common/Revenue.hpp"
+#include "domain/interfaces/ITransactionListener.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @enum RollupGranularity
+ * @brief 集計バケットの粒度
+ */
+enum class RollupGranularity {
+  HOURLY, ///< 1時間単位
+  DAILY   ///< 1日単位
+};
+
+/**
+ * @struct RollupBucket
+ * @brief 1つのバケット・スロット・決済方法に対する集計値
+ */
+struct RollupBucket {
+  std::chrono::system_clock::time_point start; ///< バケットの開始時刻
+  SlotId slot_id;                              ///< スロットID
+  PaymentMethodType payment_method;            ///< 決済方法
+  std::int64_t transaction_count;              ///< 取引回数
+  Revenue total_revenue;                       ///< 売上合計
+};
+
+/**
+ * @class SalesRollup
+ * @brief 時間帯別の売上集計を保持するクラス
+ *
+ * record() で取引を1件ずつ加算し、query() で期間内のバケットを取得します。
+ * ITransactionListener として登録すると、保存のたびに自動で加算されます。
+ * 保持期間より古い時刻の取引は、その粒度には加算しません。
+ */
+class SalesRollup : public ITransactionListener {
+public:
+  /// 既定の時間単位バケットの保持期間（31日分）
+  static constexpr std::size_t DEFAULT_MAX_HOURS = 24 * 31;
+  /// 既定の日単位バケットの保持期間（約2年分）
+  static constexpr std::size_t DEFAULT_MAX_DAYS = 366 * 2;
+
+  /**
+   * @brief コンストラクタ
+   * @param max_hours 時間単位のバケットを保持する時間数
+   * @param max_days 日単位のバケットを保持する日数
+   * @throw std::invalid_argument いずれかが 0 の場合
+   */
+  explicit SalesRollup(std::size_t max_hours = DEFAULT_MAX_HOURS,
+                       std::size_t max_days = DEFAULT_MAX_DAYS);
+
+  /**
+   * @brief 取引を集計に加算
+   * @param record 取引レコード
+   * @throw std::overflow_error 売上合計が表現可能な範囲を超える場合
+   */
+  void record(const TransactionRecord &record);
+
+  /**
+   * @brief 保存された取引を集計に加算（record() と同じ）
+   * @param record 取引レコード
+   */
+  void onTransactionSaved(const TransactionRecord &record) override;
+
+  /**
+   * @brief 期間内のバケットを取得
+   * @param granularity 集計粒度
+   * @param from 期間の開始（この時刻を含むバケットから）
+   * @param to 期間の終了（この時刻を含むバケットは含まない）
+   * @return バケットのリスト（開始時刻、スロット、決済方法の昇順）
+   */
+  std::vector<RollupBucket>
+  query(RollupGranularity granularity,
+        std::chrono::system_clock::time_point from,
+        std::chrono::system_clock::time_point to) const;
+
+  /**
+   * @brief 期間内の特定スロットのバケットを取得
+   * @param granularity 集計粒度
+   * @param slot_id スロットID
+   * @param from 期間の開始（この時刻を含むバケットから）
+   * @param to 期間の終了（この時刻を含むバケットは含まない）
+   * @return バケットのリスト（開始時刻、決済方法の昇順）
+   */
+  std::vector<RollupBucket>
+  queryBySlot(RollupGranularity granularity, const SlotId &slot_id,
+              std::chrono::system_clock::time_point from,
+              std::chrono::system_clock::time_point to) const;
+
+  /**
+   * @brief 保持しているバケット数を取得
+   * @param granularity 集計粒度
+   * @return （バケット, スロット, 決済方法）の組の数
+   */
+  std::size_t getBucketCount(RollupGranularity granularity) const;
+
+  /**
+   * @brief すべての集計をクリア
+   */
+  void clear();
+
+private:
+  struct Key {
+    std::int64_t bucket;
+    int slot_id;
+    PaymentMethodType payment_method;
+
+    bool operator<(const Key &other) const;
+  };
+
+  struct Cell {
+    std::int64_t count = 0;
+    Revenue revenue;
+  };
+
+  using BucketMap = std::map<Key, Cell>;
+
+  static std::int64_t
+  bucketOf(RollupGranularity granularity,
+           std::chrono::system_clock::time_point time_point);
+  static std::chrono::system_clock::time_point
+  startOf(RollupGranularity granularity, std::int64_t bucket);
+
+  const BucketMap &bucketsOf(RollupGranularity granularity) const;
+  static bool isRetained(const BucketMap &buckets, std::size_t max_buckets,
+                         std::int64_t bucket);
+  static void trim(BucketMap &buckets, std::size_t max_buckets);
+
+  BucketMap hourly_;
+  BucketMap daily_;
+  std::size_t max_hours_;
+  std::size_t max_days_;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_SALES_SALES_ROLLUP_HPP
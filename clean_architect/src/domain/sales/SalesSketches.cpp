@@ -0,0 +1,85 @@
+#include "SalesSketches.hpp"
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+SalesSketches::SalesSketches(std::size_t top_k_capacity, int precision,
+                             std::size_t max_days)
+    : top_slots_(top_k_capacity), distinct_sales_(precision),
+      precision_(precision), max_days_(max_days) {
+  if (max_days == 0) {
+    throw std::invalid_argument("SalesSketches must keep at least one day");
+  }
+}
+
+void SalesSketches::onTransactionSaved(const TransactionRecord &record) {
+  top_slots_.add(record.getSlotId().getValue());
+
+  // 販売IDは装置ごとに一定のため、セッションIDと組にして取引を識別する
+  // （装置IDを上位に置き、複数台を merge() しても衝突しない）
+  const auto &session_id = record.getSessionId();
+  if (session_id.has_value()) {
+    auto machine = static_cast<std::uint32_t>(record.getSalesId().getValue());
+    auto session = static_cast<std::uint32_t>(session_id->getValue());
+    std::uint64_t key = static_cast<std::uint64_t>(machine) << 32 | session;
+    distinct_sales_.add(key);
+    dailySketch(dayOf(record.getTimestamp())).add(key);
+  }
+  trimDays();
+}
+
+std::vector<TopKSketch::Entry>
+SalesSketches::getTopSlots(std::size_t k) const {
+  return top_slots_.top(k);
+}
+
+std::uint64_t SalesSketches::estimateDistinctSales() const {
+  return distinct_sales_.count();
+}
+
+std::uint64_t SalesSketches::estimateDistinctSalesOn(
+    std::chrono::system_clock::time_point day) const {
+  auto it = daily_sales_.find(dayOf(day));
+  if (it == daily_sales_.end()) {
+    return 0;
+  }
+  return it->second.count();
+}
+
+const TopKSketch &SalesSketches::getSlotSketch() const { return top_slots_; }
+
+void SalesSketches::merge(const SalesSketches &other) {
+  if (other.precision_ != precision_) {
+    throw std::invalid_argument("HyperLogLog precision mismatch");
+  }
+  top_slots_.merge(other.top_slots_);
+  distinct_sales_.merge(other.distinct_sales_);
+  for (const auto &entry : other.daily_sales_) {
+    dailySketch(entry.first).merge(entry.second);
+  }
+  trimDays();
+}
+
+std::int64_t
+SalesSketches::dayOf(std::chrono::system_clock::time_point time_point) {
+  using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+  return std::chrono::floor<Days>(time_point.time_since_epoch()).count();
+}
+
+HyperLogLog &SalesSketches::dailySketch(std::int64_t day) {
+  auto it = daily_sales_.find(day);
+  if (it == daily_sales_.end()) {
+    it = daily_sales_.emplace(day, HyperLogLog(precision_)).first;
+  }
+  return it->second;
+}
+
+void SalesSketches::trimDays() {
+  while (daily_sales_.size() > max_days_) {
+    daily_sales_.erase(daily_sales_.begin());
+  }
+}
+
+} // namespace domain
+} // namespace vending_machine
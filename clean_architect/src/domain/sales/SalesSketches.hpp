@@ -0,0 +1,106 @@
+/**
+ * @file SalesSketches.hpp
+ * @brief SalesSketches - 売れ筋・異なり数の近似集計
+ *
+ * @details
+ * 保存される取引から、次の近似集計を逐次更新します。
+ * - 売れ筋スロットの上位（TopKSketch、Space-Saving）
+ * - 取引（販売ID・セッションIDの組）の異なり数（全期間と日別、
+ *   HyperLogLog）。セッションIDを記録していない取引は数えません
+ *
+ * メモリ使用量は件数によらず、スケッチの容量・精度と
+ * 保持する日数だけで決まります。複数台の集計は merge() で合算できます。
+ * 誤差の上限は TopKSketch / HyperLogLog を参照してください。
+ *
+ * 日の境界は UTC（エポックからの経過時間）で区切ります。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_SALES_SALES_SKETCHES_HPP
+#define VENDING_MACHINE_DOMAIN_SALES_SALES_SKETCHES_HPP
+
+#include "domain/interfaces/ITransactionListener.hpp"
+#include "domain/sales/HyperLogLog.hpp"
+#include "domain/sales/TopKSketch.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class SalesSketches
+ * @brief 取引の保存に合わせて更新される近似集計の集合
+ */
+class SalesSketches : public ITransactionListener {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param top_k_capacity 売れ筋スロットの追跡数
+   * @param precision 異なり数スケッチの精度 p
+   * @param max_days 日別の異なり数を保持する日数（古い日から破棄）
+   * @throw std::invalid_argument 容量・精度・日数が不正な場合
+   */
+  explicit SalesSketches(std::size_t top_k_capacity = 64, int precision = 12,
+                         std::size_t max_days = 31);
+
+  /**
+   * @brief 保存された取引をスケッチに加算
+   * @param record 取引レコード
+   */
+  void onTransactionSaved(const TransactionRecord &record) override;
+
+  /**
+   * @brief 売れ筋スロットの上位を取得
+   * @param k 取得する件数
+   * @return スロット番号と推定販売数（推定販売数の降順）
+   */
+  std::vector<TopKSketch::Entry> getTopSlots(std::size_t k) const;
+
+  /**
+   * @brief 全期間の取引の異なり数を推定
+   */
+  std::uint64_t estimateDistinctSales() const;
+
+  /**
+   * @brief 指定日の取引の異なり数を推定
+   * @param day その日に含まれる任意の時刻
+   * @return 推定値（保持していない日は 0）
+   */
+  std::uint64_t
+  estimateDistinctSalesOn(std::chrono::system_clock::time_point day) const;
+
+  /**
+   * @brief 売れ筋スロットのスケッチを取得
+   */
+  const TopKSketch &getSlotSketch() const;
+
+  /**
+   * @brief 別の装置のスケッチを合算
+   * @param other 合算するスケッチ
+   * @throw std::invalid_argument 異なり数スケッチの精度が異なる場合
+   */
+  void merge(const SalesSketches &other);
+
+private:
+  static std::int64_t dayOf(std::chrono::system_clock::time_point time_point);
+  HyperLogLog &dailySketch(std::int64_t day);
+  void trimDays();
+
+  TopKSketch top_slots_;
+  HyperLogLog distinct_sales_;
+  std::map<std::int64_t, HyperLogLog> daily_sales_;
+  int precision_;
+  std::size_t max_days_;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_SALES_SALES_SKETCHES_HPP
@@ -1,6 +1,7 @@
 #ifndef VENDING_MACHINE_DOMAIN_SALES_SESSIONID_HPP
 #define VENDING_MACHINE_DOMAIN_SALES_SESSIONID_HPP
 
+#include "domain/common/StrongInt.hpp"
 #include <stdexcept>
 
 namespace vending_machine {
@@ -12,38 +13,27 @@ namespace domain {
  *
  * TransactionSessionを一意に識別します。
  * 正の整数値を保持します。
+ *
+ * 比較演算子（==, !=, <, <=, >, >=）は StrongInt が提供します。
  */
-class SessionId {
+class SessionId : public StrongInt<SessionId> {
 public:
   /**
    * @brief コンストラクタ
    * @param value セッションID（1以上）
    * @throw std::invalid_argument 0以下の値が指定された場合
    */
-  explicit SessionId(int value);
+  constexpr explicit SessionId(int value) : StrongInt(value) {
+    if (value <= 0) {
+      throw std::invalid_argument("SessionId must be positive");
+    }
+  }
 
   /**
    * @brief セッションIDの値を取得
    * @return セッションID
    */
-  int getValue() const;
-
-  /**
-   * @brief 等価性を比較
-   * @param other 比較対象
-   * @return 等しい場合true
-   */
-  bool operator==(const SessionId &other) const;
-
-  /**
-   * @brief 不等価性を比較
-   * @param other 比較対象
-   * @return 等しくない場合true
-   */
-  bool operator!=(const SessionId &other) const;
-
-private:
-  int value_; ///< セッションID
+  constexpr int getValue() const { return value_; }
 };
 
 } // namespace domain
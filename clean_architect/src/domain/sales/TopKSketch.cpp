@@ -0,0 +1,123 @@
+#include "TopKSketch.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+
+namespace {
+
+bool byCountDescending(const TopKSketch::Entry &a,
+                       const TopKSketch::Entry &b) {
+  if (a.count != b.count) {
+    return a.count > b.count;
+  }
+  return a.key < b.key;
+}
+
+} // namespace
+
+TopKSketch::TopKSketch(std::size_t capacity) : capacity_(capacity) {
+  if (capacity == 0) {
+    throw std::invalid_argument("TopKSketch capacity must be greater than 0");
+  }
+  entries_.reserve(capacity);
+  index_.reserve(capacity);
+}
+
+void TopKSketch::add(std::int64_t key, std::uint64_t weight) {
+  total_ += weight;
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_[it->second].count += weight;
+    return;
+  }
+
+  if (entries_.size() < capacity_) {
+    index_.emplace(key, entries_.size());
+    entries_.push_back({key, weight, 0});
+    return;
+  }
+
+  // 最小のカウンタを新しいキーに譲る。譲られた回数は誤差として記録する
+  auto victim = std::min_element(
+      entries_.begin(), entries_.end(),
+      [](const Entry &a, const Entry &b) { return a.count < b.count; });
+  index_.erase(victim->key);
+  index_.emplace(key, static_cast<std::size_t>(victim - entries_.begin()));
+  victim->error = victim->count;
+  victim->key = key;
+  victim->count += weight;
+}
+
+void TopKSketch::merge(const TopKSketch &other) {
+  // 片方にしかないキーは、もう片方で最小カウンタ以下の回数だったとみなす
+  // （満杯でなければ 0 回）。両方の上限を足し合わせ、上位 capacity 個を残す
+  std::uint64_t this_min = minCount();
+  std::uint64_t other_min = other.minCount();
+
+  std::vector<Entry> combined;
+  combined.reserve(entries_.size() + other.entries_.size());
+  for (const auto &entry : entries_) {
+    auto it = other.index_.find(entry.key);
+    if (it != other.index_.end()) {
+      const auto &match = other.entries_[it->second];
+      combined.push_back({entry.key, entry.count + match.count,
+                          entry.error + match.error});
+    } else {
+      combined.push_back({entry.key, entry.count + other_min,
+                          entry.error + other_min});
+    }
+  }
+  for (const auto &entry : other.entries_) {
+    if (index_.find(entry.key) == index_.end()) {
+      combined.push_back(
+          {entry.key, entry.count + this_min, entry.error + this_min});
+    }
+  }
+
+  std::sort(combined.begin(), combined.end(), byCountDescending);
+  if (combined.size() > capacity_) {
+    combined.resize(capacity_);
+  }
+  entries_ = std::move(combined);
+  total_ += other.total_;
+  rebuildIndex();
+}
+
+std::vector<TopKSketch::Entry> TopKSketch::top(std::size_t k) const {
+  std::vector<Entry> result = entries_;
+  std::sort(result.begin(), result.end(), byCountDescending);
+  if (result.size() > k) {
+    result.resize(k);
+  }
+  return result;
+}
+
+std::uint64_t TopKSketch::getTotalCount() const { return total_; }
+
+std::size_t TopKSketch::getCapacity() const { return capacity_; }
+
+std::uint64_t TopKSketch::getErrorBound() const { return minCount(); }
+
+std::uint64_t TopKSketch::minCount() const {
+  if (entries_.size() < capacity_) {
+    return 0;
+  }
+  return std::min_element(entries_.begin(), entries_.end(),
+                          [](const Entry &a, const Entry &b) {
+                            return a.count < b.count;
+                          })
+      ->count;
+}
+
+void TopKSketch::rebuildIndex() {
+  index_.clear();
+  for (std::size_t i = 0; i < entries_.size(); ++i) {
+    index_.emplace(entries_[i].key, i);
+  }
+}
+
+} // namespace domain
+} // namespace vending_machine
@@ -0,0 +1,106 @@
+/**
+ * @file TopKSketch.hpp
+ * @brief TopKSketch - 出現頻度上位の近似集計（Space-Saving）
+ *
+ * @details
+ * 容量 k 個のカウンタだけで、ストリーム中の頻出キー（売れ筋スロットなど）を
+ * 追跡します。メモリ使用量はキーの種類数や件数によらず O(k) です。
+ *
+ * 誤差の上限（総件数を N、getErrorBound() の値を ε とする）:
+ * - 各キーの推定回数は真の回数以上で、超過分は ε 以下
+ * - 推定回数から Entry::error を引いた値は真の回数以下
+ * - 真の回数が ε を超えるキーは必ず追跡されている
+ * - add() だけで作ったスケッチでは ε <= N / k
+ *
+ * 別の装置で集計したスケッチと merge() で合算できます。合算後も上記の
+ * 性質は成り立ち、ε は合計件数に対して 2N / k 以下に収まります。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_DOMAIN_SALES_TOP_K_SKETCH_HPP
+#define VENDING_MACHINE_DOMAIN_SALES_TOP_K_SKETCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+
+/**
+ * @class TopKSketch
+ * @brief Space-Saving アルゴリズムによる頻出キーの近似集計
+ */
+class TopKSketch {
+public:
+  /**
+   * @struct Entry
+   * @brief 追跡中のキーとその推定回数
+   */
+  struct Entry {
+    std::int64_t key;    ///< キー（スロット番号など）
+    std::uint64_t count; ///< 推定回数（真の回数以上）
+    std::uint64_t error; ///< 推定回数に含まれうる超過分の上限
+  };
+
+  /**
+   * @brief コンストラクタ
+   * @param capacity 追跡するカウンタ数 k
+   * @throw std::invalid_argument capacity が 0 の場合
+   */
+  explicit TopKSketch(std::size_t capacity);
+
+  /**
+   * @brief キーの出現を加算
+   * @param key キー
+   * @param weight 出現回数
+   */
+  void add(std::int64_t key, std::uint64_t weight = 1);
+
+  /**
+   * @brief 別のスケッチを合算
+   * @param other 合算するスケッチ（容量は異なっていてもよい）
+   */
+  void merge(const TopKSketch &other);
+
+  /**
+   * @brief 推定回数の上位を取得
+   * @param k 取得する件数
+   * @return 推定回数の降順（同数はキーの昇順）
+   */
+  std::vector<Entry> top(std::size_t k) const;
+
+  /**
+   * @brief これまでに加算した総件数を取得
+   */
+  std::uint64_t getTotalCount() const;
+
+  /**
+   * @brief 容量（カウンタ数）を取得
+   */
+  std::size_t getCapacity() const;
+
+  /**
+   * @brief 推定回数の超過分の上限 ε を取得
+   *
+   * 追跡中の最小カウンタの値です（満杯でなければ 0）。
+   */
+  std::uint64_t getErrorBound() const;
+
+private:
+  std::uint64_t minCount() const;
+  void rebuildIndex();
+
+  std::size_t capacity_;
+  std::uint64_t total_ = 0;
+  std::vector<Entry> entries_;
+  std::unordered_map<std::int64_t, std::size_t> index_;
+};
+
+} // namespace domain
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_DOMAIN_SALES_TOP_K_SKETCH_HPP
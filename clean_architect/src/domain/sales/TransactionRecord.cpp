@@ -30,5 +30,25 @@ std::chrono::system_clock::time_point TransactionRecord::getTimestamp() const {
   return timestamp_;
 }
 
+std::uint64_t TransactionRecord::getSequence() const { return sequence_; }
+
+TransactionRecord
+TransactionRecord::withSequence(std::uint64_t sequence) const {
+  TransactionRecord copy(*this);
+  copy.sequence_ = sequence;
+  return copy;
+}
+
+const std::optional<SessionId> &TransactionRecord::getSessionId() const {
+  return session_id_;
+}
+
+TransactionRecord
+TransactionRecord::withSessionId(const SessionId &session_id) const {
+  TransactionRecord copy(*this);
+  copy.session_id_ = session_id;
+  return copy;
+}
+
 } // namespace domain
 } // namespace vending_machine
@@ -5,7 +5,10 @@
 #include "domain/common/Price.hpp"
 #include "domain/inventory/SlotId.hpp"
 #include "domain/sales/SalesId.hpp"
+#include "domain/sales/SessionId.hpp"
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 
 namespace vending_machine {
@@ -25,6 +28,13 @@ enum class PaymentMethodType {
  * @brief トランザクション履歴レコード
  *
  * 実行された各取引の情報を不変レコードとして保持します。
+ *
+ * シーケンス番号は履歴リポジトリが保存時に採番する、保存順に単調増加する
+ * 番号です（1から）。保存前のレコードは 0（未採番）です。販売IDは
+ * 機械ごとに一定のため、個々のレコードの識別にはシーケンス番号を使います。
+ *
+ * セッションIDは購入を行った取引セッションのIDです。セッションは完了時に
+ * Sales から外れるため、購入ユースケースが完了前に控えて設定します。
  */
 class TransactionRecord {
 public:
@@ -75,12 +85,36 @@ public:
    */
   std::chrono::system_clock::time_point getTimestamp() const;
 
+  /**
+   * @brief シーケンス番号を取得（未採番なら 0）
+   */
+  std::uint64_t getSequence() const;
+
+  /**
+   * @brief シーケンス番号を付けたコピーを作成（リポジトリの採番用）
+   * @param sequence シーケンス番号
+   */
+  TransactionRecord withSequence(std::uint64_t sequence) const;
+
+  /**
+   * @brief 取引セッションのIDを取得（記録していない場合は std::nullopt）
+   */
+  const std::optional<SessionId> &getSessionId() const;
+
+  /**
+   * @brief 取引セッションのIDを付けたコピーを作成
+   * @param session_id 取引セッションのID
+   */
+  TransactionRecord withSessionId(const SessionId &session_id) const;
+
 private:
   SalesId sales_id_;
   SlotId slot_id_;
   Price price_;
   PaymentMethodType payment_method_;
   std::chrono::system_clock::time_point timestamp_;
+  std::uint64_t sequence_ = 0;
+  std::optional<SessionId> session_id_;
 };
 
 } // namespace domain
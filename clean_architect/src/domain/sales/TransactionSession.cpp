@@ -8,6 +8,18 @@ TransactionSession::TransactionSession(const SessionId &session_id)
     : session_id_(session_id), status_(SessionStatus::PRODUCT_SELECTING),
       selected_slot_id_(std::nullopt) {}
 
+TransactionSession::TransactionSession(const SessionId &session_id,
+                                       SessionStatus status,
+                                       std::optional<SlotId> selected_slot_id)
+    : session_id_(session_id), status_(status),
+      selected_slot_id_(selected_slot_id) {
+  if ((status == SessionStatus::PAYMENT_PENDING ||
+       status == SessionStatus::DISPENSING) &&
+      !selected_slot_id.has_value()) {
+    throw std::invalid_argument("Restored session requires a selected slot");
+  }
+}
+
 const SessionId &TransactionSession::getSessionId() const {
   return session_id_;
 }
@@ -19,34 +31,66 @@ std::optional<SlotId> TransactionSession::getSelectedSlotId() const {
 }
 
 void TransactionSession::selectProduct(const SlotId &slot_id) {
-  if (selected_slot_id_.has_value()) {
+  if (trySelectProduct(slot_id) != ErrorCode::OK) {
     throw std::domain_error("Product already selected in this session");
   }
-  selected_slot_id_ = slot_id;
 }
 
 void TransactionSession::markPaymentPending() {
-  if (!selected_slot_id_.has_value()) {
+  ErrorCode error = tryMarkPaymentPending();
+  if (error == ErrorCode::NO_PRODUCT_SELECTED) {
     throw std::domain_error("No product selected");
   }
-  if (status_ != SessionStatus::PRODUCT_SELECTING) {
+  if (error != ErrorCode::OK) {
     throw std::domain_error("Invalid state transition to PAYMENT_PENDING");
   }
-  status_ = SessionStatus::PAYMENT_PENDING;
 }
 
 void TransactionSession::markDispensing() {
-  if (status_ != SessionStatus::PAYMENT_PENDING) {
+  if (tryMarkDispensing() != ErrorCode::OK) {
     throw std::domain_error("Invalid state transition to DISPENSING");
   }
-  status_ = SessionStatus::DISPENSING;
 }
 
 void TransactionSession::complete() {
-  if (status_ != SessionStatus::DISPENSING) {
+  if (tryComplete() != ErrorCode::OK) {
     throw std::domain_error("Invalid state transition to COMPLETED");
   }
+}
+
+ErrorCode TransactionSession::trySelectProduct(const SlotId &slot_id) {
+  if (selected_slot_id_.has_value()) {
+    return ErrorCode::PRODUCT_ALREADY_SELECTED;
+  }
+  selected_slot_id_ = slot_id;
+  return ErrorCode::OK;
+}
+
+ErrorCode TransactionSession::tryMarkPaymentPending() {
+  if (!selected_slot_id_.has_value()) {
+    return ErrorCode::NO_PRODUCT_SELECTED;
+  }
+  if (status_ != SessionStatus::PRODUCT_SELECTING) {
+    return ErrorCode::INVALID_STATE_TRANSITION;
+  }
+  status_ = SessionStatus::PAYMENT_PENDING;
+  return ErrorCode::OK;
+}
+
+ErrorCode TransactionSession::tryMarkDispensing() {
+  if (status_ != SessionStatus::PAYMENT_PENDING) {
+    return ErrorCode::INVALID_STATE_TRANSITION;
+  }
+  status_ = SessionStatus::DISPENSING;
+  return ErrorCode::OK;
+}
+
+ErrorCode TransactionSession::tryComplete() {
+  if (status_ != SessionStatus::DISPENSING) {
+    return ErrorCode::INVALID_STATE_TRANSITION;
+  }
   status_ = SessionStatus::COMPLETED;
+  return ErrorCode::OK;
 }
 
 void TransactionSession::cancel() { status_ = SessionStatus::CANCELLED; }
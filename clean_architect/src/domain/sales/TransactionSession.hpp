@@ -2,6 +2,7 @@
 #define VENDING_MACHINE_DOMAIN_SALES_TRANSACTIONSESSION_HPP
 
 #include "SessionStatus.hpp"
+#include "domain/common/ErrorCode.hpp"
 #include "domain/inventory/SlotId.hpp"
 #include "domain/sales/SessionId.hpp"
 #include <optional>
@@ -24,6 +25,16 @@ public:
    */
   explicit TransactionSession(const SessionId &session_id);
 
+  /**
+   * @brief コンストラクタ - 保存済みの状態からセッションを復元
+   * @param session_id セッションID
+   * @param status 復元する状態
+   * @param selected_slot_id 選択済みの商品のスロットID
+   * @throw std::invalid_argument 決済待ち・排出中で商品が選択されていない場合
+   */
+  TransactionSession(const SessionId &session_id, SessionStatus status,
+                     std::optional<SlotId> selected_slot_id);
+
   /**
    * @brief セッションIDを取得
    * @return セッションID
@@ -67,6 +78,31 @@ public:
    */
   void complete();
 
+  /**
+   * @brief 商品を選択（例外を送出しない版）
+   * @param slot_id 選択するスロットID
+   * @return OK、または既に選択済みの場合 PRODUCT_ALREADY_SELECTED
+   */
+  ErrorCode trySelectProduct(const SlotId &slot_id);
+
+  /**
+   * @brief 決済待ち状態に遷移（例外を送出しない版）
+   * @return OK、NO_PRODUCT_SELECTED、または INVALID_STATE_TRANSITION
+   */
+  ErrorCode tryMarkPaymentPending();
+
+  /**
+   * @brief 排出中状態に遷移（例外を送出しない版）
+   * @return OK、または決済待ち状態でない場合 INVALID_STATE_TRANSITION
+   */
+  ErrorCode tryMarkDispensing();
+
+  /**
+   * @brief 取引を完了（例外を送出しない版）
+   * @return OK、または排出中状態でない場合 INVALID_STATE_TRANSITION
+   */
+  ErrorCode tryComplete();
+
   /**
    * @brief 取引をキャンセル
    */
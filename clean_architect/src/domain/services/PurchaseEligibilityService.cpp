@@ -11,33 +11,46 @@ std::vector<EligibleProduct>
 PurchaseEligibilityService::calculateEligibleProducts(
     const Inventory &inventory, const Wallet &wallet,
     const ICoinMech &coin_mech) {
+  std::vector<SlotSnapshot> views;
+  collectEligibleProducts(inventory, wallet, coin_mech, views);
+
   std::vector<EligibleProduct> eligible;
+  eligible.reserve(views.size());
+  for (const auto &view : views) {
+    eligible.emplace_back(view.slot_id, *view.product_info);
+  }
+  return eligible;
+}
+
+std::size_t PurchaseEligibilityService::collectEligibleProducts(
+    const Inventory &inventory, const Wallet &wallet,
+    const ICoinMech &coin_mech, std::vector<SlotSnapshot> &out) {
+  out.clear();
 
   // ドメインサービスは複数の集約を横断して処理を行うため、
   // 各集約の詳細にアクセスする必要がある
   const auto &slots = inventory.getAllSlots();
+  const int balance = wallet.getBalance().getRawValue();
 
   for (const auto &pair : slots) {
     const auto &slot_id = pair.first;
     const auto &product_slot = pair.second;
 
     // 在庫が存在するか確認
-    if (product_slot->getStock().getValue() == 0) {
+    if (product_slot->getStock().isZero()) {
       continue;
     }
 
     const auto &product_info = product_slot->getProductInfo();
-    const auto &price = product_info.getPrice();
+    const int price_value = product_info.getPrice().getRawValue();
 
     // 残高が価格以上か確認
-    if (wallet.getBalance().getRawValue() < price.getRawValue()) {
+    if (balance < price_value) {
       continue;
     }
 
     // 釣銭準備が可能か確認
     // 残高が価格を上回る場合、その差分が釣銭として返される
-    int balance = wallet.getBalance().getRawValue();
-    int price_value = price.getRawValue();
     int change_amount = balance - price_value;
 
     if (change_amount > 0) {
@@ -48,10 +61,10 @@ PurchaseEligibilityService::calculateEligibleProducts(
     }
 
     // すべての条件を満たしているので、購入適格商品として追加
-    eligible.emplace_back(slot_id, product_info);
+    out.push_back({slot_id, &product_info, product_slot->getStock()});
   }
 
-  return eligible;
+  return out.size();
 }
 
 } // namespace domain
@@ -3,6 +3,8 @@
 
 #include "domain/interfaces/ICoinMech.hpp"
 #include "domain/inventory/EligibleProduct.hpp"
+#include "domain/inventory/SlotSnapshot.hpp"
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -41,6 +43,24 @@ public:
   static std::vector<EligibleProduct>
   calculateEligibleProducts(const Inventory &inventory, const Wallet &wallet,
                             const ICoinMech &coin_mech);
+
+  /**
+   * @brief 購入可能な商品を呼び出し側のバッファに書き出す
+   * @param inventory 在庫集約
+   * @param wallet 通貨管理集約
+   * @param coin_mech コインメック（釣銭準備確認用）
+   * @param out 出力先（先頭からクリアされる）
+   * @return 書き出した商品の数
+   *
+   * @details
+   * 商品情報はコピーせず Inventory 内の ProductInfo を参照するため、
+   * バッファを使い回せば商品ごとのヒープ確保は発生しません。
+   * 参照は取得元の Inventory が生存している間のみ有効です。
+   */
+  static std::size_t collectEligibleProducts(const Inventory &inventory,
+                                             const Wallet &wallet,
+                                             const ICoinMech &coin_mech,
+                                             std::vector<SlotSnapshot> &out);
 };
 
 } // namespace domain
@@ -1,13 +1,18 @@
 #include "ConsoleUI.hpp"
+#include "domain/common/ErrorCode.hpp"
+#include <chrono>
 #include <iostream>
 #include <limits>
+#include <utility>
 
 namespace vending_machine {
 namespace frameworks_drivers {
 namespace ui {
 
-ConsoleUI::ConsoleUI(interface_adapters::VendingMachineController &controller)
-    : controller_(controller) {}
+ConsoleUI::ConsoleUI(interface_adapters::VendingMachineController &controller,
+                     std::function<void()> on_command_completed)
+    : controller_(controller),
+      on_command_completed_(std::move(on_command_completed)) {}
 
 void ConsoleUI::run() {
   bool running = true;
@@ -48,6 +53,10 @@ void ConsoleUI::run() {
       waitForEnter();
       break;
     }
+
+    if (on_command_completed_) {
+      on_command_completed_();
+    }
   }
 }
 
@@ -71,14 +80,19 @@ void ConsoleUI::showProductList() {
   std::cout << "          商品一覧\n";
   std::cout << "========================================\n";
 
-  auto products = controller_.getAllProducts();
+  controller_.getAllProductViews(product_views_);
+  printProducts(product_views_);
+
+  std::cout << "========================================\n";
+  waitForEnter();
+}
+
+void ConsoleUI::printProducts(
+    const std::vector<usecases::dto::ProductView> &products) {
   for (const auto &product : products) {
     std::cout << "スロット " << product.slot_id << ": " << product.name << " - "
               << product.price << "円 (在庫: " << product.stock << "個)\n";
   }
-
-  std::cout << "========================================\n";
-  waitForEnter();
 }
 
 void ConsoleUI::handleCashPurchase() {
@@ -129,17 +143,18 @@ void ConsoleUI::handleCashPurchase() {
     }
 
     // 購入実行
-    try {
-      auto response = controller_.purchaseWithCash(slot_num);
-
+    auto result = controller_.tryPurchaseWithCash(slot_num);
+    if (result) {
+      const auto &response = result.value();
       std::cout << "\n購入が完了しました！\n";
       std::cout << "商品: " << response.product_name
                 << " をお受け取りください。\n";
       if (response.change_amount > 0) {
         std::cout << "お釣り: " << response.change_amount << "円\n";
       }
-    } catch (const std::exception &e) {
-      std::cout << "購入エラー: " << e.what() << "\n";
+    } else {
+      std::cout << "購入エラー: " << domain::toMessage(result.error())
+                << "\n";
       std::cout << "返金処理を実行します...\n";
       int refunded = controller_.refund();
       std::cout << refunded << "円を返金しました。\n";
@@ -159,11 +174,8 @@ void ConsoleUI::handleEMoneyPurchase() {
   std::cout << "========================================\n";
 
   // 電子決済で購入可能な商品一覧を表示
-  auto products = controller_.getAvailableProductsForEMoney();
-  for (const auto &product : products) {
-    std::cout << "スロット " << product.slot_id << ": " << product.name << " - "
-              << product.price << "円 (在庫: " << product.stock << "個)\n";
-  }
+  controller_.getAvailableProductViewsForEMoney(product_views_);
+  printProducts(product_views_);
   std::cout << "========================================\n";
 
   std::cout
@@ -180,15 +192,15 @@ void ConsoleUI::handleEMoneyPurchase() {
     controller_.startEMoneyPurchaseSession();
 
     // 購入実行
-    auto response = controller_.purchaseWithEMoney(slot_num);
+    auto result = controller_.tryPurchaseWithEMoney(slot_num);
 
-    if (response.success) {
+    if (result) {
       std::cout << "\n決済が完了しました！\n";
-      std::cout << "商品: " << response.product_name
+      std::cout << "商品: " << result.value().product_name
                 << " をお受け取りください。\n";
     } else {
       std::cout << "\n決済に失敗しました。\n";
-      std::cout << "理由: " << response.message << "\n";
+      std::cout << "理由: " << domain::toMessage(result.error()) << "\n";
     }
 
   } catch (const std::exception &e) {
@@ -271,7 +283,7 @@ void ConsoleUI::handleCashCollection() {
   std::cout << "--- 売上金回収 ---\n";
 
   try {
-    int collected = controller_.collectCash();
+    auto collected = controller_.collectCash();
     std::cout << "\n売上金を回収しました。\n";
     std::cout << "回収金額: " << collected << "円\n";
   } catch (const std::exception &e) {
@@ -289,6 +301,20 @@ void ConsoleUI::handleSalesReport() {
     std::cout << "総売上: " << report.total_sales << "円\n";
     std::cout << "  - 現金売上: " << report.cash_sales << "円\n";
     std::cout << "  - 電子マネー売上: " << report.emoney_sales << "円\n";
+
+    auto now = std::chrono::system_clock::now();
+    std::cout << "\n本日の時間帯別売上 (UTC):\n";
+    for (const auto &item : controller_.getHourlySales(now)) {
+      std::cout << "  " << item.label << "  " << item.count << "件  "
+                << item.amount << "円\n";
+    }
+    std::cout << "本日の取引数（推定）: " << controller_.getDistinctSalesOn(now)
+              << "件\n";
+    std::cout << "\n売れ筋スロット（推定販売数）:\n";
+    for (const auto &slot : controller_.getTopSellingSlots(3)) {
+      std::cout << "  スロット" << slot.slot_id << ": "
+                << slot.estimated_count << "個\n";
+    }
   } catch (const std::exception &e) {
     std::cout << "\nエラー: " << e.what() << "\n";
   }
@@ -7,6 +7,9 @@
 #define VENDING_MACHINE_FRAMEWORKS_DRIVERS_UI_CONSOLEUI_HPP
 
 #include "interface_adapters/controllers/VendingMachineController.hpp"
+#include "usecases/dto/PurchaseDTOs.hpp"
+#include <functional>
+#include <vector>
 
 namespace vending_machine {
 namespace frameworks_drivers {
@@ -21,8 +24,11 @@ public:
   /**
    * @brief コンストラクタ
    * @param controller コントローラー
+   * @param on_command_completed メニュー操作が1つ終わるたびに呼ぶ関数
+   *        （定期チェックポイントなど。省略可）
    */
-  explicit ConsoleUI(interface_adapters::VendingMachineController &controller);
+  explicit ConsoleUI(interface_adapters::VendingMachineController &controller,
+                     std::function<void()> on_command_completed = {});
 
   /**
    * @brief UIを起動
@@ -31,10 +37,15 @@ public:
 
 private:
   interface_adapters::VendingMachineController &controller_;
+  std::function<void()> on_command_completed_;
+
+  /// 商品一覧表示用バッファ（表示のたびに使い回す）
+  std::vector<usecases::dto::ProductView> product_views_;
 
   // UIメソッド
   void showMainMenu();
   void showProductList();
+  void printProducts(const std::vector<usecases::dto::ProductView> &products);
   void handleCashPurchase();
   void handleEMoneyPurchase();
   void showAdminMenu();
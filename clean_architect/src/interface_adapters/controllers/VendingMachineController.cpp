@@ -2,6 +2,8 @@
 #include "domain/common/Money.hpp"
 #include "domain/common/Quantity.hpp"
 #include "domain/inventory/SlotId.hpp"
+#include <array>
+#include <cstdio>
 
 namespace vending_machine {
 namespace interface_adapters {
@@ -31,12 +33,28 @@ VendingMachineController::getEligibleProducts() {
   return purchase_cash_usecase_.getEligibleProducts();
 }
 
+usecases::dto::PmrProductList VendingMachineController::getEligibleProducts(
+    std::pmr::memory_resource *resource) {
+  return purchase_cash_usecase_.getEligibleProducts(resource);
+}
+
+std::size_t VendingMachineController::getEligibleProductViews(
+    std::vector<usecases::dto::ProductView> &out) {
+  return purchase_cash_usecase_.getEligibleProductViews(out);
+}
+
 usecases::dto::PurchaseResponse
 VendingMachineController::purchaseWithCash(int slot_id) {
   usecases::dto::PurchaseRequest request{slot_id};
   return purchase_cash_usecase_.selectAndPurchase(request);
 }
 
+domain::Expected<usecases::dto::PurchaseResponse>
+VendingMachineController::tryPurchaseWithCash(int slot_id) {
+  usecases::dto::PurchaseRequest request{slot_id};
+  return purchase_cash_usecase_.trySelectAndPurchase(request);
+}
+
 int VendingMachineController::getBalance() {
   return purchase_cash_usecase_.getBalance();
 }
@@ -54,39 +72,98 @@ VendingMachineController::getAvailableProductsForEMoney() {
   return purchase_emoney_usecase_.getAvailableProducts();
 }
 
+usecases::dto::PmrProductList
+VendingMachineController::getAvailableProductsForEMoney(
+    std::pmr::memory_resource *resource) {
+  return purchase_emoney_usecase_.getAvailableProducts(resource);
+}
+
+std::size_t VendingMachineController::getAvailableProductViewsForEMoney(
+    std::vector<usecases::dto::ProductView> &out) {
+  return purchase_emoney_usecase_.getAvailableProductViews(out);
+}
+
 usecases::dto::EMoneyPurchaseResponse
 VendingMachineController::purchaseWithEMoney(int slot_id) {
   usecases::dto::EMoneyPurchaseRequest request{slot_id};
   return purchase_emoney_usecase_.selectAndRequestPayment(request);
 }
 
+domain::Expected<usecases::dto::EMoneyPurchaseResponse>
+VendingMachineController::tryPurchaseWithEMoney(int slot_id) {
+  usecases::dto::EMoneyPurchaseRequest request{slot_id};
+  return purchase_emoney_usecase_.trySelectAndRequestPayment(request);
+}
+
 void VendingMachineController::refillInventory(int slot_id, int quantity) {
   refill_usecase_.refillSlot(domain::SlotId(slot_id),
                              domain::Quantity(quantity));
 }
 
-int VendingMachineController::collectCash() {
+std::int64_t VendingMachineController::collectCash() {
   return cash_collection_usecase_.collectCash().getRawValue();
 }
 
 usecases::dto::SalesReportDto VendingMachineController::getSalesReport() {
-  auto payment_reports = reporting_usecase_.generatePaymentMethodReport();
-
-  int total = 0;
-  int cash = 0;
-  int emoney = 0;
+  const auto &summary = reporting_usecase_.generateSalesSummary();
 
-  for (const auto &report : payment_reports) {
-    int amount = report.total_revenue.getRawValue();
-    total += amount;
+  std::int64_t cash = 0;
+  std::int64_t emoney = 0;
+  for (const auto &report : summary.payment_reports) {
     if (report.payment_method == domain::PaymentMethodType::CASH) {
-      cash += amount;
+      cash = report.total_revenue.getRawValue();
     } else if (report.payment_method == domain::PaymentMethodType::EMONEY) {
-      emoney += amount;
+      emoney = report.total_revenue.getRawValue();
     }
   }
 
-  return {total, cash, emoney};
+  return {summary.total_revenue.getRawValue(), cash, emoney};
+}
+
+std::vector<usecases::dto::SalesReportItemDto>
+VendingMachineController::getHourlySales(
+    std::chrono::system_clock::time_point day) {
+  using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+  auto start = std::chrono::floor<Days>(day);
+  auto buckets = reporting_usecase_.generateRollupReport(
+      domain::RollupGranularity::HOURLY, start, start + Days(1));
+
+  // スロット・決済方法ごとのバケットを時間帯ごとに合算する
+  std::array<std::int64_t, 24> counts{};
+  std::array<std::int64_t, 24> amounts{};
+  for (const auto &bucket : buckets) {
+    auto hour = std::chrono::duration_cast<std::chrono::hours>(bucket.start -
+                                                                start)
+                    .count();
+    counts[static_cast<std::size_t>(hour)] += bucket.transaction_count;
+    amounts[static_cast<std::size_t>(hour)] +=
+        bucket.total_revenue.getRawValue();
+  }
+
+  std::vector<usecases::dto::SalesReportItemDto> items;
+  for (std::size_t hour = 0; hour < counts.size(); ++hour) {
+    if (counts[hour] > 0) {
+      char label[8];
+      std::snprintf(label, sizeof(label), "%02zu:00", hour);
+      items.push_back({label, static_cast<int>(counts[hour]),
+                       static_cast<int>(amounts[hour])});
+    }
+  }
+  return items;
+}
+
+std::vector<usecases::dto::TopSlotDto>
+VendingMachineController::getTopSellingSlots(std::size_t k) {
+  std::vector<usecases::dto::TopSlotDto> slots;
+  for (const auto &entry : reporting_usecase_.getTopSellingSlots(k)) {
+    slots.push_back({static_cast<int>(entry.key), entry.count});
+  }
+  return slots;
+}
+
+std::uint64_t VendingMachineController::getDistinctSalesOn(
+    std::chrono::system_clock::time_point day) {
+  return reporting_usecase_.estimateDistinctSalesOn(day);
 }
 
 std::vector<usecases::dto::ProductDto>
@@ -94,5 +171,15 @@ VendingMachineController::getAllProducts() {
   return purchase_cash_usecase_.getAllProducts();
 }
 
+usecases::dto::PmrProductList VendingMachineController::getAllProducts(
+    std::pmr::memory_resource *resource) {
+  return purchase_cash_usecase_.getAllProducts(resource);
+}
+
+std::size_t VendingMachineController::getAllProductViews(
+    std::vector<usecases::dto::ProductView> &out) {
+  return purchase_cash_usecase_.getAllProductViews(out);
+}
+
 } // namespace interface_adapters
 } // namespace vending_machine
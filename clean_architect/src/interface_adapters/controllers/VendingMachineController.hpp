@@ -1,12 +1,17 @@
 #ifndef VENDING_MACHINE_INTERFACE_ADAPTERS_CONTROLLERS_VENDING_MACHINE_CONTROLLER_HPP
 #define VENDING_MACHINE_INTERFACE_ADAPTERS_CONTROLLERS_VENDING_MACHINE_CONTROLLER_HPP
 
+#include "domain/common/Expected.hpp"
 #include "usecases/CashCollectionUseCase.hpp"
 #include "usecases/InventoryRefillUseCase.hpp"
 #include "usecases/PurchaseWithCashUseCase.hpp"
 #include "usecases/PurchaseWithEMoneyUseCase.hpp"
 #include "usecases/SalesReportingUseCase.hpp"
 #include "usecases/dto/PurchaseDTOs.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -26,22 +31,42 @@ public:
   void startCashPurchaseSession();
   void insertCash(int amount);
   std::vector<usecases::dto::ProductDto> getEligibleProducts();
+  usecases::dto::PmrProductList
+  getEligibleProducts(std::pmr::memory_resource *resource);
+  std::size_t
+  getEligibleProductViews(std::vector<usecases::dto::ProductView> &out);
   usecases::dto::PurchaseResponse purchaseWithCash(int slot_id);
+  domain::Expected<usecases::dto::PurchaseResponse>
+  tryPurchaseWithCash(int slot_id);
   int getBalance();
   int refund();
 
   // E-Money Purchase
   void startEMoneyPurchaseSession();
   std::vector<usecases::dto::ProductDto> getAvailableProductsForEMoney();
+  usecases::dto::PmrProductList
+  getAvailableProductsForEMoney(std::pmr::memory_resource *resource);
+  std::size_t getAvailableProductViewsForEMoney(
+      std::vector<usecases::dto::ProductView> &out);
   usecases::dto::EMoneyPurchaseResponse purchaseWithEMoney(int slot_id);
+  domain::Expected<usecases::dto::EMoneyPurchaseResponse>
+  tryPurchaseWithEMoney(int slot_id);
 
   // Admin / Maintenance
   void refillInventory(int slot_id, int quantity);
-  int collectCash();
+  std::int64_t collectCash();
   usecases::dto::SalesReportDto getSalesReport();
+  // Hourly sales of the UTC day containing `day` (hours with sales only)
+  std::vector<usecases::dto::SalesReportItemDto>
+  getHourlySales(std::chrono::system_clock::time_point day);
+  std::vector<usecases::dto::TopSlotDto> getTopSellingSlots(std::size_t k);
+  std::uint64_t getDistinctSalesOn(std::chrono::system_clock::time_point day);
 
   // Product Info (General)
   std::vector<usecases::dto::ProductDto> getAllProducts();
+  usecases::dto::PmrProductList
+  getAllProducts(std::pmr::memory_resource *resource);
+  std::size_t getAllProductViews(std::vector<usecases::dto::ProductView> &out);
 
 private:
   usecases::PurchaseWithCashUseCase &purchase_cash_usecase_;
@@ -0,0 +1,196 @@
+#include "TransactionHistoryExporter.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+constexpr char CSV_HEADER[] =
+    "sequence,sales_id,slot_id,price,payment_method,timestamp_ms\n";
+constexpr char BINARY_MAGIC[4] = {'V', 'M', 'T', 'X'};
+constexpr std::uint16_t BINARY_VERSION = 2;
+constexpr std::size_t BINARY_RECORD_SIZE = 32;
+
+/**
+ * @brief バッファ経由でストリームへ書き出す出力先
+ *
+ * 出力全体の先頭からの位置（position）を数え、skip より前の部分は
+ * 書き出さずに捨てる（バイト位置からの再開用）。
+ */
+class BufferedSink {
+public:
+  BufferedSink(std::ostream &out, std::vector<char> &buffer,
+               std::uint64_t skip)
+      : out_(out), buffer_(buffer), skip_(skip) {}
+
+  // 少なくとも size バイトを書き込める位置を返す
+  char *reserve(std::size_t size) {
+    if (used_ + size > buffer_.size()) {
+      flush();
+    }
+    return buffer_.data() + used_;
+  }
+
+  void commit(std::size_t size) { used_ += size; }
+
+  void append(const char *data, std::size_t size) {
+    std::memcpy(reserve(size), data, size);
+    commit(size);
+  }
+
+  void flush() {
+    const char *data = buffer_.data();
+    std::size_t size = used_;
+    position_ += used_;
+    used_ = 0;
+
+    // 再開位置より前の部分は出力済みなので省く
+    std::uint64_t start = position_ - size;
+    if (position_ <= skip_) {
+      return;
+    }
+    if (start < skip_) {
+      auto skipped = static_cast<std::size_t>(skip_ - start);
+      data += skipped;
+      size -= skipped;
+    }
+    out_.write(data, static_cast<std::streamsize>(size));
+    if (!out_) {
+      throw std::runtime_error("Failed to write transaction export");
+    }
+    written_ += size;
+  }
+
+  std::uint64_t position() const { return position_ + used_; }
+  std::uint64_t written() const { return written_; }
+
+private:
+  std::ostream &out_;
+  std::vector<char> &buffer_;
+  std::uint64_t skip_;
+  std::size_t used_ = 0;
+  std::uint64_t position_ = 0;
+  std::uint64_t written_ = 0;
+};
+
+std::int64_t toEpochMillis(std::chrono::system_clock::time_point time_point) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time_point.time_since_epoch())
+      .count();
+}
+
+template <typename T> char *putLittleEndian(char *out, T value) {
+  auto bits = static_cast<std::uint64_t>(value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    *out++ = static_cast<char>((bits >> (8 * i)) & 0xff);
+  }
+  return out;
+}
+
+void writeCsvRecord(BufferedSink &sink,
+                    const domain::TransactionRecord &record) {
+  char *begin = sink.reserve(TransactionHistoryExporter::MAX_RECORD_SIZE);
+  char *end = begin + TransactionHistoryExporter::MAX_RECORD_SIZE;
+  char *p = begin;
+
+  p = std::to_chars(p, end, record.getSequence()).ptr;
+  *p++ = ',';
+  p = std::to_chars(p, end, record.getSalesId().getValue()).ptr;
+  *p++ = ',';
+  p = std::to_chars(p, end, record.getSlotId().getValue()).ptr;
+  *p++ = ',';
+  p = std::to_chars(p, end, record.getPrice().getRawValue()).ptr;
+  *p++ = ',';
+  if (record.getPaymentMethod() == domain::PaymentMethodType::CASH) {
+    std::memcpy(p, "CASH", 4);
+    p += 4;
+  } else {
+    std::memcpy(p, "EMONEY", 6);
+    p += 6;
+  }
+  *p++ = ',';
+  p = std::to_chars(p, end, toEpochMillis(record.getTimestamp())).ptr;
+  *p++ = '\n';
+
+  sink.commit(static_cast<std::size_t>(p - begin));
+}
+
+void writeBinaryHeader(BufferedSink &sink) {
+  char *begin = sink.reserve(8);
+  char *p = begin;
+  std::memcpy(p, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  p += sizeof(BINARY_MAGIC);
+  p = putLittleEndian(p, BINARY_VERSION);
+  p = putLittleEndian(p, std::uint16_t{0});
+  sink.commit(static_cast<std::size_t>(p - begin));
+}
+
+void writeBinaryRecord(BufferedSink &sink,
+                       const domain::TransactionRecord &record) {
+  char *begin = sink.reserve(BINARY_RECORD_SIZE);
+  char *p = begin;
+  p = putLittleEndian(p, record.getSequence());
+  p = putLittleEndian(p, std::int32_t{record.getSalesId().getValue()});
+  p = putLittleEndian(p, std::int32_t{record.getSlotId().getValue()});
+  p = putLittleEndian(p, std::int32_t{record.getPrice().getRawValue()});
+  *p++ = static_cast<char>(record.getPaymentMethod());
+  *p++ = 0;
+  *p++ = 0;
+  *p++ = 0;
+  p = putLittleEndian(p, toEpochMillis(record.getTimestamp()));
+  sink.commit(static_cast<std::size_t>(p - begin));
+}
+
+} // namespace
+
+TransactionHistoryExporter::TransactionHistoryExporter(
+    const domain::ITransactionHistoryRepository &transaction_history,
+    std::size_t buffer_size)
+    : transaction_history_(transaction_history) {
+  if (buffer_size < MAX_RECORD_SIZE) {
+    throw std::invalid_argument("Export buffer is too small");
+  }
+  buffer_.resize(buffer_size);
+}
+
+ExportResult TransactionHistoryExporter::exportTo(std::ostream &out,
+                                                  ExportFormat format,
+                                                  const ExportCursor &cursor) {
+  BufferedSink sink(out, buffer_, cursor.byte_offset);
+  ExportResult result;
+
+  if (format == ExportFormat::CSV) {
+    sink.append(CSV_HEADER, sizeof(CSV_HEADER) - 1);
+  } else {
+    writeBinaryHeader(sink);
+  }
+
+  transaction_history_.forEach([&](const domain::TransactionRecord &record) {
+    std::uint64_t sequence = record.getSequence();
+    if (cursor.after_sequence && sequence <= *cursor.after_sequence) {
+      return;
+    }
+    if (format == ExportFormat::CSV) {
+      writeCsvRecord(sink, record);
+    } else {
+      writeBinaryRecord(sink, record);
+    }
+    if (sink.position() > cursor.byte_offset) {
+      ++result.records_written;
+      result.last_sequence = sequence;
+    }
+  });
+
+  sink.flush();
+  out.flush();
+  result.bytes_written = sink.written();
+  result.end_offset = sink.position();
+  return result;
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,119 @@
+/**
+ * @file TransactionHistoryExporter.hpp
+ * @brief 取引履歴のエクスポート（CSV / バイナリ）
+ *
+ * @details
+ * リポジトリの全件走査（forEach）から1件ずつ受け取ったレコードを
+ * 再利用するバッファへ直接書式化し、バッファが埋まるたびにまとめて
+ * 出力ストリームへ書き出します。履歴のコピーは作りません。
+ *
+ * CSV 形式:
+ *   sequence,sales_id,slot_id,price,payment_method,timestamp_ms
+ *   1,1,3,120,CASH,1700000000000
+ *
+ * バイナリ形式（すべてリトルエンディアン）:
+ * - ヘッダ 8 バイト: "VMTX"、バージョン（u16 = 2）、予約（u16 = 0）
+ * - レコード 32 バイト: sequence（u64）、sales_id（i32）、slot_id（i32）、
+ *   price（i32）、決済方法（u8: 0 = CASH, 1 = EMONEY）、予約 3 バイト、
+ *   timestamp_ms（i64、エポックからのミリ秒）
+ *
+ * レコードはリポジトリの走査順、すなわちシーケンス番号の昇順に並びます。
+ * 中断したエクスポートは、出力済みのバイト数または最後に出力した
+ * シーケンス番号から再開できます（ExportCursor）。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_INTERFACE_ADAPTERS_EXPORTERS_TRANSACTION_HISTORY_EXPORTER_HPP
+#define VENDING_MACHINE_INTERFACE_ADAPTERS_EXPORTERS_TRANSACTION_HISTORY_EXPORTER_HPP
+
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @enum ExportFormat
+ * @brief エクスポート形式
+ */
+enum class ExportFormat {
+  CSV,   ///< ヘッダ付き CSV
+  BINARY ///< 固定長バイナリ
+};
+
+/**
+ * @struct ExportCursor
+ * @brief エクスポートの再開位置
+ *
+ * byte_offset を指定すると、前回と同じ出力の先頭 byte_offset バイトを
+ * 省いて続きから出力します。走査順がシーケンス番号の昇順であることに
+ * 依存するため、履歴が追記のみで前回から消去されていない場合に有効です。
+ * after_sequence を指定すると、シーケンス番号がそれより大きいレコード
+ * だけを新しい出力として（ヘッダ付きで）書き出します。こちらは消去や
+ * 保持期間による破棄をはさんでも、前回の続きだけを正しく選べます。
+ */
+struct ExportCursor {
+  std::uint64_t byte_offset = 0; ///< 省略する出力済みバイト数
+  /// このシーケンス番号以下のレコードを除外
+  std::optional<std::uint64_t> after_sequence;
+};
+
+/**
+ * @struct ExportResult
+ * @brief エクスポートの結果
+ */
+struct ExportResult {
+  std::uint64_t records_written = 0; ///< 出力したレコード数（一部を含む）
+  std::uint64_t bytes_written = 0;   ///< 今回ストリームへ書いたバイト数
+  std::uint64_t end_offset = 0; ///< 出力全体の末尾位置（次回の byte_offset）
+  /// 最後に出力したシーケンス番号（次回の after_sequence）
+  std::optional<std::uint64_t> last_sequence;
+};
+
+/**
+ * @class TransactionHistoryExporter
+ * @brief 取引履歴をストリームへ書き出すエクスポーター
+ */
+class TransactionHistoryExporter {
+public:
+  /// 既定のバッファサイズ（この単位でまとめて書き出す）
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t{1} << 16;
+  /// 1レコードの最大出力サイズ（バッファサイズの下限）
+  static constexpr std::size_t MAX_RECORD_SIZE = 128;
+
+  /**
+   * @brief コンストラクタ
+   * @param transaction_history 取引履歴リポジトリ
+   * @param buffer_size 書き出し用バッファのサイズ
+   * @throw std::invalid_argument バッファサイズが MAX_RECORD_SIZE 未満の場合
+   */
+  explicit TransactionHistoryExporter(
+      const domain::ITransactionHistoryRepository &transaction_history,
+      std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  /**
+   * @brief 取引履歴をエクスポート
+   * @param out 出力先ストリーム（バイナリの場合はバイナリモードで開くこと）
+   * @param format 出力形式
+   * @param cursor 再開位置（省略時は先頭から）
+   * @return エクスポートの結果
+   * @throw std::runtime_error ストリームへの書き込みに失敗した場合
+   */
+  ExportResult exportTo(std::ostream &out, ExportFormat format,
+                        const ExportCursor &cursor = {});
+
+private:
+  const domain::ITransactionHistoryRepository &transaction_history_;
+  std::vector<char> buffer_;
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INTERFACE_ADAPTERS_EXPORTERS_TRANSACTION_HISTORY_EXPORTER_HPP
@@ -0,0 +1,110 @@
+#include "BinaryFileIo.hpp"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace binary_file_io {
+
+namespace {
+
+/**
+ * @brief CRC-32 の表
+ */
+constexpr std::array<std::uint32_t, 256> makeCrcTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1u) != 0 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr auto CRC_TABLE = makeCrcTable();
+
+} // namespace
+
+std::uint32_t crc32(const char *data, std::size_t size) {
+  std::uint32_t crc = 0xFFFFFFFFu;
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = CRC_TABLE[(crc ^ static_cast<std::uint8_t>(data[i])) & 0xffu] ^
+          (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+void throwSystemError(const std::string &what, const std::string &path) {
+  throw std::runtime_error(what + ": " + path + ": " + std::strerror(errno));
+}
+
+void writeAll(int fd, const char *data, std::size_t size, off_t offset,
+              const std::string &path) {
+  while (size > 0) {
+    ssize_t written = ::pwrite(fd, data, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSystemError("Failed to write", path);
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+    offset += written;
+  }
+}
+
+std::size_t readAt(int fd, char *data, std::size_t size, off_t offset,
+                   const std::string &path) {
+  std::size_t total = 0;
+  while (total < size) {
+    ssize_t bytes = ::pread(fd, data + total, size - total,
+                            offset + static_cast<off_t>(total));
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSystemError("Failed to read", path);
+    }
+    if (bytes == 0) {
+      break;
+    }
+    total += static_cast<std::size_t>(bytes);
+  }
+  return total;
+}
+
+std::vector<char> readFile(int fd, const std::string &path) {
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    throwSystemError("Failed to stat", path);
+  }
+  std::vector<char> file(static_cast<std::size_t>(info.st_size));
+  // 読んでいる間に切り詰められた場合は読めた分だけ返す
+  file.resize(readAt(fd, file.data(), file.size(), 0, path));
+  return file;
+}
+
+void syncData(int fd, JournalSync sync, const std::string &path) {
+  if (sync == JournalSync::EACH_ENTRY && ::fdatasync(fd) != 0) {
+    throwSystemError("Failed to sync", path);
+  }
+}
+
+void truncateFile(int fd, off_t size, JournalSync sync,
+                  const std::string &path) {
+  if (::ftruncate(fd, size) != 0) {
+    throwSystemError("Failed to truncate", path);
+  }
+  syncData(fd, sync, path);
+}
+
+} // namespace binary_file_io
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,91 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_BINARY_FILE_IO_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_BINARY_FILE_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @enum JournalSync
+ * @brief 追記ごとにディスクへ同期するか
+ */
+enum class JournalSync {
+  NONE,      ///< 同期しない（プロセスの異常終了には耐える）
+  EACH_ENTRY ///< 追記ごとに fdatasync（電源断にも耐える）
+};
+
+/**
+ * @brief 追記専用ファイル（購入ジャーナル・イベントストア）の共通処理
+ *
+ * 数値はリトルエンディアンで書き、レコードは CRC-32 で検証します。
+ * 失敗はいずれも errno の説明を付けた std::runtime_error で報告します。
+ */
+namespace binary_file_io {
+
+/**
+ * @brief CRC-32（IEEE 802.3、反転多項式 0xEDB88320）
+ */
+std::uint32_t crc32(const char *data, std::size_t size);
+
+template <typename T> void setLittleEndian(char *out, T value) {
+  auto bits = static_cast<std::uint64_t>(value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+  }
+}
+
+template <typename T> T getLittleEndian(const char *in) {
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    bits |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in[i]))
+            << (8 * i);
+  }
+  return static_cast<T>(bits);
+}
+
+/**
+ * @brief errno の説明を付けて std::runtime_error を送出
+ */
+[[noreturn]] void throwSystemError(const std::string &what,
+                                   const std::string &path);
+
+/**
+ * @brief 指定位置へすべて書き込む（EINTR と部分書き込みを再試行）
+ */
+void writeAll(int fd, const char *data, std::size_t size, off_t offset,
+              const std::string &path);
+
+/**
+ * @brief 指定位置から最大 size バイトを読む
+ * @return 読めたバイト数（ファイルの末尾に達した場合は size 未満）
+ */
+std::size_t readAt(int fd, char *data, std::size_t size, off_t offset,
+                   const std::string &path);
+
+/**
+ * @brief ファイル全体を読む
+ */
+std::vector<char> readFile(int fd, const std::string &path);
+
+/**
+ * @brief sync が EACH_ENTRY の場合に fdatasync する
+ */
+void syncData(int fd, JournalSync sync, const std::string &path);
+
+/**
+ * @brief 指定の長さに切り詰める（sync が EACH_ENTRY なら同期も行う）
+ */
+void truncateFile(int fd, off_t size, JournalSync sync,
+                  const std::string &path);
+
+} // namespace binary_file_io
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_BINARY_FILE_IO_HPP
@@ -0,0 +1,295 @@
+#include "BinaryFileMachineStateRepository.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+constexpr char MAGIC[4] = {'V', 'M', 'C', 'P'};
+constexpr std::size_t HEADER_SIZE = 16;
+constexpr std::uint8_t NO_VALUE = 0;
+constexpr std::uint8_t HAS_VALUE = 1;
+
+std::uint32_t fnv1a(const char *data, std::size_t size) {
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<std::uint8_t>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template <typename T> void putLittleEndian(std::vector<char> &out, T value) {
+  auto bits = static_cast<std::uint64_t>(value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+template <typename T> void setLittleEndian(char *out, T value) {
+  auto bits = static_cast<std::uint64_t>(value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+  }
+}
+
+[[noreturn]] void throwCorrupt(const std::string &path) {
+  throw std::runtime_error("Corrupt machine state checkpoint: " + path);
+}
+
+/**
+ * @brief 範囲検査つきでリトルエンディアンの値を読み出す
+ */
+class Reader {
+public:
+  Reader(const char *data, std::size_t size, const std::string &path)
+      : data_(data), size_(size), path_(path) {}
+
+  template <typename T> T get() {
+    const char *bytes = take(sizeof(T));
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      bits |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(bytes[i]))
+              << (8 * i);
+    }
+    return static_cast<T>(bits);
+  }
+
+  const char *take(std::size_t size) {
+    if (size > size_ - offset_) {
+      throwCorrupt(path_);
+    }
+    const char *bytes = data_ + offset_;
+    offset_ += size;
+    return bytes;
+  }
+
+  bool atEnd() const { return offset_ == size_; }
+
+private:
+  const char *data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+  const std::string &path_;
+};
+
+/**
+ * @brief 読み取り専用のメモリマップ（スコープを抜けると解放）
+ */
+class MappedFile {
+public:
+  MappedFile(const void *data, std::size_t size) : data_(data), size_(size) {}
+  ~MappedFile() { ::munmap(const_cast<void *>(data_), size_); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data() const { return static_cast<const char *>(data_); }
+
+private:
+  const void *data_;
+  std::size_t size_;
+};
+
+void encodePayload(const domain::MachineState &state, std::vector<char> &out) {
+  putLittleEndian(out, std::int32_t{state.sales_id.getValue()});
+  putLittleEndian(out, static_cast<std::uint8_t>(state.mode));
+  putLittleEndian(out, std::int32_t{state.balance.getRawValue()});
+
+  if (state.session.has_value()) {
+    const auto &session = *state.session;
+    putLittleEndian(out, HAS_VALUE);
+    putLittleEndian(out, std::int32_t{session.session_id.getValue()});
+    putLittleEndian(out, static_cast<std::uint8_t>(session.status));
+    putLittleEndian(out, session.selected_slot_id ? HAS_VALUE : NO_VALUE);
+    putLittleEndian(out, std::int32_t{session.selected_slot_id
+                                          ? session.selected_slot_id->getValue()
+                                          : 0});
+  } else {
+    putLittleEndian(out, NO_VALUE);
+  }
+
+  putLittleEndian(out, static_cast<std::uint32_t>(state.slots.size()));
+  for (const auto &slot : state.slots) {
+    const std::string &name = slot.product_info.getName().getValue();
+    putLittleEndian(out, std::int32_t{slot.slot_id.getValue()});
+    putLittleEndian(out,
+                    std::int32_t{slot.product_info.getPrice().getRawValue()});
+    putLittleEndian(out, std::int32_t{slot.stock.getValue()});
+    putLittleEndian(out, static_cast<std::uint16_t>(name.size()));
+    out.insert(out.end(), name.begin(), name.end());
+  }
+  putLittleEndian(out, state.journal_position);
+}
+
+// 範囲外の列挙値は他の値オブジェクトと同様に invalid_argument とする
+template <typename Enum> Enum toEnum(std::uint8_t value, Enum last) {
+  if (value > static_cast<std::uint8_t>(last)) {
+    throw std::invalid_argument("Enum value out of range");
+  }
+  return static_cast<Enum>(value);
+}
+
+domain::MachineState decodePayload(Reader &reader) {
+  domain::SalesId sales_id(reader.get<std::int32_t>());
+  auto mode = toEnum(reader.get<std::uint8_t>(), domain::Mode::MAINTENANCE);
+  domain::Money balance(reader.get<std::int32_t>());
+  domain::MachineState state{sales_id, mode, balance, {}, std::nullopt};
+
+  if (reader.get<std::uint8_t>() == HAS_VALUE) {
+    domain::SessionId session_id(reader.get<std::int32_t>());
+    auto status = toEnum(reader.get<std::uint8_t>(),
+                         domain::SessionStatus::CANCELLED);
+    bool has_slot = reader.get<std::uint8_t>() == HAS_VALUE;
+    std::int32_t slot = reader.get<std::int32_t>();
+    state.session = domain::SessionState{
+        session_id, status,
+        has_slot ? std::optional<domain::SlotId>(domain::SlotId(slot))
+                 : std::nullopt};
+  }
+
+  auto slot_count = reader.get<std::uint32_t>();
+  for (std::uint32_t i = 0; i < slot_count; ++i) {
+    domain::SlotId slot_id(reader.get<std::int32_t>());
+    domain::Price price(reader.get<std::int32_t>());
+    domain::Quantity stock(reader.get<std::int32_t>());
+    auto name_size = reader.get<std::uint16_t>();
+    const char *name = reader.take(name_size);
+    state.slots.push_back(
+        {slot_id,
+         domain::ProductInfo(domain::ProductName(std::string(name, name_size)),
+                             price),
+         stock});
+  }
+  state.journal_position = reader.get<std::uint32_t>();
+  return state;
+}
+
+void writeAll(int fd, const char *data, std::size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed to write machine state checkpoint");
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+} // namespace
+
+BinaryFileMachineStateRepository::BinaryFileMachineStateRepository(
+    std::string path)
+    : path_(std::move(path)) {}
+
+void BinaryFileMachineStateRepository::save(
+    const domain::MachineState &state) {
+  buffer_.assign(HEADER_SIZE, 0);
+  encodePayload(state, buffer_);
+
+  std::size_t payload_size = buffer_.size() - HEADER_SIZE;
+  std::memcpy(buffer_.data(), MAGIC, sizeof(MAGIC));
+  setLittleEndian(buffer_.data() + 4, FORMAT_VERSION);
+  setLittleEndian(buffer_.data() + 6, std::uint16_t{0});
+  setLittleEndian(buffer_.data() + 8, static_cast<std::uint32_t>(payload_size));
+  setLittleEndian(buffer_.data() + 12,
+                  fnv1a(buffer_.data() + HEADER_SIZE, payload_size));
+
+  // 一時ファイルに書き切ってから置き換える（途中で止まっても前回分が残る）
+  std::string temp_path = path_ + ".tmp";
+  int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open machine state checkpoint: " +
+                             temp_path);
+  }
+  try {
+    writeAll(fd, buffer_.data(), buffer_.size());
+    if (::fsync(fd) != 0) {
+      throw std::runtime_error("Failed to sync machine state checkpoint");
+    }
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+
+  if (::rename(temp_path.c_str(), path_.c_str()) != 0) {
+    throw std::runtime_error("Failed to replace machine state checkpoint: " +
+                             path_);
+  }
+}
+
+std::optional<domain::MachineState>
+BinaryFileMachineStateRepository::load() const {
+  int fd = ::open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return std::nullopt;
+    }
+    throw std::runtime_error("Failed to open machine state checkpoint: " +
+                             path_);
+  }
+
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat machine state checkpoint: " +
+                             path_);
+  }
+  auto size = static_cast<std::size_t>(info.st_size);
+  if (size < HEADER_SIZE) {
+    ::close(fd);
+    throwCorrupt(path_);
+  }
+
+  void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // マップはファイル記述子を閉じても有効
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Failed to map machine state checkpoint: " +
+                             path_);
+  }
+  MappedFile file(data, size);
+
+  Reader header(file.data(), HEADER_SIZE, path_);
+  if (std::memcmp(header.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+    throwCorrupt(path_);
+  }
+  auto version = header.get<std::uint16_t>();
+  if (version != FORMAT_VERSION) {
+    throw std::runtime_error(
+        "Unsupported machine state checkpoint version: " +
+        std::to_string(version));
+  }
+  header.get<std::uint16_t>();
+  auto payload_size = header.get<std::uint32_t>();
+  auto checksum = header.get<std::uint32_t>();
+  if (payload_size != size - HEADER_SIZE ||
+      checksum != fnv1a(file.data() + HEADER_SIZE, payload_size)) {
+    throwCorrupt(path_);
+  }
+
+  Reader payload(file.data() + HEADER_SIZE, payload_size, path_);
+  try {
+    domain::MachineState state = decodePayload(payload);
+    if (!payload.atEnd()) {
+      throwCorrupt(path_);
+    }
+    return state;
+  } catch (const std::invalid_argument &) {
+    // 値オブジェクトの検証に失敗した（範囲外の値が保存されていた）
+    throwCorrupt(path_);
+  }
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,62 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_BINARY_FILE_MACHINE_STATE_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_BINARY_FILE_MACHINE_STATE_HPP
+
+#include "domain/repositories/IMachineStateRepository.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @class BinaryFileMachineStateRepository
+ * @brief 自動販売機の状態をバイナリファイル1個に保存する実装
+ *
+ * 形式（リトルエンディアン）:
+ * - ヘッダ 16 バイト: "VMCP"、版数(u16)、予約(u16)、
+ *   ペイロード長(u32)、ペイロードの FNV-1a チェックサム(u32)
+ * - ペイロード: 販売管理ID・モード・残高・セッション・スロット列・
+ *   反映済みの購入通番
+ *
+ * 保存は一時ファイルへ書いてから rename で置き換えるため、
+ * 書き込み途中で停止しても前回の内容が残ります。
+ * 読み込みはファイルをメモリマップし、コピーせずに復号します。
+ */
+class BinaryFileMachineStateRepository
+    : public domain::IMachineStateRepository {
+public:
+  static constexpr std::uint16_t FORMAT_VERSION = 2;
+
+  /**
+   * @brief コンストラクタ
+   * @param path 保存先のファイルパス
+   */
+  explicit BinaryFileMachineStateRepository(std::string path);
+
+  /**
+   * @brief 状態を保存
+   * @throw std::runtime_error ファイルに書き込めない場合
+   */
+  void save(const domain::MachineState &state) override;
+
+  /**
+   * @brief 状態を読み込む
+   * @throw std::runtime_error 形式・版数・チェックサムが不正な場合
+   */
+  std::optional<domain::MachineState> load() const override;
+
+  /**
+   * @brief 保存先のファイルパスを取得
+   */
+  const std::string &getPath() const { return path_; }
+
+private:
+  std::string path_;
+  std::vector<char> buffer_; ///< 保存のたびに使い回すエンコード用バッファ
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_BINARY_FILE_MACHINE_STATE_HPP
@@ -0,0 +1,207 @@
+#include "FileEventStore.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+using binary_file_io::crc32;
+using binary_file_io::getLittleEndian;
+using binary_file_io::setLittleEndian;
+using binary_file_io::throwSystemError;
+using binary_file_io::writeAll;
+
+constexpr char MAGIC[4] = {'V', 'M', 'E', 'V'};
+constexpr std::size_t HEADER_SIZE = 8;
+constexpr std::size_t LENGTH_SIZE = 2;
+constexpr std::size_t CRC_SIZE = 4;
+/// 商品名を除くペイロードの長さ
+constexpr std::size_t FIXED_PAYLOAD_SIZE = 29;
+constexpr std::size_t MAX_PAYLOAD_SIZE =
+    std::numeric_limits<std::uint16_t>::max();
+
+std::size_t recordSize(std::size_t payload_size) {
+  return LENGTH_SIZE + payload_size + CRC_SIZE;
+}
+
+/**
+ * @brief offset から始まるレコードが完全で正しければそのペイロード長
+ * @return ペイロード長（不完全・不正な場合は 0）
+ */
+std::size_t validPayloadSize(const char *data, std::size_t available,
+                             std::uint64_t expected_sequence) {
+  if (available < LENGTH_SIZE) {
+    return 0;
+  }
+  std::size_t payload_size = getLittleEndian<std::uint16_t>(data);
+  if (payload_size < FIXED_PAYLOAD_SIZE ||
+      available < recordSize(payload_size)) {
+    return 0;
+  }
+  std::size_t crc_offset = LENGTH_SIZE + payload_size;
+  if (getLittleEndian<std::uint32_t>(data + crc_offset) !=
+      crc32(data, crc_offset)) {
+    return 0;
+  }
+  const char *payload = data + LENGTH_SIZE;
+  auto type = getLittleEndian<std::uint8_t>(payload + 16);
+  if (getLittleEndian<std::uint64_t>(payload) != expected_sequence ||
+      type > static_cast<std::uint8_t>(domain::DomainEventType::MODE_CHANGED)) {
+    return 0;
+  }
+  return payload_size;
+}
+
+domain::DomainEvent decodeEvent(const char *payload,
+                                std::size_t payload_size) {
+  domain::DomainEvent event;
+  event.sequence = getLittleEndian<std::uint64_t>(payload);
+  event.timestamp = std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(
+              getLittleEndian<std::int64_t>(payload + 8))));
+  event.type = static_cast<domain::DomainEventType>(
+      getLittleEndian<std::uint8_t>(payload + 16));
+  event.slot_id = getLittleEndian<std::int32_t>(payload + 17);
+  event.value = getLittleEndian<std::int32_t>(payload + 21);
+  event.price = getLittleEndian<std::int32_t>(payload + 25);
+  event.product_name = std::string_view(payload + FIXED_PAYLOAD_SIZE,
+                                        payload_size - FIXED_PAYLOAD_SIZE);
+  return event;
+}
+
+} // namespace
+
+FileEventStore::FileEventStore(std::string path, JournalSync sync)
+    : path_(std::move(path)), sync_(sync) {
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    throwSystemError("Failed to open event store", path_);
+  }
+
+  try {
+    std::vector<char> file = binary_file_io::readFile(fd_, path_);
+    if (file.size() < HEADER_SIZE) {
+      // 新規作成（またはヘッダの書き込み途中で停止したファイル）
+      char header[HEADER_SIZE] = {};
+      std::memcpy(header, MAGIC, sizeof(MAGIC));
+      setLittleEndian(header + 4, FORMAT_VERSION);
+      writeAll(fd_, header, HEADER_SIZE, 0, path_);
+      end_offset_ = HEADER_SIZE;
+      return;
+    }
+    if (std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        getLittleEndian<std::uint16_t>(file.data() + 4) != FORMAT_VERSION) {
+      throw std::runtime_error("Unsupported event store: " + path_);
+    }
+
+    std::size_t offset = HEADER_SIZE;
+    while (std::size_t payload_size =
+               validPayloadSize(file.data() + offset, file.size() - offset,
+                                last_sequence_ + 1)) {
+      if (last_sequence_ % INDEX_INTERVAL == 0) {
+        index_.push_back(offset);
+      }
+      ++last_sequence_;
+      offset += recordSize(payload_size);
+    }
+    end_offset_ = offset;
+    // 書き込み途中で停止した末尾を切り詰め、以降の追記を境界に揃える
+    if (file.size() != offset) {
+      binary_file_io::truncateFile(fd_, static_cast<off_t>(offset), sync_,
+                                   path_);
+    }
+  } catch (...) {
+    ::close(fd_);
+    throw;
+  }
+}
+
+FileEventStore::~FileEventStore() { ::close(fd_); }
+
+void FileEventStore::append(const domain::DomainEvent &event) {
+  if (event.sequence != last_sequence_ + 1) {
+    throw std::invalid_argument("Event sequence must follow " +
+                                std::to_string(last_sequence_));
+  }
+  std::size_t payload_size = FIXED_PAYLOAD_SIZE + event.product_name.size();
+  if (payload_size > MAX_PAYLOAD_SIZE) {
+    throw std::invalid_argument("Product name is too long for event store");
+  }
+
+  record_buffer_.resize(recordSize(payload_size));
+  char *out = record_buffer_.data();
+  setLittleEndian(out, static_cast<std::uint16_t>(payload_size));
+  char *payload = out + LENGTH_SIZE;
+  setLittleEndian(payload, event.sequence);
+  setLittleEndian(
+      payload + 8,
+      static_cast<std::int64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              event.timestamp.time_since_epoch())
+              .count()));
+  setLittleEndian(payload + 16, static_cast<std::uint8_t>(event.type));
+  setLittleEndian(payload + 17, std::int32_t{event.slot_id});
+  setLittleEndian(payload + 21, std::int32_t{event.value});
+  setLittleEndian(payload + 25, std::int32_t{event.price});
+  std::memcpy(payload + FIXED_PAYLOAD_SIZE, event.product_name.data(),
+              event.product_name.size());
+  std::size_t crc_offset = LENGTH_SIZE + payload_size;
+  setLittleEndian(out + crc_offset, crc32(out, crc_offset));
+
+  writeAll(fd_, out, record_buffer_.size(), static_cast<off_t>(end_offset_),
+           path_);
+  binary_file_io::syncData(fd_, sync_, path_);
+
+  if (last_sequence_ % INDEX_INTERVAL == 0) {
+    index_.push_back(end_offset_);
+  }
+  ++last_sequence_;
+  end_offset_ += record_buffer_.size();
+}
+
+void FileEventStore::forEach(std::uint64_t from, std::uint64_t to,
+                             const EventVisitor &visitor) const {
+  from = std::max<std::uint64_t>(from, 1);
+  to = std::min(to, last_sequence_);
+  if (from > to) {
+    return;
+  }
+
+  // from と to を含む区間の境界の位置から、その区間だけを読む
+  auto first_block = static_cast<std::size_t>((from - 1) / INDEX_INTERVAL);
+  auto end_block = static_cast<std::size_t>((to - 1) / INDEX_INTERVAL) + 1;
+  std::uint64_t begin = index_[first_block];
+  std::uint64_t end =
+      end_block < index_.size() ? index_[end_block] : end_offset_;
+  std::vector<char> buffer(static_cast<std::size_t>(end - begin));
+  if (binary_file_io::readAt(fd_, buffer.data(), buffer.size(),
+                             static_cast<off_t>(begin),
+                             path_) != buffer.size()) {
+    throw std::runtime_error("Event store is truncated: " + path_);
+  }
+
+  std::size_t offset = 0;
+  for (std::uint64_t sequence = first_block * INDEX_INTERVAL + 1;
+       sequence <= to; ++sequence) {
+    std::size_t payload_size = getLittleEndian<std::uint16_t>(
+        buffer.data() + offset);
+    if (sequence >= from) {
+      visitor(decodeEvent(buffer.data() + offset + LENGTH_SIZE,
+                          payload_size));
+    }
+    offset += recordSize(payload_size);
+  }
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,86 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_FILE_EVENT_STORE_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_FILE_EVENT_STORE_HPP
+
+#include "BinaryFileIo.hpp"
+#include "domain/repositories/IEventStore.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @class FileEventStore
+ * @brief ドメインイベントをファイルに追記する実装
+ *
+ * 形式（リトルエンディアン）:
+ * - ヘッダ 8 バイト: "VMEV"、版数(u16)、予約(u16)
+ * - レコード（可変長）: ペイロード長(u16)、ペイロード、
+ *   ペイロード長とペイロードの CRC-32(u32)
+ * - ペイロード: 通番(u64)、記録時刻(i64、UNIX エポックからのナノ秒)、
+ *   種類(u8)、スロットID・値・価格(各 i32)、商品名（残りのバイト）
+ *
+ * 枠組みは購入ジャーナル（FilePurchaseJournal）と同じで、追記は
+ * レコード1件につき write 1回です。開くときに CRC が合わないか通番が
+ * 連続しない末尾（書き込み途中で停止したもの）を切り詰めます。
+ *
+ * 一定件数ごとのレコードの位置をメモリに持ち、範囲の読み出しは
+ * その区間だけをファイルから読みます。
+ */
+class FileEventStore : public domain::IEventStore {
+public:
+  static constexpr std::uint16_t FORMAT_VERSION = 1;
+  /// 位置を覚えておく間隔（レコード数）
+  static constexpr std::size_t INDEX_INTERVAL = 256;
+
+  /**
+   * @brief コンストラクタ（ファイルが無ければ作成）
+   * @param path ファイルパス
+   * @param sync 追記ごとの同期
+   * @throw std::runtime_error 開けない場合、または形式・版数が異なる場合
+   */
+  explicit FileEventStore(std::string path,
+                          JournalSync sync = JournalSync::NONE);
+  ~FileEventStore() override;
+
+  FileEventStore(const FileEventStore &) = delete;
+  FileEventStore &operator=(const FileEventStore &) = delete;
+
+  /**
+   * @brief イベントを追記
+   * @throw std::invalid_argument 通番が連続していない場合、
+   *        または商品名が長すぎる場合
+   * @throw std::runtime_error 書き込めない場合
+   */
+  void append(const domain::DomainEvent &event) override;
+
+  std::uint64_t getLastSequence() const override { return last_sequence_; }
+
+  /**
+   * @brief 通番が [from, to] のイベントを通番順に読み出す
+   * @throw std::runtime_error 読み込めない場合
+   */
+  void forEach(std::uint64_t from, std::uint64_t to,
+               const EventVisitor &visitor) const override;
+
+  /**
+   * @brief ファイルパスを取得
+   */
+  const std::string &getPath() const { return path_; }
+
+private:
+  std::string path_;
+  int fd_ = -1;
+  JournalSync sync_;
+  std::uint64_t last_sequence_ = 0;
+  std::uint64_t end_offset_ = 0;      ///< 次のレコードを書く位置
+  std::vector<std::uint64_t> index_;  ///< 通番 1 + k × INDEX_INTERVAL の位置
+  std::vector<char> record_buffer_;   ///< 追記の符号化に使い回す
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_FILE_EVENT_STORE_HPP
@@ -0,0 +1,163 @@
+#include "FilePurchaseJournal.hpp"
+#include "BinaryFileIo.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <utility>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+using binary_file_io::crc32;
+using binary_file_io::getLittleEndian;
+using binary_file_io::setLittleEndian;
+using binary_file_io::throwSystemError;
+using binary_file_io::writeAll;
+
+constexpr char MAGIC[4] = {'V', 'M', 'P', 'J'};
+constexpr std::size_t HEADER_SIZE = 8;
+constexpr std::size_t CRC_OFFSET = 32;
+
+void encodeEntry(const domain::PurchaseJournalEntry &entry, char *out) {
+  std::memset(out, 0, FilePurchaseJournal::ENTRY_SIZE);
+  setLittleEndian(out, entry.purchase_id);
+  setLittleEndian(out + 4, static_cast<std::uint8_t>(entry.step));
+  setLittleEndian(out + 8, std::int32_t{entry.slot_id});
+  setLittleEndian(out + 12, std::int32_t{entry.price});
+  setLittleEndian(out + 16, std::int32_t{entry.stock_before});
+  setLittleEndian(out + 20, std::int32_t{entry.balance_before});
+  setLittleEndian(out + 24, std::int32_t{entry.change});
+  setLittleEndian(out + 28, std::int32_t{entry.session_id});
+  setLittleEndian(out + CRC_OFFSET, crc32(out, CRC_OFFSET));
+}
+
+bool isValidEntry(const char *in) {
+  auto stored_crc = getLittleEndian<std::uint32_t>(in + CRC_OFFSET);
+  if (stored_crc != crc32(in, CRC_OFFSET)) {
+    return false;
+  }
+  auto step = getLittleEndian<std::uint8_t>(in + 4);
+  return step >= static_cast<std::uint8_t>(domain::PurchaseStep::STARTED) &&
+         step <= static_cast<std::uint8_t>(domain::PurchaseStep::ABORTED);
+}
+
+domain::PurchaseJournalEntry decodeEntry(const char *in) {
+  return domain::PurchaseJournalEntry{
+      getLittleEndian<std::uint32_t>(in),
+      static_cast<domain::PurchaseStep>(getLittleEndian<std::uint8_t>(in + 4)),
+      getLittleEndian<std::int32_t>(in + 8),
+      getLittleEndian<std::int32_t>(in + 12),
+      getLittleEndian<std::int32_t>(in + 16),
+      getLittleEndian<std::int32_t>(in + 20),
+      getLittleEndian<std::int32_t>(in + 24),
+      getLittleEndian<std::int32_t>(in + 28)};
+}
+
+/**
+ * @brief 先頭から連続して正しいエントリの数
+ */
+std::size_t countValidEntries(const std::vector<char> &file) {
+  std::size_t count = 0;
+  for (std::size_t offset = HEADER_SIZE;
+       offset + FilePurchaseJournal::ENTRY_SIZE <= file.size();
+       offset += FilePurchaseJournal::ENTRY_SIZE) {
+    if (!isValidEntry(file.data() + offset)) {
+      break;
+    }
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+FilePurchaseJournal::FilePurchaseJournal(std::string path, JournalSync sync,
+                                         std::size_t compact_threshold)
+    : path_(std::move(path)), sync_(sync),
+      compact_threshold_(compact_threshold) {
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    throwSystemError("Failed to open purchase journal", path_);
+  }
+
+  try {
+    std::vector<char> file = readFile();
+    if (file.size() < HEADER_SIZE) {
+      // 新規作成（またはヘッダの書き込み途中で停止したファイル）
+      char header[HEADER_SIZE];
+      std::memcpy(header, MAGIC, sizeof(MAGIC));
+      setLittleEndian(header + 4, FORMAT_VERSION);
+      setLittleEndian(header + 6, static_cast<std::uint16_t>(ENTRY_SIZE));
+      writeAll(fd_, header, HEADER_SIZE, 0, path_);
+      return;
+    }
+    if (std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        getLittleEndian<std::uint16_t>(file.data() + 4) != FORMAT_VERSION ||
+        getLittleEndian<std::uint16_t>(file.data() + 6) != ENTRY_SIZE) {
+      throw std::runtime_error("Unsupported purchase journal: " + path_);
+    }
+    // 書き込み途中で停止した末尾を切り詰め、以降の追記を境界に揃える
+    entry_count_ = countValidEntries(file);
+    if (file.size() != HEADER_SIZE + entry_count_ * ENTRY_SIZE) {
+      truncateTo(entry_count_);
+    }
+    if (entry_count_ > 0) {
+      std::memcpy(last_entry_.data(),
+                  file.data() + HEADER_SIZE + (entry_count_ - 1) * ENTRY_SIZE,
+                  ENTRY_SIZE);
+    }
+  } catch (...) {
+    ::close(fd_);
+    throw;
+  }
+}
+
+FilePurchaseJournal::~FilePurchaseJournal() { ::close(fd_); }
+
+void FilePurchaseJournal::append(const domain::PurchaseJournalEntry &entry) {
+  char buffer[ENTRY_SIZE];
+  encodeEntry(entry, buffer);
+  writeAll(fd_, buffer, ENTRY_SIZE,
+           static_cast<off_t>(HEADER_SIZE + entry_count_ * ENTRY_SIZE), path_);
+  binary_file_io::syncData(fd_, sync_, path_);
+  std::memcpy(last_entry_.data(), buffer, ENTRY_SIZE);
+  ++entry_count_;
+}
+
+std::vector<domain::PurchaseJournalEntry> FilePurchaseJournal::readAll() const {
+  std::vector<char> file = readFile();
+  std::size_t count = file.size() < HEADER_SIZE ? 0 : countValidEntries(file);
+
+  std::vector<domain::PurchaseJournalEntry> entries;
+  entries.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    entries.push_back(decodeEntry(file.data() + HEADER_SIZE + i * ENTRY_SIZE));
+  }
+  return entries;
+}
+
+void FilePurchaseJournal::discardSettled() {
+  if (entry_count_ < compact_threshold_ || entry_count_ <= 1) {
+    return;
+  }
+  writeAll(fd_, last_entry_.data(), ENTRY_SIZE,
+           static_cast<off_t>(HEADER_SIZE), path_);
+  truncateTo(1);
+}
+
+std::vector<char> FilePurchaseJournal::readFile() const {
+  return binary_file_io::readFile(fd_, path_);
+}
+
+void FilePurchaseJournal::truncateTo(std::size_t entry_count) {
+  binary_file_io::truncateFile(
+      fd_, static_cast<off_t>(HEADER_SIZE + entry_count * ENTRY_SIZE), sync_,
+      path_);
+  entry_count_ = entry_count;
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,95 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_FILE_PURCHASE_JOURNAL_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_FILE_PURCHASE_JOURNAL_HPP
+
+#include "BinaryFileIo.hpp"
+#include "domain/repositories/IPurchaseJournal.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @class FilePurchaseJournal
+ * @brief 購入ジャーナルをファイルに追記する実装
+ *
+ * 形式（リトルエンディアン）:
+ * - ヘッダ 8 バイト: "VMPJ"、版数(u16)、エントリ長(u16)
+ * - エントリ 36 バイト（固定長）: 購入通番(u32)、手順(u8)、予約(3)、
+ *   スロットID・価格・開始時の在庫数・開始時の残高・お釣り・
+ *   セッションID(各 i32)、先頭 32 バイトの CRC-32(u32)
+ *
+ * 追記はエントリ1件につき write 1回で、メモリは確保しません。
+ * 読み出しは CRC が合わないエントリ（書き込み途中で停止した末尾）の
+ * 手前で止めます。開くときにそのような末尾は切り詰めます。
+ *
+ * 決着の通知（discardSettled）を受けたとき、エントリ数が
+ * しきい値以上であれば最後のエントリだけを残して切り詰めます。
+ * 最後のエントリを先頭へ書いてから切り詰めるため、途中で停止しても
+ * 決着済みのエントリが残るだけです。
+ */
+class FilePurchaseJournal : public domain::IPurchaseJournal {
+public:
+  static constexpr std::uint16_t FORMAT_VERSION = 2;
+  static constexpr std::size_t ENTRY_SIZE = 36;
+  /// 既定の切り詰めのしきい値（エントリ数）
+  static constexpr std::size_t DEFAULT_COMPACT_THRESHOLD = 1024;
+
+  /**
+   * @brief コンストラクタ（ファイルが無ければ作成）
+   * @param path ジャーナルのファイルパス
+   * @param sync 追記ごとの同期
+   * @param compact_threshold 切り詰めるエントリ数のしきい値
+   * @throw std::runtime_error 開けない場合、または形式・版数が異なる場合
+   */
+  explicit FilePurchaseJournal(
+      std::string path, JournalSync sync = JournalSync::NONE,
+      std::size_t compact_threshold = DEFAULT_COMPACT_THRESHOLD);
+  ~FilePurchaseJournal() override;
+
+  FilePurchaseJournal(const FilePurchaseJournal &) = delete;
+  FilePurchaseJournal &operator=(const FilePurchaseJournal &) = delete;
+
+  /**
+   * @brief エントリを追記
+   * @throw std::runtime_error 書き込めない場合
+   */
+  void append(const domain::PurchaseJournalEntry &entry) override;
+
+  /**
+   * @brief 記録済みのエントリを読み出す
+   * @throw std::runtime_error 読み込めない場合
+   */
+  std::vector<domain::PurchaseJournalEntry> readAll() const override;
+
+  void discardSettled() override;
+
+  /**
+   * @brief 記録済みのエントリ数
+   */
+  std::size_t getEntryCount() const { return entry_count_; }
+
+  /**
+   * @brief ジャーナルのファイルパスを取得
+   */
+  const std::string &getPath() const { return path_; }
+
+private:
+  std::string path_;
+  int fd_ = -1;
+  JournalSync sync_;
+  std::size_t compact_threshold_;
+  std::size_t entry_count_ = 0;
+  std::array<char, ENTRY_SIZE> last_entry_{}; ///< 切り詰めで残すエントリ
+
+  std::vector<char> readFile() const;
+  void truncateTo(std::size_t entry_count);
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_FILE_PURCHASE_JOURNAL_HPP
@@ -1,19 +1,61 @@
 #include "InMemoryTransactionHistoryRepository.hpp"
+#include "domain/common/RevenueAccumulator.hpp"
 #include <algorithm>
-#include <numeric>
+#include <new>
 
 namespace vending_machine {
 namespace interface_adapters {
 
+domain::TransactionRecord *
+InMemoryTransactionHistoryRepository::Block::records() {
+  return std::launder(reinterpret_cast<domain::TransactionRecord *>(storage));
+}
+
+const domain::TransactionRecord *
+InMemoryTransactionHistoryRepository::Block::records() const {
+  return std::launder(
+      reinterpret_cast<const domain::TransactionRecord *>(storage));
+}
+
+InMemoryTransactionHistoryRepository::~InMemoryTransactionHistoryRepository() {
+  destroyRecords();
+  // 長いリストでも再帰的な解放にならないよう、先頭から1個ずつ外す
+  while (head_) {
+    head_ = std::move(head_->next);
+  }
+}
+
 void InMemoryTransactionHistoryRepository::save(
     const domain::TransactionRecord &record) {
-  records_.push_back(record);
+  if (!tail_) {
+    if (!head_) {
+      head_.reset(new Block);
+    }
+    tail_ = head_.get();
+    tail_size_ = 0;
+  } else if (tail_size_ == RECORDS_PER_BLOCK) {
+    if (!tail_->next) {
+      // 領域を初期化しないよう make_unique（値初期化）は使わない
+      tail_->next.reset(new Block);
+    }
+    tail_ = tail_->next.get();
+    tail_size_ = 0;
+  }
+  new (tail_->records() + tail_size_)
+      domain::TransactionRecord(record.withSequence(next_sequence_++));
+  ++tail_size_;
+  ++size_;
+  ++generation_;
 }
 
 std::vector<domain::TransactionRecord>
 InMemoryTransactionHistoryRepository::getAll() const {
+  std::vector<domain::TransactionRecord> sorted_records;
+  sorted_records.reserve(size_);
+  forEach([&sorted_records](const domain::TransactionRecord &record) {
+    sorted_records.push_back(record);
+  });
   // タイムスタンプの降順でソート
-  auto sorted_records = records_;
   std::sort(sorted_records.begin(), sorted_records.end(),
             [](const domain::TransactionRecord &a,
                const domain::TransactionRecord &b) {
@@ -26,10 +68,11 @@ std::vector<domain::TransactionRecord>
 InMemoryTransactionHistoryRepository::getBySlotId(
     const domain::SlotId &slot_id) const {
   std::vector<domain::TransactionRecord> result;
-  std::copy_if(records_.begin(), records_.end(), std::back_inserter(result),
-               [&slot_id](const domain::TransactionRecord &record) {
-                 return record.getSlotId() == slot_id;
-               });
+  forEach([&result, &slot_id](const domain::TransactionRecord &record) {
+    if (record.getSlotId() == slot_id) {
+      result.push_back(record);
+    }
+  });
   // タイムスタンプの降順でソート
   std::sort(result.begin(), result.end(),
             [](const domain::TransactionRecord &a,
@@ -39,16 +82,75 @@ InMemoryTransactionHistoryRepository::getBySlotId(
   return result;
 }
 
-domain::Money InMemoryTransactionHistoryRepository::getTotalRevenue() const {
-  int total =
-      std::accumulate(records_.begin(), records_.end(), 0,
-                      [](int sum, const domain::TransactionRecord &record) {
-                        return sum + record.getPrice().getRawValue();
-                      });
-  return domain::Money(total);
+domain::Revenue InMemoryTransactionHistoryRepository::getTotalRevenue() const {
+  domain::RevenueAccumulator total;
+  forEach([&total](const domain::TransactionRecord &record) {
+    total.add(record.getPrice());
+  });
+  return total.getTotal();
+}
+
+void InMemoryTransactionHistoryRepository::forEach(
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  visitRange(0, size_, visitor);
 }
 
-void InMemoryTransactionHistoryRepository::clear() { records_.clear(); }
+void InMemoryTransactionHistoryRepository::forEachInPartition(
+    std::size_t partition, std::size_t partition_count,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  // 保存順の連続した範囲に分ける（範囲の端は件数に比例させる）
+  std::size_t begin = size_ * partition / partition_count;
+  std::size_t end = size_ * (partition + 1) / partition_count;
+  visitRange(begin, end, visitor);
+}
+
+std::uint64_t InMemoryTransactionHistoryRepository::getGeneration() const {
+  return generation_;
+}
+
+void InMemoryTransactionHistoryRepository::clear() {
+  destroyRecords();
+  ++generation_;
+}
+
+void InMemoryTransactionHistoryRepository::visitRange(
+    std::size_t begin, std::size_t end,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  // 範囲の先頭を含むブロックまでリストをたどる
+  const Block *block = head_.get();
+  std::size_t block_begin = 0;
+  while (block && block_begin + RECORDS_PER_BLOCK <= begin) {
+    block = block->next.get();
+    block_begin += RECORDS_PER_BLOCK;
+  }
+  for (std::size_t index = begin; block && index < end;
+       block = block->next.get(), block_begin += RECORDS_PER_BLOCK) {
+    std::size_t block_end = std::min(end, block_begin + RECORDS_PER_BLOCK);
+    const domain::TransactionRecord *records = block->records();
+    for (; index < block_end; ++index) {
+      visitor(records[index - block_begin]);
+    }
+  }
+}
+
+void InMemoryTransactionHistoryRepository::destroyRecords() {
+  std::size_t remaining = size_;
+  for (Block *block = head_.get(); block && remaining > 0;
+       block = block->next.get()) {
+    std::size_t count = std::min(remaining, RECORDS_PER_BLOCK);
+    for (std::size_t i = 0; i < count; ++i) {
+      block->records()[i].~TransactionRecord();
+    }
+    remaining -= count;
+  }
+  // ブロックは解放せず、次の保存から先頭のブロックを再利用する
+  tail_ = nullptr;
+  tail_size_ = 0;
+  size_ = 0;
+}
 
 } // namespace interface_adapters
 } // namespace vending_machine
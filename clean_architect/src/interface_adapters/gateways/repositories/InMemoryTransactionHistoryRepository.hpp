@@ -2,6 +2,9 @@
 #define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_INMEMORY_INMEMORY_TRANSACTION_HISTORY_HPP
 
 #include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace vending_machine {
@@ -11,8 +14,13 @@ namespace interface_adapters {
  * @class InMemoryTransactionHistoryRepository
  * @brief トランザクション履歴のメモリ内実装
  *
- * すべてのトランザクションをメモリ（std::vector）に保持します。
+ * すべてのトランザクションをメモリに保持します。
  * アプリケーション実行中のみ有効です。
+ *
+ * レコードは固定サイズのブロックを連結したリストに保存順に積みます。
+ * 容量を超えても既存のレコードを再配置・コピーしないため、保存は件数に
+ * よらず最悪でも O(1)（ブロック1個の確保）で、レコードのアドレスは
+ * clear() まで変わりません。clear() 後もブロックは解放せずに再利用します。
  */
 class InMemoryTransactionHistoryRepository
     : public domain::ITransactionHistoryRepository {
@@ -22,6 +30,16 @@ public:
    */
   InMemoryTransactionHistoryRepository() = default;
 
+  /**
+   * @brief デストラクタ（保存したレコードとブロックを解放）
+   */
+  ~InMemoryTransactionHistoryRepository() override;
+
+  InMemoryTransactionHistoryRepository(
+      const InMemoryTransactionHistoryRepository &) = delete;
+  InMemoryTransactionHistoryRepository &
+  operator=(const InMemoryTransactionHistoryRepository &) = delete;
+
   /**
    * @brief トランザクションを保存
    */
@@ -41,15 +59,61 @@ public:
   /**
    * @brief 売上集計
    */
-  domain::Money getTotalRevenue() const override;
+  domain::Revenue getTotalRevenue() const override;
+
+  /**
+   * @brief 全件走査（保存順、コピーなし）
+   */
+  void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief パーティション単位の走査（保存順の連続範囲、コピーなし）
+   */
+  void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief 履歴の世代番号を取得
+   */
+  std::uint64_t getGeneration() const override;
 
   /**
    * @brief 履歴をクリア
    */
   void clear() override;
 
+  /// ブロック1個あたりのレコード数
+  static constexpr std::size_t RECORDS_PER_BLOCK = 256;
+
 private:
-  std::vector<domain::TransactionRecord> records_;
+  /// レコードを RECORDS_PER_BLOCK 件ずつ格納するブロック（未構築の領域）
+  struct Block {
+    alignas(domain::TransactionRecord) unsigned char
+        storage[RECORDS_PER_BLOCK * sizeof(domain::TransactionRecord)];
+    std::unique_ptr<Block> next;
+
+    domain::TransactionRecord *records();
+    const domain::TransactionRecord *records() const;
+  };
+
+  // 保存順で [begin, end) の範囲のレコードを走査する
+  void visitRange(
+      std::size_t begin, std::size_t end,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const;
+  void destroyRecords();
+
+  // 先頭ブロックから連結したリスト。tail_ 以降は clear() 後の再利用待ち
+  std::unique_ptr<Block> head_;
+  Block *tail_ = nullptr;     ///< 追記中のブロック
+  std::size_t tail_size_ = 0; ///< 追記中のブロックのレコード数
+  std::size_t size_ = 0;
+  std::uint64_t next_sequence_ = 1; ///< clear() でも戻さない
+  std::uint64_t generation_ = 0;
 };
 
 } // namespace interface_adapters
@@ -0,0 +1,64 @@
+#include "NotifyingTransactionHistoryRepository.hpp"
+
+namespace vending_machine {
+namespace interface_adapters {
+
+NotifyingTransactionHistoryRepository::NotifyingTransactionHistoryRepository(
+    domain::ITransactionHistoryRepository &inner)
+    : inner_(inner) {}
+
+void NotifyingTransactionHistoryRepository::addListener(
+    domain::ITransactionListener &listener) {
+  listeners_.push_back(&listener);
+}
+
+void NotifyingTransactionHistoryRepository::save(
+    const domain::TransactionRecord &record) {
+  inner_.save(record);
+  for (auto *listener : listeners_) {
+    listener->onTransactionSaved(record);
+  }
+}
+
+std::vector<domain::TransactionRecord>
+NotifyingTransactionHistoryRepository::getAll() const {
+  return inner_.getAll();
+}
+
+std::vector<domain::TransactionRecord>
+NotifyingTransactionHistoryRepository::getBySlotId(
+    const domain::SlotId &slot_id) const {
+  return inner_.getBySlotId(slot_id);
+}
+
+domain::Revenue NotifyingTransactionHistoryRepository::getTotalRevenue() const {
+  return inner_.getTotalRevenue();
+}
+
+void NotifyingTransactionHistoryRepository::forEachRollup(
+    const std::function<void(const domain::TransactionRollup &)> &visitor)
+    const {
+  inner_.forEachRollup(visitor);
+}
+
+void NotifyingTransactionHistoryRepository::forEach(
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  inner_.forEach(visitor);
+}
+
+void NotifyingTransactionHistoryRepository::forEachInPartition(
+    std::size_t partition, std::size_t partition_count,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  inner_.forEachInPartition(partition, partition_count, visitor);
+}
+
+std::uint64_t NotifyingTransactionHistoryRepository::getGeneration() const {
+  return inner_.getGeneration();
+}
+
+void NotifyingTransactionHistoryRepository::clear() { inner_.clear(); }
+
+} // namespace interface_adapters
+} // namespace vending_machine
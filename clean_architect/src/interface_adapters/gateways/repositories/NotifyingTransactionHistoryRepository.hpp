@@ -0,0 +1,101 @@
+#ifndef VENDING_MACHINE_INTERFACE_ADAPTERS_REPOSITORIES_NOTIFYING_TRANSACTION_HISTORY_HPP
+#define VENDING_MACHINE_INTERFACE_ADAPTERS_REPOSITORIES_NOTIFYING_TRANSACTION_HISTORY_HPP
+
+#include "domain/interfaces/ITransactionListener.hpp"
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @class NotifyingTransactionHistoryRepository
+ * @brief 保存のたびにリスナーへ通知するリポジトリ（デコレータ）
+ *
+ * 実際の保存は内側のリポジトリに委譲し、保存に成功した取引を
+ * 登録済みのリスナー（時間帯別集計、スケッチなど）へ登録順に通知します。
+ * ユースケースからは通常のリポジトリと同じように扱えます。
+ *
+ * clear() は内側の履歴のみを消去し、リスナー側の集計は残します
+ * （現金回収後も過去の販売傾向を補充計画に使えるようにするため）。
+ */
+class NotifyingTransactionHistoryRepository
+    : public domain::ITransactionHistoryRepository {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param inner 委譲先のリポジトリ
+   */
+  explicit NotifyingTransactionHistoryRepository(
+      domain::ITransactionHistoryRepository &inner);
+
+  /**
+   * @brief リスナーを登録
+   * @param listener 保存のたびに通知するリスナー（本オブジェクトより長く
+   *                 生存すること）
+   */
+  void addListener(domain::ITransactionListener &listener);
+
+  /**
+   * @brief トランザクションを保存し、リスナーへ通知
+   */
+  void save(const domain::TransactionRecord &record) override;
+
+  /**
+   * @brief すべてのトランザクション履歴を取得
+   */
+  std::vector<domain::TransactionRecord> getAll() const override;
+
+  /**
+   * @brief 指定スロットのトランザクション履歴を取得
+   */
+  std::vector<domain::TransactionRecord>
+  getBySlotId(const domain::SlotId &slot_id) const override;
+
+  /**
+   * @brief 売上集計
+   */
+  domain::Revenue getTotalRevenue() const override;
+
+  /**
+   * @brief 集計値の走査（内側のリポジトリに委譲）
+   */
+  void forEachRollup(
+      const std::function<void(const domain::TransactionRollup &)> &visitor)
+      const override;
+
+  /**
+   * @brief 全件走査
+   */
+  void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief パーティション単位の走査
+   */
+  void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief 履歴の世代番号を取得
+   */
+  std::uint64_t getGeneration() const override;
+
+  /**
+   * @brief 履歴をクリア（リスナー側の集計は残す）
+   */
+  void clear() override;
+
+private:
+  domain::ITransactionHistoryRepository &inner_;
+  std::vector<domain::ITransactionListener *> listeners_;
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INTERFACE_ADAPTERS_REPOSITORIES_NOTIFYING_TRANSACTION_HISTORY_HPP
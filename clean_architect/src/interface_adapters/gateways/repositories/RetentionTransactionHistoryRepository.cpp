@@ -0,0 +1,214 @@
+#include "RetentionTransactionHistoryRepository.hpp"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+/// 決済方法の数（PaymentMethodType の列挙子の数）
+constexpr std::size_t PAYMENT_METHOD_COUNT = 2;
+
+constexpr domain::PaymentMethodType PAYMENT_METHODS[PAYMENT_METHOD_COUNT] = {
+    domain::PaymentMethodType::CASH, domain::PaymentMethodType::EMONEY};
+
+void sortByTimestampDescending(
+    std::vector<domain::TransactionRecord> &records) {
+  std::sort(records.begin(), records.end(),
+            [](const domain::TransactionRecord &a,
+               const domain::TransactionRecord &b) {
+              return a.getTimestamp() > b.getTimestamp();
+            });
+}
+
+} // namespace
+
+RetentionTransactionHistoryRepository::RetentionTransactionHistoryRepository(
+    const RetentionPolicy &policy)
+    : policy_(policy) {
+  if (policy_.max_records == 0) {
+    throw std::invalid_argument("max_records must be positive");
+  }
+  records_.reserve(policy_.max_records);
+}
+
+void RetentionTransactionHistoryRepository::save(
+    const domain::TransactionRecord &record) {
+  push(record.withSequence(next_sequence_++));
+  if (policy_.max_age != std::chrono::system_clock::duration::zero()) {
+    // 最新のレコードを基準に、保持期間を過ぎたレコードを畳み込む
+    evictOlderThan(record.getTimestamp() - policy_.max_age);
+  }
+  ++generation_;
+}
+
+std::vector<domain::TransactionRecord>
+RetentionTransactionHistoryRepository::getAll() const {
+  std::vector<domain::TransactionRecord> result;
+  result.reserve(size_);
+  for (std::size_t i = 0; i < size_; ++i) {
+    result.push_back(at(i));
+  }
+  sortByTimestampDescending(result);
+  return result;
+}
+
+std::vector<domain::TransactionRecord>
+RetentionTransactionHistoryRepository::getBySlotId(
+    const domain::SlotId &slot_id) const {
+  std::vector<domain::TransactionRecord> result;
+  for (std::size_t i = 0; i < size_; ++i) {
+    if (at(i).getSlotId() == slot_id) {
+      result.push_back(at(i));
+    }
+  }
+  sortByTimestampDescending(result);
+  return result;
+}
+
+domain::Revenue RetentionTransactionHistoryRepository::getTotalRevenue() const {
+  domain::RevenueAccumulator total = folded_revenue_;
+  for (std::size_t i = 0; i < size_; ++i) {
+    total.add(at(i).getPrice());
+  }
+  return total.getTotal();
+}
+
+void RetentionTransactionHistoryRepository::forEachRollup(
+    const std::function<void(const domain::TransactionRollup &)> &visitor)
+    const {
+  std::vector<const SlotRollup *> sorted;
+  sorted.reserve(rollups_.size());
+  for (const auto &rollup : rollups_) {
+    sorted.push_back(&rollup);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const SlotRollup *a, const SlotRollup *b) {
+              return a->slot_id < b->slot_id;
+            });
+  for (const SlotRollup *rollup : sorted) {
+    for (std::size_t method = 0; method < PAYMENT_METHOD_COUNT; ++method) {
+      const auto &cell = rollup->cells[method];
+      if (cell.count == 0) {
+        continue;
+      }
+      visitor(domain::TransactionRollup{domain::SlotId(rollup->slot_id),
+                                        PAYMENT_METHODS[method], cell.count,
+                                        cell.revenue.getTotal()});
+    }
+  }
+}
+
+void RetentionTransactionHistoryRepository::forEach(
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  for (std::size_t i = 0; i < size_; ++i) {
+    visitor(at(i));
+  }
+}
+
+void RetentionTransactionHistoryRepository::forEachInPartition(
+    std::size_t partition, std::size_t partition_count,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  // 保存順の連続した範囲に分ける（範囲の端は件数に比例させる）
+  std::size_t begin = size_ * partition / partition_count;
+  std::size_t end = size_ * (partition + 1) / partition_count;
+  for (std::size_t i = begin; i < end; ++i) {
+    visitor(at(i));
+  }
+}
+
+std::uint64_t RetentionTransactionHistoryRepository::getGeneration() const {
+  return generation_;
+}
+
+void RetentionTransactionHistoryRepository::clear() {
+  records_.clear();
+  head_ = 0;
+  size_ = 0;
+  rollups_.clear();
+  rollup_index_.clear();
+  folded_revenue_ = domain::RevenueAccumulator();
+  folded_count_ = 0;
+  ++generation_;
+}
+
+std::size_t RetentionTransactionHistoryRepository::enforce(
+    std::chrono::system_clock::time_point now) {
+  if (policy_.max_age == std::chrono::system_clock::duration::zero()) {
+    return 0;
+  }
+  std::size_t evicted = evictOlderThan(now - policy_.max_age);
+  if (evicted > 0) {
+    ++generation_;
+  }
+  return evicted;
+}
+
+std::size_t RetentionTransactionHistoryRepository::getRetainedCount() const {
+  return size_;
+}
+
+std::uint64_t RetentionTransactionHistoryRepository::getFoldedCount() const {
+  return folded_count_;
+}
+
+const domain::TransactionRecord &
+RetentionTransactionHistoryRepository::at(std::size_t index) const {
+  return records_[(head_ + index) % records_.size()];
+}
+
+void RetentionTransactionHistoryRepository::push(
+    const domain::TransactionRecord &record) {
+  if (size_ == policy_.max_records) {
+    foldOldest();
+  }
+  if (size_ < records_.size()) {
+    // 空いた位置（最新の次）を上書きする
+    records_[(head_ + size_) % records_.size()] = record;
+  } else {
+    // 容量まで埋まっていないバッファを伸ばす。先頭が途中にある場合は
+    // 末尾に追加できるよう並べ直す（容量に達するまでの間だけ起こる）
+    std::rotate(records_.begin(),
+                records_.begin() + static_cast<std::ptrdiff_t>(head_),
+                records_.end());
+    head_ = 0;
+    records_.push_back(record);
+  }
+  ++size_;
+}
+
+void RetentionTransactionHistoryRepository::foldOldest() {
+  const auto &record = records_[head_];
+  int slot_id = record.getSlotId().getValue();
+  auto [it, inserted] = rollup_index_.try_emplace(slot_id, rollups_.size());
+  if (inserted) {
+    rollups_.push_back(SlotRollup{slot_id, {}});
+  }
+  auto &cell = rollups_[it->second]
+                   .cells[static_cast<std::size_t>(record.getPaymentMethod())];
+  ++cell.count;
+  cell.revenue.add(record.getPrice());
+  folded_revenue_.add(record.getPrice());
+  ++folded_count_;
+
+  head_ = (head_ + 1) % records_.size();
+  --size_;
+}
+
+std::size_t RetentionTransactionHistoryRepository::evictOlderThan(
+    std::chrono::system_clock::time_point threshold) {
+  // 保存順に古いものから見て、保持期間内のレコードに達したら止める
+  std::size_t evicted = 0;
+  while (size_ > 0 && at(0).getTimestamp() < threshold) {
+    foldOldest();
+    ++evicted;
+  }
+  return evicted;
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,159 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_RETENTION_TRANSACTION_HISTORY_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_RETENTION_TRANSACTION_HISTORY_HPP
+
+#include "domain/common/RevenueAccumulator.hpp"
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @struct RetentionPolicy
+ * @brief 個別のレコードを保持する範囲
+ */
+struct RetentionPolicy {
+  /// 保持するレコード数の上限（1以上）
+  std::size_t max_records;
+  /// 最新のレコードからさかのぼって保持する期間（0 は期間で制限しない）
+  std::chrono::system_clock::duration max_age{};
+};
+
+/**
+ * @class RetentionTransactionHistoryRepository
+ * @brief 保持範囲を過ぎたレコードを集計値に畳み込むメモリ内実装
+ *
+ * 直近のレコードを固定容量のリングバッファに保持します。上限件数を超えた
+ * レコードや保持期間を過ぎたレコードは、保存順の古いものから
+ * （スロット, 決済方法）ごとの集計値に畳み込んでから破棄します。
+ * 集計値はスロット数程度の大きさのため、使用メモリは上限件数で決まります。
+ *
+ * getTotalRevenue() と forEachRollup() は破棄したレコードを含むため、
+ * 売上合計やレポートは境界をまたいでも正確です。getAll() と
+ * getBySlotId()、forEach() は保持しているレコードのみを返します。
+ */
+class RetentionTransactionHistoryRepository
+    : public domain::ITransactionHistoryRepository {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param policy 保持範囲
+   * @throws std::invalid_argument 上限件数が0の場合
+   */
+  explicit RetentionTransactionHistoryRepository(const RetentionPolicy &policy);
+
+  /**
+   * @brief トランザクションを保存（保持範囲を過ぎたレコードは畳み込む）
+   */
+  void save(const domain::TransactionRecord &record) override;
+
+  /**
+   * @brief 保持しているトランザクション履歴を取得
+   */
+  std::vector<domain::TransactionRecord> getAll() const override;
+
+  /**
+   * @brief 保持している指定スロットのトランザクション履歴を取得
+   */
+  std::vector<domain::TransactionRecord>
+  getBySlotId(const domain::SlotId &slot_id) const override;
+
+  /**
+   * @brief 売上集計（畳み込んだ取引を含む）
+   */
+  domain::Revenue getTotalRevenue() const override;
+
+  /**
+   * @brief 畳み込んだ取引の集計値を走査（スロット, 決済方法の昇順）
+   */
+  void forEachRollup(
+      const std::function<void(const domain::TransactionRollup &)> &visitor)
+      const override;
+
+  /**
+   * @brief 保持しているレコードの全件走査（保存順、コピーなし）
+   */
+  void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief パーティション単位の走査（保存順の連続範囲、コピーなし）
+   */
+  void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief 履歴の世代番号を取得
+   */
+  std::uint64_t getGeneration() const override;
+
+  /**
+   * @brief 履歴をクリア（集計値も破棄）
+   */
+  void clear() override;
+
+  /**
+   * @brief 指定時刻を基準に保持期間を過ぎたレコードを畳み込む
+   *
+   * 取引の無い時間帯にも古いレコードを手放すために、定期的に呼び出します。
+   * 保持期間が0の場合は何もしません。
+   *
+   * @param now 基準時刻
+   * @return 畳み込んだレコード数
+   */
+  std::size_t enforce(std::chrono::system_clock::time_point now);
+
+  /**
+   * @brief 保持しているレコード数を取得
+   */
+  std::size_t getRetainedCount() const;
+
+  /**
+   * @brief 畳み込んだレコード数を取得
+   */
+  std::uint64_t getFoldedCount() const;
+
+private:
+  /// 1つの（スロット, 決済方法）の集計値
+  struct RollupCell {
+    std::int64_t count = 0;
+    domain::RevenueAccumulator revenue;
+  };
+
+  /// 1つのスロットの決済方法ごとの集計値
+  struct SlotRollup {
+    int slot_id;
+    RollupCell cells[2]; ///< PaymentMethodType の値を添字にする
+  };
+
+  const domain::TransactionRecord &at(std::size_t index) const;
+  void push(const domain::TransactionRecord &record);
+  void foldOldest();
+  std::size_t
+  evictOlderThan(std::chrono::system_clock::time_point threshold);
+
+  RetentionPolicy policy_;
+  // 保存順のリングバッファ（head_ が最古、size_ 件が有効）
+  std::vector<domain::TransactionRecord> records_;
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+  // スロットごとの集計値（初めて畳み込んだ順）と、スロットIDからの添字
+  std::vector<SlotRollup> rollups_;
+  std::unordered_map<int, std::size_t> rollup_index_;
+  domain::RevenueAccumulator folded_revenue_;
+  std::uint64_t folded_count_ = 0;
+  std::uint64_t next_sequence_ = 1; ///< clear() でも戻さない
+  std::uint64_t generation_ = 0;
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_RETENTION_TRANSACTION_HISTORY_HPP
@@ -0,0 +1,967 @@
+#include "TieredTransactionHistoryRepository.hpp"
+#include "domain/common/RevenueAccumulator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+constexpr char SEGMENT_MAGIC[4] = {'V', 'M', 'T', 'S'};
+constexpr char FOOTER_MAGIC[4] = {'V', 'M', 'T', 'F'};
+constexpr std::size_t HEADER_SIZE = 8;
+constexpr std::size_t FOOTER_SIZE = 64;
+/// フッタのうちチェックサムより前の値の長さ（チェックサムの対象に含める）
+constexpr std::size_t FOOTER_FIELDS_SIZE = 52;
+constexpr const char *SEGMENT_PREFIX = "segment-";
+constexpr const char *SEGMENT_SUFFIX = ".vmts";
+constexpr char LOG_MAGIC[4] = {'V', 'M', 'T', 'L'};
+constexpr std::uint16_t LOG_VERSION = 2;
+constexpr std::size_t LOG_HEADER_SIZE = 24;
+constexpr std::size_t LOG_ENTRY_SIZE = 40;
+constexpr const char *MEMTABLE_LOG_NAME = "memtable.log";
+
+using Clock = std::chrono::system_clock;
+
+std::uint32_t fnv1a(const char *data, std::size_t size) {
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<std::uint8_t>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template <typename T> void putLittleEndian(std::vector<char> &out, T value) {
+  auto bits = static_cast<std::uint64_t>(value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+template <typename T> void setLittleEndian(char *out, T value) {
+  auto bits = static_cast<std::uint64_t>(value);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    out[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+  }
+}
+
+template <typename T> T getLittleEndian(const char *in) {
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    bits |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in[i]))
+            << (8 * i);
+  }
+  return static_cast<T>(bits);
+}
+
+// 符号付き整数を、絶対値の小さいものほど短くなる符号なし整数に写す
+std::uint64_t zigzag(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+void putVarint(std::vector<char> &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+[[noreturn]] void throwCorrupt(const std::string &path) {
+  throw std::runtime_error("Corrupt transaction segment: " + path);
+}
+
+/**
+ * @brief 範囲検査つきで可変長整数・固定長の値を読み出す
+ */
+class Reader {
+public:
+  Reader(const char *data, std::size_t size, const std::string &path)
+      : data_(data), size_(size), path_(path) {}
+
+  std::uint64_t getVarint() {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      auto byte = static_cast<std::uint8_t>(*take(1));
+      value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throwCorrupt(path_);
+  }
+
+  std::int64_t getSignedVarint() { return unzigzag(getVarint()); }
+
+  template <typename T> T get() {
+    return getLittleEndian<T>(take(sizeof(T)));
+  }
+
+  const char *take(std::size_t size) {
+    if (size > size_ - offset_) {
+      throwCorrupt(path_);
+    }
+    const char *bytes = data_ + offset_;
+    offset_ += size;
+    return bytes;
+  }
+
+  /// 長さ付きの列を切り出す
+  Reader column() {
+    auto size = get<std::uint32_t>();
+    return Reader(take(size), size, path_);
+  }
+
+  bool atEnd() const { return offset_ == size_; }
+
+private:
+  const char *data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+  const std::string &path_;
+};
+
+/**
+ * @brief セグメントの列（レコード順）
+ */
+struct SegmentColumns {
+  std::vector<int> sales_ids;
+  std::vector<int> slot_ids;
+  std::vector<int> prices;
+  std::vector<int> payment_methods;
+  std::vector<std::int64_t> timestamps;
+  std::vector<std::int64_t> sequences;
+  std::vector<int> session_ids; ///< 0 は記録なし
+
+  std::size_t size() const { return slot_ids.size(); }
+
+  domain::TransactionRecord record(std::size_t i) const {
+    auto record =
+        domain::TransactionRecord(
+            domain::SalesId(sales_ids[i]), domain::SlotId(slot_ids[i]),
+            domain::Price(prices[i]),
+            static_cast<domain::PaymentMethodType>(payment_methods[i]),
+            Clock::time_point(Clock::duration(timestamps[i])))
+            .withSequence(static_cast<std::uint64_t>(sequences[i]));
+    if (session_ids[i] != 0) {
+      record = record.withSessionId(domain::SessionId(session_ids[i]));
+    }
+    return record;
+  }
+};
+
+// ランレングス: (値, 連続数) の組
+template <typename T>
+void encodeRunLength(const std::vector<T> &values, std::vector<char> &out) {
+  for (std::size_t i = 0; i < values.size();) {
+    std::size_t run = 1;
+    while (i + run < values.size() && values[i + run] == values[i]) {
+      ++run;
+    }
+    putVarint(out, zigzag(values[i]));
+    putVarint(out, run);
+    i += run;
+  }
+}
+
+template <typename T>
+void decodeRunLength(Reader reader, std::size_t count, std::vector<T> &out,
+                     const std::string &path) {
+  out.clear();
+  out.reserve(count);
+  while (out.size() < count) {
+    auto value = static_cast<T>(reader.getSignedVarint());
+    auto run = reader.getVarint();
+    if (run == 0 || run > count - out.size()) {
+      throwCorrupt(path);
+    }
+    out.insert(out.end(), static_cast<std::size_t>(run), value);
+  }
+  if (!reader.atEnd()) {
+    throwCorrupt(path);
+  }
+}
+
+// 辞書: 異なる値の一覧と、各レコードの値の番号（必要最小のビット幅で詰める）
+void encodeDictionary(const std::vector<int> &values, std::vector<char> &out) {
+  std::vector<int> dictionary;
+  std::vector<std::uint32_t> codes;
+  codes.reserve(values.size());
+  for (int value : values) {
+    auto it = std::find(dictionary.begin(), dictionary.end(), value);
+    codes.push_back(static_cast<std::uint32_t>(it - dictionary.begin()));
+    if (it == dictionary.end()) {
+      dictionary.push_back(value);
+    }
+  }
+
+  putVarint(out, dictionary.size());
+  for (int value : dictionary) {
+    putVarint(out, zigzag(value));
+  }
+  std::uint8_t width = 0;
+  while ((std::size_t{1} << width) < dictionary.size()) {
+    ++width;
+  }
+  out.push_back(static_cast<char>(width));
+
+  std::uint64_t bits = 0;
+  int filled = 0;
+  for (std::uint32_t code : codes) {
+    bits |= static_cast<std::uint64_t>(code) << filled;
+    filled += width;
+    while (filled >= 8) {
+      out.push_back(static_cast<char>(bits & 0xff));
+      bits >>= 8;
+      filled -= 8;
+    }
+  }
+  if (filled > 0) {
+    out.push_back(static_cast<char>(bits & 0xff));
+  }
+}
+
+void decodeDictionary(Reader reader, std::size_t count, std::vector<int> &out,
+                      const std::string &path) {
+  auto dictionary_size = reader.getVarint();
+  if (dictionary_size == 0 ? count != 0 : dictionary_size > count) {
+    throwCorrupt(path);
+  }
+  std::vector<int> dictionary;
+  dictionary.reserve(static_cast<std::size_t>(dictionary_size));
+  for (std::uint64_t i = 0; i < dictionary_size; ++i) {
+    dictionary.push_back(static_cast<int>(reader.getSignedVarint()));
+  }
+  auto width = reader.get<std::uint8_t>();
+  if (width > 32) {
+    throwCorrupt(path);
+  }
+
+  out.clear();
+  out.reserve(count);
+  std::uint64_t bits = 0;
+  int filled = 0;
+  std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+  for (std::size_t i = 0; i < count; ++i) {
+    while (filled < width) {
+      bits |= static_cast<std::uint64_t>(reader.get<std::uint8_t>()) << filled;
+      filled += 8;
+    }
+    auto code = bits & mask;
+    bits >>= width;
+    filled -= width;
+    if (code >= dictionary.size()) {
+      throwCorrupt(path);
+    }
+    out.push_back(dictionary[static_cast<std::size_t>(code)]);
+  }
+}
+
+// delta-of-delta: 先頭の値、先頭の差分、以降は差分の差分
+void encodeTimestamps(const std::vector<std::int64_t> &values,
+                      std::vector<char> &out) {
+  std::int64_t previous = 0;
+  std::int64_t previous_delta = 0;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    std::int64_t delta = values[i] - previous;
+    putVarint(out, zigzag(i == 0 ? values[i] : delta - previous_delta));
+    previous_delta = i == 0 ? 0 : delta;
+    previous = values[i];
+  }
+}
+
+void decodeTimestamps(Reader reader, std::size_t count,
+                      std::vector<std::int64_t> &out,
+                      const std::string &path) {
+  out.clear();
+  out.reserve(count);
+  std::int64_t previous = 0;
+  std::int64_t previous_delta = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::int64_t value = reader.getSignedVarint();
+    if (i == 0) {
+      previous = value;
+    } else {
+      previous_delta += value;
+      previous += previous_delta;
+    }
+    out.push_back(previous);
+  }
+  if (!reader.atEnd()) {
+    throwCorrupt(path);
+  }
+}
+
+// シーケンス番号・セッションID: 差分のランレングス（連番は1組になる）
+template <typename T>
+void encodeSequences(const std::vector<T> &values, std::vector<char> &out) {
+  std::vector<std::int64_t> deltas;
+  deltas.reserve(values.size());
+  std::int64_t previous = 0;
+  for (T value : values) {
+    deltas.push_back(static_cast<std::int64_t>(value) - previous);
+    previous = value;
+  }
+  encodeRunLength(deltas, out);
+}
+
+template <typename T>
+void decodeSequences(Reader reader, std::size_t count, std::vector<T> &out,
+                     const std::string &path) {
+  decodeRunLength(reader, count, out, path);
+  for (std::size_t i = 1; i < out.size(); ++i) {
+    out[i] += out[i - 1];
+  }
+}
+
+template <typename Encode>
+void putColumn(std::vector<char> &out, Encode encode) {
+  std::size_t length_offset = out.size();
+  putLittleEndian(out, std::uint32_t{0});
+  encode();
+  setLittleEndian(out.data() + length_offset,
+                  static_cast<std::uint32_t>(out.size() - length_offset - 4));
+}
+
+/**
+ * @brief レコード列をセグメントの形式に符号化し、要約を返す
+ */
+TransactionSegmentInfo
+encodeSegment(const std::vector<domain::TransactionRecord> &records,
+              std::vector<char> &out) {
+  SegmentColumns columns;
+  TransactionSegmentInfo info{{},
+                              static_cast<std::uint32_t>(records.size()),
+                              std::numeric_limits<std::int64_t>::max(),
+                              std::numeric_limits<std::int64_t>::min(),
+                              std::numeric_limits<int>::max(),
+                              std::numeric_limits<int>::min(),
+                              std::numeric_limits<std::uint64_t>::max(),
+                              0,
+                              domain::Revenue(),
+                              0};
+  domain::RevenueAccumulator revenue;
+  for (const auto &record : records) {
+    std::int64_t timestamp = record.getTimestamp().time_since_epoch().count();
+    int slot_id = record.getSlotId().getValue();
+    columns.sales_ids.push_back(record.getSalesId().getValue());
+    columns.slot_ids.push_back(slot_id);
+    columns.prices.push_back(record.getPrice().getRawValue());
+    columns.payment_methods.push_back(
+        static_cast<int>(record.getPaymentMethod()));
+    columns.timestamps.push_back(timestamp);
+    columns.sequences.push_back(
+        static_cast<std::int64_t>(record.getSequence()));
+    columns.session_ids.push_back(
+        record.getSessionId() ? record.getSessionId()->getValue() : 0);
+    info.min_sequence = std::min(info.min_sequence, record.getSequence());
+    info.max_sequence = std::max(info.max_sequence, record.getSequence());
+    info.min_timestamp = std::min(info.min_timestamp, timestamp);
+    info.max_timestamp = std::max(info.max_timestamp, timestamp);
+    info.min_slot_id = std::min(info.min_slot_id, slot_id);
+    info.max_slot_id = std::max(info.max_slot_id, slot_id);
+    revenue.add(record.getPrice());
+  }
+  info.revenue = revenue.getTotal();
+
+  out.clear();
+  out.insert(out.end(), SEGMENT_MAGIC, SEGMENT_MAGIC + 4);
+  putLittleEndian(out, TieredTransactionHistoryRepository::FORMAT_VERSION);
+  putLittleEndian(out, std::uint16_t{0});
+  putColumn(out, [&] { encodeRunLength(columns.sales_ids, out); });
+  putColumn(out, [&] { encodeRunLength(columns.slot_ids, out); });
+  putColumn(out, [&] { encodeDictionary(columns.prices, out); });
+  putColumn(out, [&] { encodeDictionary(columns.payment_methods, out); });
+  putColumn(out, [&] { encodeTimestamps(columns.timestamps, out); });
+  putColumn(out, [&] { encodeSequences(columns.sequences, out); });
+  putColumn(out, [&] { encodeSequences(columns.session_ids, out); });
+
+  putLittleEndian(out, info.record_count);
+  putLittleEndian(out, info.min_timestamp);
+  putLittleEndian(out, info.max_timestamp);
+  putLittleEndian(out, std::int32_t{info.min_slot_id});
+  putLittleEndian(out, std::int32_t{info.max_slot_id});
+  putLittleEndian(out, info.min_sequence);
+  putLittleEndian(out, info.max_sequence);
+  putLittleEndian(out, info.revenue.getRawValue());
+  // 列だけでなくフッタの値も対象にする（範囲の判定と売上合計に使うため）
+  putLittleEndian(out, fnv1a(out.data(), out.size()));
+  putLittleEndian(out, std::uint32_t{0});
+  out.insert(out.end(), FOOTER_MAGIC, FOOTER_MAGIC + 4);
+  info.encoded_size = out.size();
+  return info;
+}
+
+std::vector<char> readFile(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open transaction segment: " + path);
+  }
+  struct stat st;
+  std::vector<char> data;
+  if (::fstat(fd, &st) == 0) {
+    data.resize(static_cast<std::size_t>(st.st_size));
+  }
+  std::size_t offset = 0;
+  while (offset < data.size()) {
+    ssize_t bytes = ::read(fd, data.data() + offset, data.size() - offset);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes <= 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to read transaction segment: " + path);
+    }
+    offset += static_cast<std::size_t>(bytes);
+  }
+  ::close(fd);
+  return data;
+}
+
+TransactionSegmentInfo decodeFooter(const std::vector<char> &data,
+                                    const std::string &path) {
+  if (data.size() < HEADER_SIZE + FOOTER_SIZE ||
+      std::memcmp(data.data(), SEGMENT_MAGIC, 4) != 0 ||
+      std::memcmp(data.data() + data.size() - 4, FOOTER_MAGIC, 4) != 0) {
+    throwCorrupt(path);
+  }
+  if (getLittleEndian<std::uint16_t>(data.data() + 4) !=
+      TieredTransactionHistoryRepository::FORMAT_VERSION) {
+    throw std::runtime_error("Unsupported transaction segment version: " +
+                             path);
+  }
+  Reader footer(data.data() + data.size() - FOOTER_SIZE, FOOTER_SIZE, path);
+  TransactionSegmentInfo info{
+      path, 0, 0, 0, 0, 0, 0, 0, domain::Revenue(), data.size()};
+  info.record_count = footer.get<std::uint32_t>();
+  info.min_timestamp = footer.get<std::int64_t>();
+  info.max_timestamp = footer.get<std::int64_t>();
+  info.min_slot_id = footer.get<std::int32_t>();
+  info.max_slot_id = footer.get<std::int32_t>();
+  info.min_sequence = footer.get<std::uint64_t>();
+  info.max_sequence = footer.get<std::uint64_t>();
+  info.revenue = domain::Revenue(footer.get<std::int64_t>());
+  if (footer.get<std::uint32_t>() !=
+      fnv1a(data.data(), data.size() - FOOTER_SIZE + FOOTER_FIELDS_SIZE)) {
+    throwCorrupt(path);
+  }
+  return info;
+}
+
+/**
+ * @brief セグメントを読み込んで列に復号
+ */
+void decodeSegment(const TransactionSegmentInfo &info,
+                   SegmentColumns &columns) {
+  std::vector<char> data = readFile(info.path);
+  TransactionSegmentInfo footer = decodeFooter(data, info.path);
+  std::size_t count = footer.record_count;
+
+  Reader body(data.data() + HEADER_SIZE,
+              data.size() - HEADER_SIZE - FOOTER_SIZE, info.path);
+  decodeRunLength(body.column(), count, columns.sales_ids, info.path);
+  decodeRunLength(body.column(), count, columns.slot_ids, info.path);
+  decodeDictionary(body.column(), count, columns.prices, info.path);
+  decodeDictionary(body.column(), count, columns.payment_methods, info.path);
+  decodeTimestamps(body.column(), count, columns.timestamps, info.path);
+  decodeSequences(body.column(), count, columns.sequences, info.path);
+  decodeSequences(body.column(), count, columns.session_ids, info.path);
+  for (int session_id : columns.session_ids) {
+    if (session_id < 0) {
+      throwCorrupt(info.path);
+    }
+  }
+  if (!body.atEnd()) {
+    throwCorrupt(info.path);
+  }
+  for (int method : columns.payment_methods) {
+    if (method < static_cast<int>(domain::PaymentMethodType::CASH) ||
+        method > static_cast<int>(domain::PaymentMethodType::EMONEY)) {
+      throwCorrupt(info.path);
+    }
+  }
+}
+
+bool writeAll(int fd, const char *bytes, std::size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, bytes, size);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written < 0) {
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+void writeFileAtomically(const std::string &path,
+                         const std::vector<char> &data) {
+  // 一時ファイルに書き切ってから置き換える（書きかけのファイルを残さない）
+  std::string temp_path = path + ".tmp";
+  int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open history file: " + temp_path);
+  }
+  if (!writeAll(fd, data.data(), data.size())) {
+    ::close(fd);
+    throw std::runtime_error("Failed to write history file: " + temp_path);
+  }
+  if (::fsync(fd) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to sync history file: " + temp_path);
+  }
+  ::close(fd);
+  if (::rename(temp_path.c_str(), path.c_str()) != 0) {
+    throw std::runtime_error("Failed to rename history file: " + path);
+  }
+}
+
+/**
+ * @brief ログの1エントリ（固定長、末尾にチェックサム）に符号化
+ */
+void encodeLogEntry(const domain::TransactionRecord &record, char *out) {
+  std::int64_t timestamp = record.getTimestamp().time_since_epoch().count();
+  std::int32_t session_id =
+      record.getSessionId() ? record.getSessionId()->getValue() : 0;
+  setLittleEndian(out, record.getSequence());
+  setLittleEndian(out + 8, std::int32_t{record.getSalesId().getValue()});
+  setLittleEndian(out + 12, std::int32_t{record.getSlotId().getValue()});
+  setLittleEndian(out + 16, std::int32_t{record.getPrice().getRawValue()});
+  setLittleEndian(out + 20,
+                  static_cast<std::uint32_t>(record.getPaymentMethod()));
+  setLittleEndian(out + 24, timestamp);
+  setLittleEndian(out + 32, session_id);
+  setLittleEndian(out + 36, fnv1a(out, LOG_ENTRY_SIZE - 4));
+}
+
+/**
+ * @brief ログの1エントリを復号（書きかけ・壊れたエントリなら空）
+ */
+std::optional<domain::TransactionRecord> decodeLogEntry(const char *in) {
+  if (getLittleEndian<std::uint32_t>(in + 36) !=
+      fnv1a(in, LOG_ENTRY_SIZE - 4)) {
+    return std::nullopt;
+  }
+  auto method = getLittleEndian<std::uint32_t>(in + 20);
+  auto session_id = getLittleEndian<std::int32_t>(in + 32);
+  if (method < static_cast<std::uint32_t>(domain::PaymentMethodType::CASH) ||
+      method > static_cast<std::uint32_t>(domain::PaymentMethodType::EMONEY) ||
+      session_id < 0) {
+    return std::nullopt;
+  }
+  auto record =
+      domain::TransactionRecord(
+          domain::SalesId(getLittleEndian<std::int32_t>(in + 8)),
+          domain::SlotId(getLittleEndian<std::int32_t>(in + 12)),
+          domain::Price(getLittleEndian<std::int32_t>(in + 16)),
+          static_cast<domain::PaymentMethodType>(method),
+          Clock::time_point(
+              Clock::duration(getLittleEndian<std::int64_t>(in + 24))))
+          .withSequence(getLittleEndian<std::uint64_t>(in));
+  if (session_id != 0) {
+    record = record.withSessionId(domain::SessionId(session_id));
+  }
+  return record;
+}
+
+// 併合の階層: 件数がメモテーブルの容量 × COMPACTION_FAN_IN^n 以上なら n + 1
+std::size_t tierOf(std::uint64_t record_count, std::size_t memtable_capacity) {
+  std::size_t tier = 0;
+  for (std::uint64_t bound =
+           std::uint64_t{memtable_capacity} *
+           TieredTransactionHistoryRepository::COMPACTION_FAN_IN;
+       record_count >= bound;
+       bound *= TieredTransactionHistoryRepository::COMPACTION_FAN_IN) {
+    ++tier;
+  }
+  return tier;
+}
+
+void sortByTimestampDescending(
+    std::vector<domain::TransactionRecord> &records) {
+  std::stable_sort(records.begin(), records.end(),
+                   [](const domain::TransactionRecord &a,
+                      const domain::TransactionRecord &b) {
+                     return a.getTimestamp() > b.getTimestamp();
+                   });
+}
+
+} // namespace
+
+TieredTransactionHistoryRepository::TieredTransactionHistoryRepository(
+    std::string directory, std::size_t memtable_capacity)
+    : directory_(std::move(directory)), memtable_capacity_(memtable_capacity) {
+  if (memtable_capacity_ == 0) {
+    throw std::invalid_argument("Memtable capacity must be positive");
+  }
+  if (::mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) {
+    throw std::runtime_error("Failed to create history directory: " +
+                             directory_);
+  }
+  memtable_.reserve(memtable_capacity_);
+  loadExistingSegments();
+  openMemtableLog();
+  if (memtable_.size() >= memtable_capacity_) {
+    flush();
+  }
+}
+
+TieredTransactionHistoryRepository::~TieredTransactionHistoryRepository() {
+  try {
+    flush();
+  } catch (...) {
+    // デストラクタからは送出しない（メモテーブルの内容はログに残る）
+  }
+  if (log_fd_ >= 0) {
+    ::close(log_fd_);
+  }
+}
+
+void TieredTransactionHistoryRepository::save(
+    const domain::TransactionRecord &record) {
+  domain::TransactionRecord sequenced = record.withSequence(next_sequence_++);
+  char entry[LOG_ENTRY_SIZE];
+  encodeLogEntry(sequenced, entry);
+  if (!writeAll(log_fd_, entry, sizeof(entry))) {
+    throw std::runtime_error("Failed to append to memtable log: " +
+                             directory_);
+  }
+  memtable_.push_back(std::move(sequenced));
+  ++generation_;
+}
+
+std::vector<domain::TransactionRecord>
+TieredTransactionHistoryRepository::getAll() const {
+  std::vector<domain::TransactionRecord> result;
+  forEach([&result](const domain::TransactionRecord &record) {
+    result.push_back(record);
+  });
+  sortByTimestampDescending(result);
+  return result;
+}
+
+std::vector<domain::TransactionRecord>
+TieredTransactionHistoryRepository::getBySlotId(
+    const domain::SlotId &slot_id) const {
+  int id = slot_id.getValue();
+  std::vector<domain::TransactionRecord> result;
+  SegmentColumns columns;
+  for (const auto &segment : segments_) {
+    if (id < segment.min_slot_id || id > segment.max_slot_id) {
+      continue;
+    }
+    decodeSegment(segment, columns);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+      if (columns.slot_ids[i] == id) {
+        result.push_back(columns.record(i));
+      }
+    }
+  }
+  for (const auto &record : memtable_) {
+    if (record.getSlotId() == slot_id) {
+      result.push_back(record);
+    }
+  }
+  sortByTimestampDescending(result);
+  return result;
+}
+
+std::vector<domain::TransactionRecord>
+TieredTransactionHistoryRepository::getByTimeRange(
+    std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+  std::int64_t begin = from.time_since_epoch().count();
+  std::int64_t end = to.time_since_epoch().count();
+  std::vector<domain::TransactionRecord> result;
+  SegmentColumns columns;
+  for (const auto &segment : segments_) {
+    if (segment.max_timestamp < begin || segment.min_timestamp >= end) {
+      continue;
+    }
+    decodeSegment(segment, columns);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+      if (columns.timestamps[i] >= begin && columns.timestamps[i] < end) {
+        result.push_back(columns.record(i));
+      }
+    }
+  }
+  for (const auto &record : memtable_) {
+    if (record.getTimestamp() >= from && record.getTimestamp() < to) {
+      result.push_back(record);
+    }
+  }
+  sortByTimestampDescending(result);
+  return result;
+}
+
+void TieredTransactionHistoryRepository::forEach(
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  forEachInPartition(0, 1, visitor);
+}
+
+void TieredTransactionHistoryRepository::forEachInPartition(
+    std::size_t partition, std::size_t partition_count,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  // 単位 0..n-1 はセグメント、単位 n はメモテーブル
+  SegmentColumns columns;
+  for (std::size_t unit = partition; unit <= segments_.size();
+       unit += partition_count) {
+    if (unit == segments_.size()) {
+      for (const auto &record : memtable_) {
+        visitor(record);
+      }
+      break;
+    }
+    decodeSegment(segments_[unit], columns);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+      visitor(columns.record(i));
+    }
+  }
+}
+
+domain::Revenue TieredTransactionHistoryRepository::getTotalRevenue() const {
+  domain::RevenueAccumulator total;
+  for (const auto &segment : segments_) {
+    total.add(segment.revenue);
+  }
+  for (const auto &record : memtable_) {
+    total.add(record.getPrice());
+  }
+  return total.getTotal();
+}
+
+std::uint64_t TieredTransactionHistoryRepository::getGeneration() const {
+  return generation_;
+}
+
+void TieredTransactionHistoryRepository::clear() {
+  // 先にログへ墓標を書く。セグメントを消す途中で停止しても、
+  // 開くときに墓標以前のセグメントを消す
+  memtable_.clear();
+  cleared_through_ = next_sequence_ - 1;
+  resetMemtableLog();
+  for (const auto &segment : segments_) {
+    std::remove(segment.path.c_str());
+  }
+  segments_.clear();
+  ++generation_;
+}
+
+void TieredTransactionHistoryRepository::flush() {
+  if (memtable_.empty()) {
+    return;
+  }
+  segments_.push_back(writeSegment(memtable_));
+  memtable_.clear();
+  // ここで停止しても、ログに残る書き出し済みのエントリは開くときに読み飛ばす
+  resetMemtableLog();
+}
+
+bool TieredTransactionHistoryRepository::needsMaintenance() const {
+  return memtable_.size() >= memtable_capacity_ ||
+         findCompaction() < segments_.size();
+}
+
+bool TieredTransactionHistoryRepository::runMaintenance() {
+  if (memtable_.size() >= memtable_capacity_) {
+    flush();
+  }
+  if (findCompaction() < segments_.size()) {
+    compactOnce();
+  }
+  return needsMaintenance();
+}
+
+TransactionSegmentInfo TieredTransactionHistoryRepository::writeSegment(
+    const std::vector<domain::TransactionRecord> &records) {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%s%08u%s", SEGMENT_PREFIX,
+                next_segment_number_, SEGMENT_SUFFIX);
+  TransactionSegmentInfo info = encodeSegment(records, encode_buffer_);
+  info.path = directory_ + "/" + name;
+  writeFileAtomically(info.path, encode_buffer_);
+  ++next_segment_number_;
+  return info;
+}
+
+std::size_t TieredTransactionHistoryRepository::findCompaction() const {
+  if (segments_.size() < COMPACTION_FAN_IN) {
+    return segments_.size();
+  }
+  std::size_t first = segments_.size() - COMPACTION_FAN_IN;
+  std::size_t tier = tierOf(segments_[first].record_count, memtable_capacity_);
+  std::uint64_t total = 0;
+  for (std::size_t i = first; i < segments_.size(); ++i) {
+    if (tierOf(segments_[i].record_count, memtable_capacity_) != tier) {
+      return segments_.size();
+    }
+    total += segments_[i].record_count;
+  }
+  return total > MAX_COMPACTED_RECORDS ? segments_.size() : first;
+}
+
+void TieredTransactionHistoryRepository::compactOnce() {
+  auto first = segments_.begin() +
+               static_cast<std::ptrdiff_t>(findCompaction());
+  std::vector<domain::TransactionRecord> records;
+  SegmentColumns columns;
+  for (auto it = first; it != segments_.end(); ++it) {
+    decodeSegment(*it, columns);
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+      records.push_back(columns.record(i));
+    }
+  }
+  // 併合後のセグメントを書き切ってから古いものを消す
+  TransactionSegmentInfo merged = writeSegment(records);
+  for (auto it = first; it != segments_.end(); ++it) {
+    std::remove(it->path.c_str());
+  }
+  segments_.erase(first, segments_.end());
+  segments_.push_back(std::move(merged));
+}
+
+void TieredTransactionHistoryRepository::openMemtableLog() {
+  std::string path = directory_ + "/" + MEMTABLE_LOG_NAME;
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0 && errno != ENOENT) {
+    throw std::runtime_error("Failed to open memtable log: " + path);
+  }
+  if (fd >= 0) {
+    ::close(fd);
+    std::vector<char> data = readFile(path);
+    if (data.size() < LOG_HEADER_SIZE ||
+        std::memcmp(data.data(), LOG_MAGIC, 4) != 0 ||
+        getLittleEndian<std::uint16_t>(data.data() + 4) != LOG_VERSION) {
+      throw std::runtime_error("Corrupt memtable log: " + path);
+    }
+    next_sequence_ = std::max(
+        next_sequence_, getLittleEndian<std::uint64_t>(data.data() + 8));
+    cleared_through_ = getLittleEndian<std::uint64_t>(data.data() + 16);
+    // clear() がセグメントを消す途中で停止した残り
+    for (std::size_t i = segments_.size(); i-- > 0;) {
+      if (segments_[i].max_sequence <= cleared_through_) {
+        std::remove(segments_[i].path.c_str());
+        segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+    }
+    std::uint64_t flushed = cleared_through_;
+    for (const auto &segment : segments_) {
+      flushed = std::max(flushed, segment.max_sequence);
+    }
+    for (std::size_t offset = LOG_HEADER_SIZE;
+         offset + LOG_ENTRY_SIZE <= data.size(); offset += LOG_ENTRY_SIZE) {
+      auto record = decodeLogEntry(data.data() + offset);
+      if (!record) {
+        break; // 追記の途中で停止した末尾
+      }
+      if (record->getSequence() <= flushed) {
+        continue; // 書き出し後、ログを空にする前に停止した分
+      }
+      next_sequence_ = std::max(next_sequence_, record->getSequence() + 1);
+      memtable_.push_back(std::move(*record));
+    }
+  }
+  // 読み飛ばした分と壊れた末尾を除いて書き直す
+  resetMemtableLog();
+}
+
+void TieredTransactionHistoryRepository::resetMemtableLog() {
+  encode_buffer_.clear();
+  encode_buffer_.insert(encode_buffer_.end(), LOG_MAGIC, LOG_MAGIC + 4);
+  putLittleEndian(encode_buffer_, LOG_VERSION);
+  putLittleEndian(encode_buffer_, std::uint16_t{0});
+  putLittleEndian(encode_buffer_, next_sequence_);
+  putLittleEndian(encode_buffer_, cleared_through_);
+  for (const auto &record : memtable_) {
+    std::size_t offset = encode_buffer_.size();
+    encode_buffer_.resize(offset + LOG_ENTRY_SIZE);
+    encodeLogEntry(record, encode_buffer_.data() + offset);
+  }
+
+  std::string path = directory_ + "/" + MEMTABLE_LOG_NAME;
+  if (log_fd_ >= 0) {
+    ::close(log_fd_);
+    log_fd_ = -1;
+  }
+  writeFileAtomically(path, encode_buffer_);
+  log_fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+  if (log_fd_ < 0) {
+    throw std::runtime_error("Failed to open memtable log: " + path);
+  }
+}
+
+void TieredTransactionHistoryRepository::loadExistingSegments() {
+  DIR *dir = ::opendir(directory_.c_str());
+  if (dir == nullptr) {
+    throw std::runtime_error("Failed to open history directory: " +
+                             directory_);
+  }
+  std::vector<std::pair<std::uint32_t, std::string>> found;
+  std::size_t prefix_size = std::strlen(SEGMENT_PREFIX);
+  std::size_t suffix_size = std::strlen(SEGMENT_SUFFIX);
+  while (const dirent *entry = ::readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.size() <= prefix_size + suffix_size ||
+        name.compare(0, prefix_size, SEGMENT_PREFIX) != 0 ||
+        name.compare(name.size() - suffix_size, suffix_size,
+                     SEGMENT_SUFFIX) != 0) {
+      continue;
+    }
+    std::string digits =
+        name.substr(prefix_size, name.size() - prefix_size - suffix_size);
+    if (digits.find_first_not_of("0123456789") != std::string::npos) {
+      continue;
+    }
+    found.emplace_back(static_cast<std::uint32_t>(std::stoul(digits)),
+                       std::move(name));
+  }
+  ::closedir(dir);
+
+  // 番号順（書き出した順）に並べる
+  std::sort(found.begin(), found.end());
+  for (const auto &[number, name] : found) {
+    std::string path = directory_ + "/" + name;
+    segments_.push_back(decodeFooter(readFile(path), path));
+    next_segment_number_ = number + 1;
+    next_sequence_ =
+        std::max(next_sequence_, segments_.back().max_sequence + 1);
+  }
+
+  // 併合の途中で停止すると、後の番号のセグメントに含まれる古いものが残る
+  std::uint64_t covered_from = std::numeric_limits<std::uint64_t>::max();
+  for (std::size_t i = segments_.size(); i-- > 0;) {
+    if (segments_[i].max_sequence >= covered_from) {
+      std::remove(segments_[i].path.c_str());
+      segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(i));
+    } else {
+      covered_from = segments_[i].min_sequence;
+    }
+  }
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
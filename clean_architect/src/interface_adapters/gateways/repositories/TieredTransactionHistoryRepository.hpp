@@ -0,0 +1,229 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_TIERED_TRANSACTION_HISTORY_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_TIERED_TRANSACTION_HISTORY_HPP
+
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @struct TransactionSegmentInfo
+ * @brief ディスク上のセグメント1個の要約（フッタの内容）
+ */
+struct TransactionSegmentInfo {
+  std::string path;           ///< ファイルパス
+  std::uint32_t record_count; ///< レコード数
+  std::int64_t min_timestamp; ///< 最古のタイムスタンプ（system_clock の刻み）
+  std::int64_t max_timestamp; ///< 最新のタイムスタンプ
+  int min_slot_id;            ///< 最小のスロットID
+  int max_slot_id;            ///< 最大のスロットID
+  std::uint64_t min_sequence; ///< 最小のシーケンス番号
+  std::uint64_t max_sequence; ///< 最大のシーケンス番号
+  domain::Revenue revenue;    ///< 売上合計
+  std::uint64_t encoded_size; ///< ファイルサイズ（バイト）
+};
+
+/**
+ * @class TieredTransactionHistoryRepository
+ * @brief 直近の履歴をメモリに、古い履歴を圧縮したファイルに置く実装（LSM 方式）
+ *
+ * 保存したレコードはまずメモリ上のメモテーブルに積みます。メモテーブルの
+ * 書き出しとセグメントの併合は save() では行わず、呼び出し元が販売の
+ * 合間（アイドル時やチェックポイントの周期など）に runMaintenance() を
+ * 呼んで進めます。save() の所要時間はログへの追記1回で一定です。
+ * メモテーブルが満杯になっていれば、runMaintenance() がその内容を
+ * 変更不可のセグメントファイルとして書き出します。
+ *
+ * セグメントは列ごとに圧縮します。
+ * - タイムスタンプ: 差分の差分（delta-of-delta）を zigzag 可変長整数で
+ * - シーケンス番号・セッションID: 差分のランレングス
+ * - 販売ID・スロットID: ランレングス
+ * - 価格・決済方法: 辞書とビット詰めの符号
+ *
+ * フッタにレコード数・タイムスタンプとスロットIDの最小/最大・売上合計を
+ * 持ちます。そのため、時間範囲やスロットの検索では範囲外のセグメントを
+ * 読まずに飛ばせます。売上合計はファイルを読まずにフッタから求めます。
+ * チェックサムは列とフッタの値の両方を対象にします。
+ *
+ * メモテーブルへの保存はディレクトリ内の memtable.log にも追記します
+ * （fsync はしません）。ログはメモテーブルを書き出すたびに空に戻すため、
+ * 大きさは書き出していないレコードの分で済みます。プロセスが異常終了しても、
+ * 開き直すとログからメモテーブルを復元します。電源断では直近の追記が
+ * 失われることがあります。書きかけの末尾のエントリは読み飛ばします。
+ *
+ * 末尾の COMPACTION_FAN_IN 個のセグメントが同じ大きさの階層
+ * （メモテーブルの容量 × COMPACTION_FAN_IN^n 件単位）に揃うと、
+ * runMaintenance() の1回につき1組を1つのセグメントに併合します
+ * （size-tiered compaction）。セグメントの数は
+ * 件数の対数程度に保たれます。MAX_COMPACTED_RECORDS 件を超える併合は
+ * しません。併合は新しいセグメントを書き切ってから古いものを消すため、
+ * 途中で停止して両方が残っても、開くときに重複する古い方を削除します。
+ *
+ * 開くときに既存のセグメントとログを引き継ぎ、シーケンス番号はその続きから
+ * 採番します。ログの先頭には次のシーケンス番号と、clear() で消した
+ * 最後のシーケンス番号（墓標）も記録します。clear() はログを書き換えて
+ * から古いセグメントを消すため、途中で停止しても開くときに墓標以前の
+ * セグメントを消し、消した履歴が戻ることはありません。
+ * 本クラスはスレッドセーフではありません（パーティション単位の走査は
+ * 同時に実行できます）。
+ */
+class TieredTransactionHistoryRepository
+    : public domain::ITransactionHistoryRepository {
+public:
+  static constexpr std::uint16_t FORMAT_VERSION = 4;
+  /// 既定のメモテーブルの容量（レコード数）
+  static constexpr std::size_t DEFAULT_MEMTABLE_CAPACITY = 4096;
+  /// 1回の併合で1つにまとめるセグメントの数
+  static constexpr std::size_t COMPACTION_FAN_IN = 4;
+  /// 併合後のセグメントのレコード数の上限（併合はメモリ上で行うため）
+  static constexpr std::size_t MAX_COMPACTED_RECORDS = std::size_t{1} << 18;
+
+  /**
+   * @brief コンストラクタ
+   * @param directory セグメントを置くディレクトリ（無ければ作成）
+   * @param memtable_capacity メモテーブルの容量（レコード数）
+   * @throw std::invalid_argument memtable_capacity が 0 の場合
+   * @throw std::runtime_error ディレクトリや既存のセグメント・ログを
+   *        読めない場合
+   */
+  explicit TieredTransactionHistoryRepository(
+      std::string directory,
+      std::size_t memtable_capacity = DEFAULT_MEMTABLE_CAPACITY);
+
+  /**
+   * @brief デストラクタ（メモテーブルを書き出してログを閉じる）
+   */
+  ~TieredTransactionHistoryRepository() override;
+
+  TieredTransactionHistoryRepository(
+      const TieredTransactionHistoryRepository &) = delete;
+  TieredTransactionHistoryRepository &
+  operator=(const TieredTransactionHistoryRepository &) = delete;
+
+  /**
+   * @brief トランザクションを保存（メモテーブルとログに追記するだけ）
+   *
+   * メモテーブルが満杯でも書き出しません（runMaintenance() が行う）。
+   * @throw std::runtime_error ログに追記できない場合
+   */
+  void save(const domain::TransactionRecord &record) override;
+
+  /**
+   * @brief すべてのトランザクション履歴を取得（タイムスタンプ降順）
+   */
+  std::vector<domain::TransactionRecord> getAll() const override;
+
+  /**
+   * @brief 指定スロットの履歴を取得（タイムスタンプ降順）
+   *
+   * スロットIDの範囲に含まれないセグメントは読みません。
+   */
+  std::vector<domain::TransactionRecord>
+  getBySlotId(const domain::SlotId &slot_id) const override;
+
+  /**
+   * @brief 時間範囲 [from, to) の履歴を取得（タイムスタンプ降順）
+   *
+   * 時間範囲が重ならないセグメントは読みません。
+   */
+  std::vector<domain::TransactionRecord>
+  getByTimeRange(std::chrono::system_clock::time_point from,
+                 std::chrono::system_clock::time_point to) const;
+
+  /**
+   * @brief 全件走査（セグメントの古い順、最後にメモテーブル。保存順）
+   */
+  void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief パーティション単位の走査（セグメント単位で分担）
+   *
+   * メモテーブルとセグメントを1つの単位とし、単位を順にパーティションへ
+   * 割り当てます。各パーティションは自分の単位だけを古い順に読みます。
+   */
+  void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief 売上集計（セグメントはフッタの合計を使う）
+   */
+  domain::Revenue getTotalRevenue() const override;
+
+  std::uint64_t getGeneration() const override;
+
+  /**
+   * @brief 履歴をクリア（ログに墓標を書いてからセグメントファイルを削除）
+   */
+  void clear() override;
+
+  /**
+   * @brief メモテーブルの内容をセグメントとして書き出す（空なら何もしない）
+   *
+   * 書き出した後にログを空にします。併合はしません。
+   * @throw std::runtime_error 書き出せない場合
+   */
+  void flush();
+
+  /**
+   * @brief 書き出しか併合が必要か
+   */
+  bool needsMaintenance() const;
+
+  /**
+   * @brief 保守を1段階だけ進める（販売の合間に呼ぶ）
+   *
+   * メモテーブルが満杯なら書き出し、併合できるセグメントがあれば
+   * 1組だけ併合します。1回の所要時間は併合1回分で抑えられます。
+   * @return まだ保守が必要な場合 true
+   * @throw std::runtime_error 書き出せない場合
+   */
+  bool runMaintenance();
+
+  /**
+   * @brief セグメントの要約（古い順）
+   */
+  const std::vector<TransactionSegmentInfo> &getSegments() const {
+    return segments_;
+  }
+
+  /**
+   * @brief メモテーブル内のレコード数
+   */
+  std::size_t getMemtableSize() const { return memtable_.size(); }
+
+private:
+  std::string directory_;
+  std::size_t memtable_capacity_;
+  std::vector<domain::TransactionRecord> memtable_;
+  std::vector<TransactionSegmentInfo> segments_;
+  std::uint32_t next_segment_number_ = 1;
+  std::uint64_t next_sequence_ = 1;
+  std::uint64_t cleared_through_ = 0; ///< clear() で消した最後のシーケンス番号
+  std::uint64_t generation_ = 0;
+  std::vector<char> encode_buffer_; ///< 書き出しのたびに使い回す
+  int log_fd_ = -1;                 ///< memtable.log
+
+  void loadExistingSegments();
+  void openMemtableLog();
+  // ログを次のシーケンス番号だけを持つ状態に戻す
+  void resetMemtableLog();
+  TransactionSegmentInfo
+  writeSegment(const std::vector<domain::TransactionRecord> &records);
+  // 併合できる末尾のセグメントの先頭（無ければ segments_.size()）
+  std::size_t findCompaction() const;
+  void compactOnce();
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_TIERED_TRANSACTION_HISTORY_HPP
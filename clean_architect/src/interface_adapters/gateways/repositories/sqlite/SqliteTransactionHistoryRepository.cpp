@@ -0,0 +1,316 @@
+#include "SqliteTransactionHistoryRepository.hpp"
+#include "domain/common/Price.hpp"
+#include <sqlite3.h>
+#include <stdexcept>
+#include <string>
+
+namespace vending_machine {
+namespace interface_adapters {
+
+namespace {
+
+constexpr const char *SCHEMA_SQL =
+    "CREATE TABLE IF NOT EXISTS transactions ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " sales_id INTEGER NOT NULL,"
+    " slot_id INTEGER NOT NULL,"
+    " price INTEGER NOT NULL,"
+    " payment_method INTEGER NOT NULL,"
+    " timestamp INTEGER NOT NULL,"
+    " session_id INTEGER);"
+    "CREATE INDEX IF NOT EXISTS transactions_by_slot"
+    " ON transactions (slot_id, timestamp);"
+    "CREATE INDEX IF NOT EXISTS transactions_by_time"
+    " ON transactions (timestamp);";
+
+constexpr const char *COLUMNS =
+    "SELECT sales_id, slot_id, price, payment_method, timestamp, id, session_id"
+    " FROM transactions";
+
+std::int64_t toTicks(std::chrono::system_clock::time_point timestamp) {
+  return static_cast<std::int64_t>(timestamp.time_since_epoch().count());
+}
+
+domain::TransactionRecord readRow(sqlite3_stmt *statement) {
+  auto record =
+      domain::TransactionRecord(
+          domain::SalesId(sqlite3_column_int(statement, 0)),
+          domain::SlotId(sqlite3_column_int(statement, 1)),
+          domain::Price(sqlite3_column_int(statement, 2)),
+          static_cast<domain::PaymentMethodType>(
+              sqlite3_column_int(statement, 3)),
+          std::chrono::system_clock::time_point(
+              std::chrono::system_clock::duration(
+                  sqlite3_column_int64(statement, 4))))
+          .withSequence(
+              static_cast<std::uint64_t>(sqlite3_column_int64(statement, 5)));
+  if (sqlite3_column_type(statement, 6) != SQLITE_NULL) {
+    record = record.withSessionId(
+        domain::SessionId(sqlite3_column_int(statement, 6)));
+  }
+  return record;
+}
+
+/// 使い回す文を次の実行に備えて戻す
+class ResetGuard {
+public:
+  explicit ResetGuard(sqlite3_stmt *statement) : statement_(statement) {}
+  ~ResetGuard() {
+    sqlite3_reset(statement_);
+    sqlite3_clear_bindings(statement_);
+  }
+  ResetGuard(const ResetGuard &) = delete;
+  ResetGuard &operator=(const ResetGuard &) = delete;
+
+private:
+  sqlite3_stmt *statement_;
+};
+
+} // namespace
+
+SqliteTransactionHistoryRepository::SqliteTransactionHistoryRepository(
+    const std::string &path, std::size_t batch_size)
+    : path_(path), batch_size_(batch_size) {
+  if (batch_size_ == 0) {
+    throw std::invalid_argument("batch_size must be positive");
+  }
+  if (sqlite3_open(path_.c_str(), &db_) != SQLITE_OK) {
+    std::string message = db_ ? sqlite3_errmsg(db_) : "out of memory";
+    close();
+    throw std::runtime_error("Cannot open " + path_ + ": " + message);
+  }
+  try {
+    execute("PRAGMA journal_mode=WAL");
+    // WAL では NORMAL でもデータベースは壊れない（直近のコミットのみ失う）
+    execute("PRAGMA synchronous=NORMAL");
+    execute(SCHEMA_SQL);
+    insert_ = prepare("INSERT INTO transactions"
+                      " (sales_id, slot_id, price, payment_method, timestamp,"
+                      " session_id)"
+                      " VALUES (?, ?, ?, ?, ?, ?)");
+    select_by_slot_ = prepare((std::string(COLUMNS) +
+                               " WHERE slot_id = ?"
+                               " ORDER BY timestamp DESC")
+                                  .c_str());
+    select_by_time_ = prepare((std::string(COLUMNS) +
+                               " WHERE timestamp >= ? AND timestamp < ?"
+                               " ORDER BY timestamp DESC")
+                                  .c_str());
+    select_all_ =
+        prepare((std::string(COLUMNS) + " ORDER BY timestamp DESC").c_str());
+    select_in_order_ = prepare((std::string(COLUMNS) + " ORDER BY id").c_str());
+    sum_revenue_ = prepare("SELECT COALESCE(SUM(price), 0) FROM transactions");
+    select_id_bounds_ = prepare("SELECT MIN(id), MAX(id) FROM transactions");
+  } catch (...) {
+    close();
+    throw;
+  }
+}
+
+SqliteTransactionHistoryRepository::~SqliteTransactionHistoryRepository() {
+  try {
+    flush();
+  } catch (...) {
+    // 破棄時のコミット失敗は通知できないため、未コミット分は失われる
+  }
+  close();
+}
+
+void SqliteTransactionHistoryRepository::save(
+    const domain::TransactionRecord &record) {
+  if (pending_count_ == 0) {
+    execute("BEGIN");
+  }
+  {
+    ResetGuard reset(insert_);
+    sqlite3_bind_int(insert_, 1, record.getSalesId().getValue());
+    sqlite3_bind_int(insert_, 2, record.getSlotId().getValue());
+    sqlite3_bind_int(insert_, 3, record.getPrice().getRawValue());
+    sqlite3_bind_int(insert_, 4,
+                     static_cast<int>(record.getPaymentMethod()));
+    sqlite3_bind_int64(insert_, 5, toTicks(record.getTimestamp()));
+    if (record.getSessionId()) {
+      sqlite3_bind_int(insert_, 6, record.getSessionId()->getValue());
+    } else {
+      sqlite3_bind_null(insert_, 6);
+    }
+    if (sqlite3_step(insert_) != SQLITE_DONE) {
+      std::string message = sqlite3_errmsg(db_);
+      if (pending_count_ == 0) {
+        // この保存で始めたトランザクションを閉じる
+        sqlite3_exec(db_, "ROLLBACK", nullptr, nullptr, nullptr);
+      }
+      throw std::runtime_error("Cannot save transaction: " + message);
+    }
+  }
+  ++pending_count_;
+  ++generation_;
+  if (pending_count_ >= batch_size_) {
+    flush();
+  }
+}
+
+std::vector<domain::TransactionRecord>
+SqliteTransactionHistoryRepository::getAll() const {
+  ResetGuard reset(select_all_);
+  std::vector<domain::TransactionRecord> result;
+  query(select_all_, [&result](const domain::TransactionRecord &record) {
+    result.push_back(record);
+  });
+  return result;
+}
+
+std::vector<domain::TransactionRecord>
+SqliteTransactionHistoryRepository::getBySlotId(
+    const domain::SlotId &slot_id) const {
+  ResetGuard reset(select_by_slot_);
+  sqlite3_bind_int(select_by_slot_, 1, slot_id.getValue());
+  std::vector<domain::TransactionRecord> result;
+  query(select_by_slot_, [&result](const domain::TransactionRecord &record) {
+    result.push_back(record);
+  });
+  return result;
+}
+
+std::vector<domain::TransactionRecord>
+SqliteTransactionHistoryRepository::getByTimeRange(
+    std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+  ResetGuard reset(select_by_time_);
+  sqlite3_bind_int64(select_by_time_, 1, toTicks(from));
+  sqlite3_bind_int64(select_by_time_, 2, toTicks(to));
+  std::vector<domain::TransactionRecord> result;
+  query(select_by_time_, [&result](const domain::TransactionRecord &record) {
+    result.push_back(record);
+  });
+  return result;
+}
+
+domain::Revenue SqliteTransactionHistoryRepository::getTotalRevenue() const {
+  ResetGuard reset(sum_revenue_);
+  if (sqlite3_step(sum_revenue_) != SQLITE_ROW) {
+    throw std::runtime_error("Cannot read transactions: " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
+  return domain::Revenue(sqlite3_column_int64(sum_revenue_, 0));
+}
+
+void SqliteTransactionHistoryRepository::forEach(
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  ResetGuard reset(select_in_order_);
+  query(select_in_order_, visitor);
+}
+
+void SqliteTransactionHistoryRepository::forEachInPartition(
+    std::size_t partition, std::size_t partition_count,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  std::int64_t begin = 0;
+  std::int64_t end = 0;
+  sqlite3_stmt *statement = nullptr;
+  {
+    // 境界の文と文の一覧は全パーティションで共有するため、排他して使う
+    std::lock_guard<std::mutex> lock(partition_mutex_);
+    {
+      ResetGuard reset(select_id_bounds_);
+      if (sqlite3_step(select_id_bounds_) != SQLITE_ROW ||
+          sqlite3_column_type(select_id_bounds_, 0) == SQLITE_NULL) {
+        return;
+      }
+      // 行IDの範囲を件数に比例させて分ける（欠番があっても漏れ・重複はない）
+      std::int64_t min_id = sqlite3_column_int64(select_id_bounds_, 0);
+      auto span = static_cast<std::uint64_t>(
+          sqlite3_column_int64(select_id_bounds_, 1) - min_id + 1);
+      begin = min_id + static_cast<std::int64_t>(span * partition /
+                                                 partition_count);
+      end = min_id + static_cast<std::int64_t>(span * (partition + 1) /
+                                               partition_count);
+    }
+    if (partition >= select_partitions_.size()) {
+      select_partitions_.resize(partition + 1, nullptr);
+    }
+    if (select_partitions_[partition] == nullptr) {
+      select_partitions_[partition] = prepare(
+          (std::string(COLUMNS) + " WHERE id >= ? AND id < ? ORDER BY id")
+              .c_str());
+    }
+    statement = select_partitions_[partition];
+  }
+
+  // 同じパーティションを同時に走査しない限り、この文は本スレッドだけが使う
+  ResetGuard reset(statement);
+  sqlite3_bind_int64(statement, 1, begin);
+  sqlite3_bind_int64(statement, 2, end);
+  query(statement, visitor);
+}
+
+std::uint64_t SqliteTransactionHistoryRepository::getGeneration() const {
+  return generation_;
+}
+
+void SqliteTransactionHistoryRepository::clear() {
+  flush();
+  execute("DELETE FROM transactions");
+  ++generation_;
+}
+
+void SqliteTransactionHistoryRepository::flush() {
+  if (pending_count_ == 0) {
+    return;
+  }
+  execute("COMMIT");
+  pending_count_ = 0;
+}
+
+void SqliteTransactionHistoryRepository::execute(const char *sql) const {
+  char *error = nullptr;
+  if (sqlite3_exec(db_, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+    std::string message = error ? error : sqlite3_errmsg(db_);
+    sqlite3_free(error);
+    throw std::runtime_error("SQLite error on " + path_ + ": " + message);
+  }
+}
+
+sqlite3_stmt *SqliteTransactionHistoryRepository::prepare(
+    const char *sql) const {
+  sqlite3_stmt *statement = nullptr;
+  if (sqlite3_prepare_v2(db_, sql, -1, &statement, nullptr) != SQLITE_OK) {
+    throw std::runtime_error("SQLite error on " + path_ + ": " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
+  return statement;
+}
+
+void SqliteTransactionHistoryRepository::close() {
+  for (sqlite3_stmt *statement :
+       {insert_, select_by_slot_, select_by_time_, select_all_,
+        select_in_order_, sum_revenue_, select_id_bounds_}) {
+    sqlite3_finalize(statement);
+  }
+  for (sqlite3_stmt *statement : select_partitions_) {
+    sqlite3_finalize(statement);
+  }
+  insert_ = select_by_slot_ = select_by_time_ = nullptr;
+  select_all_ = select_in_order_ = sum_revenue_ = select_id_bounds_ = nullptr;
+  select_partitions_.clear();
+  sqlite3_close(db_);
+  db_ = nullptr;
+}
+
+void SqliteTransactionHistoryRepository::query(
+    sqlite3_stmt *statement,
+    const std::function<void(const domain::TransactionRecord &)> &visitor)
+    const {
+  int status;
+  while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+    visitor(readRow(statement));
+  }
+  if (status != SQLITE_DONE) {
+    throw std::runtime_error("Cannot read transactions: " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
+}
+
+} // namespace interface_adapters
+} // namespace vending_machine
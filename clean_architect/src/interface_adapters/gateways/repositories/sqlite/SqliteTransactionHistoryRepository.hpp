@@ -0,0 +1,181 @@
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_SQLITE_TRANSACTION_HISTORY_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_SQLITE_TRANSACTION_HISTORY_HPP
+
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace vending_machine {
+namespace interface_adapters {
+
+/**
+ * @class SqliteTransactionHistoryRepository
+ * @brief トランザクション履歴を SQLite のファイルに保存する実装
+ *
+ * サーバ不要の組み込みデータベースとして SQLite を使います。
+ * ビルドオプション ENABLE_SQLITE_REPOSITORY を有効にした場合のみ
+ * interface_adapters_sqlite ライブラリとして作成されます。
+ *
+ * - ジャーナルは WAL モードで、読み取りが書き込みを待ちません
+ * - SQL はすべて準備（prepare）済みの文を使い回します。パーティション
+ *   単位の走査の文はパーティションごとに初回の呼び出しで準備します
+ * - 保存は batch_size 件ごとに1つのトランザクションにまとめます。
+ *   コミット前のレコードも本クラスの読み取りには含まれますが、
+ *   異常終了時には失われます（flush() で即座にコミットできます）
+ * - スロットIDとタイムスタンプに索引を張り、getBySlotId() と
+ *   getByTimeRange() は索引を使った検索になります
+ * - シーケンス番号は AUTOINCREMENT の行IDです。削除した行の番号も
+ *   再利用しないため、clear() や開き直しをまたいでも単調増加します
+ *
+ * 本クラスはスレッドセーフではありません。例外はパーティション単位の
+ * 走査で、異なるパーティションを同時に実行できます（forEachInPartition()
+ * を参照）。
+ */
+class SqliteTransactionHistoryRepository
+    : public domain::ITransactionHistoryRepository {
+public:
+  /**
+   * @brief 既定の1トランザクションあたりの保存件数
+   *
+   * 大きいほど保存1件あたりのコミットの費用が減る一方、プロセスが
+   * 異常終了すると未コミットの最大 batch_size - 1 件を失います。
+   * 64 件は、1件ずつコミットする場合に比べて保存が数倍速くなり、
+   * 失う件数は販売数十件分に収まる値です（比較は
+   * sqlite_history_benchmark）。失えない取引がある場合は、
+   * batch_size を 1 にするか、区切りごとに flush() を呼んでください。
+   * また synchronous=NORMAL のため、電源断ではコミット済みの直近の
+   * トランザクションも失われることがあります（データベースは壊れません）。
+   */
+  static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+
+  /**
+   * @brief コンストラクタ（ファイルが無ければ作成）
+   * @param path データベースファイルのパス
+   * @param batch_size 1トランザクションにまとめる保存件数
+   * @throw std::invalid_argument batch_size が 0 の場合
+   * @throw std::runtime_error データベースを開けない場合
+   */
+  explicit SqliteTransactionHistoryRepository(
+      const std::string &path, std::size_t batch_size = DEFAULT_BATCH_SIZE);
+
+  /**
+   * @brief デストラクタ（未コミットの保存をコミットして閉じる）
+   */
+  ~SqliteTransactionHistoryRepository() override;
+
+  SqliteTransactionHistoryRepository(
+      const SqliteTransactionHistoryRepository &) = delete;
+  SqliteTransactionHistoryRepository &
+  operator=(const SqliteTransactionHistoryRepository &) = delete;
+
+  /**
+   * @brief トランザクションを保存（batch_size 件たまるとコミット）
+   * @throw std::runtime_error 書き込めない場合
+   */
+  void save(const domain::TransactionRecord &record) override;
+
+  /**
+   * @brief すべてのトランザクション履歴を取得（タイムスタンプ降順）
+   */
+  std::vector<domain::TransactionRecord> getAll() const override;
+
+  /**
+   * @brief 指定スロットの履歴を取得（タイムスタンプ降順、索引を使用）
+   */
+  std::vector<domain::TransactionRecord>
+  getBySlotId(const domain::SlotId &slot_id) const override;
+
+  /**
+   * @brief 時間範囲 [from, to) の履歴を取得（タイムスタンプ降順、索引を使用）
+   */
+  std::vector<domain::TransactionRecord>
+  getByTimeRange(std::chrono::system_clock::time_point from,
+                 std::chrono::system_clock::time_point to) const;
+
+  /**
+   * @brief 売上集計（SQL の SUM で求める）
+   */
+  domain::Revenue getTotalRevenue() const override;
+
+  /**
+   * @brief 全件走査（保存順）
+   */
+  void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  /**
+   * @brief パーティション単位の走査（行IDの連続範囲で分担）
+   *
+   * 異なるパーティションは別々のスレッドから同時に呼べます。ただし
+   * すべてのパーティションが1つの接続を共有し、SQLite は接続ごとに
+   * 処理を直列化するため、行の読み出しは逐次に進みます。並列になるのは
+   * visitor の処理だけです。未コミットの保存も読めるよう、読み取り専用の
+   * 接続を別に開くことはしません。
+   */
+  void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override;
+
+  std::uint64_t getGeneration() const override;
+
+  /**
+   * @brief 履歴をクリア（すべての行を削除）
+   */
+  void clear() override;
+
+  /**
+   * @brief 未コミットの保存をコミット（無ければ何もしない）
+   * @throw std::runtime_error コミットできない場合
+   */
+  void flush();
+
+  /**
+   * @brief 未コミットの保存件数
+   */
+  std::size_t getPendingCount() const { return pending_count_; }
+
+  /**
+   * @brief データベースファイルのパス
+   */
+  const std::string &getPath() const { return path_; }
+
+private:
+  std::string path_;
+  std::size_t batch_size_;
+  sqlite3 *db_ = nullptr;
+  sqlite3_stmt *insert_ = nullptr;
+  sqlite3_stmt *select_by_slot_ = nullptr;
+  sqlite3_stmt *select_by_time_ = nullptr;
+  sqlite3_stmt *select_all_ = nullptr;      ///< タイムスタンプ降順
+  sqlite3_stmt *select_in_order_ = nullptr; ///< 行ID順
+  sqlite3_stmt *sum_revenue_ = nullptr;
+  sqlite3_stmt *select_id_bounds_ = nullptr; ///< partition_mutex_ で保護
+  /// パーティションごとの範囲検索（添字はパーティション番号）
+  mutable std::vector<sqlite3_stmt *> select_partitions_;
+  mutable std::mutex partition_mutex_;
+  std::size_t pending_count_ = 0;
+  std::uint64_t generation_ = 0;
+
+  void execute(const char *sql) const;
+  sqlite3_stmt *prepare(const char *sql) const;
+  void close();
+  // 準備済みの SELECT を実行し、結果を順に visitor に渡す
+  void query(
+      sqlite3_stmt *statement,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const;
+};
+
+} // namespace interface_adapters
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_REPOSITORIES_SQLITE_TRANSACTION_HISTORY_HPP
@@ -1,17 +1,58 @@
+#include "domain/sales/SalesRollup.hpp"
+#include "domain/sales/SalesSketches.hpp"
 #include "frameworks_drivers/ui/ConsoleUI.hpp"
 #include "interface_adapters/controllers/VendingMachineController.hpp"
 #include "interface_adapters/gateways/adapters/SimulatedCoinMech.hpp"
 #include "interface_adapters/gateways/adapters/SimulatedDispenser.hpp"
 #include "interface_adapters/gateways/adapters/SimulatedPaymentGateway.hpp"
+#include "interface_adapters/gateways/loaders/PlanogramLoader.hpp"
+#include "interface_adapters/gateways/repositories/BinaryFileMachineStateRepository.hpp"
+#include "interface_adapters/gateways/repositories/FilePurchaseJournal.hpp"
 #include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "interface_adapters/gateways/repositories/NotifyingTransactionHistoryRepository.hpp"
 #include "usecases/VendingMachineApplication.hpp"
+#include <chrono>
+#include <fstream>
 #include <iostream>
 
-int main() {
+namespace {
+
+// プラノグラムファイルからスロットを登録する。読めなかった行は報告する
+bool loadPlanogram(vending_machine::usecases::VendingMachineApplication &app,
+                   const std::string &path) {
+  using vending_machine::interface_adapters::PlanogramLoader;
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::cerr << "プラノグラムを開けません: " << path << "\n";
+    return false;
+  }
+
+  PlanogramLoader loader;
+  auto result = loader.load(in, PlanogramLoader::formatFromPath(path),
+                            [&app](std::string_view,
+                                   const vending_machine::domain::ProductSlot
+                                       &slot) { app.addSlot(slot); });
+  for (const auto &error : result.errors) {
+    std::cerr << path << ":" << error.line << ": " << error.message << "\n";
+  }
+  return result.slots_loaded > 0;
+}
+
+} // namespace
+
+// 使い方: vending_machine [プラノグラムファイル（.csv / .json）]
+int main(int argc, char *argv[]) {
   try {
     // インフラストラクチャの実装を作成
     vending_machine::interface_adapters::InMemoryTransactionHistoryRepository
-        transaction_history;
+        transaction_store;
+    // 保存のたびに時間帯別の売上集計とスケッチを更新する
+    vending_machine::domain::SalesRollup sales_rollup;
+    vending_machine::domain::SalesSketches sales_sketches;
+    vending_machine::interface_adapters::NotifyingTransactionHistoryRepository
+        transaction_history(transaction_store);
+    transaction_history.addListener(sales_rollup);
+    transaction_history.addListener(sales_sketches);
     vending_machine::interface_adapters::SimulatedCoinMech coin_mech;
     vending_machine::interface_adapters::SimulatedDispenser dispenser;
     vending_machine::interface_adapters::SimulatedPaymentGateway
@@ -20,9 +61,41 @@ int main() {
     // アプリケーションファサードを作成
     vending_machine::usecases::VendingMachineApplication app(
         coin_mech, dispenser, payment_gateway, transaction_history);
+    app.getSalesReportingUseCase().setRollup(&sales_rollup);
+    app.getSalesReportingUseCase().setSketches(&sales_sketches);
+
+    // 前回のチェックポイントがあれば復元し、無ければ初期在庫を設定
+    vending_machine::interface_adapters::BinaryFileMachineStateRepository
+        checkpoint("vending_machine.ckpt");
+    app.enableCheckpoints(checkpoint, std::chrono::seconds(30));
+    std::optional<vending_machine::usecases::RestoreOutcome> restored;
+    try {
+      restored = app.restoreCheckpoint();
+    } catch (const std::runtime_error &e) {
+      std::cerr << "チェックポイントを読み込めません: " << e.what() << "\n";
+    }
+    using vending_machine::usecases::RestoreOutcome;
+    if (!restored.has_value()) {
+      if (argc < 2 || !loadPlanogram(app, argv[1])) {
+        app.initializeInventory();
+      }
+    } else if (*restored == RestoreOutcome::DISPENSE_ROLLED_BACK) {
+      std::cerr << "排出中に停止したため在庫を戻しました。返金してください。\n";
+    }
 
-    // 初期在庫を設定
-    app.initializeInventory();
+    // チェックポイントの後の現金購入を再適用し、停止時に途中だった購入を
+    // ジャーナルの記録に従って完了・取り消し
+    vending_machine::interface_adapters::FilePurchaseJournal purchase_journal(
+        "vending_machine.journal");
+    app.enablePurchaseJournal(purchase_journal);
+    auto recovery = app.recoverPurchases();
+    if (!recovery.purchases.empty()) {
+      std::cerr << "途中の購入を復旧しました（完了 " << recovery.rolled_forward
+                << " 件、取り消し " << recovery.rolled_back << " 件）\n";
+    }
+    if (!recovery.purchases.empty() || recovery.replayed > 0) {
+      app.saveCheckpoint(); // 再適用した購入をジャーナルから除く
+    }
 
     // コントローラーを作成 (必要なユースケースのみを注入)
     vending_machine::interface_adapters::VendingMachineController controller(
@@ -31,8 +104,10 @@ int main() {
         app.getCashCollectionUseCase());
 
     // UIを作成して実行
-    vending_machine::frameworks_drivers::ui::ConsoleUI ui(controller);
+    vending_machine::frameworks_drivers::ui::ConsoleUI ui(
+        controller, [&app] { app.checkpointIfDue(); });
     ui.run();
+    app.saveCheckpoint();
   } catch (const std::exception &e) {
     std::cerr << "エラーが発生しました: " << e.what() << std::endl;
     return 1;
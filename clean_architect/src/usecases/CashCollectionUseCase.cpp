@@ -7,12 +7,12 @@ CashCollectionUseCase::CashCollectionUseCase(
     domain::ITransactionHistoryRepository &transaction_history)
     : transaction_history_(transaction_history) {}
 
-domain::Money CashCollectionUseCase::getTotalRevenue() const {
+domain::Revenue CashCollectionUseCase::getTotalRevenue() const {
   return transaction_history_.getTotalRevenue();
 }
 
-domain::Money CashCollectionUseCase::collectCash() {
-  domain::Money total = transaction_history_.getTotalRevenue();
+domain::Revenue CashCollectionUseCase::collectCash() {
+  domain::Revenue total = transaction_history_.getTotalRevenue();
   transaction_history_.clear();
   return total;
 }
@@ -13,7 +13,7 @@
 #ifndef VENDING_MACHINE_APPLICATION_USECASES_CASH_COLLECTION_USECASE_HPP
 #define VENDING_MACHINE_APPLICATION_USECASES_CASH_COLLECTION_USECASE_HPP
 
-#include "domain/common/Money.hpp"
+#include "domain/common/Revenue.hpp"
 #include "domain/repositories/ITransactionHistoryRepository.hpp"
 
 namespace vending_machine {
@@ -38,13 +38,13 @@ public:
    * @brief 売上金の合計を取得
    * @return 売上金の合計
    */
-  domain::Money getTotalRevenue() const;
+  domain::Revenue getTotalRevenue() const;
 
   /**
    * @brief 売上金を回収して履歴をクリア
    * @return 回収した売上金の合計
    */
-  domain::Money collectCash();
+  domain::Revenue collectCash();
 
 private:
   domain::ITransactionHistoryRepository &transaction_history_;
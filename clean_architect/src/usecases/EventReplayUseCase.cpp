@@ -0,0 +1,195 @@
+#include "usecases/EventReplayUseCase.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace vending_machine {
+namespace usecases {
+
+namespace {
+
+/**
+ * @brief 1パーティション分のスロットの再生状態
+ */
+struct SlotPartition {
+  struct Slot {
+    std::optional<domain::ProductInfo> product_info;
+    int stock = 0;
+  };
+  std::unordered_map<int, Slot> slots;
+
+  void apply(const domain::DomainEvent &event) {
+    if (event.type == domain::DomainEventType::SLOT_CONFIGURED) {
+      auto &slot = slots[event.slot_id];
+      slot.product_info.emplace(
+          domain::ProductName(std::string(event.product_name)),
+          domain::Price(event.price));
+      slot.stock = event.value;
+      return;
+    }
+    // スロットのイベントは変化後の在庫数を持つので、そのまま置き換える
+    auto it = slots.find(event.slot_id);
+    if (it == slots.end()) {
+      throw std::domain_error("Event for unknown slot: " +
+                              std::to_string(event.slot_id));
+    }
+    it->second.stock = event.value;
+  }
+};
+
+} // namespace
+
+EventReplayUseCase::EventReplayUseCase(const domain::EventLog &event_log)
+    : event_log_(event_log) {}
+
+ReplayResult EventReplayUseCase::replay(std::size_t thread_count) const {
+  return replayUntil(event_log_.getLastSequence(), thread_count);
+}
+
+ReplayResult EventReplayUseCase::replayUntil(std::uint64_t sequence,
+                                             std::size_t thread_count) const {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const auto &events = event_log_.getEvents();
+  std::uint64_t target =
+      std::min<std::uint64_t>(sequence, event_log_.getLastSequence());
+
+  const domain::EventSnapshot *snapshot = event_log_.findSnapshot(target);
+  if (snapshot == nullptr && event_log_.getFirstSequence() > 1) {
+    throw std::out_of_range("Events up to sequence " + std::to_string(target) +
+                            " have been discarded");
+  }
+  domain::MachineState base =
+      snapshot != nullptr
+          ? snapshot->state
+          : domain::MachineState{domain::SalesId(1), domain::Mode::NORMAL,
+                                 domain::Money(0), {}, std::nullopt};
+  std::uint64_t from = snapshot != nullptr ? snapshot->sequence + 1 : 1;
+  std::uint64_t first_in_memory = event_log_.getFirstSequence();
+
+  // メモリから外したイベントはストアから読み出す。
+  // 商品名は読み出しの間だけ有効なので、ここで複製を持つ
+  std::vector<domain::DomainEvent> stored;
+  std::unordered_set<std::string> stored_names;
+  if (from < first_in_memory && from <= target) {
+    const domain::IEventStore *store = event_log_.getStore();
+    if (store == nullptr) {
+      throw std::out_of_range("Events from sequence " + std::to_string(from) +
+                              " have been discarded");
+    }
+    std::uint64_t stored_last = std::min(target, first_in_memory - 1);
+    stored.reserve(static_cast<std::size_t>(stored_last + 1 - from));
+    store->forEach(from, stored_last,
+                   [&stored, &stored_names](const domain::DomainEvent &event) {
+                     stored.push_back(event);
+                     if (!event.product_name.empty()) {
+                       stored.back().product_name =
+                           *stored_names.emplace(event.product_name).first;
+                     }
+                   });
+    if (stored.size() != stored_last + 1 - from) {
+      throw std::out_of_range("Event store is missing events before " +
+                              std::to_string(first_in_memory));
+    }
+  }
+  // 通番 n のイベントは events[n - getFirstSequence()]
+  auto first = static_cast<std::size_t>(std::max(from, first_in_memory) -
+                                        first_in_memory);
+  auto last = static_cast<std::size_t>(
+      std::max(target + 1, first_in_memory) - first_in_memory);
+
+  std::vector<SlotPartition> partitions(thread_count);
+  for (const auto &slot : base.slots) {
+    int id = slot.slot_id.getValue();
+    partitions[id % thread_count].slots[id] = {slot.product_info,
+                                               slot.stock.getValue()};
+  }
+
+  // スロットのイベントを1回の走査でパーティションに振り分け、
+  // Wallet とモードのイベントは順序に意味があるため、このスレッドで順に再生
+  std::vector<std::vector<const domain::DomainEvent *>> buckets(thread_count);
+  int balance = base.balance.getRawValue();
+  domain::Mode mode = base.mode;
+  auto dispatch = [&](const domain::DomainEvent &event) {
+    if (event.isSlotEvent()) {
+      buckets[static_cast<std::size_t>(event.slot_id) % thread_count]
+          .push_back(&event);
+      return;
+    }
+    switch (event.type) {
+    case domain::DomainEventType::CASH_DEPOSITED:
+    case domain::DomainEventType::EMONEY_AUTHORIZED:
+      balance += event.value;
+      break;
+    case domain::DomainEventType::BALANCE_WITHDRAWN:
+      balance -= event.value;
+      break;
+    case domain::DomainEventType::MODE_CHANGED:
+      mode = static_cast<domain::Mode>(event.value);
+      break;
+    default:
+      break;
+    }
+  };
+  for (const auto &event : stored) {
+    dispatch(event);
+  }
+  for (std::size_t i = first; i < last; ++i) {
+    dispatch(events[i]);
+  }
+
+  std::vector<std::exception_ptr> errors(thread_count);
+  auto replay_partition = [&](std::size_t partition) {
+    try {
+      for (const auto *event : buckets[partition]) {
+        partitions[partition].apply(*event);
+      }
+    } catch (...) {
+      errors[partition] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(thread_count - 1);
+  for (std::size_t partition = 1; partition < thread_count; ++partition) {
+    workers.emplace_back(replay_partition, partition);
+  }
+  replay_partition(0);
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  ReplayResult result{domain::MachineState{base.sales_id, mode,
+                                           domain::Money(balance), {},
+                                           std::nullopt},
+                      target, stored.size() + (last - first)};
+  for (const auto &partition : partitions) {
+    for (const auto &[id, slot] : partition.slots) {
+      result.state.slots.push_back({domain::SlotId(id), *slot.product_info,
+                                    domain::Quantity(slot.stock)});
+    }
+  }
+  std::sort(result.state.slots.begin(), result.state.slots.end(),
+            [](const domain::SlotState &a, const domain::SlotState &b) {
+              return a.slot_id.getValue() < b.slot_id.getValue();
+            });
+  return result;
+}
+
+} // namespace usecases
+} // namespace vending_machine
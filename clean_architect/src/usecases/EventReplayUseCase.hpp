@@ -0,0 +1,88 @@
+/**
+ * @file EventReplayUseCase.hpp
+ * @brief EventReplayUseCase - ドメインイベントの再生による状態の再構築
+ *
+ * @details
+ * EventLog のイベントを再生し、Inventory・Wallet・Sales の状態
+ * （MachineState）を組み立て直すユースケースです。任意の通番の時点の
+ * 状態も得られるため、監査や障害調査（その時点の状態の再現）に使えます。
+ *
+ * 再生は指定の通番以前で最新のスナップショットから始めます。
+ * 必要なイベントが EventLog のメモリに無い場合はストアから読み出します。
+ * スロットのイベントはスロットごとに独立しているため、
+ * SlotId でパーティションに分けて複数スレッドで並列に再生します。
+ * イベント列は呼び出し元のスレッドで1回だけ走査してパーティションごとに
+ * 振り分け、各スレッドは自分の分だけを再生します。
+ * Wallet とモードのイベントは振り分けの走査の中で順に再生します。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_APPLICATION_USECASES_EVENT_REPLAY_USECASE_HPP
+#define VENDING_MACHINE_APPLICATION_USECASES_EVENT_REPLAY_USECASE_HPP
+
+#include "domain/events/EventLog.hpp"
+#include "domain/repositories/IMachineStateRepository.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace vending_machine {
+namespace usecases {
+
+/**
+ * @struct ReplayResult
+ * @brief 再生の結果
+ */
+struct ReplayResult {
+  domain::MachineState state; ///< 再構築した状態（session は常に空）
+  std::uint64_t sequence;     ///< 反映した最後のイベントの通番
+  std::size_t events_applied; ///< スナップショット以降に再生した件数
+};
+
+/**
+ * @class EventReplayUseCase
+ * @brief イベントログから状態を再構築するユースケース
+ *
+ * 取引セッションの進行はイベントにしていないため、
+ * 再構築した状態に進行中のセッションは含まれません。
+ */
+class EventReplayUseCase {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param event_log 再生するイベントログ
+   */
+  explicit EventReplayUseCase(const domain::EventLog &event_log);
+
+  /**
+   * @brief すべてのイベントを再生
+   * @param thread_count スロットの再生に使うスレッド数
+   *        （0 の場合は std::thread::hardware_concurrency()、1 の場合は直列）
+   * @return 再生の結果
+   * @throw std::domain_error 登録されていないスロットのイベントがある場合
+   * @throw std::out_of_range 再生に必要なイベントが無い場合
+   */
+  ReplayResult replay(std::size_t thread_count = 1) const;
+
+  /**
+   * @brief 指定の通番までのイベントを再生（その時点の状態を再現）
+   * @param sequence 最後に反映するイベントの通番
+   *        （記録済みの最後の通番より大きい場合は最後まで）
+   * @param thread_count replay() と同じ
+   * @return 再生の結果
+   * @throw std::domain_error 登録されていないスロットのイベントがある場合
+   * @throw std::out_of_range 最初のスナップショットより前の通番を
+   *        指定した場合（記録を始める前の状態は再現できない）
+   */
+  ReplayResult replayUntil(std::uint64_t sequence,
+                           std::size_t thread_count = 1) const;
+
+private:
+  const domain::EventLog &event_log_;
+};
+
+} // namespace usecases
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_APPLICATION_USECASES_EVENT_REPLAY_USECASE_HPP
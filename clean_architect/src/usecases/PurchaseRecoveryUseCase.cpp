@@ -0,0 +1,202 @@
+#include "usecases/PurchaseRecoveryUseCase.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include "domain/payment/Wallet.hpp"
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include "domain/sales/Sales.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace vending_machine {
+namespace usecases {
+
+PurchaseRecoveryUseCase::PurchaseRecoveryUseCase(
+    domain::Inventory &inventory, domain::Wallet &wallet,
+    const domain::Sales &sales,
+    domain::ITransactionHistoryRepository &transaction_history,
+    domain::IPurchaseJournal &journal)
+    : inventory_(inventory), wallet_(wallet), sales_(sales),
+      transaction_history_(transaction_history), journal_(journal) {}
+
+PurchaseRecoveryReport PurchaseRecoveryUseCase::recover(
+    std::optional<std::uint32_t> checkpoint_position) {
+  PurchaseRecoveryReport report;
+  auto entries = journal_.readAll();
+  if (entries.empty()) {
+    return report;
+  }
+
+  // 購入ごとに最後のエントリだけを残す（最初に現れた順）
+  std::vector<domain::PurchaseJournalEntry> latest;
+  std::unordered_map<std::uint32_t, std::size_t> index;
+  for (const auto &entry : entries) {
+    auto [it, inserted] = index.emplace(entry.purchase_id, latest.size());
+    if (inserted) {
+      latest.push_back(entry);
+    } else {
+      latest[it->second] = entry;
+    }
+  }
+
+  std::unordered_set<int> saved_sessions = findSavedSessions(latest);
+  for (auto entry : latest) {
+    // チェックポイントの状態に反映されていない購入か
+    bool after_checkpoint = checkpoint_position.has_value() &&
+                            entry.purchase_id > *checkpoint_position;
+    if (entry.isSettled()) {
+      if (after_checkpoint &&
+          entry.step == domain::PurchaseStep::COMMITTED) {
+        // 履歴は完了の記録の前に保存済み
+        applyPurchase(entry);
+        ++report.replayed;
+      }
+      continue;
+    }
+    RecoveryAction action =
+        entry.step >= domain::PurchaseStep::PRODUCT_DISPENSED
+            ? RecoveryAction::ROLLED_FORWARD
+            : RecoveryAction::ROLLED_BACK;
+    report.purchases.push_back(
+        {entry.purchase_id, entry.slot_id, entry.step, action});
+    if (action == RecoveryAction::ROLLED_FORWARD) {
+      if (!checkpoint_position.has_value()) {
+        reconcilePurchase(entry);
+      } else if (after_checkpoint) {
+        applyPurchase(entry);
+      }
+      // 履歴の保存と完了の記録の間で停止した購入は保存済み
+      if (saved_sessions.count(entry.session_id) == 0) {
+        saveHistory(entry);
+      }
+      ++report.rolled_forward;
+      entry.step = domain::PurchaseStep::COMMITTED;
+    } else {
+      // チェックポイントの後の購入は在庫減算も反映されていない
+      if (!checkpoint_position.has_value()) {
+        revertReservation(entry);
+      }
+      ++report.rolled_back;
+      entry.step = domain::PurchaseStep::ABORTED;
+    }
+    journal_.append(entry);
+  }
+  journal_.discardSettled();
+  return report;
+}
+
+namespace {
+
+/**
+ * @brief 購入の後の残高（代金と、返却済みならお釣りを除いた額）
+ */
+int balanceAfter(const domain::PurchaseJournalEntry &entry) {
+  int paid = entry.balance_before - entry.price;
+  return entry.step >= domain::PurchaseStep::CHANGE_RETURNED
+             ? paid - entry.change
+             : paid;
+}
+
+} // namespace
+
+void PurchaseRecoveryUseCase::applyPurchase(
+    const domain::PurchaseJournalEntry &entry) {
+  if (entry.slot_id <= 0) {
+    return;
+  }
+  inventory_.tryDispense(domain::SlotId(entry.slot_id));
+
+  int balance = wallet_.getBalance().getRawValue();
+  int target = balanceAfter(entry);
+  if (balance > target) {
+    wallet_.tryWithdraw(domain::Money(balance - target));
+  } else if (balance < target) {
+    // 保存の後、購入の前に投入された現金
+    wallet_.depositCash(domain::Money(target - balance));
+  }
+}
+
+void PurchaseRecoveryUseCase::reconcilePurchase(
+    const domain::PurchaseJournalEntry &entry) {
+  if (entry.slot_id <= 0) {
+    return;
+  }
+  domain::SlotId slot_id(entry.slot_id);
+
+  // 在庫: 減算前の在庫数のままなら減算する
+  const auto *slot = inventory_.findSlot(slot_id);
+  if (slot != nullptr && slot->getStock().getValue() == entry.stock_before) {
+    inventory_.tryDispense(slot_id);
+  }
+
+  // 残高: 代金（返却済みならお釣りも）を引き落とした後の値に揃える
+  int balance = wallet_.getBalance().getRawValue();
+  int paid = entry.balance_before - entry.price;
+  int target = balanceAfter(entry);
+  if ((balance == entry.balance_before || balance == paid) &&
+      balance > target) {
+    wallet_.tryWithdraw(domain::Money(balance - target));
+  }
+}
+
+void PurchaseRecoveryUseCase::saveHistory(
+    const domain::PurchaseJournalEntry &entry) {
+  if (entry.slot_id <= 0) {
+    return;
+  }
+  domain::TransactionRecord record(sales_.getId(),
+                                  domain::SlotId(entry.slot_id),
+                                  domain::Price(entry.price),
+                                  domain::PaymentMethodType::CASH);
+  if (entry.session_id > 0) {
+    record = record.withSessionId(domain::SessionId(entry.session_id));
+  }
+  transaction_history_.save(record);
+}
+
+std::unordered_set<int> PurchaseRecoveryUseCase::findSavedSessions(
+    const std::vector<domain::PurchaseJournalEntry> &entries) const {
+  // 前進させる購入（履歴を保存する可能性があるもの）
+  std::unordered_map<int, const domain::PurchaseJournalEntry *> pending;
+  for (const auto &entry : entries) {
+    if (!entry.isSettled() &&
+        entry.step >= domain::PurchaseStep::PRODUCT_DISPENSED &&
+        entry.session_id > 0) {
+      pending.emplace(entry.session_id, &entry);
+    }
+  }
+
+  std::unordered_set<int> saved;
+  if (pending.empty()) {
+    return saved;
+  }
+  transaction_history_.forEach([&](const domain::TransactionRecord &record) {
+    if (!record.getSessionId() ||
+        record.getPaymentMethod() != domain::PaymentMethodType::CASH) {
+      return;
+    }
+    auto it = pending.find(record.getSessionId()->getValue());
+    if (it != pending.end() &&
+        record.getSlotId().getValue() == it->second->slot_id &&
+        record.getPrice().getRawValue() == it->second->price) {
+      saved.insert(it->first);
+    }
+  });
+  return saved;
+}
+
+void PurchaseRecoveryUseCase::revertReservation(
+    const domain::PurchaseJournalEntry &entry) {
+  if (entry.slot_id <= 0) {
+    return;
+  }
+  // 在庫: 減算が反映されていれば戻す。残高は変更していない
+  domain::SlotId slot_id(entry.slot_id);
+  const auto *slot = inventory_.findSlot(slot_id);
+  if (slot != nullptr &&
+      slot->getStock().getValue() == entry.stock_before - 1) {
+    inventory_.tryRevertDispense(slot_id);
+  }
+}
+
+} // namespace usecases
+} // namespace vending_machine
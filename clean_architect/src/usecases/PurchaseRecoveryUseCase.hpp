@@ -0,0 +1,160 @@
+/**
+ * @file PurchaseRecoveryUseCase.hpp
+ * @brief PurchaseRecoveryUseCase - 停止前の購入の復旧
+ *
+ * @details
+ * 起動時に購入ジャーナルを読み、決着していない（COMMITTED / ABORTED の
+ * 記録が無い）購入を、最後に完了した手順に応じて前進または後退させます。
+ *
+ * - 商品の排出が済んでいた購入は前進させます。在庫を減算し、代金を
+ *   引き落とし、取引履歴に保存します。お釣りの返却が記録されていない
+ *   場合、お釣りは残高に残します（続く返金操作で払い戻されます）。
+ * - 排出前の購入は後退させます。在庫を戻し、残高はそのまま残します。
+ *
+ * 起動時の在庫・残高は定期保存したチェックポイントから復元したもので、
+ * チェックポイントには反映済みの最後の購入通番を記録しています。
+ * - その通番より後の購入は状態に反映されていないため、完了していた購入も
+ *   含めて通番順に再適用します。在庫を1個減らし、残高を購入の後の値
+ *   （開始時の残高から代金と返却済みのお釣りを除いた額）に揃えます。
+ *   保存の後に投入された現金もこれで残高に戻ります。
+ * - その通番までの購入は状態に反映済みのため、在庫・残高を変更しません。
+ *
+ * チェックポイントを復元していない場合は、ジャーナルに記録した
+ * 開始時の在庫数・残高と比べ、まだ反映されていない変更だけを適用します
+ * （どちらとも一致しない場合は変更しません）。
+ *
+ * 購入の取引履歴にはジャーナルと同じセッションIDを付けます。前進させる
+ * 購入と同じセッションID・スロット・価格の現金取引が履歴にあれば、
+ * 履歴への保存と完了の記録の間で停止したものとして保存しません。
+ * セッションIDはジャーナルに記録した値の続きから採番するため、
+ * 再起動をまたいでも重複しません。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_APPLICATION_USECASES_PURCHASE_RECOVERY_USECASE_HPP
+#define VENDING_MACHINE_APPLICATION_USECASES_PURCHASE_RECOVERY_USECASE_HPP
+
+#include "domain/repositories/IPurchaseJournal.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+class ITransactionHistoryRepository;
+class Inventory;
+class Wallet;
+class Sales;
+} // namespace domain
+
+namespace usecases {
+
+/**
+ * @enum RecoveryAction
+ * @brief 決着していなかった購入の扱い
+ */
+enum class RecoveryAction {
+  ROLLED_FORWARD, ///< 完了させた（排出済みだった）
+  ROLLED_BACK     ///< 取り消した（排出前だった）
+};
+
+/**
+ * @struct RecoveredPurchase
+ * @brief 復旧した購入1件
+ */
+struct RecoveredPurchase {
+  std::uint32_t purchase_id;      ///< 購入の通番
+  int slot_id;                    ///< スロットID
+  domain::PurchaseStep last_step; ///< 停止前に完了していた手順
+  RecoveryAction action;          ///< 扱い
+};
+
+/**
+ * @struct PurchaseRecoveryReport
+ * @brief 復旧の結果
+ */
+struct PurchaseRecoveryReport {
+  std::vector<RecoveredPurchase> purchases; ///< 復旧した購入（通番順）
+  std::size_t rolled_forward = 0;           ///< 完了させた件数
+  std::size_t rolled_back = 0;              ///< 取り消した件数
+  std::size_t replayed = 0; ///< 再適用した完了済みの購入の件数
+};
+
+/**
+ * @class PurchaseRecoveryUseCase
+ * @brief 購入ジャーナルから停止前の購入を復旧するユースケース
+ */
+class PurchaseRecoveryUseCase {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param inventory 在庫集約
+   * @param wallet 通貨管理集約
+   * @param sales 販売管理集約（履歴の販売IDの取得用）
+   * @param transaction_history トランザクション履歴リポジトリ
+   * @param journal 購入ジャーナル
+   */
+  PurchaseRecoveryUseCase(
+      domain::Inventory &inventory, domain::Wallet &wallet,
+      const domain::Sales &sales,
+      domain::ITransactionHistoryRepository &transaction_history,
+      domain::IPurchaseJournal &journal);
+
+  /**
+   * @brief 停止前の購入を復旧
+   * @param checkpoint_position 復元したチェックポイントに反映済みの
+   *        購入通番（チェックポイントを復元していない場合は std::nullopt）
+   * @return 復旧の結果
+   *
+   * 復旧した購入ごとに決着（COMMITTED / ABORTED）を追記するため、
+   * 復旧の途中で停止しても、次回は残りの購入から再開します。
+   * 再適用した完了済みの購入は、次にチェックポイントを保存するまで
+   * 再起動のたびに同じ状態から再適用されます。
+   */
+  PurchaseRecoveryReport
+  recover(std::optional<std::uint32_t> checkpoint_position = std::nullopt);
+
+private:
+  domain::Inventory &inventory_;
+  domain::Wallet &wallet_;
+  const domain::Sales &sales_;
+  domain::ITransactionHistoryRepository &transaction_history_;
+  domain::IPurchaseJournal &journal_;
+
+  /**
+   * @brief 反映されていない購入を適用（チェックポイントの後の購入）
+   */
+  void applyPurchase(const domain::PurchaseJournalEntry &entry);
+
+  /**
+   * @brief 開始時の在庫数・残高と比べて未反映の変更だけを適用
+   */
+  void reconcilePurchase(const domain::PurchaseJournalEntry &entry);
+
+  /**
+   * @brief 開始時の在庫数と比べて反映済みの在庫減算を戻す
+   */
+  void revertReservation(const domain::PurchaseJournalEntry &entry);
+
+  /**
+   * @brief 購入の取引履歴を保存（セッションIDを付ける）
+   */
+  void saveHistory(const domain::PurchaseJournalEntry &entry);
+
+  /**
+   * @brief 前進させる購入のうち、履歴に保存済みのもののセッションID
+   *
+   * 該当する購入がある場合に限り、履歴を1回だけ走査します。
+   */
+  std::unordered_set<int> findSavedSessions(
+      const std::vector<domain::PurchaseJournalEntry> &entries) const;
+};
+
+} // namespace usecases
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_APPLICATION_USECASES_PURCHASE_RECOVERY_USECASE_HPP
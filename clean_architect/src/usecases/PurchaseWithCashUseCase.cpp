@@ -8,7 +8,11 @@
 #include "domain/sales/SessionId.hpp"
 #include "domain/sales/TransactionRecord.hpp"
 #include "domain/services/PurchaseEligibilityService.hpp"
+#include "usecases/dto/ProductDtoMapper.hpp"
+#include <algorithm>
 #include <atomic>
+#include <optional>
+#include <utility>
 
 namespace vending_machine {
 namespace usecases {
@@ -38,78 +42,159 @@ void PurchaseWithCashUseCase::insertCash(
 
 std::vector<dto::ProductDto>
 PurchaseWithCashUseCase::getEligibleProducts() const {
-  // ドメインサービスを使用して購入可能商品を算出
-  auto eligible_products =
-      domain::PurchaseEligibilityService::calculateEligibleProducts(
-          inventory_, wallet_, coin_mech_);
-
-  std::vector<dto::ProductDto> dtos;
-  for (const auto &product : eligible_products) {
-    // 在庫数を取得するためにInventoryにアクセス
-    int stock = inventory_.getSlot(product.getSlotId()).getStock().getValue();
-
-    dtos.push_back({product.getSlotId().getValue(),
-                    product.getProductInfo().getName().getValue(),
-                    product.getProductInfo().getPrice().getRawValue(), stock});
-  }
-  return dtos;
+  std::vector<dto::ProductView> views;
+  getEligibleProductViews(views);
+  return dto::toProductDtos(views);
+}
+
+dto::PmrProductList PurchaseWithCashUseCase::getEligibleProducts(
+    std::pmr::memory_resource *resource) const {
+  domain::PurchaseEligibilityService::collectEligibleProducts(
+      inventory_, wallet_, coin_mech_, snapshot_buffer_);
+  return dto::toProductDtos(snapshot_buffer_, resource);
+}
+
+std::size_t PurchaseWithCashUseCase::getEligibleProductViews(
+    std::vector<dto::ProductView> &out) const {
+  // ドメインサービスを使用して購入可能商品を算出（在庫数も同時に得られる）
+  domain::PurchaseEligibilityService::collectEligibleProducts(
+      inventory_, wallet_, coin_mech_, snapshot_buffer_);
+  return dto::toProductViews(snapshot_buffer_, out);
 }
 
 dto::PurchaseResponse PurchaseWithCashUseCase::selectAndPurchase(
     const dto::PurchaseRequest &request) {
+  auto result = trySelectAndPurchase(request);
+  domain::throwIfError(result.error());
+  return result.value();
+}
+
+domain::Expected<dto::PurchaseResponse>
+PurchaseWithCashUseCase::trySelectAndPurchase(
+    const dto::PurchaseRequest &request) {
+  if (request.slot_id <= 0) {
+    return domain::ErrorCode::SLOT_NOT_FOUND;
+  }
   domain::SlotId slot_id(request.slot_id);
 
-  // 1. 商品選択（Sales集約）
-  sales_.selectProduct(slot_id);
+  // 0. 事前条件の確認（失敗時は何も変更しない）
+  const domain::ProductSlot *product_slot = inventory_.findSlot(slot_id);
+  if (product_slot == nullptr) {
+    return domain::ErrorCode::SLOT_NOT_FOUND;
+  }
+  if (!product_slot->isAvailable()) {
+    return domain::ErrorCode::OUT_OF_STOCK;
+  }
 
-  // 2. 商品情報取得
-  const auto &product_slot = inventory_.getSlot(slot_id);
-  const auto &product_info = product_slot.getProductInfo();
+  // 1. 商品情報取得
+  const auto &product_info = product_slot->getProductInfo();
   const auto &price = product_info.getPrice();
+  domain::Money payment(price.getRawValue());
+  if (wallet_.getBalance() < payment) {
+    return domain::ErrorCode::INSUFFICIENT_BALANCE;
+  }
+
+  // 2. 商品選択（Sales集約）
+  domain::ErrorCode error = sales_.trySelectProduct(slot_id);
+  if (error != domain::ErrorCode::OK) {
+    return error;
+  }
 
   // 3. 決済待ち状態に遷移
-  sales_.markPaymentPending();
+  error = sales_.tryMarkPaymentPending();
+  if (error != domain::ErrorCode::OK) {
+    return error;
+  }
+
+  // 以降の各手順の完了をジャーナルに記録する（停止後の復旧用）
+  const auto *session = sales_.getCurrentSession();
+  domain::PurchaseJournalEntry entry{
+      next_purchase_id_,
+      domain::PurchaseStep::STARTED,
+      request.slot_id,
+      price.getRawValue(),
+      product_slot->getStock().getValue(),
+      wallet_.getBalance().getRawValue(),
+      0,
+      session != nullptr ? session->getSessionId().getValue() : 0};
+  if (journal_ != nullptr) {
+    ++next_purchase_id_;
+    journal_->append(entry);
+  }
 
   // 4. 在庫減算（イベントストーミング Step 5）
-  inventory_.dispense(slot_id);
+  error = inventory_.tryDispense(slot_id);
+  if (error != domain::ErrorCode::OK) {
+    recordStep(entry, domain::PurchaseStep::ABORTED);
+    return error;
+  }
+  recordStep(entry, domain::PurchaseStep::STOCK_RESERVED);
 
-  try {
-    // 5. 排出中状態に遷移（イベントストーミング Step 6準備）
-    sales_.markDispensing();
+  // 5. 排出中状態に遷移（イベントストーミング Step 6準備）
+  error = sales_.tryMarkDispensing();
+  if (error != domain::ErrorCode::OK) {
+    inventory_.tryRevertDispense(slot_id);
+    recordStep(entry, domain::PurchaseStep::ABORTED);
+    return error;
+  }
 
+  int change = 0;
+  bool dispensed = false;
+  try {
     // 6. 商品排出（イベントストーミング Step 6）
     dispenser_.dispense(product_info);
+    dispensed = true;
+    recordStep(entry, domain::PurchaseStep::PRODUCT_DISPENSED);
 
     // 7. 決済確定（イベントストーミング Step 7）
-    domain::Money payment(price.getRawValue());
-    wallet_.withdraw(payment);
+    // 残高は事前に確認済みのため失敗しない
+    wallet_.tryWithdraw(payment);
+    domain::Money remaining_balance = wallet_.getBalance();
+    change = remaining_balance.getRawValue();
+    entry.change = change;
+    recordStep(entry, domain::PurchaseStep::PAYMENT_CAPTURED);
 
     // 8. お釣り返却（イベントストーミング Step 8）
-    domain::Money remaining_balance = wallet_.getBalance();
-    int change = remaining_balance.getRawValue();
     if (change > 0) {
       coin_mech_.dispense(remaining_balance);
       // 残高をゼロに
-      wallet_.withdraw(remaining_balance);
+      wallet_.tryWithdraw(remaining_balance);
+      recordStep(entry, domain::PurchaseStep::CHANGE_RETURNED);
     }
 
-    // 9. トランザクション完了
-    sales_.completeTransaction();
+    // 9. トランザクション完了（完了するとセッションが外れるため、
+    //    履歴に載せる販売ID・セッションIDは先に控える）
+    std::optional<domain::TransactionRecord> record;
+    if (session != nullptr) {
+      record = domain::TransactionRecord(sales_.getId(), slot_id, price,
+                                         domain::PaymentMethodType::CASH)
+                   .withSessionId(session->getSessionId());
+    }
+    sales_.tryCompleteTransaction();
 
     // 10. トランザクション履歴を記録
-    auto sales_id = sales_.getCurrentSessionSalesId();
-    if (sales_id.has_value()) {
-      domain::TransactionRecord record(sales_id.value(), slot_id, price,
-                                       domain::PaymentMethodType::CASH);
-      transaction_history_.save(record);
+    if (record.has_value()) {
+      transaction_history_.save(*record);
     }
-
-    return {true, "Success", product_info.getName().getValue(), change};
   } catch (...) {
-    // 決済失敗時のロールバック：在庫を戻す
-    inventory_.refill(slot_id, domain::Quantity(1));
+    if (!dispensed) {
+      // 排出前の障害時のロールバック：在庫を戻す
+      inventory_.tryRevertDispense(slot_id);
+      recordStep(entry, domain::PurchaseStep::ABORTED);
+    } else if (journal_ != nullptr) {
+      // 排出後の障害（お釣り返却・履歴保存など）：商品は渡っているため
+      // 済んだ手順は戻さず、決着させずに残す（次回の起動時に前進させる）
+      has_unsettled_purchase_ = true;
+    }
     throw; // 例外を再スロー
   }
+
+  // 11. 完了を記録する。ここで失敗しても購入は済んでいるため戻さない
+  //     （決着していない購入として復旧される）
+  recordStep(entry, domain::PurchaseStep::COMMITTED);
+
+  return dto::PurchaseResponse{true, "Success",
+                               product_info.getName().getValue(), change};
 }
 
 int PurchaseWithCashUseCase::getBalance() const {
@@ -134,20 +219,61 @@ int PurchaseWithCashUseCase::refund() {
   return amount;
 }
 
-std::vector<dto::ProductDto> PurchaseWithCashUseCase::getAllProducts() const {
-  std::vector<dto::ProductDto> dtos;
-  // Assuming 4 slots for simplicity
-  for (int i = 1; i <= 4; i++) {
-    try {
-      const auto &slot = inventory_.getSlot(domain::SlotId(i));
-      dtos.push_back({i, slot.getProductInfo().getName().getValue(),
-                      slot.getProductInfo().getPrice().getRawValue(),
-                      slot.getStock().getValue()});
-    } catch (...) {
-      // Ignore empty slots
+void PurchaseWithCashUseCase::setJournal(domain::IPurchaseJournal *journal,
+                                         bool discard_when_settled,
+                                         std::uint32_t last_purchase_id) {
+  journal_ = journal;
+  discard_when_settled_ = discard_when_settled;
+  next_purchase_id_ = std::max(next_purchase_id_, last_purchase_id + 1);
+  if (journal_ != nullptr) {
+    // セッションIDも続きから採番し、履歴のセッションIDで購入を照合できる
+    // ようにする（復旧時の二重保存の防止）
+    int last_session_id = 0;
+    for (const auto &entry : journal_->readAll()) {
+      next_purchase_id_ = std::max(next_purchase_id_, entry.purchase_id + 1);
+      last_session_id = std::max(last_session_id, entry.session_id);
+    }
+    if (const auto *session = sales_.getCurrentSession()) {
+      last_session_id =
+          std::max(last_session_id, session->getSessionId().getValue());
+    }
+    int current = session_counter.load();
+    while (current <= last_session_id &&
+           !session_counter.compare_exchange_weak(current,
+                                                  last_session_id + 1)) {
     }
   }
-  return dtos;
+}
+
+void PurchaseWithCashUseCase::recordStep(domain::PurchaseJournalEntry &entry,
+                                         domain::PurchaseStep step) {
+  if (journal_ != nullptr) {
+    entry.step = step;
+    journal_->append(entry);
+    if (discard_when_settled_ && !has_unsettled_purchase_ &&
+        entry.isSettled()) {
+      journal_->discardSettled();
+    }
+  }
+}
+
+std::vector<dto::ProductDto> PurchaseWithCashUseCase::getAllProducts() const {
+  std::vector<dto::ProductView> views;
+  getAllProductViews(views);
+  return dto::toProductDtos(views);
+}
+
+dto::PmrProductList PurchaseWithCashUseCase::getAllProducts(
+    std::pmr::memory_resource *resource) const {
+  inventory_.snapshot(snapshot_buffer_);
+  return dto::toProductDtos(snapshot_buffer_, resource);
+}
+
+std::size_t PurchaseWithCashUseCase::getAllProductViews(
+    std::vector<dto::ProductView> &out) const {
+  // 登録済みの全スロットを1パスで取得（欠番の判定に例外を使わない）
+  inventory_.snapshot(snapshot_buffer_);
+  return dto::toProductViews(snapshot_buffer_, out);
 }
 
 } // namespace usecases
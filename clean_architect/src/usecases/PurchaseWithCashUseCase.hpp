@@ -1,11 +1,17 @@
 #ifndef VENDING_MACHINE_APPLICATION_USECASES_PURCHASEWITHCASHUSECASE_HPP
 #define VENDING_MACHINE_APPLICATION_USECASES_PURCHASEWITHCASHUSECASE_HPP
 
+#include "domain/common/Expected.hpp"
 #include "domain/common/Money.hpp"
 #include "domain/inventory/EligibleProduct.hpp"
 #include "domain/inventory/SlotId.hpp"
+#include "domain/inventory/SlotSnapshot.hpp"
+#include "domain/repositories/IPurchaseJournal.hpp"
 #include "usecases/dto/PurchaseDTOs.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace vending_machine {
@@ -35,6 +41,10 @@ namespace usecases {
  * 6. 決済確定（Wallet）
  * 7. 商品排出（IDispenser）
  * 8. お釣り返却（ICoinMech）
+ *
+ * 本クラスはスレッドセーフではありません。商品一覧を返す const の
+ * メンバ関数も内部のバッファに書き込むため、同じインスタンスを複数の
+ * スレッドから同時に呼び出さないでください。
  */
 class PurchaseWithCashUseCase {
 public:
@@ -70,6 +80,31 @@ public:
    */
   std::vector<dto::ProductDto> getEligibleProducts() const;
 
+  /**
+   * @brief 購入可能な商品一覧を、指定のメモリリソースに置いて取得
+   * @param resource 一覧と商品名の確保に使うメモリリソース
+   * @return 購入可能な商品のDTOリスト
+   *
+   * @details
+   * std::pmr::monotonic_buffer_resource にスタック上のバッファを渡せば、
+   * リクエスト1回分の確保をそのバッファだけで賄い、終了時にまとめて
+   * 解放できます（グローバルなヒープを使いません）。
+   */
+  dto::PmrProductList
+  getEligibleProducts(std::pmr::memory_resource *resource) const;
+
+  /**
+   * @brief 購入可能な商品一覧をビューとして取得
+   * @param out 出力先（先頭からクリアされる）
+   * @return 書き出した商品の数
+   *
+   * @details
+   * 商品名をコピーしないため、バッファを使い回せば
+   * 商品ごとのヒープ確保は発生しません。
+   */
+  std::size_t
+  getEligibleProductViews(std::vector<dto::ProductView> &out) const;
+
   /**
    * @brief 商品を選択して購入
    * @param request 商品スロットIDを含むリクエスト
@@ -78,6 +113,21 @@ public:
    */
   dto::PurchaseResponse selectAndPurchase(const dto::PurchaseRequest &request);
 
+  /**
+   * @brief 商品を選択して購入（業務上の失敗を例外にしない版）
+   * @param request 商品スロットIDを含むリクエスト
+   * @return 購入結果、または失敗理由のエラーコード
+   *
+   * @details
+   * 在庫切れ・残高不足・セッション状態の不一致は ErrorCode で返し、
+   * 在庫・残高・セッションの状態は変更しません。
+   * 排出機・コインメック・履歴リポジトリが送出した例外はそのまま
+   * 再送出します。排出前の例外では在庫を戻して購入を取り消し、
+   * 排出後の例外では済んだ手順（在庫減算・引き落とし）を戻しません。
+   */
+  domain::Expected<dto::PurchaseResponse>
+  trySelectAndPurchase(const dto::PurchaseRequest &request);
+
   /**
    * @brief 現在の残高を取得
    * @return 残高(int)
@@ -92,10 +142,63 @@ public:
 
   /**
    * @brief 全商品一覧を取得（在庫切れ含む）
-   * @return 全商品のDTOリスト
+   * @return 登録済みの全スロットのDTOリスト（スロットID昇順）
    */
   std::vector<dto::ProductDto> getAllProducts() const;
 
+  /**
+   * @brief 全商品一覧を、指定のメモリリソースに置いて取得（在庫切れ含む）
+   * @param resource 一覧と商品名の確保に使うメモリリソース
+   * @return 登録済みの全スロットのDTOリスト（スロットID昇順）
+   */
+  dto::PmrProductList getAllProducts(std::pmr::memory_resource *resource) const;
+
+  /**
+   * @brief 全商品一覧をビューとして取得（在庫切れ含む）
+   * @param out 出力先（先頭からクリアされる）
+   * @return 書き出した商品の数
+   */
+  std::size_t getAllProductViews(std::vector<dto::ProductView> &out) const;
+
+  /**
+   * @brief 購入ジャーナルを設定
+   * @param journal 記録先（nullptr で記録しない）。
+   *        本オブジェクトより長く生存すること
+   *
+   * 購入の各手順（在庫減算・排出・引き落とし・お釣り返却・履歴保存）の
+   * 完了ごとにエントリを1件追記します。停止後は PurchaseRecoveryUseCase で
+   * 決着していない購入を前進または後退させます。
+   * 記録済みの購入通番と last_purchase_id の大きいほうの続きから
+   * 採番します。
+   *
+   * @param discard_when_settled 購入が決着するたびに discardSettled() を
+   *        呼ぶか。状態を定期保存する場合は、保存した状態に反映されるまで
+   *        決着した購入も再適用に使うため false とし、保存の後に呼び出し側で
+   *        破棄します。
+   * @param last_purchase_id 使用済みの購入通番（チェックポイントに
+   *        記録した通番など）
+   */
+  void setJournal(domain::IPurchaseJournal *journal,
+                  bool discard_when_settled = true,
+                  std::uint32_t last_purchase_id = 0);
+
+  /**
+   * @brief 最後に採番した購入通番（未採番なら 0）
+   *
+   * 購入の処理中以外に呼べば、この通番までの購入は在庫・残高に
+   * 反映済みです（チェックポイントの位置として保存します）。
+   */
+  std::uint32_t getLastPurchaseId() const { return next_purchase_id_ - 1; }
+
+  /**
+   * @brief 決着させずに残した購入があるか
+   *
+   * 排出の後の手順（お釣りの返却・履歴の保存）が失敗した購入は、
+   * 済んだ手順を戻さずにジャーナルに残します。次回の起動時の復旧で
+   * 完了させるまで、ジャーナルを破棄しないでください。
+   */
+  bool hasUnsettledPurchase() const { return has_unsettled_purchase_; }
+
 private:
   domain::Inventory &inventory_;
   domain::Wallet &wallet_;
@@ -103,6 +206,21 @@ private:
   domain::ICoinMech &coin_mech_;
   domain::IDispenser &dispenser_;
   domain::ITransactionHistoryRepository &transaction_history_;
+
+  /// 在庫スナップショット用バッファ（呼び出しごとに使い回す。
+  /// const の呼び出しからも書き込むため、同時に呼び出せない）
+  mutable std::vector<domain::SlotSnapshot> snapshot_buffer_;
+
+  domain::IPurchaseJournal *journal_ = nullptr; ///< 購入ジャーナル
+  bool discard_when_settled_ = true;            ///< 決着ごとに破棄するか
+  bool has_unsettled_purchase_ = false;         ///< 決着させずに残した購入
+  std::uint32_t next_purchase_id_ = 1;          ///< 次の購入通番
+
+  /**
+   * @brief 手順の完了を記録（ジャーナル未設定なら何もしない）
+   */
+  void recordStep(domain::PurchaseJournalEntry &entry,
+                  domain::PurchaseStep step);
 };
 
 } // namespace usecases
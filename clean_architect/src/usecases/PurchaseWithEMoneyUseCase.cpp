@@ -7,7 +7,9 @@
 #include "domain/sales/Sales.hpp"
 #include "domain/sales/SessionId.hpp"
 #include "domain/sales/TransactionRecord.hpp"
+#include "usecases/dto/ProductDtoMapper.hpp"
 #include <atomic>
+#include <optional>
 
 namespace vending_machine {
 namespace usecases {
@@ -31,50 +33,75 @@ void PurchaseWithEMoneyUseCase::startSession() {
 
 std::vector<dto::ProductDto>
 PurchaseWithEMoneyUseCase::getAvailableProducts() const {
-  std::vector<dto::ProductDto> dtos;
+  std::vector<dto::ProductView> views;
+  getAvailableProductViews(views);
+  return dto::toProductDtos(views);
+}
+
+dto::PmrProductList PurchaseWithEMoneyUseCase::getAvailableProducts(
+    std::pmr::memory_resource *resource) const {
+  inventory_.snapshot(snapshot_buffer_);
+  return dto::toProductDtos(snapshot_buffer_, resource,
+                            /*in_stock_only=*/true);
+}
 
+std::size_t PurchaseWithEMoneyUseCase::getAvailableProductViews(
+    std::vector<dto::ProductView> &out) const {
   // 電子決済では在庫があればすべて購入可能
   // （残高チェックは外部決済サーバーが行う）
-  const auto &slots = inventory_.getAllSlots();
-
-  for (const auto &pair : slots) {
-    const auto &slot_id = pair.first;
-    const auto &product_slot = pair.second;
-
-    // 在庫が存在するか確認
-    if (product_slot->getStock().getValue() > 0) {
-      dtos.push_back({slot_id.getValue(),
-                      product_slot->getProductInfo().getName().getValue(),
-                      product_slot->getProductInfo().getPrice().getRawValue(),
-                      product_slot->getStock().getValue()});
-    }
-  }
-
-  return dtos;
+  inventory_.snapshot(snapshot_buffer_);
+  return dto::toProductViews(snapshot_buffer_, out, /*in_stock_only=*/true);
 }
 
 dto::EMoneyPurchaseResponse PurchaseWithEMoneyUseCase::selectAndRequestPayment(
     const dto::EMoneyPurchaseRequest &request) {
+  auto result = trySelectAndRequestPayment(request);
+  if (result.error() == domain::ErrorCode::PAYMENT_DECLINED) {
+    // 決済失敗は従来どおりレスポンスで返す
+    return {false, domain::toMessage(result.error()), ""};
+  }
+  domain::throwIfError(result.error());
+  return result.value();
+}
+
+domain::Expected<dto::EMoneyPurchaseResponse>
+PurchaseWithEMoneyUseCase::trySelectAndRequestPayment(
+    const dto::EMoneyPurchaseRequest &request) {
+  if (request.slot_id <= 0) {
+    return domain::ErrorCode::SLOT_NOT_FOUND;
+  }
   domain::SlotId slot_id(request.slot_id);
 
   // 0. 在庫確認
-  const auto &product_slot = inventory_.getSlot(slot_id);
-  if (product_slot.getStock().getValue() == 0) {
-    throw std::domain_error("Product is out of stock");
+  const domain::ProductSlot *product_slot = inventory_.findSlot(slot_id);
+  if (product_slot == nullptr) {
+    return domain::ErrorCode::SLOT_NOT_FOUND;
+  }
+  if (!product_slot->isAvailable()) {
+    return domain::ErrorCode::OUT_OF_STOCK;
   }
 
   // 1. 商品選択（Sales集約）
-  sales_.selectProduct(slot_id);
+  domain::ErrorCode error = sales_.trySelectProduct(slot_id);
+  if (error != domain::ErrorCode::OK) {
+    return error;
+  }
 
   // 2. 商品情報取得
-  const auto &product_info = product_slot.getProductInfo();
+  const auto &product_info = product_slot->getProductInfo();
   const auto &price = product_info.getPrice();
 
   // 3. 決済待ち状態に遷移
-  sales_.markPaymentPending();
+  error = sales_.tryMarkPaymentPending();
+  if (error != domain::ErrorCode::OK) {
+    return error;
+  }
 
   // 4. 在庫減算（イベントストーミング Step 5）
-  inventory_.dispense(slot_id);
+  error = inventory_.tryDispense(slot_id);
+  if (error != domain::ErrorCode::OK) {
+    return error;
+  }
 
   try {
     // 5. 外部決済ゲートウェイに決済要求（イベントストーミング Step 7準備）
@@ -83,47 +110,56 @@ dto::EMoneyPurchaseResponse PurchaseWithEMoneyUseCase::selectAndRequestPayment(
     // 6. 決済ステータス確認
     auto payment_status = payment_gateway_.getPaymentStatus();
 
-    if (payment_status == domain::PaymentStatus::Authorized) {
-      // 決済成功時のみ以下を実行
-
-      // 6. 排出中状態に遷移（イベントストーミング Step 6準備）
-      sales_.markDispensing();
-
-      // 7. 商品排出（イベントストーミング Step 6）
-      const auto &product_info = inventory_.getSlot(slot_id).getProductInfo();
-      dispenser_.dispense(product_info);
-
-      // 8. 決済確定（イベントストーミング Step 7）
-      // Walletに電子マネー承認額を記録
-      domain::Money payment_amount(price.getRawValue());
-      wallet_.authorizeEMoney(payment_amount);
-      pending_price_ = price;
+    if (payment_status != domain::PaymentStatus::Authorized) {
+      // 決済失敗
+      inventory_.tryRevertDispense(slot_id);
+      sales_.tryCancelTransaction();
+      return domain::ErrorCode::PAYMENT_DECLINED;
+    }
 
-      // 決済確定（Walletから引き落とし）
-      wallet_.withdraw(payment_amount);
+    // 決済成功時のみ以下を実行
 
-      // 9. トランザクション完了
-      sales_.completeTransaction();
+    // 6. 排出中状態に遷移（イベントストーミング Step 6準備）
+    error = sales_.tryMarkDispensing();
+    if (error != domain::ErrorCode::OK) {
+      inventory_.tryRevertDispense(slot_id);
+      sales_.tryCancelTransaction();
+      return error;
+    }
 
-      // 10. トランザクション履歴を記録
-      auto sales_id = sales_.getCurrentSessionSalesId();
-      if (sales_id.has_value()) {
-        domain::TransactionRecord record(sales_id.value(), slot_id, price,
-                                         domain::PaymentMethodType::EMONEY);
-        transaction_history_.save(record);
-      }
+    // 7. 商品排出（イベントストーミング Step 6）
+    dispenser_.dispense(product_info);
+
+    // 8. 決済確定（イベントストーミング Step 7）
+    // Walletに電子マネー承認額を記録
+    domain::Money payment_amount(price.getRawValue());
+    wallet_.authorizeEMoney(payment_amount);
+    pending_price_ = price;
+
+    // 決済確定（Walletから引き落とし）
+    wallet_.tryWithdraw(payment_amount);
+
+    // 9. トランザクション完了（完了するとセッションが外れるため、
+    //    履歴に載せる販売ID・セッションIDは先に控える）
+    std::optional<domain::TransactionRecord> record;
+    if (const auto *session = sales_.getCurrentSession()) {
+      record = domain::TransactionRecord(sales_.getId(), slot_id, price,
+                                         domain::PaymentMethodType::EMONEY)
+                   .withSessionId(session->getSessionId());
+    }
+    sales_.tryCompleteTransaction();
 
-      return {true, "Success", product_info.getName().getValue()};
-    } else {
-      // 決済失敗
-      inventory_.refill(slot_id, domain::Quantity(1));
-      sales_.cancelTransaction();
-      return {false, "Payment Failed", ""};
+    // 10. トランザクション履歴を記録
+    if (record.has_value()) {
+      transaction_history_.save(*record);
     }
+
+    return dto::EMoneyPurchaseResponse{true, "Success",
+                                       product_info.getName().getValue()};
   } catch (...) {
-    // 決済失敗時のロールバック：在庫を戻す
-    inventory_.refill(slot_id, domain::Quantity(1));
-    sales_.cancelTransaction();
+    // 外部機器・リポジトリの障害時のロールバック：在庫を戻す
+    inventory_.tryRevertDispense(slot_id);
+    sales_.tryCancelTransaction();
     throw; // 例外を再スロー
   }
 }
@@ -1,12 +1,16 @@
 #ifndef VENDING_MACHINE_APPLICATION_USECASES_PURCHASEWITHEMONEYUSECASE_HPP
 #define VENDING_MACHINE_APPLICATION_USECASES_PURCHASEWITHEMONEYUSECASE_HPP
 
+#include "domain/common/Expected.hpp"
 #include "domain/common/Money.hpp"
 #include "domain/common/Price.hpp"
 #include "domain/inventory/EligibleProduct.hpp"
 #include "domain/inventory/SlotId.hpp"
+#include "domain/inventory/SlotSnapshot.hpp"
 #include "usecases/dto/PurchaseDTOs.hpp"
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -41,6 +45,9 @@ namespace usecases {
  * 10. トランザクション完了
  *
  * @note 電子決済では「釣銭準備」の判定は不要（exact payment）
+ * @note 本クラスはスレッドセーフではありません。商品一覧を返す const の
+ *       メンバ関数も内部のバッファに書き込むため、同じインスタンスを
+ *       複数のスレッドから同時に呼び出さないでください。
  */
 class PurchaseWithEMoneyUseCase {
 public:
@@ -72,6 +79,26 @@ public:
    */
   std::vector<dto::ProductDto> getAvailableProducts() const;
 
+  /**
+   * @brief 購入可能な商品一覧を、指定のメモリリソースに置いて取得
+   * @param resource 一覧と商品名の確保に使うメモリリソース
+   * @return 在庫がある商品のDTOリスト
+   */
+  dto::PmrProductList
+  getAvailableProducts(std::pmr::memory_resource *resource) const;
+
+  /**
+   * @brief 購入可能な商品一覧をビューとして取得
+   * @param out 出力先（先頭からクリアされる）
+   * @return 書き出した商品の数
+   *
+   * @details
+   * 商品名をコピーしないため、バッファを使い回せば
+   * 商品ごとのヒープ確保は発生しません。
+   */
+  std::size_t
+  getAvailableProductViews(std::vector<dto::ProductView> &out) const;
+
   /**
    * @brief 商品を選択して決済要求
    * @param request 商品スロットIDを含むリクエスト
@@ -81,6 +108,21 @@ public:
   dto::EMoneyPurchaseResponse
   selectAndRequestPayment(const dto::EMoneyPurchaseRequest &request);
 
+  /**
+   * @brief 商品を選択して決済要求（業務上の失敗を例外にしない版）
+   * @param request 商品スロットIDを含むリクエスト
+   * @return 決済結果、または失敗理由のエラーコード
+   *
+   * @details
+   * 在庫切れ・セッション状態の不一致・決済の否認（PAYMENT_DECLINED）は
+   * ErrorCode で返します。決済が否認された場合は在庫を戻し、
+   * セッションをキャンセルします。
+   * 決済ゲートウェイ・排出機・履歴リポジトリが送出した例外は、
+   * 同様にロールバックしたうえでそのまま再送出します。
+   */
+  domain::Expected<dto::EMoneyPurchaseResponse>
+  trySelectAndRequestPayment(const dto::EMoneyPurchaseRequest &request);
+
   /**
    * @brief 決済をキャンセル
    */
@@ -95,6 +137,10 @@ private:
   domain::ITransactionHistoryRepository &transaction_history_;
 
   std::optional<domain::Price> pending_price_; ///< 決済待ち価格
+
+  /// 在庫スナップショット用バッファ（呼び出しごとに使い回す。
+  /// const の呼び出しからも書き込むため、同時に呼び出せない）
+  mutable std::vector<domain::SlotSnapshot> snapshot_buffer_;
 };
 
 } // namespace usecases
@@ -1,5 +1,13 @@
 #include "usecases/SalesReportingUseCase.hpp"
-#include <map>
+#include "domain/common/RevenueAccumulator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 namespace vending_machine {
 namespace usecases {
@@ -8,77 +16,269 @@ SalesReportingUseCase::SalesReportingUseCase(
     domain::ITransactionHistoryRepository &transaction_history)
     : transaction_history_(transaction_history) {}
 
-std::vector<SlotSalesReport>
-SalesReportingUseCase::generateSlotSalesReport() const {
-  auto all_records = transaction_history_.getAll();
+namespace {
+
+/// 決済方法の一覧（PaymentMethodType の定義順）
+constexpr domain::PaymentMethodType PAYMENT_METHODS[] = {
+    domain::PaymentMethodType::CASH, domain::PaymentMethodType::EMONEY};
+
+/**
+ * @brief 1つの集計キーに対する取引回数と売上
+ */
+struct SalesBucket {
+  std::int64_t count = 0;
+  domain::RevenueAccumulator revenue;
+
+  void add(const domain::Price &price) {
+    ++count;
+    revenue.add(price);
+  }
+
+  void add(std::int64_t transaction_count, const domain::Revenue &total) {
+    count += transaction_count;
+    revenue.add(total);
+  }
+
+  void merge(const SalesBucket &other) {
+    count += other.count;
+    revenue.merge(other.revenue);
+  }
+};
 
-  // スロット別に集計
-  std::map<int, std::pair<int, int>> slot_data; // slot_id -> (count, revenue)
+/**
+ * @brief 履歴の一部（または全体）に対する集計の途中結果
+ *
+ * スロットは初めて現れた順に詰めた番号（密な添字）で配列に集計する。
+ * スロットIDの値そのものを添字にしないため、大きなIDが現れても
+ * 配列の大きさは実際に現れたスロットの数で済む。
+ */
+class SalesAggregate {
+public:
+  void add(const domain::TransactionRecord &record) {
+    const auto &price = record.getPrice();
+    slotBucket(record.getSlotId().getValue()).add(price);
+    payment_buckets_[static_cast<std::size_t>(record.getPaymentMethod())].add(
+        price);
+    total_.add(price);
+  }
 
-  for (const auto &record : all_records) {
-    int slot_id_value = record.getSlotId().getValue();
-    int revenue = record.getPrice().getRawValue();
+  // 個別のレコードを持たない取引の集計値を加える
+  void addRollup(const domain::TransactionRollup &rollup) {
+    slotBucket(rollup.slot_id.getValue())
+        .add(rollup.transaction_count, rollup.total_revenue);
+    payment_buckets_[static_cast<std::size_t>(rollup.payment_method)].add(
+        rollup.transaction_count, rollup.total_revenue);
+    total_.add(rollup.transaction_count, rollup.total_revenue);
+  }
+
+  void merge(const SalesAggregate &other) {
+    for (std::size_t i = 0; i < other.slot_ids_.size(); ++i) {
+      slotBucket(other.slot_ids_[i]).merge(other.slot_buckets_[i]);
+    }
+    for (std::size_t i = 0; i < std::size(payment_buckets_); ++i) {
+      payment_buckets_[i].merge(other.payment_buckets_[i]);
+    }
+    total_.merge(other.total_);
+  }
 
-    if (slot_data.find(slot_id_value) == slot_data.end()) {
-      slot_data[slot_id_value] = {0, 0};
+  // レポート生成（取引のあったキーのみ、キーの昇順）
+  SalesSummary toSummary() const {
+    SalesSummary summary;
+    summary.transaction_count = total_.count;
+    summary.total_revenue = total_.revenue.getTotal();
+    std::vector<std::size_t> order(slot_ids_.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+      return slot_ids_[a] < slot_ids_[b];
+    });
+    for (std::size_t i : order) {
+      const auto &bucket = slot_buckets_[i];
+      if (bucket.count > 0) {
+        summary.slot_reports.emplace_back(domain::SlotId(slot_ids_[i]),
+                                          bucket.count,
+                                          bucket.revenue.getTotal());
+      }
+    }
+    for (auto method : PAYMENT_METHODS) {
+      const auto &bucket = payment_buckets_[static_cast<std::size_t>(method)];
+      if (bucket.count > 0) {
+        summary.payment_reports.emplace_back(method, bucket.count,
+                                             bucket.revenue.getTotal());
+      }
     }
-    slot_data[slot_id_value].first++; // count
-    slot_data[slot_id_value].second += revenue;
+    return summary;
   }
 
-  // レポート生成
-  std::vector<SlotSalesReport> reports;
-  for (const auto &entry : slot_data) {
-    reports.emplace_back(domain::SlotId(entry.first), entry.second.first,
-                         domain::Money(entry.second.second));
+private:
+  SalesBucket &slotBucket(int slot_id) {
+    auto [it, inserted] = slot_index_.try_emplace(slot_id, slot_ids_.size());
+    if (inserted) {
+      slot_ids_.push_back(slot_id);
+      slot_buckets_.emplace_back();
+    }
+    return slot_buckets_[it->second];
   }
 
-  return reports;
-}
+  std::unordered_map<int, std::size_t> slot_index_; ///< スロットID → 添字
+  std::vector<int> slot_ids_;                       ///< 添字 → スロットID
+  std::vector<SalesBucket> slot_buckets_;
+  SalesBucket payment_buckets_[std::size(PAYMENT_METHODS)];
+  SalesBucket total_;
+};
 
-std::vector<PaymentMethodReport>
-SalesReportingUseCase::generatePaymentMethodReport() const {
-  auto all_records = transaction_history_.getAll();
+} // namespace
+
+const SalesSummary &SalesReportingUseCase::generateSalesSummary() const {
+  if (const auto *cached = findCachedSummary()) {
+    return *cached;
+  }
 
-  // 決済方法別に集計
-  std::map<domain::PaymentMethodType, std::pair<int, int>>
-      payment_data; // method -> (count, revenue)
+  SalesAggregate aggregate;
+  transaction_history_.forEach(
+      [&aggregate](const domain::TransactionRecord &record) {
+        aggregate.add(record);
+      });
+  transaction_history_.forEachRollup(
+      [&aggregate](const domain::TransactionRollup &rollup) {
+        aggregate.addRollup(rollup);
+      });
+  return cacheSummary(aggregate.toSummary());
+}
 
-  for (const auto &record : all_records) {
-    auto method = record.getPaymentMethod();
-    int revenue = record.getPrice().getRawValue();
+const SalesSummary &
+SalesReportingUseCase::generateSalesSummary(std::size_t thread_count) const {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (thread_count == 1) {
+    return generateSalesSummary();
+  }
+  if (const auto *cached = findCachedSummary()) {
+    return *cached;
+  }
 
-    if (payment_data.find(method) == payment_data.end()) {
-      payment_data[method] = {0, 0};
+  // パーティションごとに独立した集計を取り、最後にパーティション番号の
+  // 順で合算する（スレッドの完了順に依存しないため、結果は常に同じ）
+  std::vector<SalesAggregate> partials(thread_count);
+  std::vector<std::exception_ptr> errors(thread_count);
+  auto aggregate_partition = [&](std::size_t partition) {
+    try {
+      transaction_history_.forEachInPartition(
+          partition, thread_count,
+          [&partials, partition](const domain::TransactionRecord &record) {
+            partials[partition].add(record);
+          });
+    } catch (...) {
+      errors[partition] = std::current_exception();
     }
-    payment_data[method].first++; // count
-    payment_data[method].second += revenue;
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(thread_count - 1);
+  for (std::size_t partition = 1; partition < thread_count; ++partition) {
+    workers.emplace_back(aggregate_partition, partition);
+  }
+  aggregate_partition(0); // 呼び出し元のスレッドも1つ分を受け持つ
+  for (auto &worker : workers) {
+    worker.join();
   }
 
-  // レポート生成
-  std::vector<PaymentMethodReport> reports;
-  for (const auto &entry : payment_data) {
-    reports.emplace_back(entry.first, entry.second.first,
-                         domain::Money(entry.second.second));
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  for (std::size_t partition = 1; partition < thread_count; ++partition) {
+    partials[0].merge(partials[partition]);
   }
+  transaction_history_.forEachRollup(
+      [&partials](const domain::TransactionRollup &rollup) {
+        partials[0].addRollup(rollup);
+      });
+  return cacheSummary(partials[0].toSummary());
+}
+
+std::vector<SlotSalesReport>
+SalesReportingUseCase::generateSlotSalesReport() const {
+  return generateSalesSummary().slot_reports;
+}
 
-  return reports;
+std::vector<PaymentMethodReport>
+SalesReportingUseCase::generatePaymentMethodReport() const {
+  return generateSalesSummary().payment_reports;
 }
 
-domain::Money
+domain::Revenue
 SalesReportingUseCase::getRevenueBySlot(const domain::SlotId &slot_id) const {
-  auto slot_records = transaction_history_.getBySlotId(slot_id);
+  // スロット別レポートはスロット番号の昇順に並んでいる
+  const auto &reports = generateSalesSummary().slot_reports;
+  auto it = std::lower_bound(reports.begin(), reports.end(), slot_id,
+                             [](const SlotSalesReport &report,
+                                const domain::SlotId &id) {
+                               return report.slot_id < id;
+                             });
+  if (it == reports.end() || it->slot_id != slot_id) {
+    return domain::Revenue();
+  }
+  return it->total_revenue;
+}
 
-  int total = 0;
-  for (const auto &record : slot_records) {
-    total += record.getPrice().getRawValue();
+std::int64_t SalesReportingUseCase::getTotalTransactionCount() const {
+  return generateSalesSummary().transaction_count;
+}
+
+void SalesReportingUseCase::setRollup(const domain::SalesRollup *rollup) {
+  rollup_ = rollup;
+}
+
+void SalesReportingUseCase::setSketches(
+    const domain::SalesSketches *sketches) {
+  sketches_ = sketches;
+}
+
+std::vector<domain::RollupBucket> SalesReportingUseCase::generateRollupReport(
+    domain::RollupGranularity granularity,
+    std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+  if (rollup_ == nullptr) {
+    throw std::logic_error("Sales rollup is not set");
   }
+  return rollup_->query(granularity, from, to);
+}
 
-  return domain::Money(total);
+std::vector<domain::TopKSketch::Entry>
+SalesReportingUseCase::getTopSellingSlots(std::size_t k) const {
+  if (sketches_ == nullptr) {
+    throw std::logic_error("Sales sketches are not set");
+  }
+  return sketches_->getTopSlots(k);
+}
+
+std::uint64_t SalesReportingUseCase::estimateDistinctSalesOn(
+    std::chrono::system_clock::time_point day) const {
+  if (sketches_ == nullptr) {
+    throw std::logic_error("Sales sketches are not set");
+  }
+  return sketches_->estimateDistinctSalesOn(day);
+}
+
+const SalesSummary *SalesReportingUseCase::findCachedSummary() const {
+  if (cached_summary_ &&
+      cached_generation_ == transaction_history_.getGeneration()) {
+    return &*cached_summary_;
+  }
+  return nullptr;
 }
 
-int SalesReportingUseCase::getTotalTransactionCount() const {
-  return transaction_history_.getAll().size();
+const SalesSummary &
+SalesReportingUseCase::cacheSummary(SalesSummary summary) const {
+  // 集計中に履歴が変わらない前提（本クラスはスレッドセーフではない）のため、
+  // 集計後に読んだ世代番号は集計対象の履歴の世代と一致する
+  cached_generation_ = transaction_history_.getGeneration();
+  cached_summary_ = std::move(summary);
+  return *cached_summary_;
 }
 
 } // namespace usecases
@@ -13,11 +13,16 @@
 #ifndef VENDING_MACHINE_APPLICATION_USECASES_SALES_REPORTING_USECASE_HPP
 #define VENDING_MACHINE_APPLICATION_USECASES_SALES_REPORTING_USECASE_HPP
 
-#include "domain/common/Money.hpp"
+#include "domain/common/Revenue.hpp"
 #include "domain/inventory/SlotId.hpp"
 #include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include "domain/sales/SalesRollup.hpp"
+#include "domain/sales/SalesSketches.hpp"
 #include "domain/sales/TransactionRecord.hpp"
-#include <map>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace vending_machine {
@@ -28,12 +33,12 @@ namespace usecases {
  * @brief スロット別売上レポート
  */
 struct SlotSalesReport {
-  domain::SlotId slot_id;      ///< スロットID
-  int transaction_count;       ///< 取引回数
-  domain::Money total_revenue; ///< 売上合計
+  domain::SlotId slot_id;         ///< スロットID
+  std::int64_t transaction_count; ///< 取引回数
+  domain::Revenue total_revenue;  ///< 売上合計
 
-  SlotSalesReport(const domain::SlotId &id, int count,
-                  const domain::Money &revenue)
+  SlotSalesReport(const domain::SlotId &id, std::int64_t count,
+                  const domain::Revenue &revenue)
       : slot_id(id), transaction_count(count), total_revenue(revenue) {}
 };
 
@@ -43,20 +48,42 @@ struct SlotSalesReport {
  */
 struct PaymentMethodReport {
   domain::PaymentMethodType payment_method; ///< 決済方法
-  int transaction_count;                    ///< 取引回数
-  domain::Money total_revenue;              ///< 売上合計
+  std::int64_t transaction_count;           ///< 取引回数
+  domain::Revenue total_revenue;            ///< 売上合計
 
-  PaymentMethodReport(domain::PaymentMethodType method, int count,
-                      const domain::Money &revenue)
+  PaymentMethodReport(domain::PaymentMethodType method, std::int64_t count,
+                      const domain::Revenue &revenue)
       : payment_method(method), transaction_count(count),
         total_revenue(revenue) {}
 };
 
+/**
+ * @struct SalesSummary
+ * @brief 売上レポート一式
+ *
+ * 取引履歴を1回走査して得られる、すべての集計結果をまとめたものです。
+ */
+struct SalesSummary {
+  std::int64_t transaction_count = 0;               ///< 取引総数
+  domain::Revenue total_revenue;                    ///< 売上合計
+  std::vector<SlotSalesReport> slot_reports;        ///< スロット別
+  std::vector<PaymentMethodReport> payment_reports; ///< 決済方法別
+};
+
 /**
  * @class SalesReportingUseCase
  * @brief 売上レポート生成を管理するユースケース
  *
  * 取引履歴から各種売上レポートを生成します。
+ *
+ * 集計結果は履歴の世代番号（ITransactionHistoryRepository::getGeneration）
+ * とともにキャッシュし、世代が変わるまでは再集計せずに返します。
+ * 売上のない間の定期的なレポート取得は、履歴の件数によらず O(1) です。
+ *
+ * 保存のたびに更新される時間帯別の集計（SalesRollup）と近似集計
+ * （SalesSketches）を設定すると、履歴を走査せずに時間帯別の売上・
+ * 売れ筋・異なり数を返します。
+ * 本クラスはスレッドセーフではありません。
  */
 class SalesReportingUseCase {
 public:
@@ -67,6 +94,36 @@ public:
   explicit SalesReportingUseCase(
       domain::ITransactionHistoryRepository &transaction_history);
 
+  /**
+   * @brief 売上レポート一式を生成
+   *
+   * 取引履歴を1回だけ走査し、スロット別・決済方法別の集計と
+   * 総数・売上合計をまとめて求めます。前回の集計から履歴の世代が
+   * 変わっていなければ、走査せずにキャッシュを返します。
+   *
+   * @return 売上レポート一式（次にいずれかのレポートを生成するまで有効）
+   */
+  const SalesSummary &generateSalesSummary() const;
+
+  /**
+   * @brief 売上レポート一式を並列に生成
+   *
+   * 取引履歴を thread_count 個のパーティションに分け、それぞれを
+   * 別スレッドで集計してから合算します。合算はパーティション番号の順に
+   * 行うため、結果はスレッド数やスケジューリングによらず
+   * generateSalesSummary() と同じです。
+   *
+   * 分割に対応していないリポジトリでは、実質的に1スレッドで集計されます。
+   * 集計中に履歴へ保存・消去を行ってはいけません。
+   *
+   * キャッシュは generateSalesSummary() と共有します。
+   *
+   * @param thread_count スレッド数（0 の場合はハードウェアの並列度）
+   * @return 売上レポート一式（次にいずれかのレポートを生成するまで有効）
+   * @throw std::overflow_error 売上合計が表現可能な範囲を超える場合
+   */
+  const SalesSummary &generateSalesSummary(std::size_t thread_count) const;
+
   /**
    * @brief スロット別売上レポートを生成
    * @return スロット別売上レポートのリスト
@@ -84,16 +141,65 @@ public:
    * @param slot_id スロットID
    * @return スロットの売上合計
    */
-  domain::Money getRevenueBySlot(const domain::SlotId &slot_id) const;
+  domain::Revenue getRevenueBySlot(const domain::SlotId &slot_id) const;
 
   /**
    * @brief 取引総数を取得
    * @return 取引総数
    */
-  int getTotalTransactionCount() const;
+  std::int64_t getTotalTransactionCount() const;
+
+  /**
+   * @brief 時間帯別の売上集計を設定
+   * @param rollup 集計（nullptr で解除）。履歴のリスナーとして登録したもの
+   */
+  void setRollup(const domain::SalesRollup *rollup);
+
+  /**
+   * @brief 近似集計を設定
+   * @param sketches 近似集計（nullptr で解除）。履歴のリスナーとして
+   *        登録したもの
+   */
+  void setSketches(const domain::SalesSketches *sketches);
+
+  /**
+   * @brief 期間内の時間帯別の売上を取得（SalesRollup::query）
+   * @param granularity 集計粒度
+   * @param from 期間の開始（この時刻を含むバケットから）
+   * @param to 期間の終了（この時刻を含むバケットは含まない）
+   * @return バケットのリスト（開始時刻、スロット、決済方法の昇順）
+   * @throw std::logic_error 集計が設定されていない場合
+   */
+  std::vector<domain::RollupBucket>
+  generateRollupReport(domain::RollupGranularity granularity,
+                       std::chrono::system_clock::time_point from,
+                       std::chrono::system_clock::time_point to) const;
+
+  /**
+   * @brief 売れ筋スロットの上位を取得（推定販売数の降順）
+   * @param k 取得する件数
+   * @throw std::logic_error 近似集計が設定されていない場合
+   */
+  std::vector<domain::TopKSketch::Entry>
+  getTopSellingSlots(std::size_t k) const;
+
+  /**
+   * @brief 指定日の取引の異なり数を推定
+   * @param day その日に含まれる任意の時刻
+   * @throw std::logic_error 近似集計が設定されていない場合
+   */
+  std::uint64_t
+  estimateDistinctSalesOn(std::chrono::system_clock::time_point day) const;
 
 private:
+  const SalesSummary *findCachedSummary() const;
+  const SalesSummary &cacheSummary(SalesSummary summary) const;
+
   domain::ITransactionHistoryRepository &transaction_history_;
+  const domain::SalesRollup *rollup_ = nullptr;
+  const domain::SalesSketches *sketches_ = nullptr;
+  mutable std::optional<SalesSummary> cached_summary_;
+  mutable std::uint64_t cached_generation_ = 0;
 };
 
 } // namespace usecases
@@ -1,5 +1,7 @@
 #include "usecases/VendingMachineApplication.hpp"
 #include "domain/inventory/ProductSlot.hpp"
+#include <stdexcept>
+#include <utility>
 
 namespace vending_machine {
 namespace usecases {
@@ -11,6 +13,9 @@ VendingMachineApplication::VendingMachineApplication(
     : sales_(domain::SalesId(1)), coin_mech_(coin_mech), dispenser_(dispenser),
       payment_gateway_(payment_gateway),
       transaction_history_(transaction_history) {
+  // 販売・補充のたびに売り切れ予測と在庫僅少の索引を更新する
+  inventory_.addObserver(depletion_forecaster_);
+  inventory_.addObserver(low_stock_tracker_);
 
   // ユースケースを初期化
   purchase_with_cash_usecase_ = std::make_unique<PurchaseWithCashUseCase>(
@@ -61,5 +66,184 @@ void VendingMachineApplication::initializeInventory() {
   inventory_.addSlot(slot4);
 }
 
+void VendingMachineApplication::addSlot(const domain::ProductSlot &slot) {
+  inventory_.addSlot(slot);
+}
+
+domain::MachineState VendingMachineApplication::captureState() const {
+  domain::MachineState state{sales_.getId(), sales_.getMode(),
+                             wallet_.getBalance(), {}, std::nullopt};
+  state.journal_position = purchase_with_cash_usecase_->getLastPurchaseId();
+
+  inventory_.snapshot(snapshot_buffer_);
+  state.slots.reserve(snapshot_buffer_.size());
+  for (const auto &slot : snapshot_buffer_) {
+    state.slots.push_back({slot.slot_id, *slot.product_info, slot.stock});
+  }
+
+  if (const auto *session = sales_.getCurrentSession()) {
+    state.session = domain::SessionState{session->getSessionId(),
+                                         session->getStatus(),
+                                         session->getSelectedSlotId()};
+  }
+  return state;
+}
+
+RestoreOutcome
+VendingMachineApplication::restoreState(const domain::MachineState &state) {
+  if (inventory_.getSlotCount() != 0) {
+    throw std::logic_error("Cannot restore state into a stocked inventory");
+  }
+
+  // 排出中: 在庫は減算済みで排出の成否は不明。
+  // 在庫を戻して決済待ちに戻し、返金で終える（代金は未引き落とし）。
+  RestoreOutcome outcome = RestoreOutcome::NO_SESSION;
+  std::optional<domain::TransactionSession> session;
+  if (state.session.has_value()) {
+    const auto &saved = *state.session;
+    bool dispensing = saved.status == domain::SessionStatus::DISPENSING;
+    outcome = dispensing ? RestoreOutcome::DISPENSE_ROLLED_BACK
+                         : RestoreOutcome::SESSION_RESUMED;
+    session.emplace(saved.session_id,
+                    dispensing ? domain::SessionStatus::PAYMENT_PENDING
+                               : saved.status,
+                    saved.selected_slot_id);
+  }
+
+  // セッションの検証を先に済ませ、失敗時に在庫だけが復元されるのを防ぐ
+  domain::Sales sales(state.sales_id);
+  sales.restore(state.mode, std::move(session));
+  domain::Mode previous_mode = sales_.getMode();
+  sales_ = std::move(sales);
+  if (event_log_ != nullptr) {
+    sales_.setEventSink(event_log_.get());
+    if (state.mode != previous_mode) {
+      // 入れ替え後に記録し、スナップショットが復元後のモードを写すようにする
+      event_log_->append(domain::DomainEvent::modeChanged(state.mode));
+    }
+  }
+
+  for (const auto &slot : state.slots) {
+    inventory_.addSlot(
+        domain::ProductSlot(slot.slot_id, slot.product_info, slot.stock));
+  }
+  if (outcome == RestoreOutcome::DISPENSE_ROLLED_BACK) {
+    inventory_.tryRevertDispense(*state.session->selected_slot_id);
+  }
+
+  // Wallet は現金と電子マネーを区別せず残高だけを持つ
+  wallet_.tryWithdraw(wallet_.getBalance());
+  wallet_.depositCash(state.balance);
+  return outcome;
+}
+
+void VendingMachineApplication::enableCheckpoints(
+    domain::IMachineStateRepository &repository,
+    std::chrono::steady_clock::duration interval) {
+  checkpoint_repository_ = &repository;
+  checkpoint_interval_ = interval;
+  last_checkpoint_ = std::chrono::steady_clock::now();
+  configurePurchaseJournal();
+}
+
+void VendingMachineApplication::saveCheckpoint() {
+  if (checkpoint_repository_ == nullptr) {
+    throw std::logic_error("Checkpoints are not enabled");
+  }
+  checkpoint_repository_->save(captureState());
+  last_checkpoint_ = std::chrono::steady_clock::now();
+  // 保存した状態は最後に採番した購入までを反映している。決着させずに
+  // 残した購入は復旧で履歴を保存するまで残す
+  if (purchase_journal_ != nullptr &&
+      !purchase_with_cash_usecase_->hasUnsettledPurchase()) {
+    purchase_journal_->discardSettled();
+  }
+}
+
+bool VendingMachineApplication::checkpointIfDue() {
+  if (checkpoint_repository_ == nullptr ||
+      std::chrono::steady_clock::now() - last_checkpoint_ <
+          checkpoint_interval_) {
+    return false;
+  }
+  saveCheckpoint();
+  return true;
+}
+
+void VendingMachineApplication::enablePurchaseJournal(
+    domain::IPurchaseJournal &journal) {
+  purchase_journal_ = &journal;
+  configurePurchaseJournal();
+}
+
+void VendingMachineApplication::configurePurchaseJournal() {
+  // チェックポイントを使う場合、決着した購入は保存するまで破棄しない。
+  // 復元した状態が反映済みの通番は再び使わない
+  purchase_with_cash_usecase_->setJournal(
+      purchase_journal_, checkpoint_repository_ == nullptr,
+      restored_journal_position_.value_or(0));
+}
+
+PurchaseRecoveryReport VendingMachineApplication::recoverPurchases() {
+  if (purchase_journal_ == nullptr) {
+    throw std::logic_error("Purchase journal is not enabled");
+  }
+  return PurchaseRecoveryUseCase(inventory_, wallet_, sales_,
+                                 transaction_history_, *purchase_journal_)
+      .recover(restored_journal_position_);
+}
+
+void VendingMachineApplication::enableEventLog(std::size_t snapshot_interval,
+                                               std::size_t max_snapshots,
+                                               domain::IEventStore *store) {
+  if (event_log_ != nullptr) {
+    throw std::logic_error("Event log is already enabled");
+  }
+  auto event_log = std::make_unique<domain::EventLog>();
+  event_log->setStore(store);
+  event_log->enableSnapshots(snapshot_interval, max_snapshots,
+                             [this] { return captureState(); });
+  // 記録を始める前の状態を再生の起点にする
+  event_log->takeSnapshot();
+
+  event_log_ = std::move(event_log);
+  inventory_event_recorder_ =
+      std::make_unique<domain::InventoryEventRecorder>(inventory_,
+                                                       *event_log_);
+  inventory_.addObserver(*inventory_event_recorder_);
+  wallet_.setEventSink(event_log_.get());
+  sales_.setEventSink(event_log_.get());
+  event_replay_usecase_ = std::make_unique<EventReplayUseCase>(*event_log_);
+}
+
+const domain::EventLog &VendingMachineApplication::getEventLog() const {
+  if (event_log_ == nullptr) {
+    throw std::logic_error("Event log is not enabled");
+  }
+  return *event_log_;
+}
+
+const EventReplayUseCase &
+VendingMachineApplication::getEventReplayUseCase() const {
+  if (event_replay_usecase_ == nullptr) {
+    throw std::logic_error("Event log is not enabled");
+  }
+  return *event_replay_usecase_;
+}
+
+std::optional<RestoreOutcome> VendingMachineApplication::restoreCheckpoint() {
+  if (checkpoint_repository_ == nullptr) {
+    throw std::logic_error("Checkpoints are not enabled");
+  }
+  auto state = checkpoint_repository_->load();
+  if (!state.has_value()) {
+    return std::nullopt;
+  }
+  RestoreOutcome outcome = restoreState(*state);
+  restored_journal_position_ = state->journal_position;
+  configurePurchaseJournal();
+  return outcome;
+}
+
 } // namespace usecases
 } // namespace vending_machine
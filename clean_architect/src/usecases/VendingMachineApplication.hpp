@@ -14,28 +14,55 @@
 #define VENDING_MACHINE_APPLICATION_VENDING_MACHINE_APPLICATION_HPP
 
 #include "usecases/CashCollectionUseCase.hpp"
+#include "usecases/EventReplayUseCase.hpp"
+#include "usecases/PurchaseRecoveryUseCase.hpp"
 #include "usecases/InventoryRefillUseCase.hpp"
 #include "usecases/PurchaseWithCashUseCase.hpp"
 #include "usecases/PurchaseWithEMoneyUseCase.hpp"
 #include "usecases/SalesReportingUseCase.hpp"
+#include "domain/events/EventLog.hpp"
+#include "domain/events/InventoryEventRecorder.hpp"
 #include "domain/interfaces/ICoinMech.hpp"
 #include "domain/interfaces/IDispenser.hpp"
 #include "domain/interfaces/IPaymentGateway.hpp"
+#include "domain/inventory/DepletionForecaster.hpp"
+#include "domain/inventory/LowStockTracker.hpp"
 #include "domain/inventory/Inventory.hpp"
 #include "domain/payment/Wallet.hpp"
+#include "domain/repositories/IMachineStateRepository.hpp"
+#include "domain/repositories/IPurchaseJournal.hpp"
 #include "domain/repositories/ITransactionHistoryRepository.hpp"
 #include "domain/sales/Sales.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace vending_machine {
 namespace usecases {
 
+/**
+ * @enum RestoreOutcome
+ * @brief 状態の復元時に進行中のセッションをどう扱ったか
+ */
+enum class RestoreOutcome {
+  NO_SESSION,          ///< 進行中のセッションは無かった
+  SESSION_RESUMED,     ///< 商品選択中・決済待ちのセッションをそのまま再開
+  DISPENSE_ROLLED_BACK ///< 排出中だったため在庫を戻し、決済待ちに戻した
+};
+
 /**
  * @class VendingMachineApplication
  * @brief アプリケーション全体を管理するファサード
  *
  * ドメインオブジェクト、ユースケース、インフラの依存関係を
  * 一元管理し、外部（UIなど）にユースケースへのアクセスを提供します。
+ *
+ * 本クラスと、本クラスが返すユースケースはスレッドセーフではありません。
+ * captureState() などの const のメンバ関数も内部のバッファに書き込むため、
+ * 1つのスレッドから呼び出してください。
  */
 class VendingMachineApplication {
 public:
@@ -56,6 +83,137 @@ public:
    */
   void initializeInventory();
 
+  /**
+   * @brief スロットを1件登録（プラノグラムファイルからの読み込み用）
+   * @param slot 登録するスロット
+   * @throw std::invalid_argument 同じ SlotId が登録済みの場合
+   */
+  void addSlot(const domain::ProductSlot &slot);
+
+  /**
+   * @name チェックポイント
+   * Inventory・Wallet・Sales の状態を保存し、起動時に復元します。
+   * @{
+   */
+
+  /**
+   * @brief 現在の状態を取得
+   * @return 自動販売機全体の状態
+   */
+  domain::MachineState captureState() const;
+
+  /**
+   * @brief 保存済みの状態を復元（initializeInventory の代わりに起動直後に呼ぶ）
+   * @param state 復元する状態
+   * @return 進行中のセッションの扱い
+   * @throw std::logic_error 既に在庫が登録されている場合
+   *
+   * 商品選択中・決済待ちのセッションはそのまま再開します。
+   * 排出中だったセッションは排出の成否が分からないため、在庫を1個戻して
+   * 決済待ちに戻します。残高はそのまま残るので、続く返金操作で払い戻されます。
+   */
+  RestoreOutcome restoreState(const domain::MachineState &state);
+
+  /**
+   * @brief チェックポイントの保存先を設定
+   * @param repository 保存先
+   * @param interval checkpointIfDue() が保存する最小間隔
+   */
+  void enableCheckpoints(domain::IMachineStateRepository &repository,
+                         std::chrono::steady_clock::duration interval);
+
+  /**
+   * @brief 現在の状態を保存（終了時など）
+   * @throw std::logic_error 保存先が設定されていない場合
+   *
+   * 購入ジャーナルを併用している場合、保存した状態に反映済みの
+   * 決着した購入をジャーナルから破棄します。
+   */
+  void saveCheckpoint();
+
+  /**
+   * @brief 前回の保存から interval 以上経過していれば保存
+   * @return 保存した場合 true（保存先が未設定の場合は常に false）
+   */
+  bool checkpointIfDue();
+
+  /**
+   * @brief 保存先から状態を読み込んで復元
+   * @return 復元結果（保存されていない場合は std::nullopt）
+   * @throw std::logic_error 保存先が設定されていない場合
+   */
+  std::optional<RestoreOutcome> restoreCheckpoint();
+
+  /** @} */
+
+  /**
+   * @name 購入ジャーナル
+   * 現金購入の各手順を記録し、停止後の起動時に途中の購入を復旧します。
+   * @{
+   */
+
+  /**
+   * @brief 購入ジャーナルを設定
+   * @param journal 記録先
+   *
+   * チェックポイントが有効な場合、状態の保存は定期保存だけで、購入ごとには
+   * 保存しません。決着した購入も次の保存までジャーナルに残し、復旧では
+   * 最後に保存した状態へ保存の後の購入を順に再適用します。
+   */
+  void enablePurchaseJournal(domain::IPurchaseJournal &journal);
+
+  /**
+   * @brief 停止前の購入を復旧（チェックポイントの復元の後に呼ぶ）
+   *
+   * チェックポイントを復元した場合は、保存の後に決着した購入も
+   * 再適用します（PurchaseRecoveryUseCase::recover）。
+   *
+   * @return 復旧の結果
+   * @throw std::logic_error 購入ジャーナルが設定されていない場合
+   */
+  PurchaseRecoveryReport recoverPurchases();
+
+  /** @} */
+
+  /**
+   * @name イベントログ
+   * 在庫・残高・モードの変化をドメインイベントとして記録し、
+   * 任意の時点の状態を再生で再現します。既定では記録しません。
+   * @{
+   */
+
+  /**
+   * @brief イベントログへの記録を始める
+   * @param snapshot_interval スナップショットを取る間隔（イベント数）
+   * @param max_snapshots 保持するスナップショットの数
+   * @param store イベントを永続化するストア（省略時はメモリ内だけ）
+   * @throw std::invalid_argument いずれかが 0 の場合
+   * @throw std::logic_error 既に記録している場合
+   *
+   * 呼び出した時点の状態を最初のスナップショットにします。
+   * 再生（EventReplayUseCase）の長さは snapshot_interval 件以内です。
+   * ストアを渡すとイベントを追記のたびに書き込み、メモリに置く
+   * イベントは snapshot_interval × max_snapshots 件程度に抑えられます。
+   * 通番はストアに記録済みのイベントの続きから振ります。
+   */
+  void enableEventLog(std::size_t snapshot_interval,
+                      std::size_t max_snapshots,
+                      domain::IEventStore *store = nullptr);
+
+  /**
+   * @brief イベントログ
+   * @throw std::logic_error enableEventLog() を呼んでいない場合
+   */
+  const domain::EventLog &getEventLog() const;
+
+  /**
+   * @brief イベントログを再生するユースケース
+   * @throw std::logic_error enableEventLog() を呼んでいない場合
+   */
+  const EventReplayUseCase &getEventReplayUseCase() const;
+
+  /** @} */
+
   // ユースケースへのアクセサ
   PurchaseWithCashUseCase &getPurchaseWithCashUseCase() {
     return *purchase_with_cash_usecase_;
@@ -81,12 +239,39 @@ public:
   const domain::Inventory &getInventory() const { return inventory_; }
   const domain::Wallet &getWallet() const { return wallet_; }
   const domain::Sales &getSales() const { return sales_; }
+  const domain::DepletionForecaster &getDepletionForecaster() const {
+    return depletion_forecaster_;
+  }
+  // 在庫僅少の通知先を登録できるよう、非 const で公開する
+  domain::LowStockTracker &getLowStockTracker() { return low_stock_tracker_; }
 
 private:
   // ドメインオブジェクト
   domain::Inventory inventory_;
   domain::Wallet wallet_;
   domain::Sales sales_;
+  domain::DepletionForecaster depletion_forecaster_; ///< 在庫の変化で更新
+  domain::LowStockTracker low_stock_tracker_;        ///< 在庫の変化で更新
+
+  // イベントログ（enableEventLog() まで空）
+  std::unique_ptr<domain::EventLog> event_log_;
+  std::unique_ptr<domain::InventoryEventRecorder> inventory_event_recorder_;
+
+  // チェックポイント
+  domain::IMachineStateRepository *checkpoint_repository_ = nullptr;
+  std::chrono::steady_clock::duration checkpoint_interval_{};
+  std::chrono::steady_clock::time_point last_checkpoint_{};
+  // captureState() が使い回す（const の呼び出しからも書き込む）
+  mutable std::vector<domain::SlotSnapshot> snapshot_buffer_;
+
+  domain::IPurchaseJournal *purchase_journal_ = nullptr; ///< 購入ジャーナル
+  /// 復元したチェックポイントに反映済みの購入通番（未復元なら空）
+  std::optional<std::uint32_t> restored_journal_position_;
+
+  /**
+   * @brief 現金購入のユースケースにジャーナルの設定を反映
+   */
+  void configurePurchaseJournal();
 
   // 外部インターフェース（参照で保持）
   domain::ICoinMech &coin_mech_;
@@ -100,6 +285,7 @@ private:
   std::unique_ptr<InventoryRefillUseCase> inventory_refill_usecase_;
   std::unique_ptr<CashCollectionUseCase> cash_collection_usecase_;
   std::unique_ptr<SalesReportingUseCase> sales_reporting_usecase_;
+  std::unique_ptr<EventReplayUseCase> event_replay_usecase_;
 };
 
 } // namespace usecases
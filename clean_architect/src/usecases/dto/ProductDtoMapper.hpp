@@ -0,0 +1,113 @@
+/**
+ * @file ProductDtoMapper.hpp
+ * @brief スロットのスナップショットから商品DTO・ビューへの変換
+ *
+ * @details
+ * 在庫のスナップショット（SlotSnapshot）を、ユースケースが返す商品一覧
+ * （ProductDto・ProductView）に変換する関数群です。現金・電子マネーの
+ * 両ユースケースで共有します。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_USECASES_DTO_PRODUCT_DTO_MAPPER_HPP
+#define VENDING_MACHINE_USECASES_DTO_PRODUCT_DTO_MAPPER_HPP
+
+#include "domain/inventory/SlotSnapshot.hpp"
+#include "usecases/dto/PurchaseDTOs.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace usecases {
+namespace dto {
+
+/**
+ * @brief スロットのスナップショットを商品ビューに変換（文字列のコピーなし）
+ * @param slot Inventory::snapshot() などで取得したスロット
+ * @return 商品ビュー
+ */
+inline ProductView toProductView(const domain::SlotSnapshot &slot) {
+  return {slot.slot_id.getValue(), slot.product_info->getName().getValue(),
+          slot.product_info->getPrice().getRawValue(), slot.stock.getValue()};
+}
+
+/**
+ * @brief スナップショットの並びを商品ビューとして書き出す
+ * @param slots Inventory::snapshot() などで取得したスロットの並び
+ * @param out 出力先（先頭からクリアされる）
+ * @param in_stock_only trueの場合、在庫切れのスロットを除外する
+ * @return 書き出した商品ビューの数
+ */
+inline std::size_t
+toProductViews(const std::vector<domain::SlotSnapshot> &slots,
+               std::vector<ProductView> &out, bool in_stock_only = false) {
+  out.clear();
+  out.reserve(slots.size());
+  for (const auto &slot : slots) {
+    if (in_stock_only && slot.stock.isZero()) {
+      continue;
+    }
+    out.push_back(toProductView(slot));
+  }
+  return out.size();
+}
+
+/**
+ * @brief 商品ビューを所有権を持つ商品DTOに変換
+ * @param view 商品ビュー
+ * @return 商品DTO
+ */
+inline ProductDto toProductDto(const ProductView &view) {
+  return {view.slot_id, std::string(view.name), view.price, view.stock};
+}
+
+/**
+ * @brief 商品ビューの並びを商品DTOのリストに変換
+ * @param views 商品ビューの並び
+ * @return 商品DTOのリスト
+ */
+inline std::vector<ProductDto>
+toProductDtos(const std::vector<ProductView> &views) {
+  std::vector<ProductDto> dtos;
+  dtos.reserve(views.size());
+  for (const auto &view : views) {
+    dtos.push_back(toProductDto(view));
+  }
+  return dtos;
+}
+
+/**
+ * @brief スナップショットの並びを、メモリリソースに置く商品DTOのリストに変換
+ * @param slots Inventory::snapshot() などで取得したスロットの並び
+ * @param resource リストと商品名の確保に使うメモリリソース
+ * @param in_stock_only trueの場合、在庫切れのスロットを除外する
+ * @return 商品DTOのリスト
+ *
+ * @details
+ * 確保はすべて resource から行い、グローバルなヒープは使わない。
+ */
+inline PmrProductList
+toProductDtos(const std::vector<domain::SlotSnapshot> &slots,
+              std::pmr::memory_resource *resource,
+              bool in_stock_only = false) {
+  PmrProductList dtos(resource);
+  dtos.reserve(slots.size());
+  for (const auto &slot : slots) {
+    if (in_stock_only && slot.stock.isZero()) {
+      continue;
+    }
+    auto view = toProductView(slot);
+    dtos.emplace_back(view.slot_id, view.name, view.price, view.stock);
+  }
+  return dtos;
+}
+
+} // namespace dto
+} // namespace usecases
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_USECASES_DTO_PRODUCT_DTO_MAPPER_HPP
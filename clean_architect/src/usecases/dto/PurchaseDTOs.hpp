@@ -1,7 +1,11 @@
 #ifndef VENDING_MACHINE_USECASES_DTO_PURCHASE_DTOS_HPP
 #define VENDING_MACHINE_USECASES_DTO_PURCHASE_DTOS_HPP
 
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace vending_machine {
@@ -15,6 +19,58 @@ struct ProductDto {
   int stock;
 };
 
+/**
+ * @brief 呼び出し元のメモリリソースに置く商品DTO（std::pmr）
+ *
+ * 商品名を所有する点は ProductDto と同じだが、文字列の領域を
+ * std::pmr のメモリリソースから確保する。アロケータ対応型のため、
+ * PmrProductList に入れると一覧と同じメモリリソースを使う。
+ * 1回のリクエストの間だけ使う一覧を、スタック上のバッファ
+ * （std::pmr::monotonic_buffer_resource）に置くために使う。
+ */
+struct PmrProductDto {
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+  int slot_id = 0;
+  std::pmr::string name;
+  int price = 0;
+  int stock = 0;
+
+  explicit PmrProductDto(const allocator_type &allocator = {})
+      : name(allocator) {}
+  PmrProductDto(int id, std::string_view product_name, int product_price,
+                int product_stock, const allocator_type &allocator = {})
+      : slot_id(id), name(product_name, allocator), price(product_price),
+        stock(product_stock) {}
+  PmrProductDto(const PmrProductDto &other, const allocator_type &allocator)
+      : slot_id(other.slot_id), name(other.name, allocator),
+        price(other.price), stock(other.stock) {}
+  PmrProductDto(PmrProductDto &&other, const allocator_type &allocator)
+      : slot_id(other.slot_id), name(std::move(other.name), allocator),
+        price(other.price), stock(other.stock) {}
+  PmrProductDto(const PmrProductDto &) = default;
+  PmrProductDto(PmrProductDto &&) = default;
+  PmrProductDto &operator=(const PmrProductDto &) = default;
+  PmrProductDto &operator=(PmrProductDto &&) = default;
+};
+
+/// 商品DTOのリスト（要素の商品名も同じメモリリソースに置く）
+using PmrProductList = std::pmr::vector<PmrProductDto>;
+
+/**
+ * @brief 商品一覧表示用の軽量ビュー
+ *
+ * 商品名は在庫（Inventory）側の文字列を参照するだけでコピーしない。
+ * 取得元の Inventory が生存している間のみ有効で、
+ * 在庫数は取得時点の値。保持し続ける場合は ProductDto を使うこと。
+ */
+struct ProductView {
+  int slot_id;
+  std::string_view name;
+  int price;
+  int stock;
+};
+
 struct InsertCashRequest {
   int amount;
 };
@@ -41,10 +97,15 @@ struct SalesReportItemDto {
   int amount;
 };
 
+struct TopSlotDto {
+  int slot_id;
+  std::uint64_t estimated_count; // Upper bound of the true count
+};
+
 struct SalesReportDto {
-  int total_sales;
-  int cash_sales;
-  int emoney_sales;
+  std::int64_t total_sales;
+  std::int64_t cash_sales;
+  std::int64_t emoney_sales;
 };
 
 struct EMoneyPurchaseRequest {
@@ -325,6 +325,22 @@ TEST_F(QuantityTest, GreaterThanOperatorWorks) {
   EXPECT_FALSE(quantity1 > quantity3);
 }
 
+/**
+ * @test 例外を送出しない版の増減は結果または ErrorCode を返す
+ */
+TEST_F(QuantityTest, TryIncreaseAndDecreaseReturnErrorCodes) {
+  Quantity quantity(Quantity::MAX_CAPACITY - 1);
+
+  auto increased = quantity.tryIncrease(1);
+  ASSERT_TRUE(increased);
+  EXPECT_EQ(Quantity::MAX_CAPACITY, increased.value().getValue());
+
+  EXPECT_EQ(ErrorCode::CAPACITY_EXCEEDED, quantity.tryIncrease(2).error());
+  EXPECT_EQ(ErrorCode::INVALID_AMOUNT, quantity.tryIncrease(-1).error());
+  EXPECT_EQ(ErrorCode::OUT_OF_STOCK, Quantity(0).tryDecrease(1).error());
+  EXPECT_EQ(ErrorCode::INVALID_AMOUNT, quantity.tryDecrease(-1).error());
+}
+
 } // namespace test
 } // namespace domain
 } // namespace vending_machine
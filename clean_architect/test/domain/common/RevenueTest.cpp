@@ -0,0 +1,90 @@
+/**
+ * @file RevenueTest.cpp
+ * @brief Revenue / RevenueAccumulator のユニットテスト
+ *
+ * テスト方針:
+ * - int の範囲を超える合計でも正確に集計できる
+ * - int64 の上限を超える加算は黙って桁あふれせず検出される
+ * - ブロック単位の合計が素朴な合計と一致する
+ */
+
+#include "domain/common/Revenue.hpp"
+#include "domain/common/RevenueAccumulator.hpp"
+#include <climits>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+static_assert(Revenue(Price(100)) + Revenue(Money(50)) == Revenue(150));
+
+TEST(RevenueTest, RejectsNegativeValue) {
+  std::int64_t negative = -1;
+  EXPECT_THROW(Revenue{negative}, std::invalid_argument);
+}
+
+TEST(RevenueTest, HoldsValuesBeyondIntRange) {
+  Revenue total = Revenue(Money(INT_MAX)) + Revenue(Money(INT_MAX));
+
+  EXPECT_EQ(total.getRawValue(), 2LL * INT_MAX);
+}
+
+TEST(RevenueTest, TryAddReportsOverflow) {
+  Revenue max(Revenue::MAX_VALUE);
+
+  auto result = max.tryAdd(Revenue(1));
+
+  EXPECT_FALSE(result);
+  EXPECT_EQ(result.error(), ErrorCode::ARITHMETIC_OVERFLOW);
+  EXPECT_THROW(max + Revenue(1), std::overflow_error);
+  EXPECT_EQ((max + Revenue()).getRawValue(), Revenue::MAX_VALUE);
+}
+
+TEST(RevenueAccumulatorTest, SumsBeyondIntRangeExactly) {
+  RevenueAccumulator accumulator;
+  accumulator.add(Price(INT_MAX));
+  accumulator.add(Money(INT_MAX));
+  accumulator.add(INT_MAX);
+
+  EXPECT_EQ(accumulator.getTotal().getRawValue(), 3LL * INT_MAX);
+}
+
+TEST(RevenueAccumulatorTest, MergeCombinesTotals) {
+  RevenueAccumulator left;
+  RevenueAccumulator right;
+  left.add(Price(120));
+  right.add(Price(150));
+  right.add(Price(INT_MAX));
+
+  left.merge(right);
+
+  EXPECT_EQ(left.getTotal().getRawValue(), 270LL + INT_MAX);
+}
+
+TEST(RevenueAccumulatorTest, DetectsOverflowOfCombinedTotal) {
+  RevenueAccumulator accumulator;
+  accumulator.add(Revenue(Revenue::MAX_VALUE));
+
+  accumulator.add(1);
+
+  EXPECT_THROW(accumulator.getTotal(), std::overflow_error);
+}
+
+TEST(RevenueAccumulatorTest, AddMatchesNaiveSumBeyondInt) {
+  RevenueAccumulator accumulator;
+  std::int64_t expected = 0;
+  for (int i = 0; i < 1000; ++i) {
+    int amount = (i % 7 == 0) ? INT_MAX : i * 10;
+    accumulator.add(amount);
+    expected += amount;
+  }
+
+  EXPECT_EQ(accumulator.getTotal().getRawValue(), expected);
+  EXPECT_EQ(RevenueAccumulator().getTotal().getRawValue(), 0);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
@@ -0,0 +1,70 @@
+/**
+ * @file StrongIntTest.cpp
+ * @brief StrongInt ベースの値オブジェクトのユニットテスト
+ *
+ * テスト方針:
+ * - 妥当な値はコンパイル時に生成・比較できる
+ * - 異なる値オブジェクト型同士は比較できない
+ * - 実行時の妥当性検証（例外）は従来どおり
+ */
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/SessionId.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <type_traits>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+// コンパイル時に評価できること
+static_assert(Money(100) + Money(20) == Money(120));
+static_assert(Money(100) - Money(20) < Money(100));
+static_assert(Price(150) >= Price(150));
+static_assert(Quantity(3).increase(2) == Quantity(5));
+static_assert(Quantity(0).tryDecrease(1).error() == ErrorCode::OUT_OF_STOCK);
+static_assert(SlotId(1) < SlotId(2));
+static_assert(SalesId(7).getValue() == 7);
+static_assert(SessionId(3) != SessionId(4));
+
+// 値オブジェクトは int と同じ大きさで、コピーが自明であること
+static_assert(sizeof(Money) == sizeof(int));
+static_assert(sizeof(SlotId) == sizeof(int));
+static_assert(std::is_trivially_copyable_v<Quantity>);
+
+// 異なる値オブジェクト型同士の比較は定義されないこと
+template <typename A, typename B, typename = void>
+struct IsEqualityComparable : std::false_type {};
+template <typename A, typename B>
+struct IsEqualityComparable<
+    A, B, std::void_t<decltype(std::declval<A>() == std::declval<B>())>>
+    : std::true_type {};
+
+static_assert(IsEqualityComparable<SlotId, SlotId>::value);
+static_assert(!IsEqualityComparable<SlotId, SalesId>::value);
+static_assert(!IsEqualityComparable<Money, Price>::value);
+
+/**
+ * @test 実行時の値は従来どおり検証される
+ */
+TEST(StrongIntTest, RuntimeValidationIsUnchanged) {
+  volatile int negative = -1;
+  volatile int zero = 0;
+
+  EXPECT_THROW(Money{negative}, std::invalid_argument);
+  EXPECT_THROW(Price{negative}, std::invalid_argument);
+  EXPECT_THROW(Quantity(Quantity::MAX_CAPACITY + 1), std::invalid_argument);
+  EXPECT_THROW(SlotId{zero}, std::invalid_argument);
+  EXPECT_THROW(SalesId{zero}, std::invalid_argument);
+  EXPECT_THROW(SessionId{zero}, std::invalid_argument);
+  EXPECT_THROW(Money(10) - Money(20), std::domain_error);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
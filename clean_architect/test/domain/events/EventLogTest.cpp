@@ -0,0 +1,249 @@
+/**
+ * @file EventLogTest.cpp
+ * @brief EventLog と各集約のイベント記録のユニットテスト
+ *
+ * テスト方針:
+ * - 追記したイベントに 1 始まりの通番が振られる
+ * - スナップショットは間隔ごとに取られ、通番以前で最新のものが引ける
+ * - 保持数を超えたスナップショットは最初のものを除いて古い順に破棄され、
+ *   イベントは破棄されない。ストアがあればメモリに置く範囲だけが狭まる
+ * - 商品名は呼び出し元の文字列ではなくログの複製を参照する
+ * - Inventory・Wallet・Sales の変化が対応するイベントとして記録される
+ */
+
+#include "domain/events/EventLog.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/events/InventoryEventRecorder.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include "domain/payment/Wallet.hpp"
+#include "domain/sales/Sales.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+/**
+ * @brief メモリ内のイベントストア（テスト用）
+ */
+class InMemoryEventStore : public IEventStore {
+public:
+  void append(const DomainEvent &event) override {
+    if (event.sequence != events_.size() + 1) {
+      throw std::invalid_argument("Event sequence must be contiguous");
+    }
+    events_.push_back(event);
+    names_.emplace_back(event.product_name);
+  }
+
+  std::uint64_t getLastSequence() const override { return events_.size(); }
+
+  void forEach(std::uint64_t from, std::uint64_t to,
+               const EventVisitor &visitor) const override {
+    for (std::uint64_t sequence = std::max<std::uint64_t>(from, 1);
+         sequence <= std::min(to, getLastSequence()); ++sequence) {
+      DomainEvent event = events_[sequence - 1];
+      event.product_name = names_[sequence - 1];
+      visitor(event);
+    }
+  }
+
+private:
+  std::vector<DomainEvent> events_;
+  std::vector<std::string> names_;
+};
+
+class EventLogTest : public ::testing::Test {
+protected:
+  EventLog log;
+
+  static MachineState emptyState(int balance) {
+    return MachineState{SalesId(1), Mode::NORMAL, Money(balance), {},
+                        std::nullopt};
+  }
+};
+
+TEST_F(EventLogTest, AssignsSequenceNumbers) {
+  log.append(DomainEvent::cashDeposited(Money(100)));
+  log.append(DomainEvent::balanceWithdrawn(Money(30)));
+
+  ASSERT_EQ(log.getEvents().size(), 2u);
+  EXPECT_EQ(log.getEvents()[0].sequence, 1u);
+  EXPECT_EQ(log.getEvents()[1].sequence, 2u);
+  EXPECT_EQ(log.getEvents()[1].type, DomainEventType::BALANCE_WITHDRAWN);
+  EXPECT_EQ(log.getEvents()[1].value, 30);
+  EXPECT_EQ(log.getLastSequence(), 2u);
+}
+
+TEST_F(EventLogTest, TakesSnapshotsAtInterval) {
+  int captures = 0;
+  log.enableSnapshots(2, 10,
+                      [&captures] { return emptyState(++captures); });
+
+  for (int i = 0; i < 5; ++i) {
+    log.append(DomainEvent::cashDeposited(Money(10)));
+  }
+
+  EXPECT_EQ(log.getSnapshotCount(), 2u); // 通番 2 と 4
+  EXPECT_EQ(log.findSnapshot(1), nullptr);
+  ASSERT_NE(log.findSnapshot(3), nullptr);
+  EXPECT_EQ(log.findSnapshot(3)->sequence, 2u);
+  EXPECT_EQ(log.findSnapshot(5)->sequence, 4u);
+  EXPECT_EQ(log.findSnapshot(5)->state.balance, Money(2));
+}
+
+TEST_F(EventLogTest, RejectsInvalidSnapshotSettings) {
+  EXPECT_THROW(log.takeSnapshot(), std::logic_error);
+  EXPECT_THROW(log.enableSnapshots(0, 1, [] { return emptyState(0); }),
+               std::invalid_argument);
+  EXPECT_THROW(log.enableSnapshots(10, 0, [] { return emptyState(0); }),
+               std::invalid_argument);
+  EXPECT_THROW(log.enableSnapshots(10, 1, nullptr), std::invalid_argument);
+}
+
+TEST_F(EventLogTest, RetiredSnapshotsDoNotDiscardEvents) {
+  log.enableSnapshots(3, 1, [] { return emptyState(0); });
+
+  for (int i = 0; i < 10; ++i) {
+    log.append(DomainEvent::cashDeposited(Money(10)));
+  }
+
+  // 通番 3, 6, 9 のうち最初の 3 と最新の 9 を保持する
+  EXPECT_EQ(log.getSnapshotCount(), 2u);
+  EXPECT_EQ(log.findSnapshot(8)->sequence, 3u);
+  EXPECT_EQ(log.findSnapshot(10)->sequence, 9u);
+  // ストアが無いのでイベントはすべてメモリに残る
+  EXPECT_EQ(log.getFirstSequence(), 1u);
+  EXPECT_EQ(log.getEvents().size(), 10u);
+}
+
+TEST_F(EventLogTest, StoreHoldsEventsMovedOutOfMemory) {
+  InMemoryEventStore store;
+  log.setStore(&store);
+  log.enableSnapshots(3, 2, [] { return emptyState(0); });
+
+  for (int i = 0; i < 10; ++i) {
+    log.append(DomainEvent::cashDeposited(Money(i)));
+  }
+
+  // 最初の 3 に加えて 6 と 9 を保持する
+  EXPECT_EQ(log.getSnapshotCount(), 3u);
+  EXPECT_EQ(log.getFirstSequence(), 1u);
+  log.append(DomainEvent::cashDeposited(Money(10)));
+  log.append(DomainEvent::cashDeposited(Money(11)));
+  // 通番 12 で 6 を破棄し、9 以前をメモリから外す
+  EXPECT_EQ(log.getSnapshotCount(), 3u);
+  EXPECT_EQ(log.findSnapshot(8)->sequence, 3u);
+  EXPECT_EQ(log.getFirstSequence(), 10u);
+  EXPECT_EQ(log.getEvents().size(), 3u);
+  EXPECT_EQ(store.getLastSequence(), 12u);
+
+  std::vector<int> values;
+  store.forEach(1, 3, [&values](const DomainEvent &event) {
+    values.push_back(event.value);
+  });
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2}));
+}
+
+TEST_F(EventLogTest, SequenceContinuesFromStore) {
+  InMemoryEventStore store;
+  {
+    EventLog previous;
+    previous.setStore(&store);
+    previous.append(DomainEvent::cashDeposited(Money(10)));
+    previous.append(DomainEvent::cashDeposited(Money(20)));
+  }
+
+  log.setStore(&store);
+  EXPECT_EQ(log.getFirstSequence(), 3u);
+  log.append(DomainEvent::cashDeposited(Money(30)));
+  EXPECT_EQ(log.getEvents().front().sequence, 3u);
+  EXPECT_EQ(store.getLastSequence(), 3u);
+  // 記録を始めた後は付け替えられない
+  EXPECT_THROW(log.setStore(nullptr), std::logic_error);
+}
+
+TEST_F(EventLogTest, KeepsOwnCopyOfProductNames) {
+  ProductInfo info(ProductName("お茶"), Price(150));
+  log.append(DomainEvent::slotConfigured(SlotId(1), info, Quantity(1)));
+  log.append(DomainEvent::slotConfigured(SlotId(2), info, Quantity(1)));
+
+  const auto &events = log.getEvents();
+  EXPECT_EQ(events[0].product_name, "お茶");
+  EXPECT_NE(events[0].product_name.data(),
+            info.getName().getValue().data());
+  // 同じ名前は1つの複製を共有する
+  EXPECT_EQ(events[0].product_name.data(), events[1].product_name.data());
+}
+
+TEST_F(EventLogTest, RecordsInventoryChanges) {
+  Inventory inventory;
+  InventoryEventRecorder recorder(inventory, log);
+  inventory.addObserver(recorder);
+
+  inventory.addSlot(ProductSlot{
+      SlotId(3), ProductInfo(ProductName("水"), Price(100)), Quantity(2)});
+  inventory.dispense(SlotId(3));
+  inventory.tryRevertDispense(SlotId(3));
+  inventory.refill(SlotId(3), Quantity(5));
+
+  const auto &events = log.getEvents();
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events[0].type, DomainEventType::SLOT_CONFIGURED);
+  EXPECT_EQ(events[0].product_name, "水");
+  EXPECT_EQ(events[0].price, 100);
+  EXPECT_EQ(events[0].value, 2);
+  EXPECT_EQ(events[1].type, DomainEventType::PRODUCT_DISPENSED);
+  EXPECT_EQ(events[1].value, 1);
+  EXPECT_EQ(events[2].type, DomainEventType::DISPENSE_REVERTED);
+  EXPECT_EQ(events[2].value, 2);
+  EXPECT_EQ(events[3].type, DomainEventType::SLOT_REFILLED);
+  EXPECT_EQ(events[3].value, 7);
+  for (const auto &event : events) {
+    EXPECT_TRUE(event.isSlotEvent());
+    EXPECT_EQ(event.slot_id, 3);
+  }
+}
+
+TEST_F(EventLogTest, RecordsWalletChangesExceptZeroAmounts) {
+  Wallet wallet;
+  wallet.setEventSink(&log);
+
+  wallet.depositCash(Money(500));
+  wallet.authorizeEMoney(Money(0));
+  wallet.withdraw(Money(120));
+  EXPECT_EQ(wallet.tryWithdraw(Money(1000)),
+            ErrorCode::INSUFFICIENT_BALANCE);
+
+  const auto &events = log.getEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, DomainEventType::CASH_DEPOSITED);
+  EXPECT_EQ(events[0].value, 500);
+  EXPECT_EQ(events[1].type, DomainEventType::BALANCE_WITHDRAWN);
+  EXPECT_EQ(events[1].value, 120);
+}
+
+TEST_F(EventLogTest, RecordsModeTransitionsOnly) {
+  Sales sales(SalesId(1));
+  sales.setEventSink(&log);
+
+  sales.startMaintenance();
+  sales.startMaintenance(); // 変化なし
+  sales.endMaintenance();
+  sales.startSession(SessionId(1)); // セッションはイベントにしない
+
+  const auto &events = log.getEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, DomainEventType::MODE_CHANGED);
+  EXPECT_EQ(static_cast<Mode>(events[0].value), Mode::MAINTENANCE);
+  EXPECT_EQ(static_cast<Mode>(events[1].value), Mode::NORMAL);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
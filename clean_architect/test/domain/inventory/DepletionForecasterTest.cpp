@@ -0,0 +1,140 @@
+/**
+ * @file DepletionForecasterTest.cpp
+ * @brief DepletionForecaster のユニットテスト
+ *
+ * テスト方針:
+ * - 一定の速度で売れ続けると推定販売速度はその速度に近づく
+ * - 売り切れまでの時間は 在庫数 / 販売速度
+ * - 販売のないスロットは予測できない（末尾に並ぶ）
+ * - 複数台をまとめて売り切れが近い順に並べられる
+ */
+
+#include "domain/inventory/DepletionForecaster.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+using std::chrono::hours;
+using std::chrono::minutes;
+using TimePoint = std::chrono::system_clock::time_point;
+
+class DepletionForecasterTest : public ::testing::Test {
+protected:
+  // 1時間に2個ずつ、10時間売り続ける
+  void sellSteadily(DepletionForecaster &forecaster, int slot, int stock) {
+    for (int i = 0; i < 20; ++i) {
+      start += minutes(30);
+      forecaster.recordSale(SlotId(slot), Quantity(stock), start);
+    }
+  }
+
+  TimePoint start = TimePoint(hours(1000));
+};
+
+TEST_F(DepletionForecasterTest, RejectsNonPositiveTimeConstant) {
+  EXPECT_THROW(DepletionForecaster(std::chrono::seconds(0)),
+               std::invalid_argument);
+}
+
+TEST_F(DepletionForecasterTest, ConvergesToSteadySalesRate) {
+  DepletionForecaster forecaster(hours(2));
+  sellSteadily(forecaster, 1, 10);
+
+  auto result = forecaster.forecast(SlotId(1), start);
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_NEAR(result->sales_per_hour, 2.0, 0.6);
+  ASSERT_TRUE(result->time_to_empty.has_value());
+  // 10個 / 約2個毎時 ≒ 5時間
+  EXPECT_NEAR(result->time_to_empty->count(), 5 * 3600, 1.5 * 3600);
+}
+
+TEST_F(DepletionForecasterTest, RateDecaysWithoutSales) {
+  DepletionForecaster forecaster(hours(2));
+  sellSteadily(forecaster, 1, 10);
+
+  auto recent = forecaster.forecast(SlotId(1), start);
+  auto later = forecaster.forecast(SlotId(1), start + hours(6));
+
+  EXPECT_LT(later->sales_per_hour, recent->sales_per_hour / 10);
+  EXPECT_GT(*later->time_to_empty, *recent->time_to_empty);
+}
+
+TEST_F(DepletionForecasterTest, RevertCancelsSale) {
+  DepletionForecaster forecaster(hours(2));
+  forecaster.recordStock(SlotId(1), Quantity(5));
+  forecaster.recordSale(SlotId(1), Quantity(4), start);
+  forecaster.recordSaleReverted(SlotId(1), Quantity(5), start);
+
+  auto result = forecaster.forecast(SlotId(1), start);
+
+  EXPECT_EQ(result->stock, Quantity(5));
+  EXPECT_DOUBLE_EQ(result->sales_per_hour, 0.0);
+  EXPECT_FALSE(result->time_to_empty.has_value());
+}
+
+TEST_F(DepletionForecasterTest, RanksSlotsBySoonestDepletion) {
+  DepletionForecaster forecaster(hours(2));
+  forecaster.recordStock(SlotId(4), Quantity(10)); // 販売なし
+  forecaster.recordStock(SlotId(3), Quantity(0));  // 売り切れ
+  sellSteadily(forecaster, 1, 20);
+  sellSteadily(forecaster, 2, 4);
+
+  auto ranking = forecaster.rankByDepletion(start);
+
+  ASSERT_EQ(ranking.size(), 4u);
+  EXPECT_EQ(ranking[0].slot_id, SlotId(3));
+  EXPECT_EQ(ranking[1].slot_id, SlotId(2));
+  EXPECT_EQ(ranking[2].slot_id, SlotId(1));
+  EXPECT_EQ(ranking[3].slot_id, SlotId(4));
+  EXPECT_FALSE(ranking[3].time_to_empty.has_value());
+  EXPECT_FALSE(forecaster.forecast(SlotId(9), start).has_value());
+}
+
+TEST_F(DepletionForecasterTest, RanksAcrossFleet) {
+  DepletionForecaster machine_a(hours(2));
+  DepletionForecaster machine_b(hours(2));
+  sellSteadily(machine_a, 1, 8);
+  sellSteadily(machine_b, 1, 2);
+  machine_b.recordStock(SlotId(2), Quantity(10));
+
+  auto ranking = DepletionForecaster::rankFleet(
+      {{"A", &machine_a}, {"B", &machine_b}}, start, 2);
+
+  ASSERT_EQ(ranking.size(), 2u);
+  EXPECT_EQ(ranking[0].machine_id, "B");
+  EXPECT_EQ(ranking[0].forecast.slot_id, SlotId(1));
+  EXPECT_EQ(ranking[1].machine_id, "A");
+}
+
+TEST_F(DepletionForecasterTest, FollowsInventoryAsObserver) {
+  TimePoint now = start;
+  DepletionForecaster forecaster(hours(2), [&now] { return now; });
+  Inventory inventory;
+  inventory.addObserver(forecaster);
+  inventory.addSlot(ProductSlot(
+      SlotId(1), ProductInfo(ProductName("Cola"), Price(100)), Quantity(5)));
+
+  now += minutes(10);
+  inventory.dispense(SlotId(1));
+  auto result = forecaster.forecast(SlotId(1), now);
+
+  EXPECT_EQ(result->stock, Quantity(4));
+  EXPECT_GT(result->sales_per_hour, 0.0);
+
+  inventory.refill(SlotId(1), Quantity(6));
+  EXPECT_EQ(forecaster.forecast(SlotId(1), now)->stock, Quantity(10));
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
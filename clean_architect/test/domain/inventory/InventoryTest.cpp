@@ -14,8 +14,11 @@
 #include "domain/inventory/ProductInfo.hpp"
 #include "domain/inventory/ProductName.hpp"
 #include "domain/inventory/ProductSlot.hpp"
+#include "domain/inventory/SlotSnapshot.hpp"
 #include <gtest/gtest.h>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace vending_machine {
 namespace domain {
@@ -316,6 +319,142 @@ TEST_F(InventoryTest, OperationsOnDifferentSlotsAreIndependent) {
   EXPECT_EQ(30, inventory.getSlot(SlotId(2)).getStock().getValue());
 }
 
+// ========================================
+// スナップショットテスト
+// ========================================
+
+/**
+ * @test 空のInventoryのスナップショットは空
+ */
+TEST_F(InventoryTest, SnapshotOfEmptyInventoryIsEmpty) {
+  Inventory inventory;
+  std::vector<SlotSnapshot> out;
+
+  EXPECT_EQ(0u, inventory.snapshot(out));
+  EXPECT_TRUE(out.empty());
+  EXPECT_EQ(0u, inventory.getSlotCount());
+}
+
+/**
+ * @test 欠番のあるスロットIDも含めて全スロットをID昇順で返す
+ */
+TEST_F(InventoryTest, SnapshotReturnsSparseSlotsInOrder) {
+  Inventory inventory;
+  inventory.addSlot(ProductSlot(SlotId(7), juice, Quantity(0)));
+  inventory.addSlot(ProductSlot(SlotId(1), cola, Quantity(10)));
+  inventory.addSlot(ProductSlot(SlotId(5), coffee, Quantity(3)));
+
+  std::vector<SlotSnapshot> out;
+  ASSERT_EQ(3u, inventory.snapshot(out));
+
+  EXPECT_EQ(1, out[0].slot_id.getValue());
+  EXPECT_EQ("Cola", out[0].product_info->getName().getValue());
+  EXPECT_EQ(10, out[0].stock.getValue());
+  EXPECT_EQ(5, out[1].slot_id.getValue());
+  EXPECT_EQ(120, out[1].product_info->getPrice().getRawValue());
+  EXPECT_EQ(7, out[2].slot_id.getValue());
+  EXPECT_TRUE(out[2].stock.isZero());
+}
+
+/**
+ * @test 呼び出し側のバッファは上書きされ、在庫の変化が反映される
+ */
+TEST_F(InventoryTest, SnapshotOverwritesCallerBuffer) {
+  Inventory inventory;
+  inventory.addSlot(ProductSlot(SlotId(1), cola, Quantity(10)));
+  inventory.addSlot(ProductSlot(SlotId(2), coffee, Quantity(20)));
+
+  std::vector<SlotSnapshot> out;
+  inventory.snapshot(out);
+  inventory.dispense(SlotId(1));
+  ASSERT_EQ(2u, inventory.snapshot(out));
+
+  EXPECT_EQ(9, out[0].stock.getValue());
+  EXPECT_EQ(20, out[1].stock.getValue());
+}
+
+/**
+ * @test 多数のスロットも1回の呼び出しで取得できる
+ */
+TEST_F(InventoryTest, SnapshotHandlesManySlots) {
+  Inventory inventory;
+  const int slot_count = 5000;
+  for (int i = 1; i <= slot_count; ++i) {
+    inventory.addSlot(ProductSlot(SlotId(i * 2), cola, Quantity(i % 10)));
+  }
+
+  std::vector<SlotSnapshot> out;
+  ASSERT_EQ(static_cast<std::size_t>(slot_count), inventory.snapshot(out));
+  EXPECT_EQ(static_cast<std::size_t>(slot_count), inventory.getSlotCount());
+  EXPECT_EQ(2, out.front().slot_id.getValue());
+  EXPECT_EQ(slot_count * 2, out.back().slot_id.getValue());
+}
+
+/**
+ * @test 例外を送出しない版の販売・補充・検索は ErrorCode で失敗を返す
+ */
+TEST_F(InventoryTest, TryOperationsReturnErrorCodes) {
+  Inventory inventory;
+  inventory.addSlot(ProductSlot(SlotId(1), cola, Quantity(1)));
+
+  EXPECT_EQ(nullptr, inventory.findSlot(SlotId(2)));
+  EXPECT_EQ(ErrorCode::SLOT_NOT_FOUND, inventory.tryDispense(SlotId(2)));
+  EXPECT_EQ(ErrorCode::SLOT_NOT_FOUND,
+            inventory.tryRefill(SlotId(2), Quantity(1)));
+
+  EXPECT_EQ(ErrorCode::CAPACITY_EXCEEDED,
+            inventory.tryRefill(SlotId(1), Quantity(Quantity::MAX_CAPACITY)));
+  EXPECT_EQ(ErrorCode::OK, inventory.tryDispense(SlotId(1)));
+  EXPECT_EQ(ErrorCode::OUT_OF_STOCK, inventory.tryDispense(SlotId(1)));
+  ASSERT_NE(nullptr, inventory.findSlot(SlotId(1)));
+  EXPECT_TRUE(inventory.findSlot(SlotId(1))->getStock().isZero());
+}
+
+// オブザーバーへの通知
+namespace {
+
+class RecordingObserver : public IInventoryObserver {
+public:
+  void onDispensed(const SlotId &slot_id, const Quantity &remaining) override {
+    events.push_back("dispensed " + std::to_string(slot_id.getValue()) + " " +
+                     std::to_string(remaining.getValue()));
+  }
+  void onDispenseReverted(const SlotId &slot_id,
+                          const Quantity &stock) override {
+    events.push_back("reverted " + std::to_string(slot_id.getValue()) + " " +
+                     std::to_string(stock.getValue()));
+  }
+  void onStocked(const SlotId &slot_id, const Quantity &stock) override {
+    events.push_back("stocked " + std::to_string(slot_id.getValue()) + " " +
+                     std::to_string(stock.getValue()));
+  }
+
+  std::vector<std::string> events;
+};
+
+} // namespace
+
+TEST_F(InventoryTest, NotifiesObserversOfStockChanges) {
+  Inventory inventory;
+  RecordingObserver observer;
+  inventory.addObserver(observer);
+
+  inventory.addSlot(ProductSlot(SlotId(1), cola, Quantity(2)));
+  inventory.dispense(SlotId(1));
+  inventory.tryDispense(SlotId(1));
+  inventory.tryDispense(SlotId(1)); // 在庫切れは通知しない
+  inventory.tryRevertDispense(SlotId(1));
+  inventory.refill(SlotId(1), Quantity(3));
+  inventory.tryRefill(SlotId(9), Quantity(1)); // 存在しないスロット
+
+  std::vector<std::string> expected = {"stocked 1 2",  "dispensed 1 1",
+                                       "dispensed 1 0", "reverted 1 1",
+                                       "stocked 1 4"};
+  EXPECT_EQ(observer.events, expected);
+  EXPECT_EQ(inventory.tryRevertDispense(SlotId(9)),
+            ErrorCode::SLOT_NOT_FOUND);
+}
+
 } // namespace test
 } // namespace domain
 } // namespace vending_machine
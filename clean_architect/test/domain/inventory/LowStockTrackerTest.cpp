@@ -0,0 +1,104 @@
+/**
+ * @file LowStockTrackerTest.cpp
+ * @brief LowStockTracker のユニットテスト
+ *
+ * テスト方針:
+ * - しきい値を下回ったとき・回復したときに1回ずつ通知される
+ * - 在庫の少ない順の取得が索引から正しく得られる
+ * - Inventory のオブザーバーとして販売・補充に追従する
+ */
+
+#include "domain/inventory/LowStockTracker.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+class LowStockTrackerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    tracker.addListener(
+        [this](const LowStockEvent &event) { events.push_back(event); });
+  }
+
+  LowStockTracker tracker{0.2}; // 50 * 0.2 = 10 個未満で在庫僅少
+  std::vector<LowStockEvent> events;
+};
+
+TEST_F(LowStockTrackerTest, ThresholdIsFractionOfMaxCapacity) {
+  EXPECT_EQ(tracker.getThreshold(), 10);
+  EXPECT_EQ(LowStockTracker(0.25).getThreshold(), 13); // 12.5 を切り上げ
+  EXPECT_THROW(LowStockTracker(1.5), std::invalid_argument);
+  EXPECT_THROW(LowStockTracker(-0.1), std::invalid_argument);
+}
+
+TEST_F(LowStockTrackerTest, EmitsEventsOnlyWhenCrossingThreshold) {
+  tracker.update(SlotId(1), Quantity(11));
+  tracker.update(SlotId(1), Quantity(10));
+  tracker.update(SlotId(1), Quantity(9)); // 下回る
+  tracker.update(SlotId(1), Quantity(8));
+  tracker.update(SlotId(1), Quantity(20)); // 回復
+
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, LowStockEventType::BELOW_THRESHOLD);
+  EXPECT_EQ(events[0].slot_id, SlotId(1));
+  EXPECT_EQ(events[0].stock, Quantity(9));
+  EXPECT_EQ(events[1].type, LowStockEventType::RECOVERED);
+  EXPECT_EQ(events[1].stock, Quantity(20));
+}
+
+TEST_F(LowStockTrackerTest, NewSlotBelowThresholdIsReported) {
+  tracker.update(SlotId(3), Quantity(2));
+
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].type, LowStockEventType::BELOW_THRESHOLD);
+  EXPECT_TRUE(tracker.isLow(SlotId(3)));
+  EXPECT_FALSE(tracker.isLow(SlotId(4)));
+}
+
+TEST_F(LowStockTrackerTest, ReturnsLowestSlotsInOrder) {
+  tracker.update(SlotId(1), Quantity(30));
+  tracker.update(SlotId(2), Quantity(5));
+  tracker.update(SlotId(3), Quantity(12));
+  tracker.update(SlotId(4), Quantity(5));
+  tracker.update(SlotId(3), Quantity(1));
+
+  auto lowest = tracker.lowest(3);
+
+  ASSERT_EQ(lowest.size(), 3u);
+  EXPECT_EQ(lowest[0].slot_id, SlotId(3));
+  EXPECT_EQ(lowest[1].slot_id, SlotId(2)); // 同数はスロットID順
+  EXPECT_EQ(lowest[2].slot_id, SlotId(4));
+  EXPECT_EQ(tracker.lowest(10).size(), 4u);
+
+  auto low = tracker.getLowStockSlots();
+  ASSERT_EQ(low.size(), 3u);
+  EXPECT_EQ(low[0].stock, Quantity(1));
+}
+
+TEST_F(LowStockTrackerTest, FollowsInventoryAsObserver) {
+  Inventory inventory;
+  inventory.addObserver(tracker);
+  inventory.addSlot(ProductSlot(
+      SlotId(1), ProductInfo(ProductName("Cola"), Price(100)), Quantity(10)));
+
+  inventory.dispense(SlotId(1));
+  EXPECT_TRUE(tracker.isLow(SlotId(1)));
+
+  inventory.refill(SlotId(1), Quantity(5));
+  EXPECT_FALSE(tracker.isLow(SlotId(1)));
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[1].type, LowStockEventType::RECOVERED);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
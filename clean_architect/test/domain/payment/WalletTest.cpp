@@ -260,6 +260,20 @@ TEST_F(WalletTest, CanWithdrawAfterEMoneyAuthorization) {
   EXPECT_EQ(180, wallet.getBalance().getRawValue());
 }
 
+/**
+ * @test 残高不足の出金は ErrorCode を返し、残高は変わらない
+ */
+TEST_F(WalletTest, TryWithdrawReturnsInsufficientBalance) {
+  Wallet wallet;
+  wallet.depositCash(Money(100));
+
+  EXPECT_EQ(ErrorCode::INSUFFICIENT_BALANCE, wallet.tryWithdraw(Money(150)));
+  EXPECT_EQ(100, wallet.getBalance().getRawValue());
+
+  EXPECT_EQ(ErrorCode::OK, wallet.tryWithdraw(Money(100)));
+  EXPECT_EQ(0, wallet.getBalance().getRawValue());
+}
+
 } // namespace test
 } // namespace domain
 } // namespace vending_machine
@@ -0,0 +1,74 @@
+/**
+ * @file HyperLogLogTest.cpp
+ * @brief HyperLogLog のユニットテスト
+ *
+ * テスト方針:
+ * - 重複した値は異なり数に影響しない
+ * - 推定値は標準誤差の数倍以内に収まる
+ * - 合算は1つのスケッチに流した場合と一致する
+ */
+
+#include "domain/sales/HyperLogLog.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+TEST(HyperLogLogTest, RejectsOutOfRangePrecision) {
+  EXPECT_THROW(HyperLogLog(3), std::invalid_argument);
+  EXPECT_THROW(HyperLogLog(17), std::invalid_argument);
+}
+
+TEST(HyperLogLogTest, EmptySketchEstimatesZero) {
+  HyperLogLog sketch;
+  EXPECT_EQ(sketch.count(), 0u);
+}
+
+TEST(HyperLogLogTest, SmallCardinalityIsNearlyExact) {
+  HyperLogLog sketch(12);
+  for (int repeat = 0; repeat < 10; ++repeat) {
+    for (std::uint64_t id = 1; id <= 100; ++id) {
+      sketch.add(id);
+    }
+  }
+
+  // 線形計数の標準誤差は約 1%
+  EXPECT_NEAR(static_cast<double>(sketch.count()), 100.0, 5.0);
+}
+
+TEST(HyperLogLogTest, LargeCardinalityWithinErrorBound) {
+  HyperLogLog sketch(12);
+  const double actual = 200000.0;
+  for (std::uint64_t id = 0; id < 200000; ++id) {
+    sketch.add(id);
+  }
+
+  double error = std::abs(sketch.estimate() - actual) / actual;
+  EXPECT_LT(error, 4 * sketch.getStandardError());
+}
+
+TEST(HyperLogLogTest, MergeMatchesSingleSketch) {
+  HyperLogLog a(10);
+  HyperLogLog b(10);
+  HyperLogLog all(10);
+  for (std::uint64_t id = 0; id < 5000; ++id) {
+    (id % 2 == 0 ? a : b).add(id);
+    all.add(id);
+  }
+  // 重複する範囲
+  for (std::uint64_t id = 0; id < 1000; ++id) {
+    b.add(id);
+  }
+
+  a.merge(b);
+
+  EXPECT_DOUBLE_EQ(a.estimate(), all.estimate());
+  EXPECT_THROW(a.merge(HyperLogLog(12)), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
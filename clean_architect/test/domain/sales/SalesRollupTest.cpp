@@ -0,0 +1,149 @@
+/**
+ * @file SalesRollupTest.cpp
+ * @brief SalesRollup のユニットテスト
+ *
+ * テスト方針:
+ * - 取引は時間単位・日単位の両方のバケットへ加算される
+ * - 期間指定は [from, to) を含むバケットで区切られる
+ * - バケット数は取引件数ではなく（時間帯, スロット, 決済方法）の数になる
+ * - 保持期間より古いバケットは破棄され、その期間より古い取引は加算しない
+ */
+
+#include "domain/sales/SalesRollup.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+using std::chrono::hours;
+using std::chrono::minutes;
+using TimePoint = std::chrono::system_clock::time_point;
+
+class SalesRollupTest : public ::testing::Test {
+protected:
+  // 2日目の 0:00（UTC）
+  const TimePoint day2 = TimePoint(hours(24));
+
+  void record(int slot_id, int price, PaymentMethodType method,
+              TimePoint timestamp) {
+    rollup.record(TransactionRecord(SalesId(++sales_id), SlotId(slot_id),
+                                    Price(price), method, timestamp));
+  }
+
+  SalesRollup rollup;
+  int sales_id = 0;
+};
+
+TEST_F(SalesRollupTest, AggregatesIntoHourlyBuckets) {
+  record(1, 120, PaymentMethodType::CASH, day2 + minutes(5));
+  record(1, 120, PaymentMethodType::CASH, day2 + minutes(55));
+  record(1, 120, PaymentMethodType::CASH, day2 + hours(1));
+
+  auto buckets =
+      rollup.query(RollupGranularity::HOURLY, day2, day2 + hours(24));
+
+  ASSERT_EQ(buckets.size(), 2u);
+  EXPECT_EQ(buckets[0].start, day2);
+  EXPECT_EQ(buckets[0].transaction_count, 2);
+  EXPECT_EQ(buckets[0].total_revenue.getRawValue(), 240);
+  EXPECT_EQ(buckets[1].start, day2 + hours(1));
+  EXPECT_EQ(buckets[1].transaction_count, 1);
+}
+
+TEST_F(SalesRollupTest, AggregatesIntoDailyBuckets) {
+  record(1, 120, PaymentMethodType::CASH, day2 + hours(1));
+  record(1, 150, PaymentMethodType::CASH, day2 + hours(23));
+  record(1, 120, PaymentMethodType::CASH, day2 + hours(24));
+
+  auto buckets =
+      rollup.query(RollupGranularity::DAILY, day2, day2 + hours(48));
+
+  ASSERT_EQ(buckets.size(), 2u);
+  EXPECT_EQ(buckets[0].start, day2);
+  EXPECT_EQ(buckets[0].transaction_count, 2);
+  EXPECT_EQ(buckets[0].total_revenue.getRawValue(), 270);
+  EXPECT_EQ(buckets[1].start, day2 + hours(24));
+}
+
+TEST_F(SalesRollupTest, SeparatesSlotsAndPaymentMethods) {
+  record(2, 150, PaymentMethodType::EMONEY, day2);
+  record(1, 120, PaymentMethodType::EMONEY, day2);
+  record(1, 120, PaymentMethodType::CASH, day2);
+
+  auto buckets = rollup.query(RollupGranularity::HOURLY, day2, day2 + hours(1));
+
+  ASSERT_EQ(buckets.size(), 3u);
+  EXPECT_EQ(buckets[0].slot_id, SlotId(1));
+  EXPECT_EQ(buckets[0].payment_method, PaymentMethodType::CASH);
+  EXPECT_EQ(buckets[1].slot_id, SlotId(1));
+  EXPECT_EQ(buckets[1].payment_method, PaymentMethodType::EMONEY);
+  EXPECT_EQ(buckets[2].slot_id, SlotId(2));
+
+  auto slot2 = rollup.queryBySlot(RollupGranularity::HOURLY, SlotId(2), day2,
+                                  day2 + hours(1));
+  ASSERT_EQ(slot2.size(), 1u);
+  EXPECT_EQ(slot2[0].total_revenue.getRawValue(), 150);
+}
+
+TEST_F(SalesRollupTest, RangeExcludesBucketContainingEnd) {
+  record(1, 120, PaymentMethodType::CASH, day2 - minutes(1));
+  record(1, 120, PaymentMethodType::CASH, day2 + minutes(30));
+  record(1, 120, PaymentMethodType::CASH, day2 + hours(2));
+
+  // from を含むバケットから、to を含むバケットの手前まで
+  auto buckets = rollup.query(RollupGranularity::HOURLY, day2 + minutes(10),
+                              day2 + hours(2) + minutes(10));
+
+  ASSERT_EQ(buckets.size(), 1u);
+  EXPECT_EQ(buckets[0].start, day2);
+}
+
+TEST_F(SalesRollupTest, BucketCountDependsOnTimeRangeNotRecords) {
+  for (int i = 0; i < 1000; ++i) {
+    record(1, 120, PaymentMethodType::CASH, day2 + minutes(i % 120));
+  }
+
+  EXPECT_EQ(rollup.getBucketCount(RollupGranularity::HOURLY), 2u);
+  EXPECT_EQ(rollup.getBucketCount(RollupGranularity::DAILY), 1u);
+
+  rollup.clear();
+  EXPECT_EQ(rollup.getBucketCount(RollupGranularity::HOURLY), 0u);
+}
+
+TEST_F(SalesRollupTest, OldBucketsAreDiscarded) {
+  SalesRollup bounded(3, 2);
+  for (int hour = 0; hour < 48; ++hour) {
+    bounded.record(TransactionRecord(SalesId(1), SlotId(1), Price(120),
+                                     PaymentMethodType::CASH,
+                                     day2 + hours(hour)));
+  }
+
+  // 最新の 3 時間・2 日分だけが残る
+  EXPECT_EQ(bounded.getBucketCount(RollupGranularity::HOURLY), 3u);
+  EXPECT_EQ(bounded.getBucketCount(RollupGranularity::DAILY), 2u);
+  auto recent =
+      bounded.query(RollupGranularity::HOURLY, day2, day2 + hours(48));
+  ASSERT_EQ(recent.size(), 3u);
+  EXPECT_EQ(recent.front().start, day2 + hours(45));
+
+  // 保持期間より古い取引は時間単位には加算せず、日単位には加算する
+  bounded.record(TransactionRecord(SalesId(1), SlotId(2), Price(150),
+                                   PaymentMethodType::CASH,
+                                   day2 + hours(30)));
+  EXPECT_EQ(bounded.getBucketCount(RollupGranularity::HOURLY), 3u);
+  auto days = bounded.query(RollupGranularity::DAILY, day2, day2 + hours(48));
+  ASSERT_EQ(days.size(), 3u);
+  EXPECT_EQ(days[2].slot_id, SlotId(2));
+
+  EXPECT_THROW(SalesRollup(0, 1), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
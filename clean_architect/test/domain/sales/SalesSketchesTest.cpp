@@ -0,0 +1,100 @@
+/**
+ * @file SalesSketchesTest.cpp
+ * @brief SalesSketches のユニットテスト
+ *
+ * テスト方針:
+ * - 異なり数は販売ID（装置ごとに一定）ではなく取引セッションで数える
+ */
+
+#include "domain/sales/SalesSketches.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/SessionId.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+using std::chrono::hours;
+using TimePoint = std::chrono::system_clock::time_point;
+
+namespace {
+
+// 1台目の装置（販売ID 1）で、指定したセッションが購入した取引
+TransactionRecord makeRecord(int session_id, int slot_id, TimePoint timestamp,
+                             int sales_id = 1) {
+  return TransactionRecord(SalesId(sales_id), SlotId(slot_id), Price(120),
+                           PaymentMethodType::CASH, timestamp)
+      .withSessionId(SessionId(session_id));
+}
+
+} // namespace
+
+TEST(SalesSketchesTest, TracksTopSlotsAndDistinctSalesPerDay) {
+  SalesSketches sketches;
+  TimePoint day1(hours(24));
+  TimePoint day2(hours(48));
+  int session_id = 0;
+  for (int i = 0; i < 30; ++i) {
+    sketches.onTransactionSaved(makeRecord(++session_id, 3, day1));
+  }
+  for (int i = 0; i < 10; ++i) {
+    sketches.onTransactionSaved(makeRecord(++session_id, 1, day2 + hours(5)));
+  }
+
+  auto top = sketches.getTopSlots(1);
+  ASSERT_EQ(top.size(), 1u);
+  EXPECT_EQ(top[0].key, 3);
+  EXPECT_EQ(top[0].count, 30u);
+
+  // 異なり数は近似値（この規模では誤差は数件以内）
+  EXPECT_NEAR(sketches.estimateDistinctSales(), 40, 2);
+  EXPECT_NEAR(sketches.estimateDistinctSalesOn(day1 + hours(12)), 30, 2);
+  EXPECT_NEAR(sketches.estimateDistinctSalesOn(day2), 10, 2);
+  EXPECT_EQ(sketches.estimateDistinctSalesOn(day2 + hours(24)), 0u);
+}
+
+TEST(SalesSketchesTest, KeepsOnlyRecentDays) {
+  SalesSketches sketches(8, 10, 2);
+  for (int day = 1; day <= 3; ++day) {
+    sketches.onTransactionSaved(makeRecord(day, 1, TimePoint(hours(24 * day))));
+  }
+
+  EXPECT_EQ(sketches.estimateDistinctSalesOn(TimePoint(hours(24))), 0u);
+  EXPECT_EQ(sketches.estimateDistinctSalesOn(TimePoint(hours(72))), 1u);
+}
+
+TEST(SalesSketchesTest, RecordsWithoutSessionAreNotCounted) {
+  SalesSketches sketches;
+  TimePoint day(hours(24));
+  sketches.onTransactionSaved(TransactionRecord(
+      SalesId(1), SlotId(2), Price(120), PaymentMethodType::CASH, day));
+
+  EXPECT_EQ(sketches.getTopSlots(1)[0].count, 1u);
+  EXPECT_EQ(sketches.estimateDistinctSales(), 0u);
+}
+
+TEST(SalesSketchesTest, MergeCombinesMachines) {
+  SalesSketches machine_a;
+  SalesSketches machine_b;
+  TimePoint day(hours(24));
+  // 装置ごとにセッションIDは重なるが、販売IDと組にするため区別できる
+  for (int i = 1; i <= 20; ++i) {
+    machine_a.onTransactionSaved(makeRecord(i, 2, day, 1));
+    machine_b.onTransactionSaved(makeRecord(i, 2, day, 2));
+  }
+
+  machine_a.merge(machine_b);
+
+  EXPECT_EQ(machine_a.getTopSlots(1)[0].count, 40u);
+  EXPECT_NEAR(machine_a.estimateDistinctSales(), 40, 2);
+  EXPECT_NEAR(machine_a.estimateDistinctSalesOn(day), 40, 2);
+  EXPECT_THROW(machine_a.merge(SalesSketches(64, 10)), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
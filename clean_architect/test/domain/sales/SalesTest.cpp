@@ -121,3 +121,32 @@ TEST_F(SalesTest, CanStartMaintenanceAfterSessionCompletes) {
   EXPECT_NO_THROW(sales.startMaintenance());
   EXPECT_EQ(Mode::MAINTENANCE, sales.getMode());
 }
+
+TEST_F(SalesTest, TryOperationsReturnErrorCodesWithoutThrowing) {
+  Sales sales(SalesId(1));
+
+  EXPECT_EQ(ErrorCode::NO_ACTIVE_SESSION, sales.trySelectProduct(SlotId(5)));
+  EXPECT_EQ(ErrorCode::OK, sales.tryStartSession(SessionId(100)));
+  EXPECT_EQ(ErrorCode::SESSION_ALREADY_EXISTS,
+            sales.tryStartSession(SessionId(101)));
+  EXPECT_EQ(ErrorCode::INVALID_STATE_TRANSITION, sales.tryMarkDispensing());
+  EXPECT_EQ(ErrorCode::NO_PRODUCT_SELECTED, sales.tryMarkPaymentPending());
+
+  EXPECT_EQ(ErrorCode::OK, sales.trySelectProduct(SlotId(5)));
+  EXPECT_EQ(ErrorCode::PRODUCT_ALREADY_SELECTED,
+            sales.trySelectProduct(SlotId(6)));
+  EXPECT_EQ(ErrorCode::OK, sales.tryMarkPaymentPending());
+  EXPECT_EQ(ErrorCode::INVALID_STATE_TRANSITION,
+            sales.tryCompleteTransaction());
+  EXPECT_EQ(ErrorCode::OK, sales.tryMarkDispensing());
+  EXPECT_EQ(ErrorCode::OK, sales.tryCompleteTransaction());
+  EXPECT_EQ(nullptr, sales.getCurrentSession());
+}
+
+TEST_F(SalesTest, TryStartSessionFailsInMaintenance) {
+  Sales sales(SalesId(1));
+  sales.startMaintenance();
+
+  EXPECT_EQ(ErrorCode::MAINTENANCE_MODE, sales.tryStartSession(SessionId(1)));
+  EXPECT_EQ(nullptr, sales.getCurrentSession());
+}
@@ -0,0 +1,111 @@
+/**
+ * @file TopKSketchTest.cpp
+ * @brief TopKSketch のユニットテスト
+ *
+ * テスト方針:
+ * - 容量内のキーは正確に数えられる
+ * - 容量を超えても頻出キーは残り、推定の超過分は誤差上限以内
+ * - 合算後も頻出キーと誤差上限の性質が保たれる
+ */
+
+#include "domain/sales/TopKSketch.hpp"
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace domain {
+namespace test {
+
+namespace {
+
+// キー 1..5 を 1 巡あたり key * 10 回、それ以外を1回ずつ流す
+void feed(TopKSketch &sketch, std::map<std::int64_t, std::uint64_t> &truth,
+          std::int64_t noise_begin, int noise_count) {
+  for (int round = 0; round < 100; ++round) {
+    for (std::int64_t key = 1; key <= 5; ++key) {
+      for (std::int64_t i = 0; i < key * 10; ++i) {
+        sketch.add(key);
+        truth[key]++;
+      }
+    }
+    for (int i = 0; i < noise_count / 100; ++i) {
+      std::int64_t key = noise_begin + round * 1000 + i;
+      sketch.add(key);
+      truth[key]++;
+    }
+  }
+}
+
+void expectWithinBound(const TopKSketch &sketch,
+                       const std::map<std::int64_t, std::uint64_t> &truth) {
+  for (const auto &entry : sketch.top(sketch.getCapacity())) {
+    std::uint64_t actual = truth.at(entry.key);
+    EXPECT_GE(entry.count, actual);
+    EXPECT_LE(entry.count - entry.error, actual);
+    EXPECT_LE(entry.count - actual, sketch.getErrorBound());
+  }
+}
+
+} // namespace
+
+TEST(TopKSketchTest, RejectsZeroCapacity) {
+  EXPECT_THROW(TopKSketch(0), std::invalid_argument);
+}
+
+TEST(TopKSketchTest, CountsExactlyWithinCapacity) {
+  TopKSketch sketch(4);
+  sketch.add(3, 5);
+  sketch.add(1);
+  sketch.add(2, 5);
+
+  auto top = sketch.top(10);
+
+  ASSERT_EQ(top.size(), 3u);
+  EXPECT_EQ(top[0].key, 2); // 同数はキーの昇順
+  EXPECT_EQ(top[0].count, 5u);
+  EXPECT_EQ(top[1].key, 3);
+  EXPECT_EQ(top[2].key, 1);
+  EXPECT_EQ(top[2].error, 0u);
+  EXPECT_EQ(sketch.getTotalCount(), 11u);
+  EXPECT_EQ(sketch.getErrorBound(), 0u);
+}
+
+TEST(TopKSketchTest, KeepsHeavyHittersBeyondCapacity) {
+  TopKSketch sketch(32);
+  std::map<std::int64_t, std::uint64_t> truth;
+  feed(sketch, truth, 10000, 2000);
+
+  // 最少のキー 1 でも 1000 回 > N / k（17000 / 32）なので必ず上位に残る
+  auto top = sketch.top(5);
+
+  ASSERT_EQ(top.size(), 5u);
+  for (std::size_t i = 0; i < top.size(); ++i) {
+    EXPECT_EQ(top[i].key, static_cast<std::int64_t>(5 - i));
+  }
+  EXPECT_LE(sketch.getErrorBound(), sketch.getTotalCount() / 32);
+  expectWithinBound(sketch, truth);
+}
+
+TEST(TopKSketchTest, MergePreservesHeavyHittersAndBounds) {
+  TopKSketch a(32);
+  TopKSketch b(32);
+  std::map<std::int64_t, std::uint64_t> truth;
+  feed(a, truth, 10000, 2000);
+  feed(b, truth, 500000, 2000);
+
+  a.merge(b);
+
+  EXPECT_EQ(a.getTotalCount(), 2u * 17000);
+  auto top = a.top(5);
+  ASSERT_EQ(top.size(), 5u);
+  for (std::size_t i = 0; i < top.size(); ++i) {
+    EXPECT_EQ(top[i].key, static_cast<std::int64_t>(5 - i));
+  }
+  EXPECT_LE(a.getErrorBound(), 2 * a.getTotalCount() / 32);
+  expectWithinBound(a, truth);
+}
+
+} // namespace test
+} // namespace domain
+} // namespace vending_machine
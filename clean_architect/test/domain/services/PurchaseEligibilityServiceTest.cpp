@@ -6,6 +6,7 @@
 #include "domain/inventory/ProductInfo.hpp"
 #include "domain/inventory/ProductName.hpp"
 #include "domain/inventory/ProductSlot.hpp"
+#include "domain/inventory/SlotSnapshot.hpp"
 #include "domain/payment/Wallet.hpp"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -222,5 +223,42 @@ TEST_F(PurchaseEligibilityServiceTest, BoundaryValueTest) {
   EXPECT_EQ(SlotId(1), eligible[0].getSlotId());
 }
 
+// テスト11: ビュー版は在庫内の商品情報を参照し、在庫数も返す
+TEST_F(PurchaseEligibilityServiceTest,
+       CollectEligibleProductsReferencesInventory) {
+  Wallet wallet;
+  wallet.depositCash(Money(500));
+
+  ON_CALL(mock_coin_mech, canMakeChange).WillByDefault(::testing::Return(true));
+
+  std::vector<SlotSnapshot> eligible;
+  ASSERT_EQ(2u, PurchaseEligibilityService::collectEligibleProducts(
+                    inventory, wallet, mock_coin_mech, eligible));
+
+  EXPECT_EQ(SlotId(1), eligible[0].slot_id);
+  EXPECT_EQ(&inventory.getSlot(SlotId(1)).getProductInfo(),
+            eligible[0].product_info);
+  EXPECT_EQ(Quantity(2), eligible[0].stock);
+  EXPECT_EQ(SlotId(2), eligible[1].slot_id);
+  EXPECT_EQ(Quantity(1), eligible[1].stock);
+}
+
+// テスト12: ビュー版は出力バッファをクリアしてから書き出す
+TEST_F(PurchaseEligibilityServiceTest, CollectEligibleProductsClearsBuffer) {
+  Wallet wallet;
+  wallet.depositCash(Money(500));
+
+  ON_CALL(mock_coin_mech, canMakeChange).WillByDefault(::testing::Return(true));
+
+  std::vector<SlotSnapshot> eligible;
+  PurchaseEligibilityService::collectEligibleProducts(inventory, wallet,
+                                                      mock_coin_mech, eligible);
+
+  Wallet empty_wallet;
+  EXPECT_EQ(0u, PurchaseEligibilityService::collectEligibleProducts(
+                    inventory, empty_wallet, mock_coin_mech, eligible));
+  EXPECT_TRUE(eligible.empty());
+}
+
 } // namespace domain
 } // namespace vending_machine
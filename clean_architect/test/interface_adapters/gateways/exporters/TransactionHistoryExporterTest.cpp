@@ -0,0 +1,152 @@
+/**
+ * @file TransactionHistoryExporterTest.cpp
+ * @brief TransactionHistoryExporter のユニットテスト
+ *
+ * テスト方針:
+ * - CSV / バイナリの出力内容が仕様どおり
+ * - バッファサイズによらず出力は同じ
+ * - バイト位置・シーケンス番号からの再開で続きだけが出力される
+ *   （販売IDは機械ごとに一定のため、再開の鍵には使えない）
+ */
+
+#include "interface_adapters/gateways/exporters/TransactionHistoryExporter.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+class TransactionHistoryExporterTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    save(1, 3, 120, domain::PaymentMethodType::CASH, 1700000000000);
+    save(2, 1, 150, domain::PaymentMethodType::EMONEY, 1700000001500);
+  }
+
+  void save(int sales_id, int slot_id, int price,
+            domain::PaymentMethodType method, std::int64_t millis) {
+    repository_.save(domain::TransactionRecord(
+        domain::SalesId(sales_id), domain::SlotId(slot_id),
+        domain::Price(price), method,
+        std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(millis))));
+  }
+
+  std::string exportAll(ExportFormat format, const ExportCursor &cursor = {},
+                        std::size_t buffer_size =
+                            TransactionHistoryExporter::DEFAULT_BUFFER_SIZE) {
+    TransactionHistoryExporter exporter(repository_, buffer_size);
+    std::ostringstream out;
+    last_result_ = exporter.exportTo(out, format, cursor);
+    return out.str();
+  }
+
+  InMemoryTransactionHistoryRepository repository_;
+  ExportResult last_result_;
+};
+
+TEST_F(TransactionHistoryExporterTest, ExportsCsv) {
+  auto csv = exportAll(ExportFormat::CSV);
+
+  EXPECT_EQ(csv,
+            "sequence,sales_id,slot_id,price,payment_method,timestamp_ms\n"
+            "1,1,3,120,CASH,1700000000000\n"
+            "2,2,1,150,EMONEY,1700000001500\n");
+  EXPECT_EQ(last_result_.records_written, 2u);
+  EXPECT_EQ(last_result_.bytes_written, csv.size());
+  EXPECT_EQ(last_result_.end_offset, csv.size());
+  EXPECT_EQ(last_result_.last_sequence, 2u);
+}
+
+TEST_F(TransactionHistoryExporterTest, ExportsBinary) {
+  auto data = exportAll(ExportFormat::BINARY);
+
+  ASSERT_EQ(data.size(), 8u + 2 * 32u);
+  EXPECT_EQ(data.substr(0, 4), "VMTX");
+  EXPECT_EQ(data[4], 2); // バージョン（リトルエンディアン）
+  EXPECT_EQ(data[5], 0);
+
+  const char *second = data.data() + 8 + 32;
+  EXPECT_EQ(static_cast<unsigned char>(second[0]), 2u);   // sequence
+  EXPECT_EQ(static_cast<unsigned char>(second[8]), 2u);   // sales_id
+  EXPECT_EQ(static_cast<unsigned char>(second[12]), 1u);  // slot_id
+  EXPECT_EQ(static_cast<unsigned char>(second[16]), 150u); // price
+  EXPECT_EQ(second[20], 1);                                // EMONEY
+  std::int64_t millis = 0;
+  for (int i = 7; i >= 0; --i) {
+    millis = (millis << 8) | static_cast<unsigned char>(second[24 + i]);
+  }
+  EXPECT_EQ(millis, 1700000001500);
+}
+
+TEST_F(TransactionHistoryExporterTest, OutputIndependentOfBufferSize) {
+  for (int i = 3; i < 200; ++i) {
+    save(i, i % 10 + 1, 100 + i, domain::PaymentMethodType::CASH,
+         1700000000000 + i);
+  }
+
+  for (auto format : {ExportFormat::CSV, ExportFormat::BINARY}) {
+    auto large = exportAll(format);
+    auto small = exportAll(format, {},
+                           TransactionHistoryExporter::MAX_RECORD_SIZE);
+    EXPECT_EQ(large, small);
+  }
+}
+
+TEST_F(TransactionHistoryExporterTest, ResumesFromByteOffset) {
+  for (int i = 3; i < 50; ++i) {
+    save(i, 1, 120, domain::PaymentMethodType::CASH, 1700000000000 + i);
+  }
+  auto full = exportAll(ExportFormat::CSV);
+
+  for (std::uint64_t offset : {0u, 10u, 100u, 777u}) {
+    auto rest = exportAll(ExportFormat::CSV, {offset, std::nullopt},
+                          TransactionHistoryExporter::MAX_RECORD_SIZE);
+    EXPECT_EQ(rest, full.substr(offset));
+    EXPECT_EQ(last_result_.end_offset, full.size());
+  }
+}
+
+TEST_F(TransactionHistoryExporterTest, ResumesAfterSequence) {
+  // 実機と同じく販売IDが一定でも、続きだけを選べる
+  save(1, 2, 100, domain::PaymentMethodType::CASH, 1700000002000);
+  auto csv = exportAll(ExportFormat::CSV, {0, 1});
+
+  EXPECT_EQ(csv,
+            "sequence,sales_id,slot_id,price,payment_method,timestamp_ms\n"
+            "2,2,1,150,EMONEY,1700000001500\n"
+            "3,1,2,100,CASH,1700000002000\n");
+  EXPECT_EQ(last_result_.records_written, 2u);
+  EXPECT_EQ(last_result_.last_sequence, 3u);
+}
+
+TEST_F(TransactionHistoryExporterTest, ResumesAfterSequenceAcrossClear) {
+  exportAll(ExportFormat::CSV);
+  auto cursor = ExportCursor{0, last_result_.last_sequence};
+
+  // 消去後も番号は戻らないため、新しいレコードだけが出力される
+  repository_.clear();
+  save(1, 4, 130, domain::PaymentMethodType::CASH, 1700000003000);
+  auto csv = exportAll(ExportFormat::CSV, cursor);
+
+  EXPECT_EQ(csv,
+            "sequence,sales_id,slot_id,price,payment_method,timestamp_ms\n"
+            "3,1,4,130,CASH,1700000003000\n");
+  EXPECT_EQ(last_result_.records_written, 1u);
+}
+
+TEST_F(TransactionHistoryExporterTest, RejectsTooSmallBuffer) {
+  EXPECT_THROW(TransactionHistoryExporter(repository_, 16),
+               std::invalid_argument);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,140 @@
+/**
+ * @file BinaryFileMachineStateRepositoryTest.cpp
+ * @brief BinaryFileMachineStateRepository のユニットテスト
+ *
+ * テスト方針:
+ * - 保存した状態（スロット・残高・モード・セッション）がそのまま読み戻せる
+ * - 保存されていない場合は std::nullopt
+ * - 壊れた内容・未知の版数は例外で検出する
+ */
+
+#include "interface_adapters/gateways/repositories/BinaryFileMachineStateRepository.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+class BinaryFileMachineStateRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "machine_state_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".ckpt";
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  static domain::MachineState makeState() {
+    domain::MachineState state{domain::SalesId(7), domain::Mode::NORMAL,
+                               domain::Money(250),
+                               {},
+                               domain::SessionState{
+                                   domain::SessionId(3),
+                                   domain::SessionStatus::PAYMENT_PENDING,
+                                   domain::SlotId(2)}};
+    state.slots.push_back(
+        {domain::SlotId(1),
+         domain::ProductInfo(domain::ProductName("コーラ"), domain::Price(120)),
+         domain::Quantity(9)});
+    state.slots.push_back(
+        {domain::SlotId(2),
+         domain::ProductInfo(domain::ProductName("水"), domain::Price(100)),
+         domain::Quantity(0)});
+    state.journal_position = 42;
+    return state;
+  }
+
+  std::string readFile() const {
+    std::ifstream in(path_, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+  }
+
+  void writeFile(const std::string &bytes) const {
+    std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+    out << bytes;
+  }
+
+  std::string path_;
+};
+
+TEST_F(BinaryFileMachineStateRepositoryTest, LoadReturnsSavedState) {
+  BinaryFileMachineStateRepository repository(path_);
+  repository.save(makeState());
+
+  auto loaded = BinaryFileMachineStateRepository(path_).load();
+
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->sales_id, domain::SalesId(7));
+  EXPECT_EQ(loaded->mode, domain::Mode::NORMAL);
+  EXPECT_EQ(loaded->balance, domain::Money(250));
+  ASSERT_EQ(loaded->slots.size(), 2u);
+  EXPECT_EQ(loaded->slots[0].slot_id, domain::SlotId(1));
+  EXPECT_EQ(loaded->slots[0].product_info.getName().getValue(), "コーラ");
+  EXPECT_EQ(loaded->slots[0].product_info.getPrice(), domain::Price(120));
+  EXPECT_EQ(loaded->slots[0].stock, domain::Quantity(9));
+  EXPECT_EQ(loaded->slots[1].stock, domain::Quantity(0));
+  ASSERT_TRUE(loaded->session.has_value());
+  EXPECT_EQ(loaded->session->session_id, domain::SessionId(3));
+  EXPECT_EQ(loaded->session->status, domain::SessionStatus::PAYMENT_PENDING);
+  EXPECT_EQ(loaded->session->selected_slot_id, domain::SlotId(2));
+  EXPECT_EQ(loaded->journal_position, 42u);
+}
+
+TEST_F(BinaryFileMachineStateRepositoryTest, SaveReplacesPreviousState) {
+  BinaryFileMachineStateRepository repository(path_);
+  repository.save(makeState());
+
+  auto state = makeState();
+  state.session.reset();
+  state.mode = domain::Mode::MAINTENANCE;
+  state.slots.pop_back();
+  repository.save(state);
+
+  auto loaded = repository.load();
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->mode, domain::Mode::MAINTENANCE);
+  EXPECT_FALSE(loaded->session.has_value());
+  EXPECT_EQ(loaded->slots.size(), 1u);
+}
+
+TEST_F(BinaryFileMachineStateRepositoryTest, MissingFileLoadsNothing) {
+  EXPECT_FALSE(BinaryFileMachineStateRepository(path_).load().has_value());
+}
+
+TEST_F(BinaryFileMachineStateRepositoryTest, CorruptedPayloadIsRejected) {
+  BinaryFileMachineStateRepository repository(path_);
+  repository.save(makeState());
+
+  std::string bytes = readFile();
+  bytes[bytes.size() - 1] ^= 0x5a;
+  writeFile(bytes);
+  EXPECT_THROW(repository.load(), std::runtime_error);
+
+  writeFile(bytes.substr(0, bytes.size() - 4));
+  EXPECT_THROW(repository.load(), std::runtime_error);
+}
+
+TEST_F(BinaryFileMachineStateRepositoryTest, UnknownVersionIsRejected) {
+  BinaryFileMachineStateRepository repository(path_);
+  repository.save(makeState());
+
+  std::string bytes = readFile();
+  bytes[4] = static_cast<char>(
+      BinaryFileMachineStateRepository::FORMAT_VERSION + 1);
+  writeFile(bytes);
+
+  EXPECT_THROW(repository.load(), std::runtime_error);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,155 @@
+/**
+ * @file FileEventStoreTest.cpp
+ * @brief FileEventStore のユニットテスト
+ *
+ * テスト方針:
+ * - 追記したイベントが開き直しても同じ内容（時刻・商品名を含む）で読み戻せる
+ * - 範囲の読み出しは位置の間隔をまたいでも指定の範囲だけを返す
+ * - 書き込み途中で壊れた末尾は開くときに切り詰められ、続きから追記できる
+ * - 通番が連続しない追記と未知の形式のファイルは例外で検出する
+ */
+
+#include "interface_adapters/gateways/repositories/FileEventStore.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+class FileEventStoreTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "event_store_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".events";
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  static domain::DomainEvent deposit(std::uint64_t sequence, int amount) {
+    auto event = domain::DomainEvent::cashDeposited(domain::Money(amount));
+    event.sequence = sequence;
+    return event;
+  }
+
+  static std::vector<domain::DomainEvent>
+  readRange(const FileEventStore &store, std::uint64_t from,
+            std::uint64_t to) {
+    std::vector<domain::DomainEvent> events;
+    store.forEach(from, to, [&events](const domain::DomainEvent &event) {
+      events.push_back(event);
+      events.back().product_name = {}; // 呼び出しの間だけ有効
+    });
+    return events;
+  }
+
+  std::string path_;
+};
+
+TEST_F(FileEventStoreTest, ReadsBackAppendedEventsAfterReopen) {
+  domain::ProductInfo info(domain::ProductName("お茶"), domain::Price(150));
+  auto configured = domain::DomainEvent::slotConfigured(
+      domain::SlotId(3), info, domain::Quantity(7));
+  configured.sequence = 1;
+  configured.timestamp = std::chrono::system_clock::now();
+  {
+    FileEventStore store(path_);
+    store.append(configured);
+    store.append(deposit(2, 500));
+  }
+
+  FileEventStore store(path_);
+  EXPECT_EQ(store.getLastSequence(), 2u);
+  std::vector<domain::DomainEvent> events;
+  std::vector<std::string> names;
+  store.forEach(1, 100, [&](const domain::DomainEvent &event) {
+    events.push_back(event);
+    names.emplace_back(event.product_name);
+  });
+
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].sequence, 1u);
+  EXPECT_EQ(events[0].type, domain::DomainEventType::SLOT_CONFIGURED);
+  EXPECT_EQ(events[0].slot_id, 3);
+  EXPECT_EQ(events[0].value, 7);
+  EXPECT_EQ(events[0].price, 150);
+  EXPECT_EQ(names[0], "お茶");
+  EXPECT_EQ(events[0].timestamp, configured.timestamp);
+  EXPECT_EQ(events[1].type, domain::DomainEventType::CASH_DEPOSITED);
+  EXPECT_EQ(events[1].value, 500);
+  EXPECT_TRUE(names[1].empty());
+}
+
+TEST_F(FileEventStoreTest, ReadsRangesAcrossIndexBoundaries) {
+  FileEventStore store(path_);
+  const std::uint64_t total = FileEventStore::INDEX_INTERVAL * 2 + 10;
+  for (std::uint64_t sequence = 1; sequence <= total; ++sequence) {
+    store.append(deposit(sequence, static_cast<int>(sequence)));
+  }
+
+  auto events = readRange(store, FileEventStore::INDEX_INTERVAL - 1,
+                          FileEventStore::INDEX_INTERVAL + 2);
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events.front().sequence, FileEventStore::INDEX_INTERVAL - 1);
+  EXPECT_EQ(events.back().value,
+            static_cast<int>(FileEventStore::INDEX_INTERVAL + 2));
+
+  // 開き直しても同じ位置から読める
+  FileEventStore reopened(path_);
+  EXPECT_EQ(readRange(reopened, total - 1, total + 5).size(), 2u);
+  EXPECT_EQ(readRange(reopened, 1, total).size(), total);
+  EXPECT_TRUE(readRange(reopened, 5, 4).empty());
+}
+
+TEST_F(FileEventStoreTest, TornTailIsTruncated) {
+  {
+    FileEventStore store(path_);
+    store.append(deposit(1, 100));
+    store.append(deposit(2, 200));
+  }
+  {
+    // 2件目の途中を壊し、3件目を書きかけの状態にする
+    std::fstream file(path_, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-3, std::ios::end);
+    file.put('\x7f');
+    file.seekp(0, std::ios::end);
+    file.write("\x20\x00part", 6);
+  }
+
+  FileEventStore store(path_);
+  EXPECT_EQ(store.getLastSequence(), 1u);
+
+  // 切り詰めた位置から追記が続けられる
+  store.append(deposit(2, 300));
+  auto events = readRange(FileEventStore(path_), 1, 2);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[1].value, 300);
+}
+
+TEST_F(FileEventStoreTest, RejectsGapsAndUnknownFormat) {
+  {
+    FileEventStore store(path_);
+    store.append(deposit(1, 100));
+    EXPECT_THROW(store.append(deposit(3, 100)), std::invalid_argument);
+    EXPECT_THROW(store.append(deposit(1, 100)), std::invalid_argument);
+    EXPECT_EQ(store.getLastSequence(), 1u);
+  }
+  {
+    std::ofstream file(path_, std::ios::binary);
+    file << "NOTANEVENTSTORE";
+  }
+  EXPECT_THROW(FileEventStore store(path_), std::runtime_error);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,133 @@
+/**
+ * @file FilePurchaseJournalTest.cpp
+ * @brief FilePurchaseJournal のユニットテスト
+ *
+ * テスト方針:
+ * - 追記したエントリが開き直しても同じ順で読み戻せる
+ * - 書き込み途中で壊れた末尾は読み飛ばされ、開くときに切り詰められる
+ * - 決着の通知でエントリ数がしきい値以上なら最後のエントリだけが残る
+ * - 未知の形式のファイルは例外で検出する
+ */
+
+#include "interface_adapters/gateways/repositories/FilePurchaseJournal.hpp"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+class FilePurchaseJournalTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "purchase_journal_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".journal";
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  static domain::PurchaseJournalEntry entry(std::uint32_t id,
+                                            domain::PurchaseStep step) {
+    return {id, step, 2, 150, 8, 500, 350, static_cast<int>(id) + 40};
+  }
+
+  std::string path_;
+};
+
+TEST_F(FilePurchaseJournalTest, ReadsBackAppendedEntriesAfterReopen) {
+  {
+    FilePurchaseJournal journal(path_);
+    journal.append(entry(1, domain::PurchaseStep::STARTED));
+    journal.append(entry(1, domain::PurchaseStep::STOCK_RESERVED));
+    journal.append(entry(2, domain::PurchaseStep::STARTED));
+  }
+
+  FilePurchaseJournal journal(path_);
+  auto entries = journal.readAll();
+
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(journal.getEntryCount(), 3u);
+  EXPECT_EQ(entries[1].purchase_id, 1u);
+  EXPECT_EQ(entries[1].step, domain::PurchaseStep::STOCK_RESERVED);
+  EXPECT_EQ(entries[2].purchase_id, 2u);
+  EXPECT_EQ(entries[2].slot_id, 2);
+  EXPECT_EQ(entries[2].price, 150);
+  EXPECT_EQ(entries[2].stock_before, 8);
+  EXPECT_EQ(entries[2].balance_before, 500);
+  EXPECT_EQ(entries[2].change, 350);
+  EXPECT_EQ(entries[2].session_id, 42);
+}
+
+TEST_F(FilePurchaseJournalTest, TornTailIsIgnoredAndTruncated) {
+  {
+    FilePurchaseJournal journal(path_);
+    journal.append(entry(1, domain::PurchaseStep::STARTED));
+    journal.append(entry(1, domain::PurchaseStep::STOCK_RESERVED));
+  }
+  {
+    // 2件目の途中を壊し、3件目を書きかけの状態にする
+    std::fstream file(path_, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(8 + FilePurchaseJournal::ENTRY_SIZE + 10);
+    file.put('\x7f');
+    file.seekp(0, std::ios::end);
+    file.write("partial", 7);
+  }
+
+  FilePurchaseJournal journal(path_);
+  ASSERT_EQ(journal.readAll().size(), 1u);
+  EXPECT_EQ(journal.getEntryCount(), 1u);
+
+  // 切り詰めた位置から追記が続けられる
+  journal.append(entry(1, domain::PurchaseStep::ABORTED));
+  auto entries = journal.readAll();
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[1].step, domain::PurchaseStep::ABORTED);
+}
+
+TEST_F(FilePurchaseJournalTest, DiscardSettledCompactsAtThreshold) {
+  FilePurchaseJournal journal(path_, JournalSync::NONE, 3);
+  journal.append(entry(1, domain::PurchaseStep::STARTED));
+  journal.append(entry(1, domain::PurchaseStep::COMMITTED));
+  journal.discardSettled();
+  EXPECT_EQ(journal.readAll().size(), 2u);
+
+  journal.append(entry(2, domain::PurchaseStep::STARTED));
+  journal.append(entry(2, domain::PurchaseStep::ABORTED));
+  journal.discardSettled();
+  // 採番の続きのため最後のエントリは残す
+  auto entries = journal.readAll();
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].purchase_id, 2u);
+  EXPECT_EQ(entries[0].step, domain::PurchaseStep::ABORTED);
+  EXPECT_EQ(journal.getEntryCount(), 1u);
+
+  journal.append(entry(3, domain::PurchaseStep::STARTED));
+  EXPECT_EQ(FilePurchaseJournal(path_).readAll().size(), 2u);
+}
+
+TEST_F(FilePurchaseJournalTest, EachEntrySyncWritesTheSameFormat) {
+  {
+    FilePurchaseJournal journal(path_, JournalSync::EACH_ENTRY);
+    journal.append(entry(1, domain::PurchaseStep::CHANGE_RETURNED));
+  }
+  FilePurchaseJournal journal(path_);
+  ASSERT_EQ(journal.readAll().size(), 1u);
+  EXPECT_EQ(journal.readAll()[0].step, domain::PurchaseStep::CHANGE_RETURNED);
+}
+
+TEST_F(FilePurchaseJournalTest, RejectsUnknownFormat) {
+  {
+    std::ofstream file(path_, std::ios::binary);
+    file << "NOTAJOURNAL";
+  }
+  EXPECT_THROW(FilePurchaseJournal journal(path_), std::runtime_error);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
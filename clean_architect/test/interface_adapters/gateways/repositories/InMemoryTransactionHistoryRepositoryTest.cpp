@@ -5,8 +5,10 @@
 #include "domain/sales/SalesId.hpp"
 #include "domain/sales/TransactionRecord.hpp"
 #include <chrono>
+#include <cstdint>
 #include <gtest/gtest.h>
 #include <thread>
+#include <vector>
 
 namespace vending_machine {
 namespace interface_adapters {
@@ -78,7 +80,7 @@ TEST_F(InMemoryTransactionHistoryRepositoryTest, GetTotalRevenue) {
   repository_.save(record1);
   repository_.save(record2);
 
-  domain::Money total_revenue = repository_.getTotalRevenue();
+  domain::Revenue total_revenue = repository_.getTotalRevenue();
   EXPECT_EQ(250, total_revenue.getRawValue()); // 150 + 100
 }
 
@@ -113,6 +115,45 @@ TEST_F(InMemoryTransactionHistoryRepositoryTest, Clear) {
   EXPECT_EQ(0, repository_.getTotalRevenue().getRawValue());
 }
 
+TEST_F(InMemoryTransactionHistoryRepositoryTest,
+       GenerationAdvancesOnSaveAndClear) {
+  auto initial = repository_.getGeneration();
+
+  repository_.save(domain::TransactionRecord(
+      sales1_, slot1_, domain::Price(100), domain::PaymentMethodType::CASH));
+  auto after_save = repository_.getGeneration();
+  repository_.getAll();
+  repository_.getTotalRevenue();
+  EXPECT_EQ(after_save, repository_.getGeneration());
+
+  repository_.clear();
+
+  EXPECT_LT(initial, after_save);
+  EXPECT_LT(after_save, repository_.getGeneration());
+}
+
+TEST_F(InMemoryTransactionHistoryRepositoryTest,
+       PartitionsVisitEachRecordExactlyOnce) {
+  for (int i = 0; i < 10; ++i) {
+    repository_.save(domain::TransactionRecord(
+        domain::SalesId(200 + i), slot1_, domain::Price(100 + i),
+        domain::PaymentMethodType::CASH));
+  }
+
+  std::vector<int> visited;
+  for (std::size_t partition = 0; partition < 3; ++partition) {
+    repository_.forEachInPartition(
+        partition, 3, [&visited](const domain::TransactionRecord &record) {
+          visited.push_back(record.getSalesId().getValue());
+        });
+  }
+
+  ASSERT_EQ(10, visited.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(200 + i, visited[i]);
+  }
+}
+
 TEST_F(InMemoryTransactionHistoryRepositoryTest, ClearAndReuse) {
   auto record1 = domain::TransactionRecord(sales1_, slot1_, price1_,
                                            domain::PaymentMethodType::CASH);
@@ -128,6 +169,27 @@ TEST_F(InMemoryTransactionHistoryRepositoryTest, ClearAndReuse) {
   EXPECT_EQ(sales2_, all_records[0].getSalesId());
 }
 
+TEST_F(InMemoryTransactionHistoryRepositoryTest,
+       SequenceFollowsSaveOrderAcrossClear) {
+  auto record = domain::TransactionRecord(sales1_, slot1_, price1_,
+                                          domain::PaymentMethodType::CASH);
+  EXPECT_EQ(0u, record.getSequence());
+  for (int i = 0; i < 300; ++i) {
+    repository_.save(record);
+  }
+  std::uint64_t expected = 1;
+  repository_.forEach([&expected](const domain::TransactionRecord &saved) {
+    EXPECT_EQ(expected, saved.getSequence());
+    ++expected;
+  });
+  EXPECT_EQ(301u, expected);
+
+  // クリアしても番号は戻らない
+  repository_.clear();
+  repository_.save(record);
+  EXPECT_EQ(301u, repository_.getAll()[0].getSequence());
+}
+
 TEST_F(InMemoryTransactionHistoryRepositoryTest,
        GetBySlotIdReturnsSortedByTimestamp) {
   auto record1 = domain::TransactionRecord(sales1_, slot1_, price1_,
@@ -162,10 +224,94 @@ TEST_F(InMemoryTransactionHistoryRepositoryTest,
   repository_.save(record2);
   repository_.save(record3);
 
-  domain::Money total_revenue = repository_.getTotalRevenue();
+  domain::Revenue total_revenue = repository_.getTotalRevenue();
   EXPECT_EQ(550, total_revenue.getRawValue()); // 200 + 50 + 300
 }
 
+TEST_F(InMemoryTransactionHistoryRepositoryTest,
+       RecordsKeepAddressesAcrossBlocks) {
+  const std::size_t count =
+      InMemoryTransactionHistoryRepository::RECORDS_PER_BLOCK * 3 + 5;
+  for (std::size_t i = 0; i < count; ++i) {
+    repository_.save(domain::TransactionRecord(
+        domain::SalesId(static_cast<int>(i + 1)), slot1_, price1_,
+        domain::PaymentMethodType::CASH));
+  }
+  std::vector<const domain::TransactionRecord *> addresses;
+  repository_.forEach([&addresses](const domain::TransactionRecord &record) {
+    addresses.push_back(&record);
+  });
+  ASSERT_EQ(count, addresses.size());
+
+  // 追加で保存しても既存のレコードは移動しない
+  for (std::size_t i = 0; i < count; ++i) {
+    repository_.save(domain::TransactionRecord(
+        sales2_, slot2_, price2_, domain::PaymentMethodType::EMONEY));
+  }
+  std::size_t index = 0;
+  repository_.forEach([&](const domain::TransactionRecord &record) {
+    if (index < count) {
+      EXPECT_EQ(addresses[index], &record);
+      EXPECT_EQ(static_cast<int>(index + 1), record.getSalesId().getValue());
+    }
+    ++index;
+  });
+  EXPECT_EQ(count * 2, index);
+  EXPECT_EQ(static_cast<std::int64_t>(count) * (150 + 100),
+            repository_.getTotalRevenue().getRawValue());
+}
+
+TEST_F(InMemoryTransactionHistoryRepositoryTest,
+       PartitionsSpanBlockBoundariesInOrder) {
+  constexpr auto BLOCK =
+      InMemoryTransactionHistoryRepository::RECORDS_PER_BLOCK;
+  const int count = static_cast<int>(BLOCK) * 2 + 7;
+  for (int i = 1; i <= count; ++i) {
+    repository_.save(domain::TransactionRecord(
+        domain::SalesId(i), slot1_, price1_, domain::PaymentMethodType::CASH));
+  }
+
+  for (std::size_t partitions : {1u, 3u, 7u, 1000u}) {
+    int expected = 1;
+    for (std::size_t partition = 0; partition < partitions; ++partition) {
+      repository_.forEachInPartition(
+          partition, partitions,
+          [&expected](const domain::TransactionRecord &record) {
+            EXPECT_EQ(expected, record.getSalesId().getValue());
+            ++expected;
+          });
+    }
+    EXPECT_EQ(count + 1, expected) << partitions;
+  }
+}
+
+TEST_F(InMemoryTransactionHistoryRepositoryTest, ClearReusesBlocks) {
+  const std::size_t count =
+      InMemoryTransactionHistoryRepository::RECORDS_PER_BLOCK + 1;
+  for (std::size_t i = 0; i < count; ++i) {
+    repository_.save(domain::TransactionRecord(
+        sales1_, slot1_, price1_, domain::PaymentMethodType::CASH));
+  }
+  const domain::TransactionRecord *first = nullptr;
+  repository_.forEachInPartition(
+      0, count, [&first](const domain::TransactionRecord &record) {
+        first = &record;
+      });
+  repository_.clear();
+  EXPECT_TRUE(repository_.getAll().empty());
+
+  // clear 後の保存は先頭のブロックを再利用する
+  repository_.save(domain::TransactionRecord(
+      sales2_, slot2_, price2_, domain::PaymentMethodType::EMONEY));
+  const domain::TransactionRecord *reused = nullptr;
+  repository_.forEach([&reused](const domain::TransactionRecord &record) {
+    reused = &record;
+  });
+  EXPECT_EQ(first, reused);
+  ASSERT_EQ(1, repository_.getAll().size());
+  EXPECT_EQ(sales2_, repository_.getAll()[0].getSalesId());
+}
+
 TEST_F(InMemoryTransactionHistoryRepositoryTest, EmptyRepository) {
   auto all_records = repository_.getAll();
   EXPECT_EQ(0, all_records.size());
@@ -0,0 +1,68 @@
+/**
+ * @file NotifyingTransactionHistoryRepositoryTest.cpp
+ * @brief NotifyingTransactionHistoryRepository のユニットテスト
+ */
+
+#include "interface_adapters/gateways/repositories/NotifyingTransactionHistoryRepository.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/SalesRollup.hpp"
+#include "domain/sales/SalesSketches.hpp"
+#include "domain/sales/SessionId.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+class NotifyingTransactionHistoryRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    repository_.addListener(rollup_);
+    repository_.addListener(sketches_);
+  }
+
+  InMemoryTransactionHistoryRepository inner_;
+  domain::SalesRollup rollup_;
+  domain::SalesSketches sketches_;
+  NotifyingTransactionHistoryRepository repository_{inner_};
+};
+
+TEST_F(NotifyingTransactionHistoryRepositoryTest,
+       SaveUpdatesHistoryAndListeners) {
+  auto now = std::chrono::system_clock::now();
+  repository_.save(domain::TransactionRecord(domain::SalesId(1),
+                                             domain::SlotId(1),
+                                             domain::Price(120),
+                                             domain::PaymentMethodType::CASH,
+                                             now)
+                       .withSessionId(domain::SessionId(1)));
+
+  EXPECT_EQ(inner_.getAll().size(), 1u);
+  EXPECT_EQ(repository_.getTotalRevenue().getRawValue(), 120);
+
+  auto buckets = rollup_.query(domain::RollupGranularity::HOURLY, now,
+                               now + std::chrono::hours(1));
+  ASSERT_EQ(buckets.size(), 1u);
+  EXPECT_EQ(buckets[0].total_revenue.getRawValue(), 120);
+  EXPECT_EQ(sketches_.estimateDistinctSales(), 1u);
+}
+
+TEST_F(NotifyingTransactionHistoryRepositoryTest, ClearKeepsListenerState) {
+  repository_.save(domain::TransactionRecord(
+      domain::SalesId(1), domain::SlotId(1), domain::Price(120),
+      domain::PaymentMethodType::CASH));
+
+  repository_.clear();
+
+  EXPECT_TRUE(repository_.getAll().empty());
+  EXPECT_EQ(rollup_.getBucketCount(domain::RollupGranularity::DAILY), 1u);
+  EXPECT_EQ(sketches_.getTopSlots(1).size(), 1u);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
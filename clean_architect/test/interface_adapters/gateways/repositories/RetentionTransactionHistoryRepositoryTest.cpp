@@ -0,0 +1,190 @@
+/**
+ * @file RetentionTransactionHistoryRepositoryTest.cpp
+ * @brief RetentionTransactionHistoryRepository のユニットテスト
+ *
+ * テスト方針:
+ * - 上限件数を超えると古いレコードから集計値に畳み込まれる
+ * - 保持期間を過ぎたレコードは保存時と enforce で畳み込まれる
+ * - 売上合計とレポートは、すべて保持する実装と同じ結果になる
+ * - 一部のレコードを畳み込んだ後も、パーティション単位の走査で
+ *   保持しているレコードをちょうど1回ずつ訪れる
+ */
+
+#include "interface_adapters/gateways/repositories/RetentionTransactionHistoryRepository.hpp"
+#include "domain/common/Price.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "usecases/SalesReportingUseCase.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+using Clock = std::chrono::system_clock;
+
+class RetentionTransactionHistoryRepositoryTest : public ::testing::Test {
+protected:
+  // 1分間隔のレコード
+  static domain::TransactionRecord record(int i) {
+    return domain::TransactionRecord(
+        domain::SalesId(1), domain::SlotId(i % 3 + 1),
+        domain::Price(i % 2 == 0 ? 120 : 150),
+        i % 5 == 0 ? domain::PaymentMethodType::EMONEY
+                   : domain::PaymentMethodType::CASH,
+        base_ + std::chrono::minutes(i));
+  }
+
+  static void expectSameSummary(const usecases::SalesSummary &actual,
+                                const usecases::SalesSummary &expected) {
+    EXPECT_EQ(actual.transaction_count, expected.transaction_count);
+    EXPECT_EQ(actual.total_revenue, expected.total_revenue);
+    ASSERT_EQ(actual.slot_reports.size(), expected.slot_reports.size());
+    for (std::size_t i = 0; i < expected.slot_reports.size(); ++i) {
+      EXPECT_EQ(actual.slot_reports[i].slot_id,
+                expected.slot_reports[i].slot_id);
+      EXPECT_EQ(actual.slot_reports[i].transaction_count,
+                expected.slot_reports[i].transaction_count);
+      EXPECT_EQ(actual.slot_reports[i].total_revenue,
+                expected.slot_reports[i].total_revenue);
+    }
+    ASSERT_EQ(actual.payment_reports.size(), expected.payment_reports.size());
+    for (std::size_t i = 0; i < expected.payment_reports.size(); ++i) {
+      EXPECT_EQ(actual.payment_reports[i].payment_method,
+                expected.payment_reports[i].payment_method);
+      EXPECT_EQ(actual.payment_reports[i].transaction_count,
+                expected.payment_reports[i].transaction_count);
+      EXPECT_EQ(actual.payment_reports[i].total_revenue,
+                expected.payment_reports[i].total_revenue);
+    }
+  }
+
+  static inline const Clock::time_point base_ =
+      Clock::time_point(std::chrono::hours(24 * 365 * 50));
+};
+
+TEST_F(RetentionTransactionHistoryRepositoryTest, FoldsOldestBeyondMaxRecords) {
+  RetentionTransactionHistoryRepository repository({4});
+  for (int i = 0; i < 10; ++i) {
+    repository.save(record(i));
+  }
+
+  EXPECT_EQ(repository.getRetainedCount(), 4u);
+  EXPECT_EQ(repository.getFoldedCount(), 6u);
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(5 * 120 + 5 * 150));
+
+  auto all = repository.getAll();
+  ASSERT_EQ(all.size(), 4u);
+  EXPECT_EQ(all.front().getTimestamp(), record(9).getTimestamp());
+  EXPECT_EQ(all.back().getTimestamp(), record(6).getTimestamp());
+  EXPECT_EQ(repository.getBySlotId(domain::SlotId(1)).size(), 2u); // 6, 9
+
+  // 畳み込んだ i = 0..5 の（スロット, 決済方法）ごとの集計値
+  int count = 0;
+  domain::RevenueAccumulator revenue;
+  repository.forEachRollup([&](const domain::TransactionRollup &rollup) {
+    count += rollup.transaction_count;
+    revenue.add(rollup.total_revenue);
+  });
+  EXPECT_EQ(count, 6);
+  EXPECT_EQ(revenue.getTotal(), domain::Revenue(3 * 120 + 3 * 150));
+}
+
+TEST_F(RetentionTransactionHistoryRepositoryTest, FoldsRecordsOlderThanMaxAge) {
+  RetentionTransactionHistoryRepository repository(
+      {100, std::chrono::minutes(3)});
+  for (int i = 0; i < 6; ++i) {
+    repository.save(record(i));
+  }
+  // 最新（i = 5）から3分より前の i = 0, 1 を畳み込む
+  EXPECT_EQ(repository.getRetainedCount(), 4u);
+
+  EXPECT_EQ(repository.enforce(base_ + std::chrono::minutes(7)), 2u);
+  EXPECT_EQ(repository.getRetainedCount(), 2u);
+  EXPECT_EQ(repository.getFoldedCount(), 4u);
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(3 * 120 + 3 * 150));
+}
+
+TEST_F(RetentionTransactionHistoryRepositoryTest, ReportsMatchFullHistory) {
+  RetentionTransactionHistoryRepository retention({7});
+  InMemoryTransactionHistoryRepository full;
+  for (int i = 0; i < 40; ++i) {
+    retention.save(record(i));
+    full.save(record(i));
+  }
+  usecases::SalesReportingUseCase retention_reports(retention);
+  usecases::SalesReportingUseCase full_reports(full);
+
+  auto expected = full_reports.generateSalesSummary();
+  expectSameSummary(retention_reports.generateSalesSummary(), expected);
+  retention.save(record(40));
+  full.save(record(40));
+  expected = full_reports.generateSalesSummary();
+  expectSameSummary(retention_reports.generateSalesSummary(4), expected);
+  EXPECT_EQ(retention.getTotalRevenue(), full.getTotalRevenue());
+}
+
+TEST_F(RetentionTransactionHistoryRepositoryTest,
+       PartitionsVisitRetainedRecordsOnce) {
+  RetentionTransactionHistoryRepository repository({5});
+  for (int i = 0; i < 13; ++i) {
+    repository.save(record(i));
+  }
+
+  for (std::size_t count : {1u, 2u, 3u, 8u}) {
+    int visited = 0;
+    for (std::size_t partition = 0; partition < count; ++partition) {
+      repository.forEachInPartition(
+          partition, count,
+          [&visited](const domain::TransactionRecord &) { ++visited; });
+    }
+    EXPECT_EQ(visited, 5) << count;
+  }
+}
+
+TEST_F(RetentionTransactionHistoryRepositoryTest, FoldsSparseSlotIds) {
+  // 番号の値で配列を確保せず、現れたスロットの数だけ集計値を持つ
+  RetentionTransactionHistoryRepository repository({1});
+  for (int slot : {2000000000, 5, 2000000000}) {
+    repository.save(domain::TransactionRecord(
+        domain::SalesId(1), domain::SlotId(slot), domain::Price(100),
+        domain::PaymentMethodType::CASH, base_));
+  }
+
+  std::vector<std::pair<int, std::int64_t>> rollups;
+  repository.forEachRollup([&rollups](const domain::TransactionRollup &r) {
+    rollups.emplace_back(r.slot_id.getValue(), r.transaction_count);
+  });
+  ASSERT_EQ(rollups.size(), 2u);
+  EXPECT_EQ(rollups[0], std::make_pair(5, std::int64_t{1}));
+  EXPECT_EQ(rollups[1], std::make_pair(2000000000, std::int64_t{1}));
+}
+
+TEST_F(RetentionTransactionHistoryRepositoryTest, ClearDropsRollups) {
+  RetentionTransactionHistoryRepository repository({2});
+  for (int i = 0; i < 5; ++i) {
+    repository.save(record(i));
+  }
+  auto generation = repository.getGeneration();
+  repository.clear();
+
+  EXPECT_GT(repository.getGeneration(), generation);
+  EXPECT_EQ(repository.getRetainedCount(), 0u);
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(0));
+  int rollups = 0;
+  repository.forEachRollup(
+      [&rollups](const domain::TransactionRollup &) { ++rollups; });
+  EXPECT_EQ(rollups, 0);
+
+  repository.save(record(0));
+  EXPECT_EQ(repository.getAll().size(), 1u);
+  EXPECT_THROW(RetentionTransactionHistoryRepository({0}),
+               std::invalid_argument);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
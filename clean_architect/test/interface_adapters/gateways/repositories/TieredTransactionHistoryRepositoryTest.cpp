@@ -0,0 +1,429 @@
+/**
+ * @file TieredTransactionHistoryRepositoryTest.cpp
+ * @brief TieredTransactionHistoryRepository のユニットテスト
+ *
+ * テスト方針:
+ * - save は書き出さず、runMaintenance が満杯のメモテーブルをセグメントに
+ *   書き出し、内容は変わらない
+ * - 列の圧縮（delta-of-delta・ランレングス・辞書）が値をそのまま復元する
+ * - フッタの範囲で時間範囲・スロットの検索が対象外のセグメントを飛ばす
+ * - 開き直すと既存のセグメントを引き継ぎ、clear でファイルも消える
+ * - シーケンス番号・セッションIDもセグメントから復元される
+ * - パーティション単位の走査で全件をちょうど1回ずつ訪れる
+ * - 異常終了してもメモテーブルはログから復元され、書きかけの末尾は捨てる
+ * - clear の後に開き直してもシーケンス番号は戻らない。セグメントを消す
+ *   途中で停止しても、開くときに墓標以前のセグメントを消す
+ * - フッタの値を書き換えたセグメントは開くときに検出する
+ * - 小さなセグメントは階層ごとに併合され、併合の途中で停止した残りは
+ *   開くときに片付ける
+ */
+
+#include "interface_adapters/gateways/repositories/TieredTransactionHistoryRepository.hpp"
+#include "domain/common/Price.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+using Clock = std::chrono::system_clock;
+
+class TieredTransactionHistoryRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    directory_ =
+        ::testing::TempDir() + "tiered_history_" +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    crashed_ = directory_ + "_crashed";
+    removeDirectory(directory_);
+    removeDirectory(crashed_);
+  }
+
+  void TearDown() override {
+    removeDirectory(directory_);
+    removeDirectory(crashed_);
+  }
+
+  static void removeDirectory(const std::string &directory) {
+    for (int i = 1; i <= 64; ++i) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "/segment-%08d.vmts", i);
+      std::remove((directory + name).c_str());
+    }
+    std::remove((directory + "/memtable.log").c_str());
+    ::rmdir(directory.c_str());
+  }
+
+  // 異常終了した時点のファイルを別のディレクトリに写す
+  void copyToCrashed(const std::string &name) {
+    ::mkdir(crashed_.c_str(), 0755);
+    std::ifstream in(directory_ + "/" + name, std::ios::binary);
+    std::ofstream out(crashed_ + "/" + name, std::ios::binary);
+    out << in.rdbuf();
+  }
+
+  static bool exists(const std::string &path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+  }
+
+  // 呼び出し側と同じく、保存のあとに保守を済ませる
+  static void saveAndMaintain(TieredTransactionHistoryRepository &repository,
+                              const domain::TransactionRecord &record) {
+    repository.save(record);
+    while (repository.runMaintenance()) {
+    }
+  }
+
+  // 1秒間隔（ところどころ不規則）のレコード
+  static domain::TransactionRecord record(int i) {
+    auto timestamp = base_ + std::chrono::seconds(i) +
+                     std::chrono::milliseconds(i % 7 == 0 ? 250 : 0);
+    return domain::TransactionRecord(
+        domain::SalesId(1), domain::SlotId(i % 3 + 1),
+        domain::Price(i % 2 == 0 ? 120 : 150),
+        i % 5 == 0 ? domain::PaymentMethodType::EMONEY
+                   : domain::PaymentMethodType::CASH,
+        timestamp);
+  }
+
+  static inline const Clock::time_point base_ =
+      Clock::time_point(std::chrono::hours(24 * 365 * 50));
+  std::string directory_;
+  std::string crashed_;
+};
+
+TEST_F(TieredTransactionHistoryRepositoryTest, FlushesFullMemtableToSegments) {
+  TieredTransactionHistoryRepository repository(directory_, 4);
+  for (int i = 0; i < 10; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+
+  EXPECT_EQ(repository.getSegments().size(), 2u);
+  EXPECT_EQ(repository.getMemtableSize(), 2u);
+  EXPECT_EQ(repository.getSegments()[0].record_count, 4u);
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(5 * 120 + 5 * 150));
+
+  auto all = repository.getAll();
+  ASSERT_EQ(all.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    const auto &actual = all[9 - i]; // タイムスタンプ降順
+    auto expected = record(i);
+    EXPECT_EQ(actual.getSalesId(), expected.getSalesId());
+    EXPECT_EQ(actual.getSlotId(), expected.getSlotId());
+    EXPECT_EQ(actual.getPrice(), expected.getPrice());
+    EXPECT_EQ(actual.getPaymentMethod(), expected.getPaymentMethod());
+    EXPECT_EQ(actual.getTimestamp(), expected.getTimestamp());
+  }
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, SaveDoesNotFlush) {
+  TieredTransactionHistoryRepository repository(directory_, 2);
+  for (int i = 0; i < 5; ++i) {
+    repository.save(record(i));
+  }
+  EXPECT_TRUE(repository.getSegments().empty());
+  EXPECT_EQ(repository.getMemtableSize(), 5u);
+  EXPECT_TRUE(repository.needsMaintenance());
+
+  EXPECT_FALSE(repository.runMaintenance());
+  EXPECT_FALSE(repository.needsMaintenance());
+  EXPECT_EQ(repository.getSegments().size(), 1u);
+  EXPECT_EQ(repository.getAll().size(), 5u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, ColumnsAreCompressed) {
+  TieredTransactionHistoryRepository repository(directory_, 1000);
+  for (int i = 0; i < 1000; ++i) {
+    saveAndMaintain(repository, domain::TransactionRecord(
+        domain::SalesId(1), domain::SlotId(i / 100 + 1), domain::Price(120),
+        domain::PaymentMethodType::CASH, base_ + std::chrono::seconds(i)));
+  }
+
+  ASSERT_EQ(repository.getSegments().size(), 1u);
+  // 固定長で持つと 1 レコードあたり 20 バイト以上になる
+  EXPECT_LT(repository.getSegments()[0].encoded_size, 1000u * 2);
+  EXPECT_EQ(repository.getBySlotId(domain::SlotId(4)).size(), 100u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, QueriesUseSegmentRanges) {
+  TieredTransactionHistoryRepository repository(directory_, 5);
+  for (int i = 0; i < 12; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+
+  auto in_range = repository.getByTimeRange(base_ + std::chrono::seconds(3),
+                                            base_ + std::chrono::seconds(11));
+  ASSERT_EQ(in_range.size(), 8u);
+  EXPECT_EQ(in_range.front().getTimestamp(), record(10).getTimestamp());
+  EXPECT_EQ(in_range.back().getTimestamp(), record(3).getTimestamp());
+
+  // 範囲外のセグメントは読まない: ファイルを壊しても検索できる
+  {
+    std::ofstream corrupt(repository.getSegments()[0].path,
+                          std::ios::binary | std::ios::trunc);
+  }
+  EXPECT_EQ(repository.getByTimeRange(base_ + std::chrono::seconds(5),
+                                      base_ + std::chrono::seconds(20))
+                .size(),
+            7u);
+  EXPECT_THROW(repository.getAll(), std::runtime_error);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, SlotQueryMergesTiers) {
+  TieredTransactionHistoryRepository repository(directory_, 4);
+  for (int i = 0; i < 10; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+
+  auto slot2 = repository.getBySlotId(domain::SlotId(2));
+  ASSERT_EQ(slot2.size(), 3u); // i = 1, 4, 7
+  EXPECT_EQ(slot2[0].getTimestamp(), record(7).getTimestamp());
+  EXPECT_TRUE(repository.getBySlotId(domain::SlotId(9)).empty());
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, ReopenKeepsSegments) {
+  {
+    TieredTransactionHistoryRepository repository(directory_, 4);
+    for (int i = 0; i < 6; ++i) {
+      saveAndMaintain(repository, record(i));
+    }
+  } // 破棄時にメモテーブルも書き出す
+
+  TieredTransactionHistoryRepository repository(directory_, 4);
+  EXPECT_EQ(repository.getSegments().size(), 2u);
+  EXPECT_EQ(repository.getAll().size(), 6u);
+  saveAndMaintain(repository, record(6));
+  repository.flush();
+  EXPECT_EQ(repository.getSegments().size(), 3u);
+
+  repository.clear();
+  EXPECT_TRUE(repository.getAll().empty());
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(0));
+  struct stat st;
+  EXPECT_NE(::stat((directory_ + "/segment-00000001.vmts").c_str(), &st), 0);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest,
+       SequenceAndSessionSurviveReopen) {
+  {
+    TieredTransactionHistoryRepository repository(directory_, 4);
+    for (int i = 0; i < 6; ++i) {
+      // セッションIDは記録したものとしていないものを混ぜる
+      saveAndMaintain(repository, i % 3 == 0 ? record(i)
+                                 : record(i).withSessionId(
+                                       domain::SessionId(100 + i)));
+    }
+  }
+
+  TieredTransactionHistoryRepository repository(directory_, 4);
+  EXPECT_EQ(repository.getSegments().back().max_sequence, 6u);
+  saveAndMaintain(repository, record(6)); // 既存のセグメントの続きから採番する
+  std::uint64_t expected = 1;
+  repository.forEach([&expected](const domain::TransactionRecord &saved) {
+    EXPECT_EQ(saved.getSequence(), expected);
+    int i = static_cast<int>(expected - 1);
+    if (i % 3 == 0) {
+      EXPECT_FALSE(saved.getSessionId().has_value());
+    } else {
+      EXPECT_EQ(saved.getSessionId(), domain::SessionId(100 + i));
+    }
+    ++expected;
+  });
+  EXPECT_EQ(expected, 8u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, PartitionsVisitEveryRecordOnce) {
+  TieredTransactionHistoryRepository repository(directory_, 3);
+  for (int i = 0; i < 11; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+
+  for (std::size_t count : {1u, 2u, 3u, 8u}) {
+    int visited = 0;
+    for (std::size_t partition = 0; partition < count; ++partition) {
+      repository.forEachInPartition(
+          partition, count,
+          [&visited](const domain::TransactionRecord &) { ++visited; });
+    }
+    EXPECT_EQ(visited, 11) << count;
+  }
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, MemtableIsRecoveredFromLog) {
+  TieredTransactionHistoryRepository repository(directory_, 4);
+  for (int i = 0; i < 6; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+  copyToCrashed("segment-00000001.vmts");
+  copyToCrashed("memtable.log");
+
+  TieredTransactionHistoryRepository recovered(crashed_, 4);
+  EXPECT_EQ(recovered.getSegments().size(), 1u);
+  EXPECT_EQ(recovered.getMemtableSize(), 2u);
+  EXPECT_EQ(recovered.getTotalRevenue(), repository.getTotalRevenue());
+  recovered.save(record(6));
+  std::uint64_t expected = 1;
+  recovered.forEach([&expected](const domain::TransactionRecord &saved) {
+    EXPECT_EQ(saved.getSequence(), expected);
+    EXPECT_EQ(saved.getTimestamp(),
+              record(static_cast<int>(expected - 1)).getTimestamp());
+    ++expected;
+  });
+  EXPECT_EQ(expected, 8u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, TornLogTailIsDropped) {
+  TieredTransactionHistoryRepository repository(directory_, 8);
+  for (int i = 0; i < 3; ++i) {
+    saveAndMaintain(repository, record(i).withSessionId(domain::SessionId(7)));
+  }
+  copyToCrashed("memtable.log");
+  {
+    // 1エントリ分の壊れたバイト列と、書きかけのエントリ
+    std::ofstream torn(crashed_ + "/memtable.log",
+                       std::ios::binary | std::ios::app);
+    torn << std::string(40, 'x') << std::string(17, '\0');
+  }
+
+  {
+    TieredTransactionHistoryRepository recovered(crashed_, 8);
+    ASSERT_EQ(recovered.getMemtableSize(), 3u);
+    EXPECT_EQ(recovered.getAll().front().getSessionId(),
+              domain::SessionId(7));
+    recovered.save(record(3));
+    // 壊れた末尾を除いたヘッダ + 4エントリになり、その後ろに追記している
+    struct stat st;
+    ASSERT_EQ(::stat((crashed_ + "/memtable.log").c_str(), &st), 0);
+    EXPECT_EQ(st.st_size, 24 + 4 * 40);
+  }
+  TieredTransactionHistoryRepository reopened(crashed_, 8);
+  EXPECT_EQ(reopened.getAll().size(), 4u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest,
+       SequenceSurvivesClearAndReopen) {
+  {
+    TieredTransactionHistoryRepository repository(directory_, 2);
+    for (int i = 0; i < 3; ++i) {
+      saveAndMaintain(repository, record(i));
+    }
+    repository.clear();
+  }
+
+  TieredTransactionHistoryRepository repository(directory_, 2);
+  EXPECT_TRUE(repository.getAll().empty());
+  saveAndMaintain(repository, record(3));
+  EXPECT_EQ(repository.getAll().front().getSequence(), 4u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest,
+       InterruptedClearIsResolvedOnOpen) {
+  TieredTransactionHistoryRepository repository(directory_, 2);
+  for (int i = 0; i < 5; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+  for (const auto &segment : repository.getSegments()) {
+    copyToCrashed(segment.path.substr(directory_.size() + 1));
+  }
+  repository.clear();
+  // 墓標をログに書いた直後、セグメントを消す前に停止した状態
+  copyToCrashed("memtable.log");
+
+  TieredTransactionHistoryRepository recovered(crashed_, 2);
+  EXPECT_TRUE(recovered.getAll().empty());
+  EXPECT_TRUE(recovered.getSegments().empty());
+  EXPECT_FALSE(exists(crashed_ + "/segment-00000001.vmts"));
+  saveAndMaintain(recovered, record(5));
+  EXPECT_EQ(recovered.getAll().front().getSequence(), 6u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, FooterChecksumCoversFields) {
+  std::string path;
+  {
+    TieredTransactionHistoryRepository repository(directory_, 4);
+    for (int i = 0; i < 4; ++i) {
+      saveAndMaintain(repository, record(i));
+    }
+    path = repository.getSegments()[0].path;
+  }
+  {
+    // フッタの売上合計（チェックサムの直前の 8 バイト）を書き換える
+    std::fstream segment(path, std::ios::in | std::ios::out | std::ios::binary);
+    segment.seekp(-20, std::ios::end);
+    segment.put('\x7f');
+  }
+  EXPECT_THROW(TieredTransactionHistoryRepository(directory_, 4),
+               std::runtime_error);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, SmallSegmentsAreCompacted) {
+  TieredTransactionHistoryRepository repository(directory_, 2);
+  for (int i = 0; i < 8; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+  // 2件のセグメント4つが8件の1つになる
+  ASSERT_EQ(repository.getSegments().size(), 1u);
+  EXPECT_EQ(repository.getSegments()[0].record_count, 8u);
+  EXPECT_FALSE(exists(directory_ + "/segment-00000001.vmts"));
+
+  for (int i = 8; i < 32; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+  // 8件のセグメント4つが、さらに32件の1つになる
+  ASSERT_EQ(repository.getSegments().size(), 1u);
+  EXPECT_EQ(repository.getSegments()[0].record_count, 32u);
+  EXPECT_EQ(repository.getTotalRevenue(),
+            domain::Revenue(16 * 120 + 16 * 150));
+  std::uint64_t expected = 1;
+  repository.forEach([&expected](const domain::TransactionRecord &saved) {
+    EXPECT_EQ(saved.getSequence(), expected);
+    ++expected;
+  });
+  EXPECT_EQ(expected, 33u);
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest,
+       InterruptedCompactionIsResolvedOnOpen) {
+  TieredTransactionHistoryRepository repository(directory_, 2);
+  for (int i = 0; i < 6; ++i) {
+    saveAndMaintain(repository, record(i));
+  }
+  for (const char *name : {"segment-00000001.vmts", "segment-00000002.vmts",
+                           "segment-00000003.vmts"}) {
+    copyToCrashed(name);
+  }
+  saveAndMaintain(repository, record(6));
+  saveAndMaintain(repository, record(7));
+  // 併合後のセグメントを書いた直後、古いものを消す前に停止した状態
+  ASSERT_EQ(repository.getSegments().size(), 1u);
+  copyToCrashed("segment-00000005.vmts");
+
+  TieredTransactionHistoryRepository recovered(crashed_, 2);
+  EXPECT_EQ(recovered.getSegments().size(), 1u);
+  EXPECT_EQ(recovered.getAll().size(), 8u);
+  EXPECT_FALSE(exists(crashed_ + "/segment-00000001.vmts"));
+}
+
+TEST_F(TieredTransactionHistoryRepositoryTest, GenerationAdvances) {
+  TieredTransactionHistoryRepository repository(directory_, 2);
+  auto generation = repository.getGeneration();
+  saveAndMaintain(repository, record(0));
+  EXPECT_GT(repository.getGeneration(), generation);
+  generation = repository.getGeneration();
+  repository.clear();
+  EXPECT_GT(repository.getGeneration(), generation);
+  EXPECT_THROW(TieredTransactionHistoryRepository(directory_, 0),
+               std::invalid_argument);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,233 @@
+/**
+ * @file SqliteTransactionHistoryRepositoryTest.cpp
+ * @brief SqliteTransactionHistoryRepository のユニットテスト
+ *
+ * テスト方針:
+ * - 保存したレコードが値とともに読み出せ、並び順はメモリ内実装と同じ
+ * - コミット前（バッチの途中）のレコードも読み取りに含まれる
+ * - スロット・時間範囲の検索と売上合計が SQL で正しく求まる
+ * - 開き直すとコミット済みの履歴を引き継ぎ、WAL モードで動作する
+ * - パーティション単位の走査で全件をちょうど1回ずつ訪れ、
+ *   別々のスレッドから同時に走査できる
+ * - 準備済みの文を使い回しても、保存後の読み取りに新しい行が含まれる
+ */
+
+#include "interface_adapters/gateways/repositories/sqlite/SqliteTransactionHistoryRepository.hpp"
+#include "domain/common/Price.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+namespace vending_machine {
+namespace interface_adapters {
+namespace test {
+
+using Clock = std::chrono::system_clock;
+
+class SqliteTransactionHistoryRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "sqlite_history_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".db";
+    removeFiles();
+  }
+
+  void TearDown() override { removeFiles(); }
+
+  void removeFiles() {
+    for (const char *suffix : {"", "-wal", "-shm"}) {
+      std::remove((path_ + suffix).c_str());
+    }
+  }
+
+  // 1秒間隔のレコード
+  static domain::TransactionRecord record(int i) {
+    return domain::TransactionRecord(
+        domain::SalesId(i + 1), domain::SlotId(i % 3 + 1),
+        domain::Price(i % 2 == 0 ? 120 : 150),
+        i % 5 == 0 ? domain::PaymentMethodType::EMONEY
+                   : domain::PaymentMethodType::CASH,
+        base_ + std::chrono::seconds(i));
+  }
+
+  std::string path_;
+  static inline const Clock::time_point base_ =
+      Clock::time_point(std::chrono::hours(24 * 365 * 50));
+};
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, SavesAndReadsBackRecords) {
+  SqliteTransactionHistoryRepository repository(path_, 4);
+  for (int i = 0; i < 10; ++i) {
+    repository.save(record(i));
+  }
+  // 8件はコミット済み、2件はバッチの途中
+  EXPECT_EQ(repository.getPendingCount(), 2u);
+
+  auto all = repository.getAll();
+  ASSERT_EQ(all.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    const auto &actual = all[static_cast<std::size_t>(9 - i)];
+    auto expected = record(i);
+    EXPECT_EQ(actual.getSalesId(), expected.getSalesId());
+    EXPECT_EQ(actual.getSlotId(), expected.getSlotId());
+    EXPECT_EQ(actual.getPrice(), expected.getPrice());
+    EXPECT_EQ(actual.getPaymentMethod(), expected.getPaymentMethod());
+    EXPECT_EQ(actual.getTimestamp(), expected.getTimestamp());
+  }
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(5 * 120 + 5 * 150));
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, QueriesBySlotAndTimeRange) {
+  SqliteTransactionHistoryRepository repository(path_);
+  for (int i = 0; i < 12; ++i) {
+    repository.save(record(i));
+  }
+
+  auto slot2 = repository.getBySlotId(domain::SlotId(2));
+  ASSERT_EQ(slot2.size(), 4u); // i = 1, 4, 7, 10
+  EXPECT_EQ(slot2.front().getTimestamp(), record(10).getTimestamp());
+  EXPECT_EQ(slot2.back().getTimestamp(), record(1).getTimestamp());
+  EXPECT_TRUE(repository.getBySlotId(domain::SlotId(9)).empty());
+
+  auto in_range = repository.getByTimeRange(base_ + std::chrono::seconds(3),
+                                            base_ + std::chrono::seconds(8));
+  ASSERT_EQ(in_range.size(), 5u); // i = 3..7
+  EXPECT_EQ(in_range.front().getTimestamp(), record(7).getTimestamp());
+  EXPECT_EQ(in_range.back().getTimestamp(), record(3).getTimestamp());
+
+  // 同じ準備済みの文を続けて使える
+  EXPECT_EQ(repository.getBySlotId(domain::SlotId(2)).size(), 4u);
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, ReopenKeepsHistoryInWalMode) {
+  {
+    SqliteTransactionHistoryRepository repository(path_, 100);
+    for (int i = 0; i < 5; ++i) {
+      repository.save(record(i));
+    }
+    repository.flush();
+    EXPECT_EQ(repository.getPendingCount(), 0u);
+    struct stat st;
+    EXPECT_EQ(::stat((path_ + "-wal").c_str(), &st), 0);
+    repository.save(record(5)); // 破棄時にコミットされる
+  }
+
+  SqliteTransactionHistoryRepository repository(path_);
+  EXPECT_EQ(repository.getAll().size(), 6u);
+  repository.clear();
+  EXPECT_TRUE(repository.getAll().empty());
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(0));
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest,
+       PartitionsVisitEveryRecordOnce) {
+  SqliteTransactionHistoryRepository repository(path_, 3);
+  for (int i = 0; i < 11; ++i) {
+    repository.save(record(i));
+  }
+
+  for (std::size_t count : {1u, 2u, 3u, 8u, 20u}) {
+    int visited = 0;
+    for (std::size_t partition = 0; partition < count; ++partition) {
+      repository.forEachInPartition(
+          partition, count,
+          [&visited](const domain::TransactionRecord &) { ++visited; });
+    }
+    EXPECT_EQ(visited, 11) << count;
+  }
+
+  int expected = 1;
+  repository.forEach([&expected](const domain::TransactionRecord &record) {
+    EXPECT_EQ(record.getSalesId().getValue(), expected);
+    EXPECT_EQ(record.getSequence(), static_cast<std::uint64_t>(expected));
+    ++expected;
+  });
+  EXPECT_EQ(expected, 12);
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, PartitionsRunConcurrently) {
+  SqliteTransactionHistoryRepository repository(path_, 16);
+  for (int i = 0; i < 200; ++i) {
+    repository.save(record(i));
+  }
+
+  for (int round = 0; round < 3; ++round) {
+    std::atomic<int> visited{0};
+    std::vector<std::thread> workers;
+    for (std::size_t partition = 0; partition < 4; ++partition) {
+      workers.emplace_back([&repository, &visited, partition] {
+        repository.forEachInPartition(
+            partition, 4,
+            [&visited](const domain::TransactionRecord &) { ++visited; });
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    EXPECT_EQ(visited, 200) << round;
+  }
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, CachedQueriesSeeNewRows) {
+  SqliteTransactionHistoryRepository repository(path_, 2);
+  repository.save(record(0));
+  EXPECT_EQ(repository.getAll().size(), 1u);
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(120));
+
+  repository.save(record(1));
+  repository.save(record(2));
+  EXPECT_EQ(repository.getAll().size(), 3u);
+  EXPECT_EQ(repository.getTotalRevenue(), domain::Revenue(390));
+  int visited = 0;
+  repository.forEach([&visited](const domain::TransactionRecord &) {
+    ++visited;
+  });
+  EXPECT_EQ(visited, 3);
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, SequenceSurvivesClearAndReopen) {
+  {
+    SqliteTransactionHistoryRepository repository(path_);
+    for (int i = 0; i < 3; ++i) {
+      repository.save(record(i));
+    }
+    repository.clear();
+  }
+
+  // 削除した行の番号も再利用しない
+  SqliteTransactionHistoryRepository repository(path_);
+  repository.save(record(3).withSessionId(domain::SessionId(42)));
+  repository.save(record(4));
+  auto all = repository.getAll();
+  ASSERT_EQ(all.size(), 2u);
+  EXPECT_EQ(all[1].getSequence(), 4u);
+  EXPECT_EQ(all[1].getSessionId(), domain::SessionId(42));
+  EXPECT_FALSE(all[0].getSessionId().has_value());
+}
+
+TEST_F(SqliteTransactionHistoryRepositoryTest, GenerationAdvances) {
+  SqliteTransactionHistoryRepository repository(path_);
+  auto generation = repository.getGeneration();
+  repository.save(record(0));
+  EXPECT_GT(repository.getGeneration(), generation);
+  generation = repository.getGeneration();
+  repository.clear();
+  EXPECT_GT(repository.getGeneration(), generation);
+
+  EXPECT_THROW(SqliteTransactionHistoryRepository(path_, 0),
+               std::invalid_argument);
+  EXPECT_THROW(SqliteTransactionHistoryRepository(
+                   ::testing::TempDir() + "no_such_directory/history.db"),
+               std::runtime_error);
+}
+
+} // namespace test
+} // namespace interface_adapters
+} // namespace vending_machine
@@ -0,0 +1,149 @@
+/**
+ * @file VendingMachineApplicationCheckpointTest.cpp
+ * @brief VendingMachineApplication のチェックポイント（保存・復元）のテスト
+ *
+ * テスト方針:
+ * - 保存した在庫・残高・モードが別インスタンスに復元される
+ * - 商品選択中・決済待ちのセッションは再開される
+ * - 排出中だったセッションは在庫を戻して決済待ちに戻り、返金で終えられる
+ * - 定期保存は間隔に従い、保存先が無ければ何もしない
+ */
+
+#include "usecases/VendingMachineApplication.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedCoinMech.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedDispenser.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedPaymentGateway.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+class InMemoryMachineStateRepository : public domain::IMachineStateRepository {
+public:
+  void save(const domain::MachineState &state) override {
+    state_ = state;
+    ++save_count;
+  }
+  std::optional<domain::MachineState> load() const override { return state_; }
+
+  int save_count = 0;
+
+private:
+  std::optional<domain::MachineState> state_;
+};
+
+class VendingMachineApplicationCheckpointTest : public ::testing::Test {
+protected:
+  interface_adapters::SimulatedCoinMech coin_mech;
+  interface_adapters::SimulatedDispenser dispenser;
+  interface_adapters::SimulatedPaymentGateway payment_gateway;
+  interface_adapters::InMemoryTransactionHistoryRepository history;
+  InMemoryMachineStateRepository checkpoint;
+
+  VendingMachineApplication app{coin_mech, dispenser, payment_gateway,
+                                history};
+  VendingMachineApplication restored{coin_mech, dispenser, payment_gateway,
+                                     history};
+
+  // セッションを指定の状態にした MachineState を作る
+  domain::MachineState stateWithSession(domain::SessionStatus status) {
+    app.initializeInventory();
+    auto state = app.captureState();
+    state.balance = domain::Money(200);
+    state.slots[0].stock = domain::Quantity(9); // 排出で1個減った後
+    state.session = domain::SessionState{domain::SessionId(5), status,
+                                         domain::SlotId(1)};
+    return state;
+  }
+};
+
+TEST_F(VendingMachineApplicationCheckpointTest, RestoresInventoryAndBalance) {
+  app.initializeInventory();
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  app.getPurchaseWithCashUseCase().selectAndPurchase(dto::PurchaseRequest{2});
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{100});
+
+  app.enableCheckpoints(checkpoint, std::chrono::hours(1));
+  app.saveCheckpoint();
+  restored.enableCheckpoints(checkpoint, std::chrono::hours(1));
+  auto outcome = restored.restoreCheckpoint();
+
+  ASSERT_TRUE(outcome.has_value());
+  EXPECT_EQ(*outcome, RestoreOutcome::SESSION_RESUMED);
+  EXPECT_EQ(restored.getInventory().getSlotCount(), 4u);
+  EXPECT_EQ(restored.getInventory().findSlot(domain::SlotId(2))->getStock(),
+            domain::Quantity(9));
+  EXPECT_EQ(restored.getWallet().getBalance(), domain::Money(100));
+  ASSERT_NE(restored.getSales().getCurrentSession(), nullptr);
+  EXPECT_EQ(restored.getSales().getCurrentSession()->getStatus(),
+            domain::SessionStatus::PRODUCT_SELECTING);
+
+  // 再開したセッションでそのまま購入できる
+  auto response = restored.getPurchaseWithCashUseCase().selectAndPurchase(
+      dto::PurchaseRequest{3});
+  EXPECT_TRUE(response.success);
+}
+
+TEST_F(VendingMachineApplicationCheckpointTest, NothingSavedRestoresNothing) {
+  restored.enableCheckpoints(checkpoint, std::chrono::hours(1));
+
+  EXPECT_FALSE(restored.restoreCheckpoint().has_value());
+  EXPECT_EQ(restored.getInventory().getSlotCount(), 0u);
+}
+
+TEST_F(VendingMachineApplicationCheckpointTest, PaymentPendingIsResumed) {
+  auto state = stateWithSession(domain::SessionStatus::PAYMENT_PENDING);
+  auto outcome = restored.restoreState(state);
+
+  EXPECT_EQ(outcome, RestoreOutcome::SESSION_RESUMED);
+  EXPECT_EQ(restored.getInventory().findSlot(domain::SlotId(1))->getStock(),
+            domain::Quantity(9));
+  EXPECT_EQ(restored.getSales().getCurrentSession()->getStatus(),
+            domain::SessionStatus::PAYMENT_PENDING);
+}
+
+TEST_F(VendingMachineApplicationCheckpointTest, DispensingIsRolledBack) {
+  auto state = stateWithSession(domain::SessionStatus::DISPENSING);
+  auto outcome = restored.restoreState(state);
+
+  EXPECT_EQ(outcome, RestoreOutcome::DISPENSE_ROLLED_BACK);
+  EXPECT_EQ(restored.getInventory().findSlot(domain::SlotId(1))->getStock(),
+            domain::Quantity(10));
+  EXPECT_EQ(restored.getSales().getCurrentSession()->getStatus(),
+            domain::SessionStatus::PAYMENT_PENDING);
+
+  EXPECT_EQ(restored.getPurchaseWithCashUseCase().refund(), 200);
+  EXPECT_EQ(restored.getSales().getCurrentSession(), nullptr);
+  EXPECT_EQ(restored.getWallet().getBalance(), domain::Money(0));
+}
+
+TEST_F(VendingMachineApplicationCheckpointTest, RestoreRequiresEmptyInventory) {
+  auto state = stateWithSession(domain::SessionStatus::PRODUCT_SELECTING);
+
+  EXPECT_THROW(app.restoreState(state), std::logic_error);
+}
+
+TEST_F(VendingMachineApplicationCheckpointTest, CheckpointIfDueHonorsInterval) {
+  app.initializeInventory();
+  EXPECT_FALSE(app.checkpointIfDue());
+  EXPECT_THROW(app.saveCheckpoint(), std::logic_error);
+
+  app.enableCheckpoints(checkpoint, std::chrono::hours(1));
+  EXPECT_FALSE(app.checkpointIfDue());
+
+  app.enableCheckpoints(checkpoint, std::chrono::seconds(0));
+  EXPECT_TRUE(app.checkpointIfDue());
+  EXPECT_EQ(checkpoint.save_count, 1);
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
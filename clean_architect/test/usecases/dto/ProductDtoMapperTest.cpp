@@ -0,0 +1,111 @@
+/**
+ * @file ProductDtoMapperTest.cpp
+ * @brief 商品DTO/ビュー変換のユニットテスト
+ *
+ * テスト方針:
+ * - ビューは在庫側の商品名をコピーせず参照する
+ * - 在庫切れ除外の指定が反映される
+ * - ビューからDTOへの変換で値が保たれる
+ * - メモリリソース版のDTOは一覧・商品名とも指定のリソースから確保する
+ */
+
+#include "usecases/dto/ProductDtoMapper.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <vector>
+
+namespace vending_machine {
+namespace usecases {
+namespace dto {
+namespace test {
+
+class ProductDtoMapperTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(1),
+        domain::ProductInfo(domain::ProductName("Cola"), domain::Price(100)),
+        domain::Quantity(3)));
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(2),
+        domain::ProductInfo(domain::ProductName("Coffee"), domain::Price(120)),
+        domain::Quantity(0)));
+    inventory.snapshot(slots);
+  }
+
+  domain::Inventory inventory;
+  std::vector<domain::SlotSnapshot> slots;
+};
+
+/**
+ * @test ビューの商品名は在庫内の文字列を参照する
+ */
+TEST_F(ProductDtoMapperTest, ViewReferencesInventoryName) {
+  std::vector<ProductView> views;
+  ASSERT_EQ(2u, toProductViews(slots, views));
+
+  const auto &name =
+      inventory.getSlot(domain::SlotId(1)).getProductInfo().getName();
+  EXPECT_EQ(name.getValue().data(), views[0].name.data());
+  EXPECT_EQ(1, views[0].slot_id);
+  EXPECT_EQ(100, views[0].price);
+  EXPECT_EQ(3, views[0].stock);
+}
+
+/**
+ * @test 在庫切れ除外を指定すると在庫0のスロットは含まれない
+ */
+TEST_F(ProductDtoMapperTest, InStockOnlySkipsEmptySlots) {
+  std::vector<ProductView> views;
+  ASSERT_EQ(1u, toProductViews(slots, views, /*in_stock_only=*/true));
+  EXPECT_EQ("Cola", views[0].name);
+}
+
+/**
+ * @test ビューからDTOに変換すると商品名を所有する
+ */
+TEST_F(ProductDtoMapperTest, DtoOwnsCopiedName) {
+  std::vector<ProductView> views;
+  toProductViews(slots, views);
+
+  auto dtos = toProductDtos(views);
+  ASSERT_EQ(2u, dtos.size());
+  EXPECT_EQ("Coffee", dtos[1].name);
+  EXPECT_EQ(120, dtos[1].price);
+  EXPECT_EQ(0, dtos[1].stock);
+}
+
+/**
+ * @test メモリリソース版のDTOは一覧と商品名を指定のリソースに置く
+ */
+TEST_F(ProductDtoMapperTest, PmrDtosUseGivenResource) {
+  // バッファを使い切るとグローバルなヒープではなく例外になる
+  std::byte buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+
+  auto dtos = toProductDtos(slots, &arena, /*in_stock_only=*/true);
+  ASSERT_EQ(1u, dtos.size());
+  EXPECT_EQ(&arena, dtos.get_allocator().resource());
+  EXPECT_EQ(&arena, dtos[0].name.get_allocator().resource());
+  EXPECT_EQ("Cola", dtos[0].name);
+  EXPECT_EQ(100, dtos[0].price);
+  EXPECT_EQ(3, dtos[0].stock);
+
+  // 別のリソースの一覧へ移しても要素は移し先のリソースを使う
+  std::pmr::monotonic_buffer_resource other;
+  PmrProductList copied(dtos.begin(), dtos.end(), &other);
+  EXPECT_EQ(&other, copied[0].name.get_allocator().resource());
+}
+
+} // namespace test
+} // namespace dto
+} // namespace usecases
+} // namespace vending_machine
@@ -0,0 +1,236 @@
+/**
+ * @file EventReplayUseCaseTest.cpp
+ * @brief EventReplayUseCase のテスト
+ *
+ * テスト方針:
+ * - アプリケーションの操作で記録されたイベントを再生すると、
+ *   現在の在庫・残高・モードと一致する
+ * - 並列の再生は直列の再生と同じ結果になる
+ * - 通番を指定するとその時点の状態を再現できる
+ * - スナップショットがあれば、その後のイベントだけを再生する
+ * - 記録は enableEventLog() までしない。スナップショットの保持数を
+ *   超えてもイベントは破棄しない
+ * - ストアがあればメモリに置くイベントは抑えられ、古い範囲の再生は
+ *   ストアから読み出す。再起動後の通番はストアの続きから振られ、
+ *   記録を始める前の時点の再生は例外になる
+ */
+
+#include "usecases/EventReplayUseCase.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedCoinMech.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedDispenser.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedPaymentGateway.hpp"
+#include "interface_adapters/gateways/repositories/FileEventStore.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "usecases/VendingMachineApplication.hpp"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+class EventReplayUseCaseTest : public ::testing::Test {
+protected:
+  interface_adapters::SimulatedCoinMech coin_mech;
+  interface_adapters::SimulatedDispenser dispenser;
+  interface_adapters::SimulatedPaymentGateway payment_gateway;
+  interface_adapters::InMemoryTransactionHistoryRepository history;
+
+  VendingMachineApplication app{coin_mech, dispenser, payment_gateway,
+                                history};
+
+  void purchase(int slot_id) {
+    auto &usecase = app.getPurchaseWithCashUseCase();
+    usecase.startSession();
+    usecase.insertCash(dto::InsertCashRequest{500});
+    usecase.selectAndPurchase(dto::PurchaseRequest{slot_id});
+  }
+
+  static void expectSameState(const domain::MachineState &actual,
+                              const domain::MachineState &expected) {
+    EXPECT_EQ(actual.mode, expected.mode);
+    EXPECT_EQ(actual.balance, expected.balance);
+    ASSERT_EQ(actual.slots.size(), expected.slots.size());
+    for (std::size_t i = 0; i < actual.slots.size(); ++i) {
+      EXPECT_EQ(actual.slots[i].slot_id, expected.slots[i].slot_id);
+      EXPECT_EQ(actual.slots[i].product_info.getName(),
+                expected.slots[i].product_info.getName());
+      EXPECT_EQ(actual.slots[i].product_info.getPrice(),
+                expected.slots[i].product_info.getPrice());
+      EXPECT_EQ(actual.slots[i].stock, expected.slots[i].stock);
+    }
+  }
+};
+
+TEST_F(EventReplayUseCaseTest, ReplayRebuildsCurrentState) {
+  app.enableEventLog(100, 2);
+  app.initializeInventory();
+  purchase(1);
+  purchase(2);
+  purchase(1);
+  app.getInventoryRefillUseCase().refillSlot(domain::SlotId(1),
+                                             domain::Quantity(2));
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{100});
+
+  auto result = app.getEventReplayUseCase().replay();
+
+  expectSameState(result.state, app.captureState());
+  EXPECT_FALSE(result.state.session.has_value());
+  EXPECT_EQ(result.sequence, app.getEventLog().getLastSequence());
+  EXPECT_EQ(result.events_applied, app.getEventLog().getEvents().size());
+}
+
+TEST_F(EventReplayUseCaseTest, ParallelReplayMatchesSerialReplay) {
+  app.enableEventLog(100, 2);
+  app.initializeInventory();
+  for (int i = 0; i < 20; ++i) {
+    purchase(i % 4 + 1);
+  }
+
+  auto serial = app.getEventReplayUseCase().replay(1);
+  for (std::size_t threads : {2u, 3u, 8u, 0u}) {
+    SCOPED_TRACE(threads);
+    expectSameState(app.getEventReplayUseCase().replay(threads).state,
+                    serial.state);
+  }
+  EXPECT_EQ(serial.state.slots[0].stock, domain::Quantity(5));
+}
+
+TEST_F(EventReplayUseCaseTest, ReplayUntilReproducesPastState) {
+  app.enableEventLog(100, 2);
+  app.initializeInventory();
+  auto before = app.captureState();
+  std::uint64_t sequence = app.getEventLog().getLastSequence();
+  purchase(3);
+  purchase(3);
+
+  auto result = app.getEventReplayUseCase().replayUntil(sequence, 2);
+
+  expectSameState(result.state, before);
+  EXPECT_EQ(result.sequence, sequence);
+  // 記録済みより先の通番は最後までの再生になる
+  EXPECT_EQ(app.getEventReplayUseCase().replayUntil(1000).sequence,
+            app.getEventLog().getLastSequence());
+}
+
+TEST_F(EventReplayUseCaseTest, SnapshotsBoundReplayLength) {
+  app.enableEventLog(5, 100);
+  app.initializeInventory();
+  for (int i = 0; i < 10; ++i) {
+    purchase(i % 4 + 1);
+  }
+
+  auto result = app.getEventReplayUseCase().replay(4);
+
+  EXPECT_GT(app.getEventLog().getSnapshotCount(), 0u);
+  EXPECT_LT(result.events_applied, 5u);
+  expectSameState(result.state, app.captureState());
+}
+
+TEST_F(EventReplayUseCaseTest, RecordsNothingUntilEnabled) {
+  app.initializeInventory();
+  purchase(1);
+  EXPECT_THROW(app.getEventLog(), std::logic_error);
+  EXPECT_THROW(app.getEventReplayUseCase(), std::logic_error);
+
+  // 有効にした時点の状態が再生の起点になる
+  app.enableEventLog(100, 2);
+  purchase(2);
+  expectSameState(app.getEventReplayUseCase().replay(2).state,
+                  app.captureState());
+  EXPECT_THROW(app.enableEventLog(100, 2), std::logic_error);
+}
+
+TEST_F(EventReplayUseCaseTest, RetentionKeepsEventsWithoutStore) {
+  app.enableEventLog(4, 2);
+  app.initializeInventory();
+  auto initial = app.captureState();
+  std::uint64_t initialized = app.getEventLog().getLastSequence();
+  for (int i = 0; i < 30; ++i) {
+    purchase(i % 4 + 1);
+  }
+
+  // 記録を始めた時点のスナップショットと直近の2個
+  const auto &log = app.getEventLog();
+  EXPECT_EQ(log.getSnapshotCount(), 3u);
+  EXPECT_EQ(log.getFirstSequence(), 1u);
+  EXPECT_EQ(log.getEvents().size(), log.getLastSequence());
+  expectSameState(app.getEventReplayUseCase().replay(3).state,
+                  app.captureState());
+  expectSameState(
+      app.getEventReplayUseCase().replayUntil(initialized).state, initial);
+}
+
+TEST_F(EventReplayUseCaseTest, StoreBoundsEventsInMemory) {
+  std::string path = ::testing::TempDir() + "event_replay_store.events";
+  std::remove(path.c_str());
+  interface_adapters::FileEventStore store(path);
+  app.enableEventLog(4, 2, &store);
+  app.initializeInventory();
+  auto initial = app.captureState();
+  std::uint64_t initialized = app.getEventLog().getLastSequence();
+  for (int i = 0; i < 30; ++i) {
+    purchase(i % 4 + 1);
+  }
+
+  const auto &log = app.getEventLog();
+  EXPECT_LE(log.getEvents().size(), 8u);
+  EXPECT_GT(log.getFirstSequence(), initialized);
+  EXPECT_EQ(store.getLastSequence(), log.getLastSequence());
+  expectSameState(app.getEventReplayUseCase().replay(3).state,
+                  app.captureState());
+
+  // メモリから外したイベントはストアから読み出して再生する
+  auto past = app.getEventReplayUseCase().replayUntil(initialized, 2);
+  expectSameState(past.state, initial);
+  EXPECT_EQ(past.events_applied, initialized);
+
+  // 再起動後は通番がストアの続きから振られ、それより前は再生できない
+  interface_adapters::FileEventStore reopened(path);
+  VendingMachineApplication restarted{coin_mech, dispenser, payment_gateway,
+                                      history};
+  restarted.restoreState(app.captureState());
+  restarted.enableEventLog(4, 2, &reopened);
+  restarted.getInventoryRefillUseCase().refillSlot(domain::SlotId(1),
+                                                   domain::Quantity(1));
+  std::uint64_t last_sequence = log.getLastSequence();
+  EXPECT_EQ(restarted.getEventLog().getFirstSequence(), last_sequence + 1);
+  EXPECT_EQ(reopened.getLastSequence(), last_sequence + 1);
+  expectSameState(restarted.getEventReplayUseCase().replay().state,
+                  restarted.captureState());
+  EXPECT_THROW(restarted.getEventReplayUseCase().replayUntil(last_sequence - 1),
+               std::out_of_range);
+  std::remove(path.c_str());
+}
+
+TEST_F(EventReplayUseCaseTest, RestoredModeIsRecorded) {
+  domain::MachineState state{domain::SalesId(1), domain::Mode::MAINTENANCE,
+                             domain::Money(0), {}, std::nullopt};
+  state.slots.push_back(
+      {domain::SlotId(7),
+       domain::ProductInfo(domain::ProductName("お茶"), domain::Price(150)),
+       domain::Quantity(3)});
+  app.enableEventLog(100, 2);
+  app.restoreState(state);
+
+  expectSameState(app.getEventReplayUseCase().replay().state, state);
+}
+
+TEST_F(EventReplayUseCaseTest, EventForUnknownSlotIsRejected) {
+  domain::EventLog log;
+  log.append(domain::DomainEvent::productDispensed(domain::SlotId(9),
+                                                   domain::Quantity(1)));
+
+  EventReplayUseCase usecase(log);
+  EXPECT_THROW(usecase.replay(), std::domain_error);
+  EXPECT_THROW(usecase.replay(4), std::domain_error);
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
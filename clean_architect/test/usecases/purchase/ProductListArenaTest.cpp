@@ -0,0 +1,133 @@
+/**
+ * @file ProductListArenaTest.cpp
+ * @brief 商品一覧をメモリリソースに置くAPI（std::pmr）のユニットテスト
+ *
+ * テスト方針:
+ * - 一覧・商品名の確保はすべてスタック上のバッファから行われる
+ *   （上流を null_memory_resource にし、ヒープに逃げれば例外になる）
+ * - 返す内容は従来のAPIと同じ
+ * - 同じバッファを release して繰り返し使える
+ */
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include "domain/payment/Wallet.hpp"
+#include "domain/sales/Sales.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedCoinMech.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedDispenser.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedPaymentGateway.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "usecases/PurchaseWithCashUseCase.hpp"
+#include "usecases/PurchaseWithEMoneyUseCase.hpp"
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string_view>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+class ProductListArenaTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    // 短い文字列の最適化に収まらない長さの商品名にする
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(1),
+        domain::ProductInfo(
+            domain::ProductName("Sparkling Orange Juice 500ml"),
+            domain::Price(150)),
+        domain::Quantity(5)));
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(2),
+        domain::ProductInfo(domain::ProductName("Premium Black Coffee 280ml"),
+                            domain::Price(120)),
+        domain::Quantity(0)));
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(3),
+        domain::ProductInfo(domain::ProductName("Mineral Water 600ml Bottle"),
+                            domain::Price(100)),
+        domain::Quantity(2)));
+  }
+
+  bool inBuffer(const void *pointer) const {
+    const auto *byte = static_cast<const std::byte *>(pointer);
+    return byte >= buffer && byte < buffer + sizeof(buffer);
+  }
+
+  domain::Inventory inventory;
+  domain::Wallet wallet;
+  domain::Sales sales{domain::SalesId(1)};
+  interface_adapters::SimulatedCoinMech coin_mech;
+  interface_adapters::SimulatedDispenser dispenser;
+  interface_adapters::SimulatedPaymentGateway payment_gateway;
+  interface_adapters::InMemoryTransactionHistoryRepository repository;
+  PurchaseWithCashUseCase cash_use_case{inventory, wallet,    sales,
+                                        coin_mech, dispenser, repository};
+  PurchaseWithEMoneyUseCase emoney_use_case{
+      inventory, wallet, sales, payment_gateway, dispenser, repository};
+
+  std::byte buffer[2048];
+  std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource()};
+};
+
+/**
+ * @test 購入可能な商品一覧はバッファ内に置かれ、従来のAPIと同じ内容になる
+ */
+TEST_F(ProductListArenaTest, EligibleProductsLiveInBuffer) {
+  cash_use_case.startSession();
+  cash_use_case.insertCash({100});
+  cash_use_case.insertCash({50});
+  auto expected = cash_use_case.getEligibleProducts();
+
+  auto products = cash_use_case.getEligibleProducts(&arena);
+  ASSERT_EQ(expected.size(), products.size());
+  ASSERT_EQ(2u, products.size());
+  for (std::size_t i = 0; i < products.size(); ++i) {
+    EXPECT_EQ(expected[i].slot_id, products[i].slot_id);
+    EXPECT_EQ(expected[i].name, std::string_view(products[i].name));
+    EXPECT_EQ(expected[i].price, products[i].price);
+    EXPECT_EQ(expected[i].stock, products[i].stock);
+    EXPECT_TRUE(inBuffer(products[i].name.data()));
+  }
+  EXPECT_TRUE(inBuffer(products.data()));
+}
+
+/**
+ * @test 全商品一覧・電子マネーの一覧もバッファだけで確保する
+ */
+TEST_F(ProductListArenaTest, AllAndEMoneyProductsLiveInBuffer) {
+  auto all = cash_use_case.getAllProducts(&arena);
+  ASSERT_EQ(3u, all.size());
+  EXPECT_EQ("Premium Black Coffee 280ml", all[1].name);
+  EXPECT_TRUE(inBuffer(all[1].name.data()));
+
+  auto available = emoney_use_case.getAvailableProducts(&arena);
+  ASSERT_EQ(2u, available.size()); // 在庫切れのスロット2を除く
+  EXPECT_EQ(1, available[0].slot_id);
+  EXPECT_EQ(3, available[1].slot_id);
+  EXPECT_TRUE(inBuffer(available[1].name.data()));
+}
+
+/**
+ * @test リクエストごとに release すれば同じバッファで繰り返し処理できる
+ */
+TEST_F(ProductListArenaTest, ReleasedBufferServesRepeatedRequests) {
+  for (int request = 0; request < 100; ++request) {
+    {
+      auto products = cash_use_case.getAllProducts(&arena);
+      ASSERT_EQ(3u, products.size());
+    }
+    arena.release();
+  }
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
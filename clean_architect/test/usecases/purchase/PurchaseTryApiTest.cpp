@@ -0,0 +1,206 @@
+/**
+ * @file PurchaseTryApiTest.cpp
+ * @brief 購入ユースケースの例外を送出しないAPIのユニットテスト
+ *
+ * テスト方針:
+ * - 在庫切れ・残高不足・決済否認は ErrorCode で返る
+ * - 失敗時に在庫・残高が変わらない（排出機は呼ばれない）
+ * - 従来の例外ベースのAPIは同じ失敗で例外を送出する
+ * - 成功した購入は、完了したセッションのIDとともに履歴に記録される
+ */
+
+#include "domain/common/Money.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/common/Quantity.hpp"
+#include "domain/interfaces/ICoinMech.hpp"
+#include "domain/interfaces/IDispenser.hpp"
+#include "domain/interfaces/IPaymentGateway.hpp"
+#include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductInfo.hpp"
+#include "domain/inventory/ProductName.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include "domain/payment/Wallet.hpp"
+#include "domain/repositories/ITransactionHistoryRepository.hpp"
+#include "domain/sales/Sales.hpp"
+#include "usecases/PurchaseWithCashUseCase.hpp"
+#include "usecases/PurchaseWithEMoneyUseCase.hpp"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <optional>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+class MockCoinMech : public domain::ICoinMech {
+public:
+  MOCK_METHOD(bool, canMakeChange, (const domain::Money &amount),
+              (const override));
+  MOCK_METHOD(void, dispense, (const domain::Money &amount), (override));
+};
+
+class MockDispenser : public domain::IDispenser {
+public:
+  MOCK_METHOD(bool, canDispense, (const domain::ProductInfo &product),
+              (const override));
+  MOCK_METHOD(void, dispense, (const domain::ProductInfo &product), (override));
+};
+
+class MockPaymentGateway : public domain::IPaymentGateway {
+public:
+  MOCK_METHOD(void, requestPayment, (const domain::Price &price), (override));
+  MOCK_METHOD(void, cancelPayment, (), (override));
+  MOCK_METHOD(domain::PaymentStatus, getPaymentStatus, (), (const, override));
+};
+
+class MockTransactionHistoryRepository
+    : public domain::ITransactionHistoryRepository {
+public:
+  MOCK_METHOD(void, save, (const domain::TransactionRecord &record),
+              (override));
+  MOCK_METHOD(std::vector<domain::TransactionRecord>, getAll, (),
+              (const, override));
+  MOCK_METHOD(std::vector<domain::TransactionRecord>, getBySlotId,
+              (const domain::SlotId &slot_id), (const, override));
+  MOCK_METHOD(domain::Revenue, getTotalRevenue, (), (const, override));
+  MOCK_METHOD(std::uint64_t, getGeneration, (), (const, override));
+  MOCK_METHOD(void, clear, (), (override));
+};
+
+class PurchaseTryApiTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(1),
+        domain::ProductInfo(domain::ProductName("Cola"), domain::Price(120)),
+        domain::Quantity(5)));
+    inventory.addSlot(domain::ProductSlot(
+        domain::SlotId(2),
+        domain::ProductInfo(domain::ProductName("Water"), domain::Price(100)),
+        domain::Quantity(0)));
+  }
+
+  int stockOf(int slot_id) const {
+    return inventory.getSlot(domain::SlotId(slot_id)).getStock().getValue();
+  }
+
+  domain::Inventory inventory;
+  domain::Wallet wallet;
+  domain::Sales sales{domain::SalesId(1)};
+  ::testing::NiceMock<MockCoinMech> coin_mech;
+  ::testing::NiceMock<MockDispenser> dispenser;
+  ::testing::NiceMock<MockPaymentGateway> payment_gateway;
+  ::testing::NiceMock<MockTransactionHistoryRepository> repository;
+  PurchaseWithCashUseCase cash_use_case{inventory, wallet,    sales,
+                                        coin_mech, dispenser, repository};
+  PurchaseWithEMoneyUseCase emoney_use_case{
+      inventory, wallet, sales, payment_gateway, dispenser, repository};
+};
+
+/**
+ * @test 残高不足はエラーコードで返り、商品は排出されない
+ */
+TEST_F(PurchaseTryApiTest, CashInsufficientBalanceLeavesStateUntouched) {
+  cash_use_case.startSession();
+  cash_use_case.insertCash({100});
+
+  EXPECT_CALL(dispenser, dispense).Times(0);
+  auto result = cash_use_case.trySelectAndPurchase({1});
+
+  ASSERT_FALSE(result);
+  EXPECT_EQ(domain::ErrorCode::INSUFFICIENT_BALANCE, result.error());
+  EXPECT_EQ(5, stockOf(1));
+  EXPECT_EQ(100, cash_use_case.getBalance());
+  EXPECT_FALSE(sales.getCurrentSession()->getSelectedSlotId().has_value());
+}
+
+/**
+ * @test 在庫切れ・存在しないスロットはエラーコードで返る
+ */
+TEST_F(PurchaseTryApiTest, CashOutOfStockAndUnknownSlot) {
+  cash_use_case.startSession();
+  cash_use_case.insertCash({500});
+
+  EXPECT_EQ(domain::ErrorCode::OUT_OF_STOCK,
+            cash_use_case.trySelectAndPurchase({2}).error());
+  EXPECT_EQ(domain::ErrorCode::SLOT_NOT_FOUND,
+            cash_use_case.trySelectAndPurchase({9}).error());
+  EXPECT_EQ(domain::ErrorCode::SLOT_NOT_FOUND,
+            cash_use_case.trySelectAndPurchase({0}).error());
+}
+
+/**
+ * @test 購入成功時はレスポンスとお釣りを返し、セッションIDつきで記録する
+ */
+TEST_F(PurchaseTryApiTest, CashPurchaseSucceeds) {
+  cash_use_case.startSession();
+  cash_use_case.insertCash({500});
+  auto session_id = sales.getCurrentSession()->getSessionId();
+
+  EXPECT_CALL(dispenser, dispense).Times(1);
+  EXPECT_CALL(coin_mech, dispense(domain::Money(380))).Times(1);
+  std::optional<domain::TransactionRecord> saved;
+  EXPECT_CALL(repository, save)
+      .WillOnce(::testing::SaveArg<0>(&saved));
+  auto result = cash_use_case.trySelectAndPurchase({1});
+
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(saved.has_value());
+  EXPECT_EQ(domain::SalesId(1), saved->getSalesId());
+  EXPECT_EQ(session_id, saved->getSessionId());
+  EXPECT_EQ(nullptr, sales.getCurrentSession());
+  EXPECT_EQ("Cola", result.value().product_name);
+  EXPECT_EQ(380, result.value().change_amount);
+  EXPECT_EQ(4, stockOf(1));
+  EXPECT_EQ(0, cash_use_case.getBalance());
+}
+
+/**
+ * @test 従来のAPIは同じ失敗を例外として送出する
+ */
+TEST_F(PurchaseTryApiTest, CashThrowingApiStillThrows) {
+  cash_use_case.startSession();
+  cash_use_case.insertCash({100});
+
+  EXPECT_THROW(cash_use_case.selectAndPurchase({1}), std::domain_error);
+  EXPECT_THROW(cash_use_case.selectAndPurchase({9}), std::invalid_argument);
+}
+
+/**
+ * @test 決済否認はエラーコードで返り、在庫とセッションが戻される
+ */
+TEST_F(PurchaseTryApiTest, EMoneyDeclinedRollsBack) {
+  emoney_use_case.startSession();
+  ON_CALL(payment_gateway, getPaymentStatus)
+      .WillByDefault(::testing::Return(domain::PaymentStatus::Failed));
+
+  EXPECT_CALL(dispenser, dispense).Times(0);
+  auto result = emoney_use_case.trySelectAndRequestPayment({1});
+
+  ASSERT_FALSE(result);
+  EXPECT_EQ(domain::ErrorCode::PAYMENT_DECLINED, result.error());
+  EXPECT_EQ(5, stockOf(1));
+  EXPECT_EQ(nullptr, sales.getCurrentSession());
+
+  // 従来のAPIは失敗レスポンスを返す
+  emoney_use_case.startSession();
+  auto response = emoney_use_case.selectAndRequestPayment({1});
+  EXPECT_FALSE(response.success);
+  EXPECT_EQ("Payment Failed", response.message);
+}
+
+/**
+ * @test 電子決済でも在庫切れはエラーコードで返る
+ */
+TEST_F(PurchaseTryApiTest, EMoneyOutOfStock) {
+  emoney_use_case.startSession();
+
+  EXPECT_CALL(payment_gateway, requestPayment).Times(0);
+  EXPECT_EQ(domain::ErrorCode::OUT_OF_STOCK,
+            emoney_use_case.trySelectAndRequestPayment({2}).error());
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
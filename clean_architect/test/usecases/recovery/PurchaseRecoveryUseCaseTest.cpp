@@ -0,0 +1,426 @@
+/**
+ * @file PurchaseRecoveryUseCaseTest.cpp
+ * @brief 購入ジャーナルの記録と PurchaseRecoveryUseCase のテスト
+ *
+ * テスト方針:
+ * - 現金購入の各手順がジャーナルに記録され、完了で決着する
+ * - 排出済みの購入は前進（在庫減算・引き落とし・履歴保存）する
+ * - 排出前の購入は後退し、反映済みの在庫減算だけを戻す
+ * - 排出の後に失敗した購入は済んだ手順を戻さずに残し、復旧で前進させる
+ * - 復旧は決着を記録するため、2回目の復旧では何もしない
+ * - 履歴に保存済みの購入（セッションIDで照合）は二重に保存しない
+ * - チェックポイントは定期保存だけで、購入ごとには保存しない
+ * - チェックポイントの後の購入は、完了済みのものも含めて再適用し、
+ *   決着していない購入をその後に前進させる
+ */
+
+#include "usecases/PurchaseRecoveryUseCase.hpp"
+#include "domain/common/Money.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedCoinMech.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedDispenser.hpp"
+#include "interface_adapters/gateways/adapters/SimulatedPaymentGateway.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "usecases/VendingMachineApplication.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+class InMemoryPurchaseJournal : public domain::IPurchaseJournal {
+public:
+  void append(const domain::PurchaseJournalEntry &entry) override {
+    entries.push_back(entry);
+  }
+  std::vector<domain::PurchaseJournalEntry> readAll() const override {
+    return entries;
+  }
+  void discardSettled() override { ++discard_count; }
+
+  std::vector<domain::PurchaseJournalEntry> entries;
+  int discard_count = 0;
+};
+
+// 保存の失敗を注入できる履歴
+class FlakyTransactionHistoryRepository
+    : public interface_adapters::InMemoryTransactionHistoryRepository {
+public:
+  void save(const domain::TransactionRecord &record) override {
+    if (fail_saves) {
+      throw std::runtime_error("history is unavailable");
+    }
+    InMemoryTransactionHistoryRepository::save(record);
+  }
+
+  bool fail_saves = false;
+};
+
+class InMemoryMachineStateRepository : public domain::IMachineStateRepository {
+public:
+  void save(const domain::MachineState &state) override {
+    state_ = state;
+    ++save_count;
+  }
+  std::optional<domain::MachineState> load() const override { return state_; }
+
+  int save_count = 0;
+
+private:
+  std::optional<domain::MachineState> state_;
+};
+
+class PurchaseRecoveryUseCaseTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    app.initializeInventory();
+    app.enablePurchaseJournal(journal);
+  }
+
+  interface_adapters::SimulatedCoinMech coin_mech;
+  interface_adapters::SimulatedDispenser dispenser;
+  interface_adapters::SimulatedPaymentGateway payment_gateway;
+  FlakyTransactionHistoryRepository history;
+  InMemoryPurchaseJournal journal;
+
+  VendingMachineApplication app{coin_mech, dispenser, payment_gateway,
+                                history};
+
+  // スロット1（コーラ 120円、在庫10）を 500円で買いかけた記録
+  void journalUntil(domain::PurchaseStep last_step) {
+    domain::PurchaseJournalEntry entry{7, domain::PurchaseStep::STARTED, 1,
+                                       120, 10, 500, 0};
+    for (auto step = domain::PurchaseStep::STARTED;;
+         step = static_cast<domain::PurchaseStep>(
+             static_cast<int>(step) + 1)) {
+      entry.step = step;
+      if (step >= domain::PurchaseStep::PAYMENT_CAPTURED) {
+        entry.change = 380;
+      }
+      journal.append(entry);
+      if (step == last_step) {
+        break;
+      }
+    }
+  }
+
+  int stockOf(int slot_id) const {
+    return app.getInventory()
+        .findSlot(domain::SlotId(slot_id))
+        ->getStock()
+        .getValue();
+  }
+};
+
+TEST_F(PurchaseRecoveryUseCaseTest, PurchaseRecordsEachStepUntilCommitted) {
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  app.getPurchaseWithCashUseCase().selectAndPurchase(dto::PurchaseRequest{2});
+
+  std::vector<domain::PurchaseStep> steps;
+  for (const auto &entry : journal.entries) {
+    steps.push_back(entry.step);
+    EXPECT_EQ(entry.purchase_id, 1u);
+    EXPECT_EQ(entry.slot_id, 2);
+    EXPECT_EQ(entry.stock_before, 10);
+    EXPECT_EQ(entry.balance_before, 500);
+  }
+  EXPECT_EQ(steps, (std::vector<domain::PurchaseStep>{
+                       domain::PurchaseStep::STARTED,
+                       domain::PurchaseStep::STOCK_RESERVED,
+                       domain::PurchaseStep::PRODUCT_DISPENSED,
+                       domain::PurchaseStep::PAYMENT_CAPTURED,
+                       domain::PurchaseStep::CHANGE_RETURNED,
+                       domain::PurchaseStep::COMMITTED}));
+  EXPECT_EQ(journal.entries.back().change, 350);
+  EXPECT_EQ(journal.discard_count, 1);
+  EXPECT_TRUE(app.recoverPurchases().purchases.empty());
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, DispensedPurchaseRollsForward) {
+  // 購入前の状態が復元され、排出まで済んでいた
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  journalUntil(domain::PurchaseStep::PRODUCT_DISPENSED);
+
+  auto report = app.recoverPurchases();
+
+  ASSERT_EQ(report.purchases.size(), 1u);
+  EXPECT_EQ(report.rolled_forward, 1u);
+  EXPECT_EQ(report.purchases[0].purchase_id, 7u);
+  EXPECT_EQ(report.purchases[0].last_step,
+            domain::PurchaseStep::PRODUCT_DISPENSED);
+  EXPECT_EQ(stockOf(1), 9);
+  // お釣りは未返却なので残高に残る
+  EXPECT_EQ(app.getWallet().getBalance(), domain::Money(380));
+  EXPECT_EQ(history.getAll().size(), 1u);
+  EXPECT_EQ(journal.entries.back().step, domain::PurchaseStep::COMMITTED);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, ReturnedChangeIsNotLeftInBalance) {
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  journalUntil(domain::PurchaseStep::CHANGE_RETURNED);
+
+  app.recoverPurchases();
+
+  EXPECT_EQ(stockOf(1), 9);
+  EXPECT_EQ(app.getWallet().getBalance(), domain::Money(0));
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, ReservedStockRollsBack) {
+  // 購入前の状態が復元され、排出前に停止していた
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  journalUntil(domain::PurchaseStep::STOCK_RESERVED);
+
+  auto report = app.recoverPurchases();
+
+  EXPECT_EQ(report.rolled_back, 1u);
+  EXPECT_EQ(report.rolled_forward, 0u);
+  EXPECT_EQ(stockOf(1), 10); // 減算前のままなので変更しない
+  EXPECT_EQ(app.getWallet().getBalance(), domain::Money(500));
+  EXPECT_EQ(journal.entries.back().step, domain::PurchaseStep::ABORTED);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, RollBackRevertsAppliedReservation) {
+  journalUntil(domain::PurchaseStep::STOCK_RESERVED);
+  // 減算だけが反映された状態
+  journal.entries.back().stock_before = 11;
+
+  app.recoverPurchases();
+
+  EXPECT_EQ(stockOf(1), 11);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, RecoveryIsIdempotent) {
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  journalUntil(domain::PurchaseStep::PAYMENT_CAPTURED);
+
+  EXPECT_EQ(app.recoverPurchases().rolled_forward, 1u);
+  EXPECT_TRUE(app.recoverPurchases().purchases.empty());
+  EXPECT_EQ(stockOf(1), 9);
+  EXPECT_EQ(history.getAll().size(), 1u);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, SavedHistoryIsNotDuplicated) {
+  auto &usecase = app.getPurchaseWithCashUseCase();
+  usecase.startSession();
+  usecase.insertCash(dto::InsertCashRequest{500});
+  usecase.selectAndPurchase(dto::PurchaseRequest{2});
+  // 履歴の保存の後、完了の記録の前に停止した
+  ASSERT_EQ(journal.entries.back().step, domain::PurchaseStep::COMMITTED);
+  journal.entries.pop_back();
+  int session_id = journal.entries.back().session_id;
+  ASSERT_GT(session_id, 0);
+
+  auto report = app.recoverPurchases();
+
+  EXPECT_EQ(report.rolled_forward, 1u);
+  auto records = history.getAll();
+  ASSERT_EQ(records.size(), 1u);
+  EXPECT_EQ(records[0].getSessionId(), domain::SessionId(session_id));
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, RecoveredHistoryCarriesSessionId) {
+  app.getPurchaseWithCashUseCase().startSession();
+  app.getPurchaseWithCashUseCase().insertCash(dto::InsertCashRequest{500});
+  journalUntil(domain::PurchaseStep::PAYMENT_CAPTURED);
+  for (auto &entry : journal.entries) {
+    entry.session_id = 9000;
+  }
+  // 同じセッションIDでも、スロットが異なる取引は別の購入
+  history.save(domain::TransactionRecord(domain::SalesId(1), domain::SlotId(2),
+                                         domain::Price(120),
+                                         domain::PaymentMethodType::CASH)
+                   .withSessionId(domain::SessionId(9000)));
+
+  app.recoverPurchases();
+
+  auto records = history.getAll();
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].getSessionId(), domain::SessionId(9000));
+  EXPECT_EQ(records[1].getSessionId(), domain::SessionId(9000));
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, SessionIdsContinueFromJournal) {
+  journal.append({50, domain::PurchaseStep::STARTED, 1, 120, 10, 500, 0,
+                  50000});
+  journal.append({50, domain::PurchaseStep::COMMITTED, 1, 120, 10, 500, 380,
+                  50000});
+
+  VendingMachineApplication restarted{coin_mech, dispenser, payment_gateway,
+                                      history};
+  restarted.initializeInventory();
+  restarted.enablePurchaseJournal(journal);
+  auto &usecase = restarted.getPurchaseWithCashUseCase();
+  usecase.startSession();
+  usecase.insertCash(dto::InsertCashRequest{500});
+  usecase.selectAndPurchase(dto::PurchaseRequest{1});
+
+  EXPECT_EQ(journal.entries.back().purchase_id, 51u);
+  EXPECT_GT(journal.entries.back().session_id, 50000);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, CheckpointOlderThanInFlightPurchase) {
+  InMemoryMachineStateRepository checkpoints;
+  app.enableCheckpoints(checkpoints, std::chrono::hours(1));
+  auto &usecase = app.getPurchaseWithCashUseCase();
+  usecase.startSession();
+  usecase.insertCash(dto::InsertCashRequest{500});
+  usecase.selectAndPurchase(dto::PurchaseRequest{1});
+  app.saveCheckpoint(); // 定期保存（在庫9、通番1まで反映）
+  EXPECT_EQ(journal.discard_count, 1);
+  for (int i = 0; i < 2; ++i) {
+    usecase.startSession();
+    usecase.insertCash(dto::InsertCashRequest{500});
+    usecase.selectAndPurchase(dto::PurchaseRequest{1});
+  }
+  // 購入ごとには保存も破棄もしない
+  EXPECT_EQ(checkpoints.save_count, 1);
+  EXPECT_EQ(journal.discard_count, 1);
+
+  // 4件目（開始時の在庫7）が排出の後に停止した。
+  // 現金は定期保存の後に投入されている
+  usecase.startSession();
+  usecase.insertCash(dto::InsertCashRequest{500});
+  journal.append({4, domain::PurchaseStep::STARTED, 1, 120, 7, 500, 0});
+  journal.append(
+      {4, domain::PurchaseStep::PRODUCT_DISPENSED, 1, 120, 7, 500, 0});
+
+  VendingMachineApplication restarted{coin_mech, dispenser, payment_gateway,
+                                      history};
+  restarted.enableCheckpoints(checkpoints, std::chrono::hours(1));
+  restarted.restoreCheckpoint();
+  restarted.enablePurchaseJournal(journal);
+  auto report = restarted.recoverPurchases();
+
+  EXPECT_EQ(report.replayed, 2u);
+  EXPECT_EQ(report.rolled_forward, 1u);
+  EXPECT_EQ(restarted.getInventory()
+                .findSlot(domain::SlotId(1))
+                ->getStock()
+                .getValue(),
+            6);
+  // お釣りは未返却なので残高に残る
+  EXPECT_EQ(restarted.getWallet().getBalance(), domain::Money(380));
+  EXPECT_EQ(history.getAll().size(), 4u);
+
+  // 続く購入は反映済みの通番の続きから採番する
+  restarted.saveCheckpoint();
+  EXPECT_EQ(checkpoints.load()->journal_position, 4u);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, AbortedPurchaseAfterCheckpointIsSkipped) {
+  InMemoryMachineStateRepository checkpoints;
+  app.enableCheckpoints(checkpoints, std::chrono::hours(1));
+  app.saveCheckpoint(); // 在庫10、残高0
+  journal.append({1, domain::PurchaseStep::STARTED, 1, 120, 10, 500, 0});
+  journal.append({1, domain::PurchaseStep::ABORTED, 1, 120, 10, 500, 0});
+  journal.append({2, domain::PurchaseStep::STARTED, 1, 120, 10, 500, 0});
+  journal.append(
+      {2, domain::PurchaseStep::STOCK_RESERVED, 1, 120, 10, 500, 0});
+
+  VendingMachineApplication restarted{coin_mech, dispenser, payment_gateway,
+                                      history};
+  restarted.enableCheckpoints(checkpoints, std::chrono::hours(1));
+  restarted.restoreCheckpoint();
+  restarted.enablePurchaseJournal(journal);
+  auto report = restarted.recoverPurchases();
+
+  // どちらも保存した状態には反映されていないため、変更しない
+  EXPECT_EQ(report.replayed, 0u);
+  EXPECT_EQ(report.rolled_back, 1u);
+  EXPECT_EQ(restarted.getInventory()
+                .findSlot(domain::SlotId(1))
+                ->getStock()
+                .getValue(),
+            10);
+  EXPECT_TRUE(history.getAll().empty());
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, FailureAfterPaymentIsLeftUnsettled) {
+  InMemoryMachineStateRepository checkpoints;
+  app.enableCheckpoints(checkpoints, std::chrono::hours(1));
+  auto &usecase = app.getPurchaseWithCashUseCase();
+  usecase.startSession();
+  usecase.insertCash(dto::InsertCashRequest{500});
+  history.fail_saves = true;
+
+  EXPECT_THROW(usecase.selectAndPurchase(dto::PurchaseRequest{1}),
+               std::runtime_error);
+
+  // 排出・引き落とし・お釣りの返却は済んでいるため戻さない
+  EXPECT_EQ(stockOf(1), 9);
+  EXPECT_EQ(app.getWallet().getBalance(), domain::Money(0));
+  EXPECT_EQ(journal.entries.back().step,
+            domain::PurchaseStep::CHANGE_RETURNED);
+  EXPECT_TRUE(usecase.hasUnsettledPurchase());
+
+  // 保存した状態には反映されるが、ジャーナルは破棄しない
+  app.saveCheckpoint();
+  EXPECT_EQ(journal.discard_count, 0);
+
+  history.fail_saves = false;
+  VendingMachineApplication restarted{coin_mech, dispenser, payment_gateway,
+                                      history};
+  restarted.enableCheckpoints(checkpoints, std::chrono::hours(1));
+  restarted.restoreCheckpoint();
+  restarted.enablePurchaseJournal(journal);
+  auto report = restarted.recoverPurchases();
+
+  // 状態は反映済みなので履歴だけを保存する
+  EXPECT_EQ(report.rolled_forward, 1u);
+  EXPECT_EQ(restarted.getInventory()
+                .findSlot(domain::SlotId(1))
+                ->getStock()
+                .getValue(),
+            9);
+  EXPECT_EQ(restarted.getWallet().getBalance(), domain::Money(0));
+  EXPECT_EQ(history.getAll().size(), 1u);
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, FailureBeforeDispenseIsAborted) {
+  class JammedDispenser : public domain::IDispenser {
+  public:
+    bool canDispense(const domain::ProductInfo &) const override {
+      return true;
+    }
+    void dispense(const domain::ProductInfo &) override {
+      throw std::runtime_error("jammed");
+    }
+  } jammed;
+  VendingMachineApplication other{coin_mech, jammed, payment_gateway,
+                                  history};
+  other.initializeInventory();
+  other.enablePurchaseJournal(journal);
+  auto &usecase = other.getPurchaseWithCashUseCase();
+  usecase.startSession();
+  usecase.insertCash(dto::InsertCashRequest{500});
+
+  EXPECT_THROW(usecase.selectAndPurchase(dto::PurchaseRequest{1}),
+               std::runtime_error);
+
+  EXPECT_EQ(other.getInventory()
+                .findSlot(domain::SlotId(1))
+                ->getStock()
+                .getValue(),
+            10);
+  EXPECT_EQ(journal.entries.back().step, domain::PurchaseStep::ABORTED);
+  EXPECT_FALSE(usecase.hasUnsettledPurchase());
+}
+
+TEST_F(PurchaseRecoveryUseCaseTest, RecoveryRequiresJournal) {
+  VendingMachineApplication other{coin_mech, dispenser, payment_gateway,
+                                  history};
+  EXPECT_THROW(other.recoverPurchases(), std::logic_error);
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
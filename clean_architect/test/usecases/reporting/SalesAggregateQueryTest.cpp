@@ -0,0 +1,88 @@
+/**
+ * @file SalesAggregateQueryTest.cpp
+ * @brief SalesReportingUseCase の時間帯別集計・近似集計の取得のユニットテスト
+ *
+ * テスト方針:
+ * - 履歴のリスナーとして登録した集計の値を、履歴を走査せずに返す
+ * - 集計を設定していない場合は例外で知らせる
+ */
+
+#include "usecases/SalesReportingUseCase.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include "interface_adapters/gateways/repositories/NotifyingTransactionHistoryRepository.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+class SalesAggregateQueryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    history_.addListener(rollup_);
+    history_.addListener(sketches_);
+  }
+
+  void save(int slot_id, int session_id, std::chrono::minutes offset) {
+    history_.save(domain::TransactionRecord(
+                      domain::SalesId(1), domain::SlotId(slot_id),
+                      domain::Price(120), domain::PaymentMethodType::CASH,
+                      day_ + offset)
+                      .withSessionId(domain::SessionId(session_id)));
+  }
+
+  // 2日目の 0:00（UTC）
+  const std::chrono::system_clock::time_point day_ =
+      std::chrono::system_clock::time_point(std::chrono::hours(24));
+  interface_adapters::InMemoryTransactionHistoryRepository store_;
+  interface_adapters::NotifyingTransactionHistoryRepository history_{store_};
+  domain::SalesRollup rollup_;
+  domain::SalesSketches sketches_;
+};
+
+TEST_F(SalesAggregateQueryTest, ReturnsValuesOfListeners) {
+  SalesReportingUseCase reporting(history_);
+  reporting.setRollup(&rollup_);
+  reporting.setSketches(&sketches_);
+  save(1, 1, std::chrono::minutes(0));
+  save(2, 2, std::chrono::minutes(1));
+  save(2, 3, std::chrono::minutes(70));
+
+  auto buckets = reporting.generateRollupReport(
+      domain::RollupGranularity::HOURLY, day_, day_ + std::chrono::hours(2));
+  ASSERT_EQ(buckets.size(), 3u);
+  EXPECT_EQ(buckets[1].slot_id, domain::SlotId(2));
+  EXPECT_EQ(buckets[2].start, day_ + std::chrono::hours(1));
+  EXPECT_EQ(buckets[2].total_revenue.getRawValue(), 120);
+
+  auto top = reporting.getTopSellingSlots(1);
+  ASSERT_EQ(top.size(), 1u);
+  EXPECT_EQ(top[0].key, 2);
+  EXPECT_EQ(top[0].count, 2u);
+  EXPECT_EQ(reporting.estimateDistinctSalesOn(day_), 3u);
+}
+
+TEST_F(SalesAggregateQueryTest, RequiresAggregates) {
+  SalesReportingUseCase reporting(history_);
+  EXPECT_THROW(reporting.generateRollupReport(
+                   domain::RollupGranularity::DAILY, day_, day_),
+               std::logic_error);
+  EXPECT_THROW(reporting.getTopSellingSlots(1), std::logic_error);
+  EXPECT_THROW(reporting.estimateDistinctSalesOn(day_), std::logic_error);
+
+  reporting.setRollup(&rollup_);
+  EXPECT_TRUE(reporting
+                  .generateRollupReport(domain::RollupGranularity::DAILY,
+                                        day_, day_)
+                  .empty());
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
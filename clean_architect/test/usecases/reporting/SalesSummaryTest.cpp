@@ -0,0 +1,241 @@
+/**
+ * @file SalesSummaryTest.cpp
+ * @brief SalesReportingUseCase の一括集計のユニットテスト
+ *
+ * テスト方針:
+ * - 履歴の走査は1回だけで、getAll() によるコピーを伴わない
+ * - スロット別・決済方法別・合計がまとめて得られる
+ * - 個別のレポートと一括集計の結果が一致する
+ * - 並列集計の結果はスレッド数によらず逐次集計と一致する
+ * - 履歴の世代が変わらない間はキャッシュを返し、再走査しない
+ * - スロット番号の大きさによらず、現れたスロットの数だけで集計する
+ */
+
+#include "usecases/SalesReportingUseCase.hpp"
+#include "domain/common/Price.hpp"
+#include "domain/inventory/SlotId.hpp"
+#include "domain/sales/SalesId.hpp"
+#include "domain/sales/TransactionRecord.hpp"
+#include "interface_adapters/gateways/repositories/InMemoryTransactionHistoryRepository.hpp"
+#include <atomic>
+#include <gtest/gtest.h>
+
+namespace vending_machine {
+namespace usecases {
+namespace test {
+
+/**
+ * @brief 走査方法ごとの呼び出し回数を数えるリポジトリ
+ */
+class CountingTransactionHistoryRepository
+    : public interface_adapters::InMemoryTransactionHistoryRepository {
+public:
+  std::vector<domain::TransactionRecord> getAll() const override {
+    ++get_all_calls;
+    return InMemoryTransactionHistoryRepository::getAll();
+  }
+
+  void forEach(
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override {
+    ++for_each_calls;
+    InMemoryTransactionHistoryRepository::forEach(visitor);
+  }
+
+  void forEachInPartition(
+      std::size_t partition, std::size_t partition_count,
+      const std::function<void(const domain::TransactionRecord &)> &visitor)
+      const override {
+    ++partition_calls;
+    InMemoryTransactionHistoryRepository::forEachInPartition(
+        partition, partition_count, visitor);
+  }
+
+  mutable int get_all_calls = 0;
+  mutable int for_each_calls = 0;
+  mutable std::atomic<int> partition_calls{0};
+};
+
+class SalesSummaryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    save(1, 3, 120, domain::PaymentMethodType::CASH);
+    save(2, 1, 150, domain::PaymentMethodType::EMONEY);
+    save(3, 3, 120, domain::PaymentMethodType::EMONEY);
+    save(4, 1, 150, domain::PaymentMethodType::CASH);
+    save(5, 3, 120, domain::PaymentMethodType::CASH);
+  }
+
+  void save(int sales_id, int slot_id, int price,
+            domain::PaymentMethodType method) {
+    repository.save(domain::TransactionRecord(domain::SalesId(sales_id),
+                                              domain::SlotId(slot_id),
+                                              domain::Price(price), method));
+  }
+
+  CountingTransactionHistoryRepository repository;
+  SalesReportingUseCase use_case{repository};
+};
+
+TEST_F(SalesSummaryTest, ScansHistoryOnceWithoutCopy) {
+  use_case.generateSalesSummary();
+
+  EXPECT_EQ(repository.for_each_calls, 1);
+  EXPECT_EQ(repository.get_all_calls, 0);
+}
+
+TEST_F(SalesSummaryTest, AggregatesAllReportsTogether) {
+  auto summary = use_case.generateSalesSummary();
+
+  EXPECT_EQ(summary.transaction_count, 5);
+  EXPECT_EQ(summary.total_revenue.getRawValue(), 660);
+
+  // スロット番号の昇順
+  ASSERT_EQ(summary.slot_reports.size(), 2u);
+  EXPECT_EQ(summary.slot_reports[0].slot_id, domain::SlotId(1));
+  EXPECT_EQ(summary.slot_reports[0].transaction_count, 2);
+  EXPECT_EQ(summary.slot_reports[0].total_revenue.getRawValue(), 300);
+  EXPECT_EQ(summary.slot_reports[1].slot_id, domain::SlotId(3));
+  EXPECT_EQ(summary.slot_reports[1].transaction_count, 3);
+  EXPECT_EQ(summary.slot_reports[1].total_revenue.getRawValue(), 360);
+
+  // 決済方法の定義順
+  ASSERT_EQ(summary.payment_reports.size(), 2u);
+  EXPECT_EQ(summary.payment_reports[0].payment_method,
+            domain::PaymentMethodType::CASH);
+  EXPECT_EQ(summary.payment_reports[0].transaction_count, 3);
+  EXPECT_EQ(summary.payment_reports[0].total_revenue.getRawValue(), 390);
+  EXPECT_EQ(summary.payment_reports[1].payment_method,
+            domain::PaymentMethodType::EMONEY);
+  EXPECT_EQ(summary.payment_reports[1].transaction_count, 2);
+  EXPECT_EQ(summary.payment_reports[1].total_revenue.getRawValue(), 270);
+}
+
+TEST_F(SalesSummaryTest, IndividualReportsMatchSummary) {
+  auto summary = use_case.generateSalesSummary();
+
+  auto slot_reports = use_case.generateSlotSalesReport();
+  auto payment_reports = use_case.generatePaymentMethodReport();
+
+  ASSERT_EQ(slot_reports.size(), summary.slot_reports.size());
+  ASSERT_EQ(payment_reports.size(), summary.payment_reports.size());
+  EXPECT_EQ(use_case.getTotalTransactionCount(), summary.transaction_count);
+  EXPECT_EQ(use_case.getRevenueBySlot(domain::SlotId(3)),
+            summary.slot_reports[1].total_revenue);
+  EXPECT_EQ(repository.get_all_calls, 0);
+}
+
+void expectSameSummary(const SalesSummary &expected,
+                       const SalesSummary &actual) {
+  EXPECT_EQ(actual.transaction_count, expected.transaction_count);
+  EXPECT_EQ(actual.total_revenue, expected.total_revenue);
+  ASSERT_EQ(actual.slot_reports.size(), expected.slot_reports.size());
+  for (std::size_t i = 0; i < expected.slot_reports.size(); ++i) {
+    EXPECT_EQ(actual.slot_reports[i].slot_id, expected.slot_reports[i].slot_id);
+    EXPECT_EQ(actual.slot_reports[i].transaction_count,
+              expected.slot_reports[i].transaction_count);
+    EXPECT_EQ(actual.slot_reports[i].total_revenue,
+              expected.slot_reports[i].total_revenue);
+  }
+  ASSERT_EQ(actual.payment_reports.size(), expected.payment_reports.size());
+  for (std::size_t i = 0; i < expected.payment_reports.size(); ++i) {
+    EXPECT_EQ(actual.payment_reports[i].payment_method,
+              expected.payment_reports[i].payment_method);
+    EXPECT_EQ(actual.payment_reports[i].transaction_count,
+              expected.payment_reports[i].transaction_count);
+    EXPECT_EQ(actual.payment_reports[i].total_revenue,
+              expected.payment_reports[i].total_revenue);
+  }
+}
+
+TEST_F(SalesSummaryTest, ParallelSummaryMatchesSequential) {
+  for (int i = 0; i < 10000; ++i) {
+    save(100 + i, 1 + i % 12, 100 + (i % 5) * 10,
+         i % 3 == 0 ? domain::PaymentMethodType::EMONEY
+                    : domain::PaymentMethodType::CASH);
+  }
+  auto sequential = use_case.generateSalesSummary();
+
+  for (std::size_t threads : {2u, 3u, 8u}) {
+    SalesReportingUseCase parallel_use_case{repository};
+    repository.partition_calls = 0;
+    expectSameSummary(sequential,
+                      parallel_use_case.generateSalesSummary(threads));
+    EXPECT_EQ(repository.partition_calls, static_cast<int>(threads));
+  }
+  // 0 はハードウェアの並列度を使う
+  SalesReportingUseCase default_use_case{repository};
+  expectSameSummary(sequential, default_use_case.generateSalesSummary(0));
+}
+
+TEST_F(SalesSummaryTest, ParallelSummaryHandlesMorePartitionsThanRecords) {
+  auto sequential = use_case.generateSalesSummary();
+
+  SalesReportingUseCase parallel_use_case{repository};
+  expectSameSummary(sequential, parallel_use_case.generateSalesSummary(16));
+}
+
+TEST_F(SalesSummaryTest, ServesCachedSummaryWhileHistoryUnchanged) {
+  const auto *first = &use_case.generateSalesSummary();
+  const auto *second = &use_case.generateSalesSummary();
+  use_case.generateSlotSalesReport();
+  use_case.getTotalTransactionCount();
+  use_case.getRevenueBySlot(domain::SlotId(1));
+  use_case.generateSalesSummary(4);
+
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(repository.for_each_calls, 1);
+  EXPECT_EQ(repository.partition_calls, 0);
+}
+
+TEST_F(SalesSummaryTest, SaveInvalidatesCachedSummary) {
+  use_case.generateSalesSummary();
+
+  save(6, 2, 200, domain::PaymentMethodType::CASH);
+  const auto &summary = use_case.generateSalesSummary();
+
+  EXPECT_EQ(repository.for_each_calls, 2);
+  EXPECT_EQ(summary.transaction_count, 6);
+  EXPECT_EQ(use_case.getRevenueBySlot(domain::SlotId(2)).getRawValue(), 200);
+  EXPECT_EQ(use_case.getRevenueBySlot(domain::SlotId(9)).getRawValue(), 0);
+}
+
+TEST_F(SalesSummaryTest, ClearInvalidatesCachedSummary) {
+  use_case.generateSalesSummary();
+
+  repository.clear();
+
+  EXPECT_EQ(use_case.generateSalesSummary().transaction_count, 0);
+  EXPECT_EQ(repository.for_each_calls, 2);
+}
+
+TEST_F(SalesSummaryTest, SparseSlotIdsAreReportedInOrder) {
+  // 番号の値で配列を確保すると 16GB を超える
+  save(6, 2000000000, 300, domain::PaymentMethodType::CASH);
+  save(7, 1000000000, 200, domain::PaymentMethodType::EMONEY);
+
+  const auto &summary = use_case.generateSalesSummary(4);
+
+  ASSERT_EQ(summary.slot_reports.size(), 4u);
+  EXPECT_EQ(summary.slot_reports[0].slot_id, domain::SlotId(1));
+  EXPECT_EQ(summary.slot_reports[1].slot_id, domain::SlotId(3));
+  EXPECT_EQ(summary.slot_reports[2].slot_id, domain::SlotId(1000000000));
+  EXPECT_EQ(summary.slot_reports[3].slot_id, domain::SlotId(2000000000));
+  EXPECT_EQ(summary.slot_reports[3].total_revenue.getRawValue(), 300);
+  EXPECT_EQ(summary.transaction_count, 7);
+}
+
+TEST_F(SalesSummaryTest, EmptyHistoryYieldsEmptySummary) {
+  repository.clear();
+
+  auto summary = use_case.generateSalesSummary();
+
+  EXPECT_EQ(summary.transaction_count, 0);
+  EXPECT_EQ(summary.total_revenue.getRawValue(), 0);
+  EXPECT_TRUE(summary.slot_reports.empty());
+  EXPECT_TRUE(summary.payment_reports.empty());
+}
+
+} // namespace test
+} // namespace usecases
+} // namespace vending_machine
@@ -0,0 +1,618 @@
+#include "PlanogramLoader.hpp"
+#include "domain/Money.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace vending_machine::adapters::inbound {
+
+namespace {
+
+constexpr std::size_t kIncomplete = static_cast<std::size_t>(-1);
+
+enum Field : std::size_t {
+  kMachineId,
+  kSlotId,
+  kName,
+  kPrice,
+  kStock,
+  kFieldCount
+};
+
+constexpr std::array<std::string_view, kFieldCount> kFieldNames = {
+    "machine_id", "slot_id", "name", "price", "stock"};
+
+// 必須の項目は name 以降（machine_id・slot_id は省略可）
+constexpr std::size_t kFirstRequired = kName;
+
+// 1行分の項目（入力バッファ上の範囲を指す）
+struct RawRow {
+  std::array<std::string_view, kFieldCount> values{};
+  std::array<bool, kFieldCount> present{};
+};
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string_view trim(std::string_view text) {
+  while (!text.empty() && isSpace(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && isSpace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+std::size_t fieldIndex(std::string_view name) {
+  auto it = std::find(kFieldNames.begin(), kFieldNames.end(), name);
+  return static_cast<std::size_t>(it - kFieldNames.begin());
+}
+
+bool parseInt(std::string_view text, int &out) {
+  text = trim(text);
+  auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+  return !text.empty() && result.ec == std::errc() &&
+         result.ptr == text.data() + text.size();
+}
+
+void appendProblem(std::string &message, std::string_view field,
+                   std::string_view value, std::string_view problem) {
+  if (!message.empty()) {
+    message += "; ";
+  }
+  message.append(field).append(" '").append(value).append("' ");
+  message.append(problem);
+}
+
+// 検証して visitor へ渡す（形式によらず共通）。
+// Money・Inventory と同じ条件を例外を使わずに確かめ、不正な項目を
+// 1つのメッセージにまとめて報告する。
+class RowSink {
+public:
+  RowSink(const PlanogramLoader::ProductVisitor &visitor,
+          std::string_view machineId, PlanogramLoadResult &result,
+          std::string &nameBuffer)
+      : visitor_(visitor), machineId_(machineId), result_(result),
+        nameBuffer_(nameBuffer) {}
+
+  void accept(const RawRow &row, std::size_t line) {
+    std::string_view machineId = trim(row.values[kMachineId]);
+    if (!machineId_.empty() && machineId != machineId_) {
+      return;
+    }
+    ++result_.rowsRead;
+
+    std::string problems;
+    for (std::size_t field = kFirstRequired; field < kFieldCount; ++field) {
+      if (!row.present[field]) {
+        problems += problems.empty() ? "missing " : "; missing ";
+        problems.append(kFieldNames[field]);
+      }
+    }
+    if (!problems.empty()) {
+      error(line, std::move(problems));
+      return;
+    }
+
+    int price = 0;
+    int stock = 0;
+    std::string_view name = trim(row.values[kName]);
+    if (name.empty()) {
+      appendProblem(problems, "name", name, "is empty");
+    }
+    if (!parseInt(row.values[kPrice], price) || price < 0) {
+      appendProblem(problems, "price", row.values[kPrice],
+                    "is not a non-negative integer");
+    }
+    if (!parseInt(row.values[kStock], stock) || stock < 0) {
+      appendProblem(problems, "stock", row.values[kStock],
+                    "is not a non-negative integer");
+    }
+    if (!problems.empty()) {
+      error(line, std::move(problems));
+      return;
+    }
+
+    // 検証済みなので Money の生成は失敗しない
+    nameBuffer_.assign(name.data(), name.size());
+    domain::Product product(nameBuffer_, domain::Money(price));
+    try {
+      visitor_(machineId, product, stock);
+      ++result_.productsLoaded;
+    } catch (const std::invalid_argument &e) {
+      error(line, e.what());
+    }
+  }
+
+  void error(std::size_t line, std::string message) {
+    result_.errors.push_back({line, std::move(message)});
+  }
+
+private:
+  const PlanogramLoader::ProductVisitor &visitor_;
+  std::string_view machineId_; // 空でなければこの機械の行だけを扱う
+  PlanogramLoadResult &result_;
+  std::string &nameBuffer_;
+};
+
+// ストリームをバッファへ読み込み、区切り単位ごとに scanner へ渡す。
+// 区切りの途中でバッファの末尾に達した場合は、未処理部分を先頭へ
+// 詰めてから続きを読み込む。1単位がバッファに収まらない場合は中断する。
+template <typename Scanner>
+void scanStream(std::istream &in, std::vector<char> &buffer, Scanner &scanner,
+                RowSink &sink) {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  std::size_t line = 1;
+  bool eof = false;
+
+  while (true) {
+    char *data = buffer.data() + begin;
+    std::size_t length = scanner.findEnd(data, end - begin);
+    if (length == kIncomplete || (length == 0 && !eof)) {
+      if (eof) {
+        // 末尾の改行が無い最後の単位
+        if (!scanner.onRecord(data, data + (end - begin), line, false)) {
+          return;
+        }
+        break;
+      }
+      if (begin == 0 && end == buffer.size()) {
+        sink.error(line, "Record exceeds the loader buffer size");
+        return;
+      }
+      std::memmove(buffer.data(), data, end - begin);
+      end -= begin;
+      begin = 0;
+      in.read(buffer.data() + end,
+              static_cast<std::streamsize>(buffer.size() - end));
+      if (in.bad()) {
+        throw std::runtime_error("Failed to read planogram");
+      }
+      end += static_cast<std::size_t>(in.gcount());
+      eof = in.eof();
+      continue;
+    }
+    if (length == 0) {
+      break;
+    }
+
+    // 項目の取り出しはバッファを書き換えるので、行数は先に数える
+    std::size_t newlines =
+        static_cast<std::size_t>(std::count(data, data + length, '\n'));
+    if (!scanner.onRecord(data, data + length, line, true)) {
+      return;
+    }
+    line += newlines;
+    begin += length;
+  }
+  scanner.finish(line);
+}
+
+// CSV を1行ずつ区切る
+class CsvScanner {
+public:
+  explicit CsvScanner(RowSink &sink) : sink_(sink) {}
+
+  std::size_t findEnd(const char *data, std::size_t size) const {
+    bool quoted = false;
+    for (std::size_t i = 0; i < size; ++i) {
+      if (data[i] == '"') {
+        quoted = !quoted;
+      } else if (data[i] == '\n' && !quoted) {
+        return i + 1;
+      }
+    }
+    return size == 0 ? 0 : kIncomplete;
+  }
+
+  bool onRecord(char *begin, char *end, std::size_t line, bool) {
+    while (end != begin && (end[-1] == '\n' || end[-1] == '\r')) {
+      --end;
+    }
+    if (trim(std::string_view(begin, end - begin)).empty()) {
+      return true;
+    }
+
+    std::size_t count = 0;
+    if (!split(begin, end, count)) {
+      sink_.error(line, "Malformed CSV row");
+      return true;
+    }
+    if (!hasHeader_) {
+      return readHeader(count, line);
+    }
+    if (count != columnCount_) {
+      sink_.error(line, "Expected " + std::to_string(columnCount_) +
+                            " fields but found " + std::to_string(count));
+      return true;
+    }
+
+    RawRow row;
+    for (std::size_t column = 0; column < count; ++column) {
+      std::size_t field = columnFields_[column];
+      if (field < kFieldCount) {
+        row.values[field] = fields_[column];
+        row.present[field] = true;
+      }
+    }
+    sink_.accept(row, line);
+    return true;
+  }
+
+  void finish(std::size_t line) {
+    if (!hasHeader_) {
+      sink_.error(line, "Missing CSV header");
+    }
+  }
+
+private:
+  static constexpr std::size_t kMaxColumns = 16;
+
+  // 項目に分割する。クォートは取り除き、"" はその場で " に詰める
+  bool split(char *p, char *end, std::size_t &count) {
+    while (true) {
+      if (count == kMaxColumns) {
+        return false;
+      }
+      char *start = p;
+      if (p != end && *p == '"') {
+        char *out = p;
+        ++p;
+        while (true) {
+          if (p == end) {
+            return false;
+          }
+          if (*p == '"') {
+            if (p + 1 != end && p[1] == '"') {
+              *out++ = '"';
+              p += 2;
+              continue;
+            }
+            ++p;
+            break;
+          }
+          *out++ = *p++;
+        }
+        fields_[count++] = std::string_view(start, out - start);
+        if (p != end && *p != ',') {
+          return false;
+        }
+      } else {
+        while (p != end && *p != ',') {
+          ++p;
+        }
+        fields_[count++] = std::string_view(start, p - start);
+      }
+      if (p == end) {
+        return true;
+      }
+      ++p; // ','
+    }
+  }
+
+  bool readHeader(std::size_t count, std::size_t line) {
+    hasHeader_ = true;
+    columnCount_ = count;
+    std::array<bool, kFieldCount> seen{};
+    for (std::size_t column = 0; column < count; ++column) {
+      columnFields_[column] = fieldIndex(trim(fields_[column]));
+      if (columnFields_[column] < kFieldCount) {
+        seen[columnFields_[column]] = true;
+      }
+    }
+    for (std::size_t field = kFirstRequired; field < kFieldCount; ++field) {
+      if (!seen[field]) {
+        sink_.error(line, "CSV header is missing column '" +
+                              std::string(kFieldNames[field]) + "'");
+        return false;
+      }
+    }
+    return true;
+  }
+
+  RowSink &sink_;
+  bool hasHeader_ = false;
+  std::size_t columnCount_ = 0;
+  std::array<std::string_view, kMaxColumns> fields_{};
+  std::array<std::size_t, kMaxColumns> columnFields_{};
+};
+
+// JSON の配列をオブジェクト単位で区切る。
+// 区切り単位は「オブジェクト1個」または「オブジェクト間の区切り文字の並び」。
+class JsonScanner {
+public:
+  explicit JsonScanner(RowSink &sink) : sink_(sink) {}
+
+  std::size_t findEnd(const char *data, std::size_t size) const {
+    if (size == 0) {
+      return 0;
+    }
+    if (data[0] != '{') {
+      const auto *object =
+          static_cast<const char *>(std::memchr(data, '{', size));
+      return object == nullptr ? size
+                               : static_cast<std::size_t>(object - data);
+    }
+
+    bool inString = false;
+    int depth = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      char c = data[i];
+      if (inString) {
+        if (c == '\\') {
+          ++i;
+        } else if (c == '"') {
+          inString = false;
+        }
+      } else if (c == '"') {
+        inString = true;
+      } else if (c == '{') {
+        ++depth;
+      } else if (c == '}' && --depth == 0) {
+        return i + 1;
+      }
+    }
+    return kIncomplete;
+  }
+
+  bool onRecord(char *begin, char *end, std::size_t line, bool complete) {
+    if (*begin != '{') {
+      return onPunctuation(begin, end, line);
+    }
+    if (!complete) {
+      sink_.error(line, "Unterminated JSON object");
+      return false;
+    }
+    if (!opened_ || closed_) {
+      sink_.error(line, "JSON object outside the top-level array");
+      return true;
+    }
+
+    RawRow row;
+    if (const char *problem = parseObject(begin + 1, end - 1, row)) {
+      sink_.error(line, problem);
+      return true;
+    }
+    sink_.accept(row, line);
+    return true;
+  }
+
+  void finish(std::size_t line) {
+    if (!opened_) {
+      sink_.error(line, "Expected a JSON array");
+    } else if (!closed_) {
+      sink_.error(line, "Unterminated JSON array");
+    }
+  }
+
+private:
+  bool onPunctuation(const char *p, const char *end, std::size_t line) {
+    for (; p != end; ++p) {
+      char c = *p;
+      if (isSpace(c)) {
+        if (c == '\n') {
+          ++line;
+        }
+      } else if (c == '[' && !opened_) {
+        opened_ = true;
+      } else if (c == ']' && opened_ && !closed_) {
+        closed_ = true;
+      } else if (c == ',' && opened_ && !closed_) {
+        continue;
+      } else {
+        sink_.error(line, std::string("Unexpected character '") + c + "'");
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static char *skipSpace(char *p, char *end) {
+    while (p != end && isSpace(*p)) {
+      ++p;
+    }
+    return p;
+  }
+
+  static void appendUtf8(char *&out, unsigned code) {
+    if (code < 0x80) {
+      *out++ = static_cast<char>(code);
+    } else if (code < 0x800) {
+      *out++ = static_cast<char>(0xc0 | (code >> 6));
+      *out++ = static_cast<char>(0x80 | (code & 0x3f));
+    } else if (code < 0x10000) {
+      *out++ = static_cast<char>(0xe0 | (code >> 12));
+      *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      *out++ = static_cast<char>(0x80 | (code & 0x3f));
+    } else {
+      *out++ = static_cast<char>(0xf0 | (code >> 18));
+      *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+      *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      *out++ = static_cast<char>(0x80 | (code & 0x3f));
+    }
+  }
+
+  static bool parseHex4(const char *p, const char *end, unsigned &code) {
+    if (end - p < 4) {
+      return false;
+    }
+    auto result = std::from_chars(p, p + 4, code, 16);
+    return result.ec == std::errc() && result.ptr == p + 4;
+  }
+
+  // 文字列を取り出す。エスケープはその場で展開する（結果は常に元より短い）
+  static const char *parseString(char *&p, char *end, std::string_view &out) {
+    char *write = ++p;
+    char *start = write;
+    while (p != end && *p != '"') {
+      if (*p != '\\') {
+        *write++ = *p++;
+        continue;
+      }
+      if (++p == end) {
+        return "Unterminated JSON string";
+      }
+      char c = *p++;
+      switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        *write++ = c;
+        break;
+      case 'b':
+        *write++ = '\b';
+        break;
+      case 'f':
+        *write++ = '\f';
+        break;
+      case 'n':
+        *write++ = '\n';
+        break;
+      case 'r':
+        *write++ = '\r';
+        break;
+      case 't':
+        *write++ = '\t';
+        break;
+      case 'u': {
+        unsigned code = 0;
+        if (!parseHex4(p, end, code)) {
+          return "Invalid \\u escape in JSON string";
+        }
+        p += 4;
+        unsigned low = 0;
+        if (code >= 0xd800 && code < 0xdc00 && end - p >= 6 && p[0] == '\\' &&
+            p[1] == 'u' && parseHex4(p + 2, end, low) && low >= 0xdc00 &&
+            low < 0xe000) {
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+          p += 6;
+        }
+        appendUtf8(write, code);
+        break;
+      }
+      default:
+        return "Invalid escape in JSON string";
+      }
+    }
+    if (p == end) {
+      return "Unterminated JSON string";
+    }
+    ++p; // 閉じクォート
+    out = std::string_view(start, write - start);
+    return nullptr;
+  }
+
+  // {} の内側を解析する。不正な場合は理由を返す
+  static const char *parseObject(char *p, char *end, RawRow &row) {
+    p = skipSpace(p, end);
+    if (p == end) {
+      return nullptr;
+    }
+    while (true) {
+      if (*p != '"') {
+        return "Expected a key in JSON object";
+      }
+      std::string_view key;
+      if (const char *problem = parseString(p, end, key)) {
+        return problem;
+      }
+      p = skipSpace(p, end);
+      if (p == end || *p != ':') {
+        return "Expected ':' in JSON object";
+      }
+      p = skipSpace(p + 1, end);
+      if (p == end) {
+        return "Expected a value in JSON object";
+      }
+
+      std::string_view value;
+      if (*p == '"') {
+        if (const char *problem = parseString(p, end, value)) {
+          return problem;
+        }
+      } else if (*p == '{' || *p == '[') {
+        return "Nested values are not supported in planogram objects";
+      } else {
+        char *start = p;
+        while (p != end && *p != ',' && !isSpace(*p)) {
+          ++p;
+        }
+        value = std::string_view(start, p - start);
+      }
+
+      std::size_t field = fieldIndex(key);
+      if (field < kFieldCount) {
+        row.values[field] = value;
+        row.present[field] = true;
+      }
+
+      p = skipSpace(p, end);
+      if (p == end) {
+        return nullptr;
+      }
+      if (*p != ',') {
+        return "Expected ',' in JSON object";
+      }
+      p = skipSpace(p + 1, end);
+      if (p == end) {
+        return "Trailing ',' in JSON object";
+      }
+    }
+  }
+
+  RowSink &sink_;
+  bool opened_ = false;
+  bool closed_ = false;
+};
+
+} // namespace
+
+PlanogramLoader::PlanogramLoader(std::size_t bufferSize) {
+  if (bufferSize == 0) {
+    throw std::invalid_argument("Planogram buffer must not be empty");
+  }
+  buffer_.resize(bufferSize);
+}
+
+PlanogramLoadResult PlanogramLoader::load(std::istream &in,
+                                          PlanogramFormat format,
+                                          const ProductVisitor &visitor,
+                                          std::string_view machineId) {
+  PlanogramLoadResult result;
+  RowSink sink(visitor, machineId, result, nameBuffer_);
+  if (format == PlanogramFormat::Csv) {
+    CsvScanner scanner(sink);
+    scanStream(in, buffer_, scanner, sink);
+  } else {
+    JsonScanner scanner(sink);
+    scanStream(in, buffer_, scanner, sink);
+  }
+  return result;
+}
+
+PlanogramLoadResult PlanogramLoader::loadInto(std::istream &in,
+                                              PlanogramFormat format,
+                                              domain::Inventory &inventory,
+                                              std::string_view machineId) {
+  return load(
+      in, format,
+      [&inventory](std::string_view, const domain::Product &product,
+                   int count) { inventory.add(product, count); },
+      machineId);
+}
+
+PlanogramFormat PlanogramLoader::formatFromPath(std::string_view path) {
+  constexpr std::string_view kJsonExtension = ".json";
+  if (path.size() >= kJsonExtension.size() &&
+      path.substr(path.size() - kJsonExtension.size()) == kJsonExtension) {
+    return PlanogramFormat::Json;
+  }
+  return PlanogramFormat::Csv;
+}
+
+} // namespace vending_machine::adapters::inbound
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "domain/Inventory.hpp"
+#include "domain/Product.hpp"
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vending_machine::adapters::inbound {
+
+// プラノグラム（商品構成）ファイルを読み込み、初期在庫を組み立てるアダプター。
+// - 入力を使い回すバッファへ一定量ずつ読み込み、バッファ上でそのまま
+//   行（JSON ではオブジェクト）と項目に区切る。項目は std::string_view で扱い、
+//   数値は std::from_chars で変換するため、区切り処理ではメモリを確保しない
+//   （確保するのは Product が保持する商品名だけ）。
+// - 各行の値は例外を使わずにまとめて検証し、不正な行は読み飛ばして
+//   行番号と理由をすべて報告する。
+//
+// CSV 形式（1行目はヘッダ。列の順序は自由、machine_id・slot_id は省略可）:
+//   machine_id,slot_id,name,price,stock
+//   M001,1,Cola,100,5
+// 項目はダブルクォートで囲める（"" はクォート自身を表す）。
+//
+// JSON 形式（フラットなオブジェクトの配列。未知のキーは無視）:
+//   [{"machine_id": "M001", "name": "Cola", "price": 100, "stock": 5}]
+//
+// 他の構成と同じファイルを読めるよう slot_id も受け付けるが、この構成の
+// 在庫は商品名で SKU を識別するため使わない。同じ商品名の行は
+// Inventory::add と同じく在庫を加算し、価格は後の行で上書きする。
+enum class PlanogramFormat {
+  Csv, // ヘッダ付き CSV
+  Json // オブジェクトの配列
+};
+
+// 読み込めなかった行とその理由
+struct PlanogramError {
+  std::size_t line;    // 行番号（1始まり。JSON はオブジェクトの開始行）
+  std::string message; // 理由
+};
+
+struct PlanogramLoadResult {
+  std::size_t rowsRead = 0;       // 読んだデータ行の数（不正な行を含む）
+  std::size_t productsLoaded = 0; // 在庫に登録した行の数
+  std::vector<PlanogramError> errors; // 不正な行（行番号順）
+
+  bool ok() const { return errors.empty(); }
+};
+
+// バッファはインスタンスごとに保持して使い回す。
+class PlanogramLoader {
+public:
+  // 既定のバッファサイズ（1行・1オブジェクトの最大長でもある）
+  static constexpr std::size_t kDefaultBufferSize = std::size_t{1} << 16;
+
+  // 検証済みの1行を受け取る関数。std::invalid_argument を送出すると、
+  // その行は不正な行として報告される。
+  using ProductVisitor = std::function<void(
+      std::string_view machineId, const domain::Product &product, int count)>;
+
+  // bufferSize が 0 の場合は std::invalid_argument を送出する。
+  explicit PlanogramLoader(std::size_t bufferSize = kDefaultBufferSize);
+
+  // ストリームを読み込み、有効な行ごとに visitor を呼び出す。
+  // machineId が空でなければその機械の行だけを扱う（他の機械の行は
+  // 検証もせず、rowsRead にも数えない）。
+  // ストリームの読み込みに失敗した場合は std::runtime_error を送出する。
+  PlanogramLoadResult load(std::istream &in, PlanogramFormat format,
+                           const ProductVisitor &visitor,
+                           std::string_view machineId = {});
+
+  // ストリームを読み込み、在庫に商品を登録する。
+  PlanogramLoadResult loadInto(std::istream &in, PlanogramFormat format,
+                               domain::Inventory &inventory,
+                               std::string_view machineId = {});
+
+  // ".json" で終わるパスは JSON、それ以外は CSV とみなす。
+  static PlanogramFormat formatFromPath(std::string_view path);
+
+private:
+  std::vector<char> buffer_;
+  std::string nameBuffer_; // 商品名の受け渡し用（使い回す）
+};
+
+} // namespace vending_machine::adapters::inbound
@@ -0,0 +1,370 @@
+#include "MappedFileInventoryRepository.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace vending_machine::adapters::outbound {
+
+namespace {
+
+constexpr char kMagic[4] = {'V', 'M', 'I', 'V'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::size_t kInitialCapacity = 64;
+constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+void writeAll(int fd, const char *data, std::size_t size,
+              const std::string &path) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Cannot write inventory file: " + path);
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+std::size_t pageSize() {
+  static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+} // namespace
+
+struct MappedFileInventoryRepository::Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t recordCount;
+  std::uint32_t capacity;
+  char reserved[44];
+};
+
+struct MappedFileInventoryRepository::Record {
+  std::int32_t count;
+  std::int32_t price;
+  std::uint32_t nameLength;
+  char name[kMaxNameLength];
+
+  std::string_view nameView() const { return {name, nameLength}; }
+
+  void assign(const Product &product, int newCount) {
+    count = newCount;
+    price = product.price().amount();
+    nameLength = static_cast<std::uint32_t>(product.name().size());
+    std::memset(name, 0, sizeof(name));
+    std::memcpy(name, product.name().data(), product.name().size());
+  }
+};
+
+MappedFileInventoryRepository::MappedFileInventoryRepository(
+    std::string path, std::size_t syncInterval)
+    : path_(std::move(path)), syncInterval_(syncInterval) {
+  static_assert(sizeof(Header) == 64, "header must keep records aligned");
+  static_assert(sizeof(Record) == 64, "records must be fixed-size");
+
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0) {
+    throw std::runtime_error("Cannot open inventory file: " + path_);
+  }
+
+  struct stat info {};
+  if (::fstat(fd_, &info) != 0) {
+    ::close(fd_);
+    throw std::runtime_error("Cannot stat inventory file: " + path_);
+  }
+
+  try {
+    if (info.st_size == 0) {
+      // 新規ファイル: ヘッダと初期容量分のレコード領域を確保する
+      std::size_t size = sizeof(Header) + kInitialCapacity * sizeof(Record);
+      if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        throw std::runtime_error("Cannot size inventory file: " + path_);
+      }
+      map(size);
+      Header &h = header();
+      std::memcpy(h.magic, kMagic, sizeof(kMagic));
+      h.version = kVersion;
+      h.byteOrder = kByteOrderMark;
+      h.recordCount = 0;
+      h.capacity = kInitialCapacity;
+      markDirty(0, sizeof(Header));
+      sync();
+      return;
+    }
+
+    auto size = static_cast<std::size_t>(info.st_size);
+    if (size < sizeof(Header)) {
+      throw std::runtime_error("Corrupt inventory file: " + path_);
+    }
+    map(size);
+    const Header &h = header();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 ||
+        h.version != kVersion || h.byteOrder != kByteOrderMark ||
+        h.recordCount > h.capacity ||
+        sizeof(Header) + std::size_t{h.capacity} * sizeof(Record) > size) {
+      throw std::runtime_error("Corrupt inventory file: " + path_);
+    }
+
+    index_.reserve(h.recordCount);
+    for (std::size_t i = 0; i < h.recordCount; ++i) {
+      const Record &r = record(i);
+      if (r.nameLength == 0 || r.nameLength > kMaxNameLength || r.count < 0 ||
+          !index_.emplace(std::string(r.nameView()), i).second) {
+        throw std::runtime_error("Corrupt inventory file: " + path_);
+      }
+    }
+  } catch (...) {
+    unmap();
+    ::close(fd_);
+    throw;
+  }
+}
+
+MappedFileInventoryRepository::~MappedFileInventoryRepository() {
+  try {
+    sync();
+  } catch (...) {
+    // デストラクタからは例外を投げない
+  }
+  unmap();
+  ::close(fd_);
+}
+
+Inventory MappedFileInventoryRepository::getInventory() {
+  const std::size_t count = recordCount();
+  Inventory inventory;
+  inventory.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const Record &r = record(i);
+    inventory.add(Product(std::string(r.nameView()), Money(r.price)), r.count);
+  }
+  // ファイルと同じ内容なので、差分としては扱わない
+  inventory.clearChanges();
+  return inventory;
+}
+
+void MappedFileInventoryRepository::save(const Inventory &inventory) {
+  const std::size_t count = inventory.skuCount();
+  for (SkuId sku = 0; sku < count; ++sku) {
+    if (inventory.product(sku).name().size() > kMaxNameLength) {
+      throw std::length_error("Product name too long for inventory file: " +
+                              inventory.product(sku).name());
+    }
+  }
+
+  // 新しいファイルの内容を組み立てる（容量は今のファイル以上を保つ）
+  std::size_t capacity =
+      std::max({count, kInitialCapacity, std::size_t{header().capacity}});
+  std::vector<char> image(sizeof(Header) + capacity * sizeof(Record), 0);
+  auto *h = reinterpret_cast<Header *>(image.data());
+  std::memcpy(h->magic, kMagic, sizeof(kMagic));
+  h->version = kVersion;
+  h->byteOrder = kByteOrderMark;
+  h->recordCount = static_cast<std::uint32_t>(count);
+  h->capacity = static_cast<std::uint32_t>(capacity);
+  auto *records = reinterpret_cast<Record *>(image.data() + sizeof(Header));
+  for (SkuId sku = 0; sku < count; ++sku) {
+    records[sku].assign(inventory.product(sku), inventory.count(sku));
+  }
+
+  replaceFile(image);
+  index_.clear();
+  index_.reserve(count);
+  for (SkuId sku = 0; sku < count; ++sku) {
+    index_.emplace(inventory.product(sku).name(), sku);
+  }
+}
+
+void MappedFileInventoryRepository::saveChanges(
+    const InventoryChangeSet &changes) {
+  for (const auto &change : changes) {
+    if (change.count < 0) {
+      throw std::invalid_argument("Count must be non-negative");
+    }
+
+    std::size_t position = findRecord(change.sku, change.product->name());
+    if (position != kNotFound) {
+      // 通常の販売: 在庫数を1つ書き換えるだけ
+      Record &r = record(position);
+      r.count = change.count;
+      r.price = change.product->price().amount();
+      auto offset = sizeof(Header) + position * sizeof(Record);
+      markDirty(offset, offset + sizeof(Record));
+      continue;
+    }
+
+    if (change.product->name().size() > kMaxNameLength) {
+      throw std::length_error("Product name too long for inventory file: " +
+                              change.product->name());
+    }
+    position = recordCount();
+    reserveRecords(position + 1);
+    writeRecord(position, *change.product, change.count);
+    index_.emplace(change.product->name(), position);
+    header().recordCount = static_cast<std::uint32_t>(position + 1);
+    markDirty(0, sizeof(Header));
+  }
+
+  if (syncInterval_ > 0 && ++writesSinceSync_ >= syncInterval_) {
+    sync();
+  }
+}
+
+void MappedFileInventoryRepository::flush() { sync(); }
+
+std::size_t MappedFileInventoryRepository::recordCount() const {
+  return header().recordCount;
+}
+
+MappedFileInventoryRepository::Header &
+MappedFileInventoryRepository::header() const {
+  return *static_cast<Header *>(mapping_);
+}
+
+MappedFileInventoryRepository::Record &
+MappedFileInventoryRepository::record(std::size_t position) const {
+  auto *records =
+      reinterpret_cast<Record *>(static_cast<char *>(mapping_) + sizeof(Header));
+  return records[position];
+}
+
+void *MappedFileInventoryRepository::mapFile(int fd,
+                                             std::size_t size) const {
+  void *mapping =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Cannot map inventory file: " + path_);
+  }
+  return mapping;
+}
+
+void MappedFileInventoryRepository::map(std::size_t size) {
+  mapping_ = mapFile(fd_, size);
+  mappedSize_ = size;
+}
+
+void MappedFileInventoryRepository::replaceFile(std::vector<char> &image) {
+  // 一時ファイルに書き切って同期してから rename で置き換える。
+  // 失敗した場合は元のファイルとマップをそのまま使い続ける
+  const std::string tempPath = path_ + ".tmp";
+  int fd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open inventory file: " + tempPath);
+  }
+  void *mapping = nullptr;
+  try {
+    writeAll(fd, image.data(), image.size(), tempPath);
+    if (::fsync(fd) != 0) {
+      throw std::runtime_error("Cannot sync inventory file: " + tempPath);
+    }
+    mapping = mapFile(fd, image.size());
+    if (::rename(tempPath.c_str(), path_.c_str()) != 0) {
+      throw std::runtime_error("Cannot replace inventory file: " + path_);
+    }
+  } catch (...) {
+    if (mapping != nullptr) {
+      ::munmap(mapping, image.size());
+    }
+    ::close(fd);
+    ::unlink(tempPath.c_str());
+    throw;
+  }
+
+  // 古いファイルへの未同期の変更は新しい内容に含まれている
+  unmap();
+  ::close(fd_);
+  fd_ = fd;
+  mapping_ = mapping;
+  mappedSize_ = image.size();
+  dirtyBegin_ = dirtyEnd_ = 0;
+  writesSinceSync_ = 0;
+}
+
+void MappedFileInventoryRepository::unmap() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mappedSize_);
+    mapping_ = nullptr;
+    mappedSize_ = 0;
+  }
+}
+
+void MappedFileInventoryRepository::reserveRecords(std::size_t count) {
+  std::size_t capacity = header().capacity;
+  if (count <= capacity) {
+    return;
+  }
+
+  // 容量を倍々に広げて張り直す（未同期の範囲は先に書き出す）。
+  // 伸ばして新しくマップできてから古いマップを外すため、失敗しても
+  // 元の容量のまま使い続けられる
+  sync();
+  capacity = std::max(count, capacity * 2);
+  std::size_t size = sizeof(Header) + capacity * sizeof(Record);
+  if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    throw std::runtime_error("Cannot grow inventory file: " + path_);
+  }
+  void *mapping = mapFile(fd_, size);
+  unmap();
+  mapping_ = mapping;
+  mappedSize_ = size;
+  header().capacity = static_cast<std::uint32_t>(capacity);
+  markDirty(0, sizeof(Header));
+}
+
+std::size_t MappedFileInventoryRepository::findRecord(
+    SkuId sku, std::string_view name) const {
+  if (sku < recordCount() && record(sku).nameView() == name) {
+    return sku;
+  }
+  auto it = index_.find(std::string(name));
+  return it == index_.end() ? kNotFound : it->second;
+}
+
+void MappedFileInventoryRepository::writeRecord(std::size_t position,
+                                                const Product &product,
+                                                int count) {
+  record(position).assign(product, count);
+  auto offset = sizeof(Header) + position * sizeof(Record);
+  markDirty(offset, offset + sizeof(Record));
+}
+
+void MappedFileInventoryRepository::markDirty(std::size_t begin,
+                                              std::size_t end) {
+  if (dirtyBegin_ == dirtyEnd_) {
+    dirtyBegin_ = begin;
+    dirtyEnd_ = end;
+    return;
+  }
+  dirtyBegin_ = std::min(dirtyBegin_, begin);
+  dirtyEnd_ = std::max(dirtyEnd_, end);
+}
+
+void MappedFileInventoryRepository::sync() {
+  writesSinceSync_ = 0;
+  if (dirtyBegin_ == dirtyEnd_ || mapping_ == nullptr) {
+    return;
+  }
+
+  // msync の開始位置はページ境界に揃える必要がある
+  std::size_t begin = dirtyBegin_ / pageSize() * pageSize();
+  std::size_t end = std::min(mappedSize_, dirtyEnd_);
+  dirtyBegin_ = dirtyEnd_ = 0;
+  auto *start = static_cast<char *>(mapping_) + begin;
+  std::size_t length = end - begin;
+  if (::msync(start, length, MS_SYNC) != 0) {
+    throw std::runtime_error("Cannot sync inventory file: " + path_);
+  }
+}
+
+} // namespace vending_machine::adapters::outbound
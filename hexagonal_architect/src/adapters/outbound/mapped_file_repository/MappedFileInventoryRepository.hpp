@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ports/outbound/IInventoryRepository.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vending_machine::adapters::outbound {
+
+using namespace ports::outbound;
+using namespace domain;
+
+// SKU ごとの在庫を固定長レコードとしてメモリマップしたファイルに保持する
+// リポジトリ。
+// - 差分保存は、マップ上のレコードの在庫数をその場で書き換えるだけ。
+//   SkuId とレコード位置が一致していれば（save() 以降に追加された SKU も
+//   末尾に同じ順で追記されるため通常は一致する）索引も引かない。
+// - 書き換えたページは syncInterval 回の差分保存ごとにまとめて msync する。
+// - getInventory() はマップ上のレコードから直接 Inventory を組み立てる
+//   （ファイル全体の読み込みや解析は行わない）。
+// - save() は全体を一時ファイル（path + ".tmp"）に書いて fsync し、rename で
+//   置き換える。途中で停止しても、ファイルは以前の内容か新しい内容のどちらか
+//   になる。
+// ファイルはホストのバイト順で書かれ、別アーキテクチャとの共有は想定しない。
+class MappedFileInventoryRepository : public IInventoryRepository {
+public:
+  static constexpr std::size_t kDefaultSyncInterval = 32;
+  static constexpr std::size_t kMaxNameLength = 52;
+
+  // ファイルが無ければ空の在庫として作成する。
+  // syncInterval に 0 を指定すると、flush() とデストラクタでのみ同期する。
+  explicit MappedFileInventoryRepository(
+      std::string path, std::size_t syncInterval = kDefaultSyncInterval);
+  ~MappedFileInventoryRepository() override;
+
+  MappedFileInventoryRepository(const MappedFileInventoryRepository &) = delete;
+  MappedFileInventoryRepository &
+  operator=(const MappedFileInventoryRepository &) = delete;
+
+  Inventory getInventory() override;
+  void save(const Inventory &inventory) override;
+  void saveChanges(const InventoryChangeSet &changes) override;
+
+  // 未同期の変更をファイルへ書き出す
+  void flush();
+
+  std::size_t recordCount() const;
+
+private:
+  struct Header;
+  struct Record;
+
+  std::string path_;
+  std::size_t syncInterval_;
+  int fd_ = -1;
+  void *mapping_ = nullptr;
+  std::size_t mappedSize_ = 0;
+
+  // 名前 -> レコード位置（SkuId と一致しない場合の検索用）
+  std::unordered_map<std::string, std::size_t> index_;
+
+  // msync 待ちのバイト範囲 [dirtyBegin_, dirtyEnd_)
+  std::size_t dirtyBegin_ = 0;
+  std::size_t dirtyEnd_ = 0;
+  std::size_t writesSinceSync_ = 0;
+
+  Header &header() const;
+  Record &record(std::size_t position) const;
+  void *mapFile(int fd, std::size_t size) const;
+  void map(std::size_t size);
+  void unmap();
+  void replaceFile(std::vector<char> &image);
+  void reserveRecords(std::size_t count);
+  std::size_t findRecord(SkuId sku, std::string_view name) const;
+  void writeRecord(std::size_t position, const Product &product, int count);
+  void markDirty(std::size_t begin, std::size_t end);
+  void sync();
+};
+
+} // namespace vending_machine::adapters::outbound
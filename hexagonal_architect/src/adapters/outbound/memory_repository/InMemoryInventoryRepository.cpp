@@ -8,6 +8,12 @@ Inventory InMemoryInventoryRepository::getInventory() {
 
 void InMemoryInventoryRepository::save(const Inventory &inventory) {
   currentInventory_ = inventory;
+  currentInventory_.clearChanges();
+}
+
+void InMemoryInventoryRepository::saveChanges(
+    const InventoryChangeSet &changes) {
+  currentInventory_.apply(changes);
 }
 
 } // namespace vending_machine::adapters::outbound
\ No newline at end of file
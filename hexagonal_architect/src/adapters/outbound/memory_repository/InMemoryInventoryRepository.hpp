@@ -12,6 +12,7 @@ class InMemoryInventoryRepository : public IInventoryRepository {
 public:
   Inventory getInventory() override;
   void save(const Inventory &inventory) override;
+  void saveChanges(const InventoryChangeSet &changes) override;
 
 private:
   Inventory currentInventory_;
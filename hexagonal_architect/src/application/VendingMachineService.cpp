@@ -4,11 +4,13 @@
 namespace vending_machine::application {
 
 VendingMachineService::VendingMachineService(IInventoryRepository &repository,
-                                             IPaymentGateway &paymentGateway)
-    : repository_(repository), paymentGateway_(paymentGateway) {
+                                             IPaymentGateway &paymentGateway,
+                                             std::size_t checkpointInterval)
+    : repository_(repository), paymentGateway_(paymentGateway),
+      checkpointInterval_(checkpointInterval) {
   // 起動時にリポジトリから在庫をロードしてドメインモデルにセットする
-  Inventory inventory = repository_.getInventory();
-  vendingMachine_.setInventory(inventory);
+  // （ロード結果はそのままムーブし、コピーを作らない）
+  vendingMachine_.setInventory(repository_.getInventory());
 }
 
 void VendingMachineService::insertMoney(const Money &money) {
@@ -19,8 +21,8 @@ Product VendingMachineService::selectProduct(const std::string &productName) {
   // 購入処理
   Product product = vendingMachine_.purchase(productName);
 
-  // 購入成功したら永続化（在庫情報を更新）
-  repository_.save(vendingMachine_.inventory());
+  // 購入成功したら永続化（変更された在庫だけを更新）
+  persistInventory();
 
   return product;
 }
@@ -38,7 +40,7 @@ Product VendingMachineService::purchaseWithElectronicMoney(
   }
 
   Product p = vendingMachine_.purchaseViaElectronicMoney(productName);
-  repository_.save(vendingMachine_.inventory());
+  persistInventory();
   return p;
 }
 
@@ -84,11 +86,28 @@ void VendingMachineService::addStock(const std::string &name, int price,
                                      int count) {
   Product product(name, Money(price));
   vendingMachine_.addStock(product, count);
-  repository_.save(vendingMachine_.inventory());
+  persistInventory();
 }
 
 int VendingMachineService::getTotalSales() const {
   return vendingMachine_.getSales();
 }
 
+void VendingMachineService::persistInventory() {
+  vendingMachine_.collectInventoryChanges(pendingChanges_);
+  if (pendingChanges_.empty()) {
+    return;
+  }
+
+  // 定期的に全体を書き出し、差分の積み重ねに頼らない復元点を作る
+  if (checkpointInterval_ > 0 &&
+      ++writesSinceCheckpoint_ >= checkpointInterval_) {
+    repository_.save(vendingMachine_.inventory());
+    writesSinceCheckpoint_ = 0;
+    return;
+  }
+
+  repository_.saveChanges(pendingChanges_);
+}
+
 } // namespace vending_machine::application
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "ports/inbound/IVendingMachineService.hpp"
 #include "ports/outbound/IInventoryRepository.hpp"
 #include "ports/outbound/IPaymentGateway.hpp"
+#include <cstddef>
 
 namespace vending_machine::application {
 
@@ -15,10 +16,17 @@ using namespace domain;
 class VendingMachineService : public IVendingMachineService,
                               public IMaintenanceService {
 public:
+  static constexpr std::size_t kDefaultCheckpointInterval = 64;
+
   // TODO: PaymentGateway is optional or required? Making it required for now.
   // In real world, maybe set via setter or pass in constructor.
-  VendingMachineService(IInventoryRepository &repository,
-                        IPaymentGateway &paymentGateway);
+  //
+  // 在庫の永続化は差分保存（saveChanges）で行い、checkpointInterval
+  // 回ごとに全体を save() してチェックポイントとする。0 を指定すると
+  // 定期チェックポイントを行わない。
+  VendingMachineService(
+      IInventoryRepository &repository, IPaymentGateway &paymentGateway,
+      std::size_t checkpointInterval = kDefaultCheckpointInterval);
 
   // IVendingMachineService
   void insertMoney(const Money &money) override;
@@ -41,6 +49,13 @@ private:
   IInventoryRepository &repository_;
   IPaymentGateway &paymentGateway_;
   VendingMachine vendingMachine_;
+
+  std::size_t checkpointInterval_;
+  std::size_t writesSinceCheckpoint_ = 0;
+  InventoryChangeSet pendingChanges_; // 差分保存用バッファ（使い回す）
+
+  // 変更された在庫だけをリポジトリへ書き出す
+  void persistInventory();
 };
 
 } // namespace vending_machine::application
\ No newline at end of file
@@ -3,41 +3,151 @@
 
 namespace vending_machine::domain {
 
-void Inventory::add(const Product &product, int count) {
+Inventory::Inventory(const Inventory &other)
+    : products_(other.products_), counts_(other.counts_), dirty_(other.dirty_),
+      dirtyFlags_(other.dirtyFlags_) {
+  rebuildIndex();
+}
+
+Inventory &Inventory::operator=(const Inventory &other) {
+  if (this != &other) {
+    products_ = other.products_;
+    counts_ = other.counts_;
+    dirty_ = other.dirty_;
+    dirtyFlags_ = other.dirtyFlags_;
+    rebuildIndex();
+  }
+  return *this;
+}
+
+SkuId Inventory::add(const Product &product, int count) {
   if (count < 0) {
     throw std::invalid_argument("Count must be non-negative");
   }
-  stocks_[product] += count;
+
+  SkuId sku = upsert(product);
+  counts_[sku] += count;
+  markDirty(sku);
+  return sku;
 }
 
 void Inventory::reduce(const Product &product) {
-  auto it = stocks_.find(product);
-  if (it == stocks_.end() || it->second <= 0) {
+  auto sku = findSku(product.name());
+  if (!sku || counts_[*sku] <= 0) {
     throw std::runtime_error("Out of stock: " + product.name());
   }
-  it->second--;
+  counts_[*sku]--;
+  markDirty(*sku);
+}
+
+void Inventory::reduce(SkuId sku) {
+  if (counts_.at(sku) <= 0) {
+    throw std::runtime_error("Out of stock: " + products_[sku].name());
+  }
+  counts_[sku]--;
+  markDirty(sku);
 }
 
 bool Inventory::hasStock(const Product &product) const {
-  auto it = stocks_.find(product);
-  return it != stocks_.end() && it->second > 0;
+  return getCount(product) > 0;
 }
 
 int Inventory::getCount(const Product &product) const {
-  auto it = stocks_.find(product);
-  if (it == stocks_.end()) {
+  auto sku = findSku(product.name());
+  if (!sku) {
     return 0;
   }
+  return counts_[*sku];
+}
+
+std::optional<SkuId> Inventory::findSku(std::string_view name) const {
+  auto it = index_.find(name);
+  if (it == index_.end()) {
+    return std::nullopt;
+  }
   return it->second;
 }
 
-const Product *Inventory::findProductByName(const std::string &name) const {
-  for (const auto &pair : stocks_) {
-    if (pair.first.name() == name) {
-      return &pair.first;
+const Product &Inventory::product(SkuId sku) const { return products_.at(sku); }
+
+int Inventory::count(SkuId sku) const { return counts_.at(sku); }
+
+std::size_t Inventory::skuCount() const { return products_.size(); }
+
+void Inventory::reserve(std::size_t skuCount) {
+  counts_.reserve(skuCount);
+  dirty_.reserve(skuCount);
+  dirtyFlags_.reserve(skuCount);
+  index_.reserve(skuCount);
+}
+
+const Product *Inventory::findProductByName(std::string_view name) const {
+  auto sku = findSku(name);
+  if (!sku) {
+    return nullptr;
+  }
+  return &products_[*sku];
+}
+
+bool Inventory::hasChanges() const { return !dirty_.empty(); }
+
+void Inventory::collectChanges(InventoryChangeSet &out) {
+  out.clear();
+  out.reserve(dirty_.size());
+  for (SkuId sku : dirty_) {
+    out.push_back({sku, &products_[sku], counts_[sku]});
+  }
+  clearChanges();
+}
+
+void Inventory::clearChanges() {
+  for (SkuId sku : dirty_) {
+    dirtyFlags_[sku] = false;
+  }
+  dirty_.clear();
+}
+
+void Inventory::apply(const InventoryChangeSet &changes) {
+  for (const auto &change : changes) {
+    if (change.count < 0) {
+      throw std::invalid_argument("Count must be non-negative");
     }
+    counts_[upsert(*change.product)] = change.count;
+  }
+}
+
+SkuId Inventory::upsert(const Product &product) {
+  if (auto sku = findSku(product.name())) {
+    if (products_[*sku].price() != product.price()) {
+      // 索引のキーが参照している文字列を置き換えるので、先に外しておく
+      index_.erase(products_[*sku].name());
+      products_[*sku] = product;
+      index_.emplace(products_[*sku].name(), *sku);
+    }
+    return *sku;
+  }
+
+  SkuId sku = products_.size();
+  products_.push_back(product);
+  counts_.push_back(0);
+  dirtyFlags_.push_back(false);
+  index_.emplace(products_.back().name(), sku);
+  return sku;
+}
+
+void Inventory::markDirty(SkuId sku) {
+  if (!dirtyFlags_[sku]) {
+    dirtyFlags_[sku] = true;
+    dirty_.push_back(sku);
+  }
+}
+
+void Inventory::rebuildIndex() {
+  index_.clear();
+  index_.reserve(products_.size());
+  for (SkuId sku = 0; sku < products_.size(); ++sku) {
+    index_.emplace(products_[sku].name(), sku);
   }
-  return nullptr;
 }
 
-} // namespace vending_machine::domain
\ No newline at end of file
+} // namespace vending_machine::domain
@@ -1,25 +1,89 @@
 #pragma once
 
 #include "Product.hpp"
-#include <map>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace vending_machine::domain {
 
+// 在庫内の商品種別（SKU）を表す密な連番ID。
+// Inventory 内部の配列インデックスを兼ねるため、同じ Inventory
+// （およびそのコピー）の中でのみ有効。
+using SkuId = std::size_t;
+
+// 1 つの SKU の最新状態（差分保存の単位）。
+// 販売ごとの保存で商品名をコピーしないよう、商品は収集元の Inventory 内を
+// 指す。ポインタは収集元の Inventory が生きている間のみ有効。
+struct SkuChange {
+  SkuId sku;
+  const Product *product;
+  int count;
+};
+
+// 前回の収集以降に在庫数・価格が変わった SKU の集合
+using InventoryChangeSet = std::vector<SkuChange>;
+
+// 商品名を SKU の同一性とする在庫。
+// 名前 -> SkuId のハッシュ索引と、SkuId で引く密な在庫配列を持つため、
+// 名前検索・在庫の増減はいずれも O(1)。
 class Inventory {
 public:
-  void add(const Product &product, int count);
+  Inventory() = default;
+  Inventory(const Inventory &other);
+  Inventory(Inventory &&other) noexcept = default;
+  Inventory &operator=(const Inventory &other);
+  Inventory &operator=(Inventory &&other) noexcept = default;
+
+  // 同名の SKU が既にある場合は価格を更新して在庫を加算する
+  // （価格改定で別エントリが増えることはない）。
+  SkuId add(const Product &product, int count);
   void reduce(const Product &product);
+  void reduce(SkuId sku);
   bool hasStock(const Product &product) const;
   int getCount(const Product &product) const;
 
-  // 名前から商品を検索する。見つからない場合は std::nullopt
-  // を返す設計が望ましいが ここではポインタを返す（見つからない場合は
-  // nullptr）。 返されるポインタは Inventory
-  // オブジェクトが生きている間のみ有効。
-  const Product *findProductByName(const std::string &name) const;
+  // 名前から SKU を検索する。一時的な std::string は生成しない。
+  std::optional<SkuId> findSku(std::string_view name) const;
+  const Product &product(SkuId sku) const;
+  int count(SkuId sku) const;
+  std::size_t skuCount() const;
+  // skuCount 件の SKU を再確保なしで追加できるようにする
+  // （リポジトリから一括で組み立てる場合など）。
+  void reserve(std::size_t skuCount);
+
+  // 名前から商品を検索する。見つからない場合は nullptr を返す。
+  // 返されるポインタは Inventory オブジェクトが生きている間のみ有効。
+  const Product *findProductByName(std::string_view name) const;
+
+  // 変更追跡: add/reduce で変わった SKU を記録しておき、
+  // リポジトリには変わった分だけを書き出せるようにする。
+  bool hasChanges() const;
+  // 変更された SKU を out に書き出し（out は先にクリアされる）、
+  // 追跡をリセットする。呼び出し側がバッファを使い回せば、
+  // 定常状態では再確保が発生しない。
+  void collectChanges(InventoryChangeSet &out);
+  void clearChanges();
+
+  // 変更セットを適用する（名前で SKU を突き合わせ、在庫数は上書き）。
+  // 永続化側のコピーに反映するためのもので、変更追跡の対象にはならない。
+  void apply(const InventoryChangeSet &changes);
 
 private:
-  std::map<Product, int> stocks_;
+  // std::deque は末尾追加で既存要素のアドレスを変えないため、
+  // index_ のキーは products_ 内の商品名を直接参照できる。
+  std::deque<Product> products_;
+  std::vector<int> counts_;
+  std::unordered_map<std::string_view, SkuId> index_;
+  std::vector<SkuId> dirty_;
+  std::vector<bool> dirtyFlags_;
+
+  SkuId upsert(const Product &product);
+  void markDirty(SkuId sku);
+  void rebuildIndex();
 };
 
-} // namespace vending_machine::domain
\ No newline at end of file
+} // namespace vending_machine::domain
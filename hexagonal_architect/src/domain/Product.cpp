@@ -5,7 +5,7 @@ namespace vending_machine::domain {
 Product::Product(const std::string &name, const Money &price)
     : name_(name), price_(price) {}
 
-std::string Product::name() const { return name_; }
+const std::string &Product::name() const { return name_; }
 
 Money Product::price() const { return price_; }
 
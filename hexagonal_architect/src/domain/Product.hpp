@@ -9,7 +9,7 @@ class Product {
 public:
   Product(const std::string &name, const Money &price);
 
-  std::string name() const;
+  const std::string &name() const;
   Money price() const;
 
   bool operator==(const Product &other) const;
@@ -1,5 +1,6 @@
 #include "VendingMachine.hpp"
 #include <stdexcept>
+#include <utility>
 
 namespace vending_machine::domain {
 
@@ -11,6 +12,13 @@ void VendingMachine::addStock(const Product &product, int count) {
 
 void VendingMachine::setInventory(const Inventory &inventory) {
   inventory_ = inventory;
+  // ロードした状態は永続化済みなので、差分としては扱わない
+  inventory_.clearChanges();
+}
+
+void VendingMachine::setInventory(Inventory &&inventory) {
+  inventory_ = std::move(inventory);
+  inventory_.clearChanges();
 }
 
 void VendingMachine::insertMoney(const Money &money) {
@@ -21,54 +29,56 @@ void VendingMachine::insertMoney(const Money &money) {
   currentAmount_ += money.amount();
 }
 
-Product VendingMachine::purchase(const std::string &productName) {
-  const Product *product = inventory_.findProductByName(productName);
+Product VendingMachine::purchase(std::string_view productName) {
+  auto sku = inventory_.findSku(productName);
 
-  if (!product) {
-    throw std::runtime_error("Product not found: " + productName);
+  if (!sku) {
+    throw std::runtime_error("Product not found: " + std::string(productName));
   }
 
-  if (!inventory_.hasStock(*product)) {
-    throw std::runtime_error("Out of stock: " + productName);
+  if (inventory_.count(*sku) <= 0) {
+    throw std::runtime_error("Out of stock: " + std::string(productName));
   }
 
-  if (currentAmount_ < product->price().amount()) {
-    throw std::runtime_error("Insufficient funds for: " + productName);
+  const Product &product = inventory_.product(*sku);
+  if (currentAmount_ < product.price().amount()) {
+    throw std::runtime_error("Insufficient funds for: " +
+                             std::string(productName));
   }
 
   // Purchase process
-  currentAmount_ -= product->price().amount();
-  totalSales_ += product->price().amount();
-  inventory_.reduce(*product);
+  currentAmount_ -= product.price().amount();
+  totalSales_ += product.price().amount();
+  inventory_.reduce(*sku);
 
-  return *product;
+  return product;
 }
 
 Product
-VendingMachine::purchaseViaElectronicMoney(const std::string &productName) {
-  const Product *product = inventory_.findProductByName(productName);
+VendingMachine::purchaseViaElectronicMoney(std::string_view productName) {
+  auto sku = inventory_.findSku(productName);
 
-  if (!product) {
-    throw std::runtime_error("Product not found: " + productName);
+  if (!sku) {
+    throw std::runtime_error("Product not found: " + std::string(productName));
   }
 
-  if (!inventory_.hasStock(*product)) {
-    throw std::runtime_error("Out of stock: " + productName);
+  if (inventory_.count(*sku) <= 0) {
+    throw std::runtime_error("Out of stock: " + std::string(productName));
   }
 
   // 電子マネー決済の場合は投入金額のチェックを行わない
   // 承認済みであることを前提とする
 
-  totalSales_ += product->price().amount();
-  inventory_.reduce(*product);
+  const Product &product = inventory_.product(*sku);
+  totalSales_ += product.price().amount();
+  inventory_.reduce(*sku);
 
-  return *product;
+  return product;
 }
 
 int VendingMachine::getSales() const { return totalSales_; }
 
-const Product *
-VendingMachine::findProductByName(const std::string &name) const {
+const Product *VendingMachine::findProductByName(std::string_view name) const {
   return inventory_.findProductByName(name);
 }
 
@@ -82,6 +92,10 @@ int VendingMachine::refund() {
 
 const Inventory &VendingMachine::inventory() const { return inventory_; }
 
+void VendingMachine::collectInventoryChanges(InventoryChangeSet &out) {
+  inventory_.collectChanges(out);
+}
+
 // purchaseの実装はInventoryの拡張後に記述する
 
 } // namespace vending_machine::domain
\ No newline at end of file
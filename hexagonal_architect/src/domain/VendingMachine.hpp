@@ -4,6 +4,7 @@
 #include "Money.hpp"
 #include "Product.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace vending_machine::domain {
@@ -15,12 +16,13 @@ public:
   // 在庫管理用
   void addStock(const Product &product, int count);
   void setInventory(const Inventory &inventory);
+  void setInventory(Inventory &&inventory); // ロード結果をコピーせずに受け取る
 
   // 操作
   void insertMoney(const Money &money);
-  Product purchase(const std::string &productName);
+  Product purchase(std::string_view productName);
   Product
-  purchaseViaElectronicMoney(const std::string &productName); // 電子マネー用
+  purchaseViaElectronicMoney(std::string_view productName); // 電子マネー用
   int refund();
 
   // 参照
@@ -28,15 +30,17 @@ public:
   int getSales() const;               // 売上確認
   const Inventory &inventory() const; // For repository saving if needed
 
+  // 前回の収集以降に変わった在庫（差分保存用）
+  void collectInventoryChanges(InventoryChangeSet &out);
+
 private:
   int currentAmount_;
   int totalSales_; // 売上合計
   Inventory inventory_;
 
   // Helper to find product by name in inventory
-  // Since Inventory uses Product as key, we need to iterate or maintain a
-  // separate map. Assuming small number of products, iteration is fine.
-  const Product *findProductByName(const std::string &name) const;
+  // Inventory keeps a name -> SKU hash index, so this is an O(1) lookup.
+  const Product *findProductByName(std::string_view name) const;
 };
 
 } // namespace vending_machine::domain
\ No newline at end of file
@@ -1,26 +1,59 @@
 #include "adapters/inbound/console/ConsoleAdapter.hpp"
+#include "adapters/inbound/planogram/PlanogramLoader.hpp"
 #include "adapters/outbound/MockPaymentGateway.hpp"
-#include "adapters/outbound/memory_repository/InMemoryInventoryRepository.hpp"
+#include "adapters/outbound/mapped_file_repository/MappedFileInventoryRepository.hpp"
 #include "application/VendingMachineService.hpp"
 #include "domain/Money.hpp"
 #include "domain/Product.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
 
 using namespace vending_machine::domain;
 using namespace vending_machine::application;
 using namespace vending_machine::adapters::inbound;
 using namespace vending_machine::adapters::outbound;
 
-int main() {
+namespace {
+
+// プラノグラムファイルから在庫を組み立てる。読めなかった行は報告する
+bool loadPlanogram(Inventory &inventory, const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::cerr << "プラノグラムを開けません: " << path << "\n";
+    return false;
+  }
+
+  PlanogramLoader loader;
+  auto result =
+      loader.loadInto(in, PlanogramLoader::formatFromPath(path), inventory);
+  for (const auto &error : result.errors) {
+    std::cerr << path << ":" << error.line << ": " << error.message << "\n";
+  }
+  return result.productsLoaded > 0;
+}
+
+} // namespace
+
+// 使い方: vending_machine [プラノグラムファイル（.csv / .json）]
+int main(int argc, char *argv[]) {
   // 1. Prepare Dependencies (Driven Adapters)
-  InMemoryInventoryRepository repository;
+  // 在庫はメモリマップしたファイルに保持し、再起動後も引き継ぐ
+  MappedFileInventoryRepository repository("inventory.dat");
   MockPaymentGateway paymentGateway;
 
-  // 2. Initialize Data (normally this would come from a real DB)
-  Inventory initialInventory;
-  initialInventory.add(Product("Cola", Money(100)), 5);
-  initialInventory.add(Product("Water", Money(100)), 5);
-  initialInventory.add(Product("Coffee", Money(150)), 5);
-  repository.save(initialInventory);
+  // 2. Initialize Data (only when the inventory file is new)
+  // プラノグラムが指定されていればそこから、無ければ既定の商品で始める
+  if (repository.recordCount() == 0) {
+    Inventory initialInventory;
+    if (argc < 2 || !loadPlanogram(initialInventory, argv[1])) {
+      initialInventory = Inventory();
+      initialInventory.add(Product("Cola", Money(100)), 5);
+      initialInventory.add(Product("Water", Money(100)), 5);
+      initialInventory.add(Product("Coffee", Money(150)), 5);
+    }
+    repository.save(initialInventory);
+  }
 
   // 3. Inject Dependencies into Application Core
   VendingMachineService service(repository, paymentGateway);
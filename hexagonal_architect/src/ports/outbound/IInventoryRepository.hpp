@@ -13,8 +13,12 @@ public:
   // 在庫情報を取得する
   virtual Inventory getInventory() = 0;
 
-  // 在庫情報を保存する
+  // 在庫情報を保存する（全体のチェックポイント）
   virtual void save(const Inventory &inventory) = 0;
+
+  // 変更された SKU だけを保存する（差分保存）。
+  // コストは変更セットの大きさに比例し、カタログ全体の大きさには依存しない。
+  virtual void saveChanges(const InventoryChangeSet &changes) = 0;
 };
 
 } // namespace vending_machine::ports::outbound
\ No newline at end of file
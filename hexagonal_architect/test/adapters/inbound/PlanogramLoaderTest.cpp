@@ -0,0 +1,120 @@
+#include "adapters/inbound/planogram/PlanogramLoader.hpp"
+#include "domain/Money.hpp"
+#include "domain/Product.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace vending_machine::domain;
+
+namespace vending_machine::adapters::inbound::test {
+
+class PlanogramLoaderTest : public ::testing::Test {
+protected:
+  PlanogramLoadResult load(const std::string &text, PlanogramFormat format,
+                           std::size_t bufferSize =
+                               PlanogramLoader::kDefaultBufferSize) {
+    std::istringstream in(text);
+    PlanogramLoader loader(bufferSize);
+    return loader.loadInto(in, format, inventory);
+  }
+
+  int count(const std::string &name) const {
+    auto sku = inventory.findSku(name);
+    return sku ? inventory.count(*sku) : -1;
+  }
+
+  Inventory inventory;
+};
+
+TEST_F(PlanogramLoaderTest, ShouldLoadCsvWithOptionalSlotColumn) {
+  auto result = load("slot_id,name,price,stock\r\n"
+                     "1,Cola,100,5\r\n"
+                     "2,\"Tea, \"\"green\"\"\",150,0\r\n"
+                     "\n"
+                     "3,Water,100,7",
+                     PlanogramFormat::Csv);
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.rowsRead, 3u);
+  EXPECT_EQ(result.productsLoaded, 3u);
+  EXPECT_EQ(count("Cola"), 5);
+  EXPECT_EQ(count("Tea, \"green\""), 0);
+  EXPECT_EQ(count("Water"), 7);
+
+  // slot_id 列は無くてもよい
+  auto withoutSlots =
+      load("name,price,stock\nCoffee,150,2\n", PlanogramFormat::Csv);
+  EXPECT_TRUE(withoutSlots.ok());
+  EXPECT_EQ(inventory.product(*inventory.findSku("Coffee")).price(),
+            Money(150));
+}
+
+TEST_F(PlanogramLoaderTest, ShouldLoadJsonAndFilterByMachine) {
+  std::istringstream in(R"([
+  {"machine_id": "M001", "name": "Cola", "price": 100, "stock": 5},
+  {"machine_id": "M002", "name": "Water", "price": 100, "stock": 3},
+  {"machine_id": "M001", "name": "Café", "price": 150, "stock": 2}
+])");
+  PlanogramLoader loader;
+  auto result =
+      loader.loadInto(in, PlanogramFormat::Json, inventory, "M001");
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.rowsRead, 2u); // M002 の行は数えない
+  EXPECT_EQ(count("Cola"), 5);
+  EXPECT_EQ(count("Water"), -1);
+  EXPECT_EQ(count("Caf\xc3\xa9"), 2);
+}
+
+TEST_F(PlanogramLoaderTest, ShouldReportEveryBadRow) {
+  auto result = load("name,price,stock\n"
+                     "Cola,100,5\n"
+                     ",-1,x\n"
+                     "Water,100\n"
+                     "Tea,120,-3\n",
+                     PlanogramFormat::Csv);
+
+  EXPECT_EQ(result.rowsRead, 3u);
+  EXPECT_EQ(result.productsLoaded, 1u);
+  ASSERT_EQ(result.errors.size(), 3u);
+  EXPECT_EQ(result.errors[0].line, 3u);
+  // 1行の不正な項目はまとめて報告する
+  EXPECT_NE(result.errors[0].message.find("name"), std::string::npos);
+  EXPECT_NE(result.errors[0].message.find("price"), std::string::npos);
+  EXPECT_NE(result.errors[0].message.find("stock"), std::string::npos);
+  EXPECT_EQ(result.errors[1].line, 4u);
+  EXPECT_EQ(result.errors[2].line, 5u);
+  EXPECT_EQ(inventory.skuCount(), 1u);
+}
+
+TEST_F(PlanogramLoaderTest, ShouldMergeRowsOfTheSameProduct) {
+  auto result = load("name,price,stock\nCola,100,5\nCola,120,2\n",
+                     PlanogramFormat::Csv);
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(inventory.skuCount(), 1u);
+  EXPECT_EQ(count("Cola"), 7);
+  EXPECT_EQ(inventory.product(*inventory.findSku("Cola")).price(),
+            Money(120));
+}
+
+TEST_F(PlanogramLoaderTest, ShouldReadAcrossSmallBuffer) {
+  std::string text = "name,price,stock\n";
+  for (int i = 0; i < 100; ++i) {
+    text += "Product" + std::to_string(i) + ",100," + std::to_string(i) + "\n";
+  }
+
+  // 行がバッファ境界をまたいでも結果は同じ
+  auto result = load(text, PlanogramFormat::Csv, 32);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.productsLoaded, 100u);
+  EXPECT_EQ(count("Product99"), 99);
+
+  EXPECT_EQ(PlanogramLoader::formatFromPath("fleet.json"),
+            PlanogramFormat::Json);
+  EXPECT_EQ(PlanogramLoader::formatFromPath("planogram.csv"),
+            PlanogramFormat::Csv);
+}
+
+} // namespace vending_machine::adapters::inbound::test
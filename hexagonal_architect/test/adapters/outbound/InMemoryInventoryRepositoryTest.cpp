@@ -38,4 +38,40 @@ TEST_F(InMemoryInventoryRepositoryTest, ShouldUpdateExistingInventory) {
   EXPECT_EQ(inv3.getCount(cola), 4);
 }
 
+TEST_F(InMemoryInventoryRepositoryTest, ShouldApplyChangeSet) {
+  InMemoryInventoryRepository repo;
+  Product cola("Cola", Money(100));
+  Product water("Water", Money(100));
+
+  Inventory inventory;
+  inventory.add(cola, 5);
+  inventory.add(water, 5);
+  repo.save(inventory);
+
+  // Cola だけが変わった差分を保存する
+  inventory.clearChanges();
+  inventory.reduce(cola);
+  InventoryChangeSet changes;
+  inventory.collectChanges(changes);
+  ASSERT_EQ(changes.size(), 1u);
+  repo.saveChanges(changes);
+
+  Inventory retrieved = repo.getInventory();
+  EXPECT_EQ(retrieved.getCount(cola), 4);
+  EXPECT_EQ(retrieved.getCount(water), 5);
+}
+
+TEST_F(InMemoryInventoryRepositoryTest, ShouldAddNewSkuFromChangeSet) {
+  InMemoryInventoryRepository repo;
+  repo.save(Inventory());
+
+  Inventory inventory;
+  inventory.add(Product("Tea", Money(120)), 3);
+  InventoryChangeSet changes;
+  inventory.collectChanges(changes);
+  repo.saveChanges(changes);
+
+  EXPECT_EQ(repo.getInventory().getCount(Product("Tea", Money(120))), 3);
+}
+
 } // namespace vending_machine::adapters::outbound::test
\ No newline at end of file
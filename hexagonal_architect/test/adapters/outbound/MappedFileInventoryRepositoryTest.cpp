@@ -0,0 +1,188 @@
+#include "adapters/outbound/mapped_file_repository/MappedFileInventoryRepository.hpp"
+#include "adapters/outbound/MockPaymentGateway.hpp"
+#include "application/VendingMachineService.hpp"
+#include "domain/Product.hpp"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace vending_machine::adapters::outbound::test {
+
+using namespace domain;
+
+class MappedFileInventoryRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path = ::testing::TempDir() + "inventory_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+           ".dat";
+    std::remove(path.c_str());
+  }
+
+  void TearDown() override {
+    std::remove(path.c_str());
+    std::remove((path + ".tmp").c_str());
+  }
+
+  std::string path;
+  Product cola{"Cola", Money(100)};
+  Product water{"Water", Money(100)};
+};
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldStartEmptyForNewFile) {
+  MappedFileInventoryRepository repo(path);
+
+  EXPECT_EQ(repo.recordCount(), 0u);
+  EXPECT_EQ(repo.getInventory().skuCount(), 0u);
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldRestoreSavedInventoryOnReopen) {
+  {
+    MappedFileInventoryRepository repo(path);
+    Inventory inventory;
+    inventory.add(cola, 5);
+    inventory.add(water, 3);
+    repo.save(inventory);
+  }
+
+  MappedFileInventoryRepository reopened(path);
+  Inventory inventory = reopened.getInventory();
+
+  EXPECT_EQ(inventory.skuCount(), 2u);
+  EXPECT_EQ(inventory.getCount(cola), 5);
+  EXPECT_EQ(inventory.getCount(water), 3);
+  EXPECT_FALSE(inventory.hasChanges());
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldStoreChangedCountsInPlace) {
+  {
+    MappedFileInventoryRepository repo(path, 0);
+    Inventory inventory;
+    inventory.add(cola, 5);
+    inventory.add(water, 5);
+    repo.save(inventory);
+
+    inventory.clearChanges();
+    inventory.reduce(water);
+    InventoryChangeSet changes;
+    inventory.collectChanges(changes);
+    repo.saveChanges(changes);
+
+    // 新しい SKU は末尾に追加される
+    Product tea("Tea", Money(150));
+    repo.saveChanges({{2, &tea, 7}});
+    EXPECT_EQ(repo.recordCount(), 3u);
+  } // デストラクタで同期される
+
+  MappedFileInventoryRepository reopened(path);
+  Inventory inventory = reopened.getInventory();
+  EXPECT_EQ(inventory.getCount(cola), 5);
+  EXPECT_EQ(inventory.getCount(water), 4);
+  EXPECT_EQ(inventory.getCount(Product("Tea", Money(150))), 7);
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldFindRecordWhenSkuIdDiffers) {
+  MappedFileInventoryRepository repo(path);
+  Inventory inventory;
+  inventory.add(cola, 5);
+  inventory.add(water, 5);
+  repo.save(inventory);
+
+  // 別の Inventory の SkuId（位置が一致しない）でも名前で突き合わせる
+  repo.saveChanges({{0, &water, 1}});
+
+  Inventory loaded = repo.getInventory();
+  EXPECT_EQ(loaded.getCount(cola), 5);
+  EXPECT_EQ(loaded.getCount(water), 1);
+  EXPECT_EQ(repo.recordCount(), 2u);
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldGrowBeyondInitialCapacity) {
+  {
+    MappedFileInventoryRepository repo(path);
+    std::vector<Product> products;
+    for (SkuId sku = 0; sku < 200; ++sku) {
+      products.emplace_back("P" + std::to_string(sku), Money(100));
+    }
+    InventoryChangeSet changes;
+    for (SkuId sku = 0; sku < 200; ++sku) {
+      changes.push_back({sku, &products[sku], 1});
+    }
+    repo.saveChanges(changes);
+  }
+
+  MappedFileInventoryRepository reopened(path);
+  Inventory inventory = reopened.getInventory();
+  EXPECT_EQ(inventory.skuCount(), 200u);
+  EXPECT_EQ(inventory.getCount(Product("P199", Money(100))), 1);
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldReplaceFileAtomicallyOnSave) {
+  MappedFileInventoryRepository repo(path);
+  Inventory first;
+  first.add(cola, 5);
+  repo.save(first);
+
+  // 保存の途中で停止した一時ファイルが残っていても、元の内容は壊れない
+  {
+    std::ofstream stale(path + ".tmp", std::ios::binary);
+    stale << "partial";
+  }
+  {
+    MappedFileInventoryRepository reopened(path);
+    EXPECT_EQ(reopened.getInventory().getCount(cola), 5);
+  }
+
+  Inventory second;
+  second.add(water, 2);
+  repo.save(second);
+  // 置き換えた後のファイルにも差分保存を続けられる
+  repo.saveChanges({{0, &water, 1}});
+  repo.flush();
+
+  MappedFileInventoryRepository reopened(path);
+  Inventory inventory = reopened.getInventory();
+  EXPECT_EQ(inventory.skuCount(), 1u);
+  EXPECT_EQ(inventory.getCount(water), 1);
+  EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldRejectTooLongProductName) {
+  MappedFileInventoryRepository repo(path);
+  Inventory inventory;
+  inventory.add(Product(std::string(60, 'x'), Money(100)), 1);
+
+  EXPECT_THROW(repo.save(inventory), std::length_error);
+  EXPECT_EQ(repo.recordCount(), 0u);
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldRejectCorruptFile) {
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not an inventory file";
+  }
+
+  EXPECT_THROW(MappedFileInventoryRepository repo(path), std::runtime_error);
+}
+
+TEST_F(MappedFileInventoryRepositoryTest, ShouldPersistSalesThroughService) {
+  {
+    MappedFileInventoryRepository repo(path);
+    Inventory inventory;
+    inventory.add(cola, 5);
+    repo.save(inventory);
+
+    MockPaymentGateway payment;
+    application::VendingMachineService service(repo, payment);
+    service.insertMoney(Money(100));
+    service.selectProduct("Cola");
+  }
+
+  MappedFileInventoryRepository reopened(path);
+  EXPECT_EQ(reopened.getInventory().getCount(cola), 4);
+}
+
+} // namespace vending_machine::adapters::outbound::test
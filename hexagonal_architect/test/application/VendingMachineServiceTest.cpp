@@ -9,7 +9,12 @@ using namespace vending_machine::ports::inbound;
 using namespace vending_machine::ports::outbound;
 using namespace vending_machine::domain;
 using ::testing::_;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::InSequence;
 using ::testing::Return;
+using ::testing::Truly;
 
 namespace vending_machine::application::test {
 
@@ -18,6 +23,7 @@ class MockInventoryRepository : public IInventoryRepository {
 public:
   MOCK_METHOD(Inventory, getInventory, (), (override));
   MOCK_METHOD(void, save, (const Inventory &), (override));
+  MOCK_METHOD(void, saveChanges, (const InventoryChangeSet &), (override));
 };
 
 // Mock Payment Gateway
@@ -31,6 +37,12 @@ protected:
   MockInventoryRepository mockRepo;
   MockPaymentGateway mockPayment;
   // Service will be initialized in tests
+
+  // 差分保存が指定の SKU 1 件だけ（在庫数 count）であることを照合する
+  static auto onlySku(SkuId sku, int count) {
+    return ElementsAre(
+        AllOf(Field(&SkuChange::sku, sku), Field(&SkuChange::count, count)));
+  }
 };
 
 TEST_F(VendingMachineServiceTest, ShouldInitializeWithInventoryFromRepo) {
@@ -38,6 +50,7 @@ TEST_F(VendingMachineServiceTest, ShouldInitializeWithInventoryFromRepo) {
   initialInventory.add(Product("Cola", Money(100)), 5);
 
   EXPECT_CALL(mockRepo, getInventory()).WillOnce(Return(initialInventory));
+  EXPECT_CALL(mockRepo, saveChanges(onlySku(0, 4))).Times(1);
 
   VendingMachineService service(mockRepo, mockPayment);
 
@@ -52,13 +65,73 @@ TEST_F(VendingMachineServiceTest, ShouldSaveInventoryAfterPurchase) {
 
   EXPECT_CALL(mockRepo, getInventory()).WillOnce(Return(initialInventory));
 
-  EXPECT_CALL(mockRepo, save(_)).Times(1);
+  // 購入ごとの永続化は変更された SKU だけの差分保存になる
+  EXPECT_CALL(mockRepo, saveChanges(onlySku(0, 4))).Times(1);
+  EXPECT_CALL(mockRepo, save(_)).Times(0);
 
   VendingMachineService service(mockRepo, mockPayment);
   service.insertMoney(Money(100));
   service.selectProduct("Cola");
 }
 
+TEST_F(VendingMachineServiceTest, ShouldWriteFullCheckpointPeriodically) {
+  Inventory initialInventory;
+  initialInventory.add(Product("Cola", Money(100)), 5);
+
+  EXPECT_CALL(mockRepo, getInventory()).WillOnce(Return(initialInventory));
+
+  // チェックポイント間隔 3: 2 回は差分、3 回目は全体保存
+  InSequence sequence;
+  EXPECT_CALL(mockRepo, saveChanges(onlySku(0, 4))).Times(1);
+  EXPECT_CALL(mockRepo, saveChanges(onlySku(0, 3))).Times(1);
+  EXPECT_CALL(mockRepo, save(Truly([](const Inventory &inventory) {
+                return inventory.getCount(Product("Cola", Money(100))) == 2;
+              })))
+      .Times(1);
+
+  VendingMachineService service(mockRepo, mockPayment, 3);
+  for (int i = 0; i < 3; ++i) {
+    service.insertMoney(Money(100));
+    service.selectProduct("Cola");
+  }
+}
+
+TEST_F(VendingMachineServiceTest,
+       ShouldSaveOnlyDirtySkusAndCheckpointAtDefaultInterval) {
+  Inventory initialInventory;
+  initialInventory.add(Product("Cola", Money(100)), 100);
+  initialInventory.add(Product("Tea", Money(120)), 5);
+  initialInventory.add(Product("Water", Money(100)), 5);
+
+  EXPECT_CALL(mockRepo, getInventory()).WillOnce(Return(initialInventory));
+
+  // 既定の間隔では 63 回は売れた SKU だけの差分、64 回目は全体保存。
+  // 全体保存の後は再び差分に戻る
+  const int interval =
+      static_cast<int>(VendingMachineService::kDefaultCheckpointInterval);
+  InSequence sequence;
+  for (int sale = 1; sale < interval; ++sale) {
+    EXPECT_CALL(mockRepo, saveChanges(onlySku(0, 100 - sale))).Times(1);
+  }
+  EXPECT_CALL(mockRepo, save(Truly([interval](const Inventory &inventory) {
+                return inventory.skuCount() == 3 &&
+                       inventory.getCount(Product("Cola", Money(100))) ==
+                           100 - interval &&
+                       inventory.getCount(Product("Tea", Money(120))) == 5;
+              })))
+      .Times(1);
+  EXPECT_CALL(mockRepo, saveChanges(onlySku(1, 4))).Times(1);
+
+  VendingMachineService service(mockRepo, mockPayment);
+  for (int sale = 0; sale < interval; ++sale) {
+    service.insertMoney(Money(100));
+    service.selectProduct("Cola");
+  }
+  service.insertMoney(Money(100));
+  service.insertMoney(Money(50));
+  service.selectProduct("Tea");
+}
+
 TEST_F(VendingMachineServiceTest, ShouldProcessElectronicMoneyPurchase) {
   Inventory initialInventory;
   initialInventory.add(Product("Tea", Money(120)), 5);
@@ -67,7 +140,8 @@ TEST_F(VendingMachineServiceTest, ShouldProcessElectronicMoneyPurchase) {
 
   EXPECT_CALL(mockPayment, pay(120)).WillOnce(Return(true));
 
-  EXPECT_CALL(mockRepo, save(_)).Times(1);
+  EXPECT_CALL(mockRepo, saveChanges(onlySku(0, 4))).Times(1);
+  EXPECT_CALL(mockRepo, save(_)).Times(0);
 
   VendingMachineService service(mockRepo, mockPayment);
 
@@ -86,6 +160,7 @@ TEST_F(VendingMachineServiceTest,
   EXPECT_CALL(mockPayment, pay(120)).WillOnce(Return(false));
 
   EXPECT_CALL(mockRepo, save(_)).Times(0);
+  EXPECT_CALL(mockRepo, saveChanges(_)).Times(0);
 
   VendingMachineService service(mockRepo, mockPayment);
 
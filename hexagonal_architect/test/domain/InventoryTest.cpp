@@ -44,4 +44,64 @@ TEST_F(InventoryTest, ShouldManageMultipleProducts) {
     EXPECT_EQ(inventory.getCount(water), 2);
 }
 
+TEST_F(InventoryTest, ShouldTreatProductNameAsSkuIdentity) {
+    Inventory inventory;
+
+    SkuId sku = inventory.add(Product("Cola", Money(100)), 5);
+    // 価格改定しても別エントリにはならず、同じ SKU の価格が更新される
+    SkuId repriced = inventory.add(Product("Cola", Money(120)), 3);
+
+    EXPECT_EQ(sku, repriced);
+    EXPECT_EQ(inventory.skuCount(), 1u);
+    EXPECT_EQ(inventory.count(sku), 8);
+    EXPECT_EQ(inventory.product(sku).price(), Money(120));
+}
+
+TEST_F(InventoryTest, ShouldFindSkuByName) {
+    Inventory inventory;
+    inventory.add(Product("Cola", Money(100)), 1);
+    SkuId water = inventory.add(Product("Water", Money(100)), 2);
+
+    auto found = inventory.findSku(std::string_view("Water"));
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(*found, water);
+    EXPECT_FALSE(inventory.findSku("Tea").has_value());
+
+    inventory.reduce(water);
+    EXPECT_EQ(inventory.count(water), 1);
+}
+
+TEST_F(InventoryTest, ShouldKeepNameIndexValidAfterCopy) {
+    Inventory original;
+    original.add(Product("Cola", Money(100)), 5);
+
+    Inventory copy = original;
+    original = Inventory();
+
+    const Product *cola = copy.findProductByName("Cola");
+    ASSERT_NE(cola, nullptr);
+    EXPECT_EQ(cola->name(), "Cola");
+    EXPECT_EQ(copy.getCount(*cola), 5);
+}
+
+TEST_F(InventoryTest, ShouldTrackOnlyChangedSkus) {
+    Inventory inventory;
+    SkuId cola = inventory.add(Product("Cola", Money(100)), 5);
+    inventory.add(Product("Water", Money(100)), 5);
+    inventory.clearChanges();
+    EXPECT_FALSE(inventory.hasChanges());
+
+    inventory.reduce(cola);
+    inventory.reduce(cola);
+
+    InventoryChangeSet changes;
+    inventory.collectChanges(changes);
+    ASSERT_EQ(changes.size(), 1u); // 同じ SKU は 1 件にまとめられる
+    EXPECT_EQ(changes[0].sku, cola);
+    EXPECT_EQ(changes[0].count, 3);
+    // 商品はコピーせず、在庫内の商品を指す
+    EXPECT_EQ(changes[0].product, &inventory.product(cola));
+    EXPECT_FALSE(inventory.hasChanges());
+}
+
 } // namespace vending_machine::domain::test
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "application/usecases/PurchaseWithEMoneyUseCase.hpp"
 #include "application/usecases/SalesReportingUseCase.hpp"
 #include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductSlot.hpp"
 #include "domain/payment/Wallet.hpp"
 #include "domain/sales/Sales.hpp"
 #include "infrastructure/interfaces/ICoinMech.hpp"
@@ -57,6 +58,13 @@ public:
    */
   void initializeInventory();
 
+  /**
+   * @brief スロットを1件登録（プラノグラムファイルからの読み込み用）
+   * @param slot 登録するスロット
+   * @throw std::invalid_argument 同じ SlotId が登録済みの場合
+   */
+  void addSlot(const domain::ProductSlot &slot);
+
   // ユースケースへのアクセサ
   PurchaseWithCashUseCase &getPurchaseWithCashUseCase() {
     return *purchase_with_cash_usecase_;
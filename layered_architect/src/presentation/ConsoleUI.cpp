@@ -69,16 +69,12 @@ void ConsoleUI::showProductList() {
   std::cout << "          商品一覧\n";
   std::cout << "========================================\n";
 
-  for (int i = 1; i <= 4; i++) {
-    try {
-      const auto &slot = app_.getInventory().getSlot(domain::SlotId(i));
-      std::cout << "スロット " << i << ": "
-                << slot.getProductInfo().getName().getValue() << " - "
-                << slot.getProductInfo().getPrice().getRawValue()
-                << "円 (在庫: " << slot.getStock().getValue() << "個)\n";
-    } catch (...) {
-      // スロットが存在しない場合はスキップ
-    }
+  // 登録済みのスロットをスロット番号の順にすべて表示する
+  for (const auto &[slot_id, slot] : app_.getInventory().getAllSlots()) {
+    std::cout << "スロット " << slot_id.getValue() << ": "
+              << slot->getProductInfo().getName().getValue() << " - "
+              << slot->getProductInfo().getPrice().getRawValue()
+              << "円 (在庫: " << slot->getStock().getValue() << "個)\n";
   }
 
   std::cout << "========================================\n";
@@ -61,5 +61,9 @@ void VendingMachineApplication::initializeInventory() {
   inventory_.addSlot(slot4);
 }
 
+void VendingMachineApplication::addSlot(const domain::ProductSlot &slot) {
+  inventory_.addSlot(slot);
+}
+
 } // namespace application
 } // namespace vending_machine
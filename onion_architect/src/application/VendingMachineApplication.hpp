@@ -22,6 +22,7 @@
 #include "domain/interfaces/IDispenser.hpp"
 #include "domain/interfaces/IPaymentGateway.hpp"
 #include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductSlot.hpp"
 #include "domain/payment/Wallet.hpp"
 #include "domain/repositories/ITransactionHistoryRepository.hpp"
 #include "domain/sales/Sales.hpp"
@@ -56,6 +57,13 @@ public:
    */
   void initializeInventory();
 
+  /**
+   * @brief スロットを1件登録（プラノグラムファイルからの読み込み用）
+   * @param slot 登録するスロット
+   * @throw std::invalid_argument 同じ SlotId が登録済みの場合
+   */
+  void addSlot(const domain::ProductSlot &slot);
+
   // ユースケースへのアクセサ
   PurchaseWithCashUseCase &getPurchaseWithCashUseCase() {
     return *purchase_with_cash_usecase_;
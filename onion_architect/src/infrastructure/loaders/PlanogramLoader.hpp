@@ -0,0 +1,145 @@
+/**
+ * @file PlanogramLoader.hpp
+ * @brief プラノグラム（スロット構成）ファイルの読み込み（CSV / JSON）
+ *
+ * @details
+ * 入力を再利用するバッファへ一定量ずつ読み込み、バッファ上でそのまま
+ * 行（JSON ではオブジェクト）と項目に区切ります。項目は std::string_view
+ * で扱い、数値は std::from_chars で変換するため、区切り処理では
+ * メモリを確保しません（確保するのは ProductName が保持する商品名だけ）。
+ *
+ * CSV 形式（1行目はヘッダ。列の順序は自由、machine_id は省略可）:
+ *   machine_id,slot_id,name,price,stock
+ *   M001,1,コーラ,120,10
+ *
+ * 項目はダブルクォートで囲めます（"" はクォート自身を表す）。
+ *
+ * JSON 形式（フラットなオブジェクトの配列。未知のキーは無視）:
+ *   [{"machine_id": "M001", "slot_id": 1, "name": "コーラ",
+ *     "price": 120, "stock": 10}]
+ *
+ * 各行の値（SlotId・ProductName・Price・Quantity）は例外を使わずに
+ * まとめて検証し、不正な行は読み飛ばして行番号と理由をすべて報告します。
+ *
+ * @author VendingMachine Team
+ * @version 1.0.0
+ */
+
+#ifndef VENDING_MACHINE_INFRASTRUCTURE_LOADERS_PLANOGRAM_LOADER_HPP
+#define VENDING_MACHINE_INFRASTRUCTURE_LOADERS_PLANOGRAM_LOADER_HPP
+
+#include "domain/inventory/Inventory.hpp"
+#include "domain/inventory/ProductSlot.hpp"
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vending_machine {
+namespace infrastructure {
+
+/**
+ * @enum PlanogramFormat
+ * @brief プラノグラムファイルの形式
+ */
+enum class PlanogramFormat {
+  CSV, ///< ヘッダ付き CSV
+  JSON ///< オブジェクトの配列
+};
+
+/**
+ * @struct PlanogramError
+ * @brief 読み込めなかった行とその理由
+ */
+struct PlanogramError {
+  std::size_t line;    ///< 行番号（1始まり。JSON はオブジェクトの開始行）
+  std::string message; ///< 理由
+};
+
+/**
+ * @struct PlanogramLoadResult
+ * @brief 読み込みの結果
+ */
+struct PlanogramLoadResult {
+  std::size_t rows_read = 0;    ///< 読んだデータ行の数（不正な行を含む）
+  std::size_t slots_loaded = 0; ///< 登録したスロット数
+  std::vector<PlanogramError> errors; ///< 不正な行（行番号順）
+
+  /**
+   * @brief すべての行を読み込めたか
+   */
+  bool ok() const { return errors.empty(); }
+};
+
+/**
+ * @class PlanogramLoader
+ * @brief プラノグラムファイルを逐次読み込んでスロットを生成するローダー
+ *
+ * バッファはインスタンスごとに保持して使い回します。
+ */
+class PlanogramLoader {
+public:
+  /// 既定のバッファサイズ（1行・1オブジェクトの最大長でもある）
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t{1} << 16;
+
+  /**
+   * @brief 検証済みの1行を受け取る関数
+   *
+   * std::invalid_argument / std::domain_error を送出すると、
+   * その行は不正な行として報告されます（SlotId の重複など）。
+   */
+  using SlotVisitor = std::function<void(std::string_view machine_id,
+                                         const domain::ProductSlot &slot)>;
+
+  /**
+   * @brief コンストラクタ
+   * @param buffer_size 読み込み用バッファのサイズ（1行の最大長）
+   * @throw std::invalid_argument バッファサイズが 0 の場合
+   */
+  explicit PlanogramLoader(std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  /**
+   * @brief ストリームを読み込み、有効な行ごとに visitor を呼び出す
+   * @param in 入力ストリーム
+   * @param format 入力形式
+   * @param visitor 有効な行ごとに呼び出す関数
+   * @param machine_id 空でない場合、この機械の行だけを扱う
+   *        （他の機械の行は検証もせず、rows_read にも数えない）
+   * @return 読み込みの結果
+   * @throw std::runtime_error ストリームの読み込みに失敗した場合
+   */
+  PlanogramLoadResult load(std::istream &in, PlanogramFormat format,
+                           const SlotVisitor &visitor,
+                           std::string_view machine_id = {});
+
+  /**
+   * @brief ストリームを読み込み、在庫にスロットを登録
+   * @param in 入力ストリーム
+   * @param format 入力形式
+   * @param inventory 登録先の在庫
+   * @param machine_id 空でない場合、この機械の行だけを登録
+   * @return 読み込みの結果（登録済みの SlotId は不正な行として報告）
+   * @throw std::runtime_error ストリームの読み込みに失敗した場合
+   */
+  PlanogramLoadResult loadInto(std::istream &in, PlanogramFormat format,
+                               domain::Inventory &inventory,
+                               std::string_view machine_id = {});
+
+  /**
+   * @brief ファイル名の拡張子から形式を判定
+   * @param path ファイルパス
+   * @return ".json" で終わる場合 JSON、それ以外は CSV
+   */
+  static PlanogramFormat formatFromPath(std::string_view path);
+
+private:
+  std::vector<char> buffer_;
+  std::string name_buffer_; ///< 商品名の受け渡し用（使い回す）
+};
+
+} // namespace infrastructure
+} // namespace vending_machine
+
+#endif // VENDING_MACHINE_INFRASTRUCTURE_LOADERS_PLANOGRAM_LOADER_HPP
@@ -2,11 +2,40 @@
 #include "infrastructure/adapters/SimulatedCoinMech.hpp"
 #include "infrastructure/adapters/SimulatedDispenser.hpp"
 #include "infrastructure/adapters/SimulatedPaymentGateway.hpp"
+#include "infrastructure/loaders/PlanogramLoader.hpp"
 #include "infrastructure/repositories/InMemoryTransactionHistoryRepository.hpp"
 #include "presentation/ConsoleUI.hpp"
+#include <fstream>
 #include <iostream>
+#include <string>
 
-int main() {
+namespace {
+
+// プラノグラムファイルからスロットを登録する。読めなかった行は報告する
+bool loadPlanogram(vending_machine::application::VendingMachineApplication &app,
+                   const std::string &path) {
+  using vending_machine::infrastructure::PlanogramLoader;
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::cerr << "プラノグラムを開けません: " << path << "\n";
+    return false;
+  }
+
+  PlanogramLoader loader;
+  auto result = loader.load(in, PlanogramLoader::formatFromPath(path),
+                            [&app](std::string_view,
+                                   const vending_machine::domain::ProductSlot
+                                       &slot) { app.addSlot(slot); });
+  for (const auto &error : result.errors) {
+    std::cerr << path << ":" << error.line << ": " << error.message << "\n";
+  }
+  return result.slots_loaded > 0;
+}
+
+} // namespace
+
+// 使い方: vending_machine [プラノグラムファイル（.csv / .json）]
+int main(int argc, char *argv[]) {
   try {
     // インフラストラクチャの実装を作成
     vending_machine::infrastructure::InMemoryTransactionHistoryRepository
@@ -19,8 +48,10 @@ int main() {
     vending_machine::application::VendingMachineApplication app(
         coin_mech, dispenser, payment_gateway, transaction_history);
 
-    // 初期在庫を設定
-    app.initializeInventory();
+    // 初期在庫を設定（プラノグラムが指定されていればそこから読み込む）
+    if (argc < 2 || !loadPlanogram(app, argv[1])) {
+      app.initializeInventory();
+    }
 
     // UIを作成して実行
     vending_machine::presentation::ConsoleUI ui(app);
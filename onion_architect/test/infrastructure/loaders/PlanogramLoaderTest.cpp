@@ -0,0 +1,190 @@
+/**
+ * @file PlanogramLoaderTest.cpp
+ * @brief PlanogramLoader のユニットテスト
+ *
+ * テスト方針:
+ * - CSV / JSON から在庫へスロットが登録される
+ * - 不正な行は読み飛ばされ、行番号と理由がすべて報告される
+ * - バッファより長い入力も、行がバッファ境界をまたいでも同じ結果になる
+ * - machine_id を指定するとその機械の行だけが登録される
+ */
+
+#include "src/infrastructure/loaders/PlanogramLoader.hpp"
+#include "src/domain/common/Price.hpp"
+#include "src/domain/inventory/ProductName.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace vending_machine {
+namespace infrastructure {
+
+class PlanogramLoaderTest : public ::testing::Test {
+protected:
+  PlanogramLoadResult loadCsv(const std::string &text,
+                              std::size_t buffer_size =
+                                  PlanogramLoader::DEFAULT_BUFFER_SIZE) {
+    std::istringstream in(text);
+    PlanogramLoader loader(buffer_size);
+    return loader.loadInto(in, PlanogramFormat::CSV, inventory);
+  }
+
+  PlanogramLoadResult loadJson(const std::string &text) {
+    std::istringstream in(text);
+    PlanogramLoader loader;
+    return loader.loadInto(in, PlanogramFormat::JSON, inventory);
+  }
+
+  const domain::ProductSlot &slot(int id) const {
+    return inventory.getSlot(domain::SlotId(id));
+  }
+
+  domain::Inventory inventory;
+};
+
+TEST_F(PlanogramLoaderTest, LoadsCsvWithQuotedFields) {
+  auto result = loadCsv("slot_id,name,price,stock\r\n"
+                        "1,コーラ,120,10\r\n"
+                        "2,\"Tea, \"\"green\"\"\",150,0\r\n"
+                        "\n"
+                        "3,水,100,50");
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.rows_read, 3u);
+  EXPECT_EQ(result.slots_loaded, 3u);
+  EXPECT_EQ(slot(1).getProductInfo().getName().getValue(), "コーラ");
+  EXPECT_EQ(slot(1).getProductInfo().getPrice(), domain::Price(120));
+  EXPECT_EQ(slot(2).getProductInfo().getName().getValue(),
+            "Tea, \"green\"");
+  EXPECT_EQ(slot(2).getStock(), domain::Quantity(0));
+  EXPECT_EQ(slot(3).getStock(), domain::Quantity(50));
+}
+
+TEST_F(PlanogramLoaderTest, ColumnsMayAppearInAnyOrder) {
+  auto result = loadCsv("stock,price,extra,name,slot_id\n"
+                        "7,130,ignored,コーヒー,4\n");
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(slot(4).getStock(), domain::Quantity(7));
+  EXPECT_EQ(slot(4).getProductInfo().getPrice(), domain::Price(130));
+}
+
+TEST_F(PlanogramLoaderTest, ReportsEveryBadRowAndLoadsTheRest) {
+  auto result = loadCsv("slot_id,name,price,stock\n"
+                        "1,コーラ,120,10\n"
+                        "0,お茶,abc,51\n"
+                        "2,,100\n"
+                        "3,,100,5\n"
+                        "1,水,100,5\n"
+                        "4,\"unterminated,100,5\n");
+
+  EXPECT_EQ(result.rows_read, 4u);
+  EXPECT_EQ(result.slots_loaded, 1u);
+  ASSERT_EQ(result.errors.size(), 5u);
+  EXPECT_EQ(result.errors[0].line, 3u);
+  EXPECT_NE(result.errors[0].message.find("slot_id"), std::string::npos);
+  EXPECT_NE(result.errors[0].message.find("price"), std::string::npos);
+  EXPECT_NE(result.errors[0].message.find("stock"), std::string::npos);
+  EXPECT_EQ(result.errors[1].line, 4u); // 項目数が合わない
+  EXPECT_EQ(result.errors[2].line, 5u); // 商品名が空
+  EXPECT_EQ(result.errors[3].line, 6u); // SlotId の重複
+  EXPECT_EQ(result.errors[4].line, 7u); // クォートが閉じていない
+  EXPECT_EQ(inventory.getAllSlots().size(), 1u);
+}
+
+TEST_F(PlanogramLoaderTest, MissingHeaderColumnStopsLoading) {
+  auto result = loadCsv("slot_id,name,price\n1,コーラ,120\n");
+
+  ASSERT_EQ(result.errors.size(), 1u);
+  EXPECT_EQ(result.errors[0].line, 1u);
+  EXPECT_EQ(result.rows_read, 0u);
+}
+
+TEST_F(PlanogramLoaderTest, RecordsSpanningBufferBoundariesAreLoaded) {
+  std::string text = "slot_id,name,price,stock\n";
+  for (int id = 1; id <= 200; ++id) {
+    text += std::to_string(id) + ",product-" + std::to_string(id) + "," +
+            std::to_string(id * 10) + "," + std::to_string(id % 51) + "\n";
+  }
+
+  auto result = loadCsv(text, 32);
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.slots_loaded, 200u);
+  EXPECT_EQ(slot(200).getProductInfo().getName().getValue(), "product-200");
+  EXPECT_EQ(slot(200).getStock(), domain::Quantity(200 % 51));
+}
+
+TEST_F(PlanogramLoaderTest, RecordLongerThanBufferIsReported) {
+  auto result = loadCsv("slot_id,name,price,stock\n1," +
+                            std::string(100, 'x') + ",120,10\n",
+                        32);
+
+  ASSERT_EQ(result.errors.size(), 1u);
+  EXPECT_EQ(result.errors[0].line, 2u);
+}
+
+TEST_F(PlanogramLoaderTest, LoadsJsonArray) {
+  auto result = loadJson(R"([
+  {"slot_id": 1, "name": "コーラ", "price": 120, "stock": 10},
+  {"stock": 3, "price": 150, "name": "Tea \"green\"", "slot_id": 2,
+   "note": "ignored"}
+])");
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.slots_loaded, 2u);
+  EXPECT_EQ(slot(1).getProductInfo().getName().getValue(), "コーラ");
+  EXPECT_EQ(slot(2).getProductInfo().getName().getValue(), "Tea \"green\"");
+  EXPECT_EQ(slot(2).getStock(), domain::Quantity(3));
+}
+
+TEST_F(PlanogramLoaderTest, ReportsBadJsonObjectsByLine) {
+  auto result = loadJson(R"([
+  {"slot_id": 1, "name": "コーラ", "price": 120, "stock": 10},
+  {"slot_id": 2, "name": "お茶", "price": -1, "stock": 10},
+  {"slot_id": 3, "name": "水", "price": 100},
+  {"slot_id": 4, "name": {"nested": true}, "price": 100, "stock": 1}
+])");
+
+  EXPECT_EQ(result.slots_loaded, 1u);
+  ASSERT_EQ(result.errors.size(), 3u);
+  EXPECT_EQ(result.errors[0].line, 3u);
+  EXPECT_EQ(result.errors[1].line, 4u);
+  EXPECT_EQ(result.errors[1].message, "missing stock");
+  EXPECT_EQ(result.errors[2].line, 5u);
+}
+
+TEST_F(PlanogramLoaderTest, MalformedJsonStructureIsReported) {
+  EXPECT_FALSE(loadJson(R"({"slot_id": 1})").ok());
+  EXPECT_FALSE(loadJson(R"([{"slot_id": 1, "name": "a")").ok());
+  EXPECT_FALSE(loadJson("[1, 2]").ok());
+  EXPECT_TRUE(loadJson("[]").ok());
+}
+
+TEST_F(PlanogramLoaderTest, FiltersFleetFileByMachine) {
+  std::istringstream in("machine_id,slot_id,name,price,stock\n"
+                        "M001,1,コーラ,120,10\n"
+                        "M002,1,お茶,150,10\n"
+                        "M002,2,水,abc,10\n"
+                        "M001,2,水,100,10\n");
+  PlanogramLoader loader;
+
+  auto result =
+      loader.loadInto(in, PlanogramFormat::CSV, inventory, "M001");
+
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(result.rows_read, 2u);
+  EXPECT_EQ(inventory.getAllSlots().size(), 2u);
+  EXPECT_EQ(slot(1).getProductInfo().getName().getValue(), "コーラ");
+}
+
+TEST_F(PlanogramLoaderTest, FormatIsChosenByExtension) {
+  EXPECT_EQ(PlanogramLoader::formatFromPath("fleet.json"),
+            PlanogramFormat::JSON);
+  EXPECT_EQ(PlanogramLoader::formatFromPath("fleet.csv"),
+            PlanogramFormat::CSV);
+  EXPECT_EQ(PlanogramLoader::formatFromPath("json"), PlanogramFormat::CSV);
+}
+
+} // namespace infrastructure
+} // namespace vending_machine